@@ -0,0 +1,65 @@
+! Fortran program that solves a sequence of polynomials
+! reusing the same MPSolve solver
+!
+! The polynomials x^n - k, for k = 1, ..., m, are solved first one at
+! a time, as in a time-stepping loop, and then all together.
+!
+PROGRAM batch_roots
+
+	USE, INTRINSIC :: ISO_C_BINDING, ONLY : C_INT
+	USE mpsolve
+
+	IMPLICIT NONE
+
+	! Double precision
+	INTEGER, PARAMETER :: dp = KIND(0.d0)
+
+	! Degree and number of polynomials
+	INTEGER, PARAMETER :: n = 5
+	INTEGER, PARAMETER :: m = 4
+
+	! Auxiliary variables
+	INTEGER :: i, k, info
+	REAL(dp) :: err
+
+	TYPE(mps_solver) :: solver
+
+	! Coefficients, roots and inclusion radii
+	COMPLEX(dp), DIMENSION(n + 1, m) :: coeff
+	COMPLEX(dp), DIMENSION(n, m) :: roots
+	REAL(dp), DIMENSION(n, m) :: radius
+	INTEGER(C_INT), DIMENSION(m) :: status
+
+	! Set coefficients of x^n - k
+	coeff = 0
+	DO k = 1,m
+		coeff(1, k) = -k
+		coeff(n + 1, k) = 1
+	END DO
+
+	CALL mps_solver_new(solver)
+
+	! Solve the polynomials one at a time
+	DO k = 1,m
+		CALL mps_solve(solver, coeff(:, k), roots(:, k), radius(:, k), info)
+		IF (info /= MPS_SUCCESS) STOP 1
+	END DO
+
+	! Solve them again all together
+	CALL mps_solve_batch(solver, coeff, roots, radius, status)
+	IF (ANY(status /= MPS_SUCCESS)) STOP 1
+
+	CALL mps_solver_free(solver)
+
+	! Check that the roots have modulus k^(1/n)
+	err = 0
+	DO k = 1,m
+		DO i = 1,n
+			err = MAX(err, ABS(ABS(roots(i, k)) - REAL(k, dp) ** (1.0_dp / n)))
+		END DO
+	END DO
+
+	WRITE(*,*) "Maximum error on the moduli of the roots: ", err
+	IF (err > 1.0e-12_dp) STOP 1
+
+END PROGRAM
@@ -38,3 +38,171 @@ mps_roots_ (int * n, cplx_t * coeff, cplx_t * roots)
   mps_context_get_roots_d (s, &roots, NULL);
   mps_context_free (s);
 }
+
+/**
+ * @brief Status codes returned by the solver handles.
+ */
+#define MPS_FORTRAN_SUCCESS 0
+#define MPS_FORTRAN_INVALID_POLYNOMIAL 1
+#define MPS_FORTRAN_SOLVER_ERROR 2
+
+/**
+ * @brief A solver that can be used for many polynomials in a row.
+ *
+ * The mps_context, with its thread pool and workspace, lives as long as
+ * the handle, and the polynomial is reallocated only when the degree
+ * changes, so calling the solver inside a loop does not allocate
+ * anything in the common case.
+ */
+typedef struct {
+  mps_context * ctx;
+  mps_monomial_poly * poly;
+} mps_fortran_solver;
+
+static void
+mps_fortran_solver_init (mps_fortran_solver * solver)
+{
+  solver->ctx = mps_context_new ();
+  solver->poly = NULL;
+
+  mps_context_set_output_prec (solver->ctx, 53);
+  mps_context_set_output_goal (solver->ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+}
+
+static void
+mps_fortran_solver_clear (mps_fortran_solver * solver)
+{
+  if (solver->poly)
+    mps_polynomial_free (solver->ctx, MPS_POLYNOMIAL (solver->poly));
+
+  mps_context_free (solver->ctx);
+}
+
+/**
+ * @brief Create a new solver handle, that must be released with
+ * mps_fortran_solver_free().
+ */
+mps_fortran_solver *
+mps_fortran_solver_new (void)
+{
+  mps_fortran_solver * solver = mps_new (mps_fortran_solver);
+
+  mps_fortran_solver_init (solver);
+
+  return solver;
+}
+
+/**
+ * @brief Release a handle created by mps_fortran_solver_new().
+ */
+void
+mps_fortran_solver_free (mps_fortran_solver * solver)
+{
+  if (!solver)
+    return;
+
+  mps_fortran_solver_clear (solver);
+  free (solver);
+}
+
+/**
+ * @brief Solve the polynomial of degree n with coefficients
+ * coeff[0], ..., coeff[n], in increasing order of degree.
+ *
+ * The roots and, if radius is not NULL, their inclusion radii are written
+ * in the n elements of the arrays provided by the caller. The roots equal
+ * to zero are removed before calling MPSolve, so that the polynomial
+ * stored in the handle is never deflated and can be reused.
+ *
+ * @return MPS_FORTRAN_SUCCESS, MPS_FORTRAN_INVALID_POLYNOMIAL if n is not
+ * positive or the leading coefficient is zero, or MPS_FORTRAN_SOLVER_ERROR
+ * if MPSolve failed. In the last two cases the outputs are undefined.
+ */
+int
+mps_fortran_solve (mps_fortran_solver * solver, int n, const cplx_t * coeff,
+                   cplx_t * roots, double * radius)
+{
+  mps_context * ctx = solver->ctx;
+  int i, zero_roots = 0, degree;
+
+  if (n <= 0 || (cplx_Re (coeff[n]) == 0.0 && cplx_Im (coeff[n]) == 0.0))
+    return MPS_FORTRAN_INVALID_POLYNOMIAL;
+
+  while (cplx_Re (coeff[zero_roots]) == 0.0 && cplx_Im (coeff[zero_roots]) == 0.0)
+    {
+      cplx_set (roots[n - zero_roots - 1], cplx_zero);
+      if (radius)
+        radius[n - zero_roots - 1] = 0.0;
+      zero_roots++;
+    }
+
+  degree = n - zero_roots;
+  if (degree == 0)
+    return MPS_FORTRAN_SUCCESS;
+
+  if (solver->poly && MPS_POLYNOMIAL (solver->poly)->degree != degree)
+    {
+      mps_polynomial_free (ctx, MPS_POLYNOMIAL (solver->poly));
+      solver->poly = NULL;
+    }
+
+  if (!solver->poly)
+    solver->poly = mps_monomial_poly_new (ctx, degree);
+
+  /* Let the structure be detected again from the new coefficients. */
+  MPS_POLYNOMIAL (solver->poly)->structure = MPS_STRUCTURE_UNKNOWN;
+  for (i = 0; i <= degree; i++)
+    mps_monomial_poly_set_coefficient_d (ctx, solver->poly, i,
+                                         cplx_Re (coeff[i + zero_roots]),
+                                         cplx_Im (coeff[i + zero_roots]));
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (solver->poly));
+  mps_mpsolve (ctx);
+
+  /* The error state of a context is never cleared, so start again
+   * with a new one for the next polynomial. */
+  if (mps_context_has_errors (ctx))
+    {
+      mps_fortran_solver_clear (solver);
+      mps_fortran_solver_init (solver);
+      return MPS_FORTRAN_SOLVER_ERROR;
+    }
+
+  mps_context_get_roots_d (ctx, &roots, radius ? &radius : NULL);
+
+  return MPS_FORTRAN_SUCCESS;
+}
+
+/**
+ * @brief Solve m polynomials of degree n at once.
+ *
+ * The coefficients of the j-th polynomial are coeff[j * (n + 1)], ...,
+ * coeff[j * (n + 1) + n], i.e., the columns of a Fortran array of shape
+ * (n + 1, m), and its roots and radii are written in the j-th column of
+ * the arrays roots and radius of shape (n, m). The radii can be NULL.
+ *
+ * @param info If not NULL, the status returned by mps_fortran_solve() for
+ * each polynomial is stored in info[j].
+ * @return The number of polynomials that could not be solved.
+ */
+int
+mps_fortran_solve_batch (mps_fortran_solver * solver, int n, int m, const cplx_t * coeff,
+                         cplx_t * roots, double * radius, int * info)
+{
+  int j, status, failed = 0;
+
+  for (j = 0; j < m; j++)
+    {
+      status = mps_fortran_solve (solver, n, coeff + (size_t) j * (n + 1),
+                                  roots + (size_t) j * n,
+                                  radius ? radius + (size_t) j * n : NULL);
+
+      if (status != MPS_FORTRAN_SUCCESS)
+        failed++;
+
+      if (info)
+        info[j] = status;
+    }
+
+  return failed;
+}
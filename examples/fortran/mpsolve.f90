@@ -0,0 +1,127 @@
+! Fortran module with the bindings to the MPSolve solver handles
+! defined in mps_impl.c
+!
+! A solver handle keeps the MPSolve context alive between calls,
+! so that polynomials can be solved inside a loop without creating
+! and destroying the context every time. Coefficients are read from
+! contiguous arrays, in increasing order of degree, and the roots
+! are written in arrays owned by the caller.
+!
+MODULE mpsolve
+
+	USE, INTRINSIC :: ISO_C_BINDING
+
+	IMPLICIT NONE
+	PRIVATE
+
+	PUBLIC :: mps_solver, mps_solver_new, mps_solver_free
+	PUBLIC :: mps_solve, mps_solve_batch
+
+	! Status codes, see mps_impl.c
+	INTEGER, PARAMETER, PUBLIC :: MPS_SUCCESS = 0
+	INTEGER, PARAMETER, PUBLIC :: MPS_INVALID_POLYNOMIAL = 1
+	INTEGER, PARAMETER, PUBLIC :: MPS_SOLVER_ERROR = 2
+
+	! Opaque solver handle
+	TYPE :: mps_solver
+		TYPE(C_PTR) :: handle = C_NULL_PTR
+	END TYPE
+
+	INTERFACE
+		FUNCTION mps_fortran_solver_new () BIND(C, NAME = "mps_fortran_solver_new")
+			IMPORT :: C_PTR
+			TYPE(C_PTR) :: mps_fortran_solver_new
+		END FUNCTION
+
+		SUBROUTINE mps_fortran_solver_free (solver) BIND(C, NAME = "mps_fortran_solver_free")
+			IMPORT :: C_PTR
+			TYPE(C_PTR), VALUE :: solver
+		END SUBROUTINE
+
+		FUNCTION mps_fortran_solve (solver, n, coeff, roots, radius) &
+			BIND(C, NAME = "mps_fortran_solve")
+			IMPORT :: C_PTR, C_INT, C_DOUBLE, C_DOUBLE_COMPLEX
+			TYPE(C_PTR), VALUE :: solver
+			INTEGER(C_INT), VALUE :: n
+			COMPLEX(C_DOUBLE_COMPLEX), DIMENSION(*), INTENT(IN) :: coeff
+			COMPLEX(C_DOUBLE_COMPLEX), DIMENSION(*), INTENT(OUT) :: roots
+			REAL(C_DOUBLE), DIMENSION(*), INTENT(OUT) :: radius
+			INTEGER(C_INT) :: mps_fortran_solve
+		END FUNCTION
+
+		FUNCTION mps_fortran_solve_batch (solver, n, m, coeff, roots, radius, info) &
+			BIND(C, NAME = "mps_fortran_solve_batch")
+			IMPORT :: C_PTR, C_INT, C_DOUBLE, C_DOUBLE_COMPLEX
+			TYPE(C_PTR), VALUE :: solver
+			INTEGER(C_INT), VALUE :: n, m
+			COMPLEX(C_DOUBLE_COMPLEX), DIMENSION(*), INTENT(IN) :: coeff
+			COMPLEX(C_DOUBLE_COMPLEX), DIMENSION(*), INTENT(OUT) :: roots
+			REAL(C_DOUBLE), DIMENSION(*), INTENT(OUT) :: radius
+			INTEGER(C_INT), DIMENSION(*), INTENT(OUT) :: info
+			INTEGER(C_INT) :: mps_fortran_solve_batch
+		END FUNCTION
+	END INTERFACE
+
+CONTAINS
+
+	! Create a new solver, that must be released with mps_solver_free
+	SUBROUTINE mps_solver_new (solver)
+		TYPE(mps_solver), INTENT(OUT) :: solver
+
+		solver%handle = mps_fortran_solver_new ()
+	END SUBROUTINE
+
+	SUBROUTINE mps_solver_free (solver)
+		TYPE(mps_solver), INTENT(INOUT) :: solver
+
+		CALL mps_fortran_solver_free (solver%handle)
+		solver%handle = C_NULL_PTR
+	END SUBROUTINE
+
+	! Solve the polynomial with coefficients coeff(1), ..., coeff(n + 1),
+	! where n = SIZE(roots), and store the roots and their inclusion
+	! radii in roots and radius.
+	SUBROUTINE mps_solve (solver, coeff, roots, radius, info)
+		TYPE(mps_solver), INTENT(IN) :: solver
+		COMPLEX(C_DOUBLE_COMPLEX), DIMENSION(:), CONTIGUOUS, INTENT(IN) :: coeff
+		COMPLEX(C_DOUBLE_COMPLEX), DIMENSION(:), CONTIGUOUS, INTENT(OUT) :: roots
+		REAL(C_DOUBLE), DIMENSION(:), CONTIGUOUS, INTENT(OUT) :: radius
+		INTEGER, INTENT(OUT), OPTIONAL :: info
+
+		INTEGER(C_INT) :: status
+
+		IF (SIZE(coeff) /= SIZE(roots) + 1 .OR. SIZE(radius) < SIZE(roots)) THEN
+			status = MPS_INVALID_POLYNOMIAL
+		ELSE
+			status = mps_fortran_solve (solver%handle, INT(SIZE(roots), C_INT), &
+				coeff, roots, radius)
+		END IF
+
+		IF (PRESENT(info)) info = status
+	END SUBROUTINE
+
+	! Solve the polynomials stored in the columns of coeff, of shape
+	! (n + 1, m), and store their roots and radii in the columns of roots
+	! and radius, of shape (n, m). The status of the j-th polynomial is
+	! written in info(j).
+	SUBROUTINE mps_solve_batch (solver, coeff, roots, radius, info)
+		TYPE(mps_solver), INTENT(IN) :: solver
+		COMPLEX(C_DOUBLE_COMPLEX), DIMENSION(:,:), CONTIGUOUS, INTENT(IN) :: coeff
+		COMPLEX(C_DOUBLE_COMPLEX), DIMENSION(:,:), CONTIGUOUS, INTENT(OUT) :: roots
+		REAL(C_DOUBLE), DIMENSION(:,:), CONTIGUOUS, INTENT(OUT) :: radius
+		INTEGER(C_INT), DIMENSION(:), CONTIGUOUS, INTENT(OUT) :: info
+
+		INTEGER(C_INT) :: failed
+
+		IF (SIZE(coeff, 1) /= SIZE(roots, 1) + 1 .OR. &
+			ANY(SHAPE(radius) /= SHAPE(roots)) .OR. &
+			SIZE(coeff, 2) /= SIZE(roots, 2) .OR. SIZE(info) < SIZE(roots, 2)) THEN
+			info = MPS_INVALID_POLYNOMIAL
+			RETURN
+		END IF
+
+		failed = mps_fortran_solve_batch (solver%handle, INT(SIZE(roots, 1), C_INT), &
+			INT(SIZE(roots, 2), C_INT), coeff, roots, radius, info)
+	END SUBROUTINE
+
+END MODULE
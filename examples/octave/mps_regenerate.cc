@@ -40,13 +40,17 @@ This function will take that b_i chosen as nodes and return the respective a_i s
     {
       ComplexMatrix A = args(1).complex_matrix_value().transpose();
       cplx_t * A_data = (cplx_t*) A.fortran_vec();
+      long int * exponents = mps_newv (long int, a.length());
+
+      // Compute all the determinants det(A - b_i I) in a single call
+      mps_fhessenberg_shifted_determinants (ctx, A_data, A.rows(), fb, b.length(), fa,
+					    NULL, exponents, NULL);
       
       for (int i = 0; i < a.length(); i++)
 	{
-	  long int exponent = 0;
+	  long int exponent = exponents[i];
 	  cplx_t prod;
 
-	  mps_fhessenberg_shifted_determinant (ctx, A_data, fb[i], A.rows(), fa[i], &exponent);
 	  cplx_set (prod, cplx_one);
 
 	  for (int j = 0; j < b.length(); j++)
@@ -74,6 +78,8 @@ This function will take that b_i chosen as nodes and return the respective a_i s
 	  cdpe_get_x (prod, ctmp);
 	  cplx_mul_eq (fa[i], prod);
 	}
+
+      free (exponents);
     }
 
   mps_context_free (ctx);
@@ -33,6 +33,12 @@ struct mps_approximation {
   mps_boolean again;
   long int wp;
 
+  /**
+   * @brief True if the approximation has been left at its precision
+   * by the last raise of the working precision of the secular equation.
+   */
+  mps_boolean frozen;
+
   mps_root_status status;
 
   /**
@@ -51,6 +57,42 @@ struct mps_approximation {
 
 #endif
 
+/**
+ * @brief Read-only view of the approximations stored in a mps_context.
+ *
+ * The view is filled by mps_context_get_root_view() with pointers to the
+ * internal storage of the context, so nothing is copied and nothing has to
+ * be freed. It stays valid until the context solves another polynomial or
+ * is freed. The approximations can be inspected with the accessor functions
+ * below, that do not allocate memory.
+ */
+struct mps_root_view {
+  /**
+   * @brief Number of approximations in <code>root</code>.
+   */
+  int n;
+
+  /**
+   * @brief Number of roots equal to zero, that have been deflated from the
+   * polynomial and are not stored in <code>root</code>.
+   */
+  int zero_roots;
+
+  /**
+   * @brief Phase where the approximations have been computed. The values
+   * stored in <code>fvalue</code> or <code>dvalue</code> are meaningful
+   * only if this is float_phase or dpe_phase, respectively, while the
+   * ones in <code>mvalue</code> always are after mps_mpsolve() has
+   * returned.
+   */
+  mps_phase phase;
+
+  /**
+   * @brief The approximations, owned by the context.
+   */
+  mps_approximation * const * root;
+};
+
 /* Creation and deletion of approximations. */
 mps_approximation * mps_approximation_new (mps_context * s);
 void mps_approximation_free (mps_context * s, mps_approximation * appr);
@@ -67,6 +109,7 @@ mps_root_status mps_approximation_get_status (mps_context * ctx, mps_approximati
 mps_root_attrs mps_approximation_get_attrs (mps_context * ctx, mps_approximation * approximation);
 mps_root_inclusion mps_approximaiton_get_inclusion (mps_context * ctx, mps_approximation * approximation);
 mps_boolean mps_approximation_get_again (mps_context * ctx, mps_approximation * approximation);
+long int mps_approximation_get_wp (mps_context * ctx, mps_approximation * approximation);
 
 /* Public setters functions */
 void mps_approximation_set_fvalue (mps_context * ctx, mps_approximation * approximation, const cplx_t value);
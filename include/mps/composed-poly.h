@@ -0,0 +1,181 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Polynomials defined by the iteration of a bivariate map.
+ *
+ * A composed polynomial is given by a base polynomial \f$p_0(x)\f$, a
+ * step map
+ * \f[
+ *   f(x, y) = \sum_{i,j} f_{ij} x^i y^j,
+ * \f]
+ * and a number of levels \f$k\f$, and it is defined by the recurrence
+ * \f$p_{l}(x) = f(x, p_{l-1}(x))\f$, \f$p = p_k\f$. Its degree can be
+ * exponential in \f$k\f$, but it is evaluated (with its derivative) in
+ * \f$O(k)\f$ operations, without ever computing its coefficients.
+ *
+ * The Mandelbrot polynomials, for example, are obtained with \f$p_0 = 1\f$
+ * and \f$f(x,y) = 1 + x y^2\f$, while if \f$f\f$ does not depend on
+ * \f$x\f$ the polynomial is the composition \f$g^{\circ k} \circ p_0\f$
+ * with \f$g(y) = f(x, y)\f$.
+ *
+ * The starting points are obtained from the roots of the lower levels: the
+ * ones of a composition are the preimages of the roots of \f$g\f$, computed
+ * level by level, while in the other cases the roots of \f$p_{k-1}\f$ are
+ * approximated in a separate mps_context and used as centers of the
+ * starting points of \f$p_k\f$.
+ */
+
+#ifndef MPS_COMPOSED_POLY_H_
+#define MPS_COMPOSED_POLY_H_
+
+MPS_BEGIN_DECLS
+
+ #define MPS_COMPOSED_POLY_TYPE_NAME "mps_composed_poly"
+ #define MPS_COMPOSED_POLY(t) ((mps_composed_poly*)t)
+ #define MPS_IS_COMPOSED_POLY(t) mps_polynomial_check_type (t, "mps_composed_poly")
+
+/**
+ * @brief Position of the coefficient \f$f_{ij}\f$ of the step map in the
+ * coefficient vectors of a mps_composed_poly. The coefficients of the
+ * base polynomial come first, in increasing degree.
+ */
+#define MPS_COMPOSED_POLY_INDEX(cp, i, j) ((cp)->base_degree + 1 + (j) * ((cp)->x_degree + 1) + (i))
+
+typedef struct {
+  /**
+   * @brief Base implementation of a polynomial.
+   */
+  mps_polynomial super;
+
+  /**
+   * @brief Number of applications of the step map.
+   */
+  int levels;
+
+  /**
+   * @brief Maximum degree of the base polynomial.
+   */
+  int base_degree;
+
+  /**
+   * @brief Maximum degree in \f$x\f$ of the step map.
+   */
+  int x_degree;
+
+  /**
+   * @brief Maximum degree in \f$y\f$ of the step map.
+   */
+  int y_degree;
+
+  /**
+   * @brief Number of coefficients stored, that is
+   * <code>base_degree + 1 + (x_degree + 1) * (y_degree + 1)</code>.
+   */
+  int n_coeffs;
+
+  /**
+   * @brief Degrees of the polynomials \f$p_0, \dots, p_k\f$, or -1 for the
+   * ones that are zero.
+   */
+  int * degrees;
+
+  /**
+   * @brief Floating point coefficients.
+   */
+  cplx_t * fpc;
+
+  /**
+   * @brief DPE coefficients.
+   */
+  cdpe_t * dpc;
+
+  /**
+   * @brief Multiprecision coefficients.
+   */
+  mpc_t * mfpc;
+
+  /**
+   * @brief Moduli of the coefficients, used in the floating point error
+   * bounds.
+   */
+  double * fap;
+
+  /**
+   * @brief Moduli of the coefficients, used in the DPE and multiprecision
+   * error bounds.
+   */
+  rdpe_t * dap;
+
+  /**
+   * @brief Real parts of the coefficients.
+   */
+  mpq_t * rational_real_coeffs;
+
+  /**
+   * @brief Imaginary parts of the coefficients.
+   */
+  mpq_t * rational_imag_coeffs;
+
+  /**
+   * @brief Internal mutex used to manage the change of precision.
+   */
+  pthread_mutex_t precision_mutex;
+} mps_composed_poly;
+
+/**
+ * @brief Create a new composed polynomial with all the coefficients set
+ * to zero.
+ *
+ * @param ctx The current mps_context.
+ * @param base_degree The maximum degree of the base polynomial \f$p_0\f$.
+ * @param x_degree The maximum degree in \f$x\f$ of the step map.
+ * @param y_degree The maximum degree in \f$y\f$ of the step map.
+ * @param levels The number of applications of the step map.
+ */
+mps_composed_poly * mps_composed_poly_new (mps_context * ctx, int base_degree, int x_degree,
+                                           int y_degree, int levels);
+
+/**
+ * @brief Set the coefficient of degree i of the base polynomial.
+ *
+ * The degree of the polynomial is updated accordingly, so all the
+ * coefficients must be set before passing it to
+ * mps_context_set_input_poly().
+ */
+void mps_composed_poly_set_base_coefficient_q (mps_context * ctx, mps_composed_poly * cp, int i,
+                                               mpq_t real_part, mpq_t imag_part);
+
+/**
+ * @brief Integer version of mps_composed_poly_set_base_coefficient_q().
+ */
+void mps_composed_poly_set_base_coefficient_i (mps_context * ctx, mps_composed_poly * cp, int i,
+                                               long int real_part, long int imag_part);
+
+/**
+ * @brief Set the coefficient of \f$x^i y^j\f$ in the step map.
+ *
+ * The degree of the polynomial is the one obtained assuming that the
+ * leading terms of \f$f(x, p_{l-1}(x))\f$ do not cancel out, which is true
+ * unless two of them have the same degree.
+ */
+void mps_composed_poly_set_coefficient_q (mps_context * ctx, mps_composed_poly * cp, int i, int j,
+                                          mpq_t real_part, mpq_t imag_part);
+
+/**
+ * @brief Integer version of mps_composed_poly_set_coefficient_q().
+ */
+void mps_composed_poly_set_coefficient_i (mps_context * ctx, mps_composed_poly * cp, int i, int j,
+                                          long int real_part, long int imag_part);
+
+MPS_END_DECLS
+
+#endif
@@ -185,6 +185,41 @@ struct mps_context {
    */
   FILE *rtstr;
 
+  /**
+   * @brief Path of the file where the state of the computation is saved
+   * at the end of each packet of iterations, or NULL.
+   */
+  char * checkpoint_file;
+
+  /**
+   * @brief Path of a checkpoint from which the computation should be
+   * resumed, or NULL to start from scratch.
+   */
+  char * resume_file;
+
+  /**
+   * @brief Queue where the progress of the computation is reported,
+   * or NULL.
+   */
+  mps_event_queue * event_queue;
+
+  /**
+   * @brief For each root, the last event among MPS_EVENT_ROOT_ISOLATED and
+   * MPS_EVENT_ROOT_APPROXIMATED that has been emitted for it, or
+   * MPS_EVENT_PACKET if none of them has been emitted yet.
+   */
+  mps_event_type * event_status;
+
+  /**
+   * @brief Number of elements of event_status.
+   */
+  int event_status_size;
+
+  /**
+   * @brief Number of packets reported to event_queue during this computation.
+   */
+  int event_packets;
+
   /*
    * CONSTANT, PARAMETERS
    */
@@ -285,6 +320,19 @@ struct mps_context {
    */
   int zero_roots;
 
+  /**
+   * @brief Largest k such that the input polynomial, with exact
+   * coefficients, is a polynomial in \f$x^k\f$. It is 1 if no such
+   * structure has been detected.
+   */
+  int symmetry_power;
+
+  /**
+   * @brief Palindromic structure of the input polynomial, if it has
+   * exact coefficients.
+   */
+  mps_symmetry symmetry;
+
   /**
    * @brief Output index order
    */
@@ -457,6 +505,12 @@ struct mps_context {
    */
   mps_starting_strategy starting_strategy;
 
+  /**
+   * @brief Thresholds used by MPS_ALGORITHM_AUTO to configure the
+   * computation.
+   */
+  mps_auto_calibration * auto_calibration;
+
   /**
    * @brief Routine that performs the loop needed to coordinate
    * root finding. It has to be called to do the hard work.
@@ -483,6 +537,28 @@ struct mps_context {
    */
   mps_thread_pool * pool;
 
+  /**
+   * @brief Memory reused by the iteration packets, allocated
+   * in <code>mps_allocate_data()</code>.
+   */
+  mps_thread_workspace * workspace;
+
+  /**
+   * @brief True if the computation is shared among the processes of an
+   * MPI job, see <code>mps_context_set_distributed()</code>.
+   */
+  mps_boolean distributed;
+
+  /**
+   * @brief Rank of this process in the distributed computation.
+   */
+  int distributed_rank;
+
+  /**
+   * @brief Number of processes taking part in the distributed computation.
+   */
+  int distributed_size;
+
   /**
    * @brief Auxiliary memory used in regeneation to avoid thread-safeness
    * issues.
@@ -495,6 +571,24 @@ struct mps_context {
    */
   mps_boolean jacobi_iterations;
 
+  /**
+   * @brief True if block Gauss-Seidel iterations must be used in the
+   * secular algorithm. Ignored if jacobi_iterations is true.
+   */
+  mps_boolean block_iterations;
+
+  /**
+   * @brief True if the polynomials with exact real coefficients must be
+   * split in their square-free factors, that are solved separately.
+   */
+  mps_boolean square_free;
+
+  /**
+   * @brief True if the structure stored in symmetry_power and symmetry
+   * must be used to solve a polynomial of lower degree.
+   */
+  mps_boolean exploit_symmetry;
+
   /**
    * @brief Char to be intersted after the with statement in the output piped to gnuplot.
    */
@@ -556,6 +650,7 @@ void mps_context_set_degree (mps_context * s, int n);
 
 #ifdef _MPS_PRIVATE
 void mps_context_allocate_poly_inplace (mps_context * s, int n);
+void mps_context_copy_options (mps_context * s, mps_context * source);
 #endif
 
 /* Accessor functions */
@@ -565,10 +660,20 @@ int mps_context_get_degree (mps_context * s);
 int mps_context_get_roots_d (mps_context * s, cplx_t ** roots, double **radius);
 int mps_context_get_roots_m (mps_context * s, mpc_t ** roots, rdpe_t ** radius);
 int mps_context_get_zero_roots (mps_context * s);
+mps_symmetry mps_context_get_symmetry (mps_context * s, int * power);
 mps_root_status mps_context_get_root_status (mps_context * ctx, int i);
 mps_boolean mps_context_get_over_max (mps_context * s);
 mps_polynomial * mps_context_get_active_poly (mps_context * ctx);
 mps_approximation** mps_context_get_approximations (mps_context * ctx);
+int mps_context_get_root_view (mps_context * s, mps_root_view * view);
+
+/* Bulk export of the roots, in root-view.c */
+int mps_context_export_roots_d (mps_context * s, double * re, double * im, double * radius,
+                                mps_boolean parallel);
+int mps_context_export_roots_ld (mps_context * s, long double * re, long double * im,
+                                 long double * radius, mps_boolean parallel);
+int mps_context_export_roots_m (mps_context * s, mpc_t * roots, rdpe_t * radius,
+                                mps_boolean parallel);
 
 /* I/O options and flags */
 void mps_context_set_input_prec (mps_context * s, long int prec);
@@ -578,10 +683,20 @@ void mps_context_set_output_goal (mps_context * s, mps_output_goal goal);
 void mps_context_set_starting_phase (mps_context * s, mps_phase phase);
 void mps_context_set_log_stream (mps_context * s, FILE * logstr);
 void mps_context_set_jacobi_iterations (mps_context * s, mps_boolean jacobi_iterations);
+void mps_context_set_block_iterations (mps_context * s, mps_boolean block_iterations);
+void mps_context_set_square_free (mps_context * s, mps_boolean square_free);
+void mps_context_set_exploit_symmetry (mps_context * s, mps_boolean exploit_symmetry);
 void mps_context_select_starting_strategy (mps_context * s, mps_starting_strategy strategy);
 void mps_context_set_avoid_multiprecision (mps_context * s, mps_boolean avoid_multiprecision);
 void mps_context_set_crude_approximation_mode (mps_context * s, mps_boolean crude_approximation_mode);
 void mps_context_set_regeneration_driver (mps_context * s, mps_regeneration_driver * rd);
+void mps_context_set_checkpoint_file (mps_context * s, const char * filename);
+void mps_context_set_resume_file (mps_context * s, const char * filename);
+void mps_context_set_event_queue (mps_context * s, mps_event_queue * queue);
+void mps_context_set_thread_affinity (mps_context * s, mps_thread_affinity affinity,
+                                      const int * cores, int n_cores);
+void mps_context_set_distributed (mps_context * s, mps_boolean distributed);
+void mps_context_set_auto_calibration_file (mps_context * s, const char * filename);
 
 /* Debugging */
 void mps_context_set_debug_level (mps_context * s, mps_debug_level level);
@@ -0,0 +1,145 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ *
+ * @brief Progress events emitted while the roots are computed.
+ */
+
+#ifndef MPS_EVENTS_H_
+#define MPS_EVENTS_H_
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Kind of an mps_event.
+ */
+typedef enum {
+  /**
+   * @brief A packet of iterations has been completed.
+   */
+  MPS_EVENT_PACKET,
+
+  /**
+   * @brief The inclusion disc of a root does not intersect the others.
+   */
+  MPS_EVENT_ROOT_ISOLATED,
+
+  /**
+   * @brief A root has been approximated with the required precision.
+   */
+  MPS_EVENT_ROOT_APPROXIMATED,
+
+  /**
+   * @brief The computation has terminated, and the final approximations
+   * can be read from the context.
+   */
+  MPS_EVENT_DONE
+} mps_event_type;
+
+/**
+ * @brief An event describing the progress of the computation.
+ */
+struct mps_event {
+  mps_event_type type;
+
+  /**
+   * @brief The context that emitted the event, so that a queue can be
+   * shared by many computations.
+   */
+  mps_context * ctx;
+
+  /**
+   * @brief Number of packets of iterations completed so far.
+   */
+  int packet;
+
+  /**
+   * @brief Index of the root for the events MPS_EVENT_ROOT_ISOLATED and
+   * MPS_EVENT_ROOT_APPROXIMATED, or -1.
+   */
+  int root;
+
+  /**
+   * @brief Phase of the computation and working precision when the event
+   * was emitted.
+   */
+  mps_phase phase;
+  long int wp;
+
+  /**
+   * @brief Number of isolated and of approximated roots when the event
+   * was emitted. These are only set for MPS_EVENT_PACKET and MPS_EVENT_DONE.
+   */
+  int isolated;
+  int approximated;
+
+  /**
+   * @brief Current approximation of the root and its inclusion radius.
+   */
+  cdpe_t value;
+  rdpe_t radius;
+};
+
+#ifdef _MPS_PRIVATE
+/**
+ * @brief Bounded queue that transfers the events from the solver to
+ * the consumers.
+ *
+ * Events can be pushed and popped concurrently by any number of threads
+ * without taking locks, so the solver never waits for the consumers.
+ */
+struct mps_event_queue {
+  /**
+   * @brief Circular buffer of the events, whose size is a power of 2.
+   */
+  struct mps_event_queue_cell * cells;
+  unsigned long mask;
+
+  /**
+   * @brief Position of the next push and of the next pop. They are kept
+   * in different cache lines, since they are modified by different threads.
+   */
+  volatile unsigned long push_position;
+  char padding[64];
+  volatile unsigned long pop_position;
+
+  /**
+   * @brief Number of events that have been discarded since the queue was full.
+   */
+  volatile long int dropped;
+
+  /**
+   * @brief Number of computations that are still emitting events on this queue.
+   */
+  volatile int producers;
+};
+#endif
+
+mps_event_queue * mps_event_queue_new (int capacity);
+void mps_event_queue_free (mps_event_queue * queue);
+mps_boolean mps_event_queue_pop (mps_event_queue * queue, mps_event * event);
+int mps_event_queue_drain (mps_event_queue * queue, mps_event * events, int max_events);
+mps_boolean mps_event_queue_is_finished (mps_event_queue * queue);
+long int mps_event_queue_get_dropped (mps_event_queue * queue);
+
+void mps_context_set_event_queue (mps_context * s, mps_event_queue * queue);
+
+#ifdef _MPS_PRIVATE
+void mps_events_begin (mps_context * s);
+void mps_events_packet (mps_context * s);
+void mps_events_finish (mps_context * s);
+void mps_events_free (mps_context * s);
+#endif
+
+MPS_END_DECLS
+
+#endif /* MPS_EVENTS_H_ */
@@ -198,6 +198,13 @@ extern "C"
  *
  * This routine will return a <code>mps_handle</code> pointer that can be used to wait
  * for the result by calling mps_mpsolve_wait() on it.
+ *
+ * The partial results can be followed while the computation is running by
+ * attaching an <code>mps_event_queue</code> to the context with
+ * mps_context_set_event_queue(). The solver pushes an event at the end of
+ * every packet of iterations, and one for each root as soon as it is isolated
+ * or approximated; any thread can then consume them with
+ * mps_event_queue_pop(). See events.h for the details.
  */
 
 /*
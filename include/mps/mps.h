@@ -71,14 +71,17 @@
  * Secular equations. */
 #include <mps/matrix.h>
 #include <mps/chebyshev.h>
+#include <mps/composed-poly.h>
 #include <mps/monomial-matrix-poly.h>
 #include <mps/monomial-poly.h>
+#include <mps/rational-equation.h>
 #include <mps/secular-equation.h>
 #include <mps/nroots-polynomial.h>
 #include <mps/regeneration-driver.h>
 
 /* Public interface functions for MPSolve */
 #include <mps/approximation.h>
+#include <mps/events.h>
 #include <mps/context.h>
 #include <mps/debug.h>
 #include <mps/interface.h>
@@ -98,9 +101,15 @@ MPS_END_DECLS
 #include <mps/private/system/memory-file-stream.h>
 #include <mps/private/aberth.h>
 #include <mps/private/algorithms.h>
+#include <mps/private/auto-configuration.h>
+#include <mps/private/ball.h>
+#include <mps/private/checkpoint.h>
 #include <mps/private/cluster.h>
 #include <mps/private/convex.h>
+#include <mps/private/count.h>
 #include <mps/private/data.h>
+#include <mps/private/distributed.h>
+#include <mps/private/frozen-roots.h>
 #include <mps/private/hessenberg-determinant.h>
 #include <mps/private/horner.h>
 #include <mps/private/jacobi-aberth.h>
@@ -112,11 +121,15 @@ MPS_END_DECLS
 #include <mps/private/newton.h>
 #include <mps/private/options.h>
 #include <mps/private/radii.h>
+#include <mps/private/secular-batch.h>
 #include <mps/private/secular-evaluation.h>
+#include <mps/private/small-degree.h>
 #include <mps/private/solve.h>
 #include <mps/private/sort.h>
+#include <mps/private/square-free.h>
 #include <mps/private/starting.h>
 #include <mps/private/starting-configuration.h>
+#include <mps/private/symmetry.h>
 #include <mps/private/threading.h>
 #include <mps/private/tools.h>
 #include <mps/private/touch.h>
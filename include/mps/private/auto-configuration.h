@@ -0,0 +1,152 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Automatic selection of the algorithm and of its tuning
+ * parameters, used by MPS_ALGORITHM_AUTO.
+ *
+ * A few features of the input are computed before starting the
+ * computation: they are cheap to obtain (a single pass over the moduli
+ * of the coefficients and a convex hull) and describe the shape of the
+ * problem well enough to choose between the standard and the secular
+ * algorithm, the starting phase, the starting strategy, the number of
+ * threads and the iteration scheme. The thresholds used in the choice
+ * are collected in a mps_auto_calibration, that can be tuned on a set
+ * of benchmarks and loaded from a file.
+ */
+
+#ifndef MPS_AUTO_CONFIGURATION_H_
+#define MPS_AUTO_CONFIGURATION_H_
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Features of the input that drive the automatic configuration.
+ */
+struct mps_polynomial_features {
+  /**
+   * @brief Degree of the polynomial.
+   */
+  int degree;
+
+  /**
+   * @brief True if the input is a polynomial in the monomial basis.
+   */
+  mps_boolean monomial;
+
+  /**
+   * @brief True if the input is a secular equation.
+   */
+  mps_boolean secular;
+
+  /**
+   * @brief Structure of the coefficients.
+   */
+  mps_structure structure;
+
+  /**
+   * @brief Fraction of the coefficients that are zero, between 0 and 1.
+   * It is zero if the coefficients are not known.
+   */
+  double sparsity;
+
+  /**
+   * @brief Logarithm in base 2 of the ratio between the largest and the
+   * smallest non zero coefficient, in modulus.
+   */
+  double dynamic_range;
+
+  /**
+   * @brief Number of vertices of the Newton polygon, i.e. of the
+   * upper convex hull of the points \f$(i, \log|a_i|)\f$. It is one more
+   * than the number of circles that contain the starting points.
+   */
+  int hull_vertices;
+
+  /**
+   * @brief Logarithm in base 2 of the ratio between the largest and the
+   * smallest radius of the circles given by the Newton polygon. It
+   * measures how much the moduli of the roots are spread.
+   */
+  double modulus_spread;
+};
+
+/**
+ * @brief Thresholds used to configure the computation from the
+ * features of the input.
+ *
+ * The default values are set by mps_auto_calibration_set_defaults().
+ * They can be overridden by a file made of lines of the form
+ * <code>key = value</code>, where the keys are the names of the fields;
+ * lines starting with <code>#</code> are comments.
+ */
+struct mps_auto_calibration {
+  /**
+   * @brief The standard algorithm is used on monomial polynomials whose
+   * fraction of non zero coefficients is at most this value.
+   */
+  double sparse_ratio;
+
+  /**
+   * @brief The floating point phase is skipped if the dynamic range of
+   * the coefficients, in bits, is larger than this value.
+   */
+  double dpe_dynamic_range;
+
+  /**
+   * @brief Maximum degree for which the companion matrix starting
+   * strategy is used.
+   */
+  int companion_max_degree;
+
+  /**
+   * @brief The companion matrix starting strategy is used only if the
+   * modulus spread, in bits, is larger than this value. When the roots
+   * lie on a few circles the Newton polygon already gives good starting
+   * points.
+   */
+  double companion_min_spread;
+
+  /**
+   * @brief Minimum number of roots assigned to each thread. The number
+   * of threads is reduced on small problems, where the synchronization
+   * costs more than the iterations.
+   */
+  int roots_per_thread;
+
+  /**
+   * @brief Minimum degree for which the block Gauss-Seidel iterations are
+   * used on more than one thread, or 0 to never select them.
+   */
+  int block_min_degree;
+
+  /**
+   * @brief The block Gauss-Seidel iterations are used only if the
+   * modulus spread, in bits, is at most this value.
+   */
+  double block_max_spread;
+};
+
+void mps_auto_calibration_set_defaults (mps_auto_calibration * calibration);
+
+mps_boolean mps_auto_calibration_load (mps_context * s, mps_auto_calibration * calibration,
+                                       const char * filename);
+
+void mps_polynomial_features_compute (mps_context * s, mps_polynomial * p,
+                                      mps_polynomial_features * features);
+
+mps_algorithm mps_auto_configure (mps_context * s, mps_polynomial_features * features);
+
+void mps_auto_mpsolve (mps_context * s);
+
+MPS_END_DECLS
+
+#endif /* MPS_AUTO_CONFIGURATION_H_ */
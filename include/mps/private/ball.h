@@ -0,0 +1,77 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Midpoint-radius (ball) arithmetic used by the multiprecision
+ * evaluators that return a bound to the error.
+ *
+ * The radii are stored as <code>rdpe_t</code>, but they are handled by the
+ * <code>mps_mag</code> kernels below, which only deal with non negative
+ * values. These skip the sign and overflow checks of the rdpe functions,
+ * fuse a multiplication and an addition in a single normalization, and
+ * round every result up, so that they always give an upper bound. The
+ * moduli of the multiprecision values are read from the exponents of
+ * their mpf components and a double precision mantissa, without the
+ * cdpe conversion and the square root done by mpc_rmod().
+ */
+
+#ifndef MPS_BALL_H_
+#define MPS_BALL_H_
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief A complex ball, i.e., a multiprecision midpoint and an
+ * upper bound to its distance from the exact value.
+ */
+struct mps_mball {
+  /**
+   * @brief The midpoint of the ball.
+   */
+  mpc_t mid;
+
+  /**
+   * @brief The radius of the ball.
+   */
+  rdpe_t rad;
+
+  /**
+   * @brief Bound to the relative error of an operation on the midpoint,
+   * at its precision.
+   */
+  rdpe_t eps;
+};
+
+/* Magnitudes */
+void mps_mag_set_mpc (rdpe_t r, mpc_t c);
+
+void mps_mag_add (rdpe_t r, const rdpe_t a, const rdpe_t b);
+
+void mps_mag_mul (rdpe_t r, const rdpe_t a, const rdpe_t b);
+
+void mps_mag_mul_d (rdpe_t r, const rdpe_t a, double d);
+
+void mps_mag_fma (rdpe_t r, const rdpe_t a, const rdpe_t b, const rdpe_t c);
+
+void mps_mag_fma_d (rdpe_t r, const rdpe_t a, double d, const rdpe_t c);
+
+/* Balls */
+void mps_mball_init2 (mps_mball * b, long int prec);
+
+void mps_mball_clear (mps_mball * b);
+
+void mps_mball_set_mpc (mps_mball * b, mpc_t c, const rdpe_t ac);
+
+void mps_mball_fma (mps_mball * b, mpc_t x, const rdpe_t ax, mpc_t c, const rdpe_t ac);
+
+MPS_END_DECLS
+
+#endif /* MPS_BALL_H_ */
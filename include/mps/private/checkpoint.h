@@ -0,0 +1,34 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Saving and restoring the state of the secular algorithm.
+ */
+
+#ifndef MPS_CHECKPOINT_H_
+#define MPS_CHECKPOINT_H_
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Version of the binary format of the checkpoint files.
+ */
+#define MPS_CHECKPOINT_VERSION 1
+
+mps_boolean mps_checkpoint_save (mps_context * s, const char * filename,
+                                 int packet, mps_boolean just_regenerated);
+
+mps_boolean mps_checkpoint_load (mps_context * s, const char * filename,
+                                 int * packet, mps_boolean * just_regenerated);
+
+MPS_END_DECLS
+
+#endif /* MPS_CHECKPOINT_H_ */
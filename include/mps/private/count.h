@@ -0,0 +1,40 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Certified count of the roots in the search set, used when the
+ * output goal is MPS_OUTPUT_GOAL_COUNT.
+ *
+ * By Pellet's theorem, if the coefficients of a polynomial satisfy
+ * \f$|a_k| > \sum_{i \neq k} |a_i|\f$ then exactly k of its roots lie in
+ * the open unit disc, and none on the unit circle. The test is applied to
+ * the Graeffe iterates of the polynomial, whose roots are the powers
+ * \f$z^{2^m}\f$ of its roots, so that the roots move away from the unit
+ * circle at each step.
+ *
+ * The half-planes are mapped to the unit disc by the Moebius
+ * transformation \f$z = (1 + w) / (1 - w)\f$, computed with two Taylor
+ * shifts. All the coefficients are stored as a DPE value and a bound to
+ * its distance from the exact one, so that the count is certified.
+ */
+
+#ifndef MPS_COUNT_H_
+#define MPS_COUNT_H_
+
+MPS_BEGIN_DECLS
+
+int mps_count_unit_disc (mps_context * s, cdpe_t * a, rdpe_t * rad, int n);
+
+mps_boolean mps_count_mpsolve (mps_context * s);
+
+MPS_END_DECLS
+
+#endif /* MPS_COUNT_H_ */
@@ -0,0 +1,56 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Routines used to share the secular algorithm among the processes
+ * of an MPI job.
+ *
+ * Every process owns a contiguous slice of the approximations, and iterates
+ * only on them. The state of the approximations and the regenerated
+ * coefficients are exchanged after every packet, so that all the processes
+ * take the same decisions on the rest of the computation. When the context
+ * is not distributed all these routines do nothing.
+ */
+
+#ifndef MPS_DISTRIBUTED_H_
+#define MPS_DISTRIBUTED_H_
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief True if the approximation <code>i</code> is owned by this process,
+ * i.e. if it has to be iterated here. The slice owned by the process of rank
+ * r is made of the indices i such that <code>i * size / n == r</code>.
+ */
+#define MPS_DISTRIBUTED_OWNS(s, i) \
+  (!(s)->distributed || \
+   (int)(((long int)(i) * (s)->distributed_size) / (s)->n) == (s)->distributed_rank)
+
+mps_boolean mps_distributed_setup (mps_context * s);
+
+int mps_distributed_count_foreign_roots (mps_context * s);
+
+void mps_distributed_gather_roots (mps_context * s);
+
+void mps_distributed_gather_packet (mps_context * s, int * nit, mps_boolean * excep,
+                                    int * computed_roots);
+
+void mps_distributed_gather_cdpe (mps_context * s, cdpe_t * v);
+
+void mps_distributed_gather_coefficients (mps_context * s);
+
+mps_boolean mps_distributed_any (mps_context * s, mps_boolean value);
+
+mps_boolean mps_distributed_all (mps_context * s, mps_boolean value);
+
+MPS_END_DECLS
+
+#endif /* MPS_DISTRIBUTED_H_ */
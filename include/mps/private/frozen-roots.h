@@ -0,0 +1,169 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Deflation of the converged approximations from the Aberth
+ * corrections.
+ *
+ * The approximations that have stopped at the start of a packet of
+ * iterations (because they are approximated, or because they are iterated
+ * by another process) do not move until the end of the packet. Their
+ * contribution to the Aberth sum of an active approximation \f$z\f$,
+ * \f[
+ *   f(z) = \sum_{w \textrm{ frozen}} \frac{1}{z - w},
+ * \f]
+ * is then computed once at a center \f$c\f$ and reused, through the first
+ * order expansion \f$f(c) + f'(c) (z - c)\f$, as long as \f$z\f$ stays close
+ * enough to \f$c\f$. The remaining terms are summed only over the active
+ * approximations, and the job queue only visits these.
+ */
+
+#ifndef MPS_FROZEN_ROOTS_H_
+#define MPS_FROZEN_ROOTS_H_
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Relative error allowed on the contribution of the frozen
+ * approximations to an Aberth sum.
+ *
+ * An error on the Aberth sum only slows down the convergence, since the
+ * fixed points of the iteration are the roots whatever the sum is, so
+ * there is no need to go down to the machine precision.
+ */
+#define MPS_FROZEN_ROOTS_TOLERANCE (1.0 / (1 << 26))
+
+/**
+ * @brief Partition of the approximations in active and frozen ones,
+ * and expansions of the contribution of the frozen ones.
+ */
+struct mps_frozen_roots {
+  /**
+   * @brief Number of approximations that the struct can handle.
+   */
+  int n;
+
+  /**
+   * @brief Number of active approximations.
+   */
+  int n_active;
+
+  /**
+   * @brief Indices of the active approximations, in increasing order.
+   */
+  int *active;
+
+  /**
+   * @brief Indices of the active approximations, in the order in which
+   * they are visited by the job queue.
+   */
+  int *schedule;
+
+  /**
+   * @brief Number of frozen approximations.
+   */
+  int n_frozen;
+
+  /**
+   * @brief Indices of the frozen approximations.
+   */
+  int *frozen;
+
+  /**
+   * @brief True if the floating point expansion of the i-th approximation
+   * has been computed in this packet.
+   */
+  mps_boolean *fvalid;
+
+  /**
+   * @brief Centers of the floating point expansions.
+   */
+  cplx_t *fcenter;
+
+  /**
+   * @brief Values of the frozen contribution at the centers.
+   */
+  cplx_t *fsum;
+
+  /**
+   * @brief Derivatives of the frozen contribution at the centers.
+   */
+  cplx_t *fdsum;
+
+  /**
+   * @brief Sums of \f$|c - w|^{-1}\f$ over the frozen approximations, that
+   * measure the size of the frozen contribution.
+   */
+  double *fscale;
+
+  /**
+   * @brief Sums of \f$|c - w|^{-3}\f$ over the frozen approximations, that
+   * bound the error of the expansions.
+   */
+  double *fbound;
+
+  /**
+   * @brief Distances of the centers from the nearest frozen approximation.
+   */
+  double *fdist;
+
+  /**
+   * @brief True if the DPE expansion of the i-th approximation has been
+   * computed in this packet.
+   */
+  mps_boolean *dvalid;
+
+  /**
+   * @brief Centers of the DPE expansions.
+   */
+  cdpe_t *dcenter;
+
+  /**
+   * @brief Values of the frozen contribution at the DPE centers.
+   */
+  cdpe_t *dsum;
+
+  /**
+   * @brief Derivatives of the frozen contribution at the DPE centers.
+   */
+  cdpe_t *ddsum;
+
+  /**
+   * @brief DPE version of <code>fscale</code>.
+   */
+  rdpe_t *dscale;
+
+  /**
+   * @brief DPE version of <code>fbound</code>.
+   */
+  rdpe_t *dbound;
+
+  /**
+   * @brief DPE version of <code>fdist</code>.
+   */
+  rdpe_t *ddist;
+};
+
+mps_frozen_roots * mps_frozen_roots_new (int n);
+
+void mps_frozen_roots_free (mps_frozen_roots * fr);
+
+void mps_frozen_roots_update (mps_context * s, mps_frozen_roots * fr);
+
+void mps_faberth_frozen_wl (mps_context * s, mps_frozen_roots * fr, int j, cplx_t abcorr,
+                            pthread_mutex_t * aberth_mutexes);
+
+void mps_daberth_frozen_wl (mps_context * s, mps_frozen_roots * fr, int j, cdpe_t abcorr,
+                            pthread_mutex_t * aberth_mutexes);
+
+MPS_END_DECLS
+
+#endif /* MPS_FROZEN_ROOTS_H_ */
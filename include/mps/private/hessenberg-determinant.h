@@ -21,11 +21,63 @@
 
 MPS_BEGIN_DECLS
 
+/**
+ * @brief Number of shifts processed together by
+ * mps_fhessenberg_shifted_determinants().
+ */
+#define MPS_HESSENBERG_BLOCK 8
+
+/**
+ * @brief Number of elimination steps between two rescalings of the
+ * work vectors in the floating point determinants.
+ */
+#define MPS_HESSENBERG_RESCALE 50
+
+/**
+ * @brief Minimum size of the matrix for which the blocks of shifts are
+ * distributed among the threads.
+ */
+#define MPS_HESSENBERG_THREAD_THRESHOLD 64
+
+/**
+ * @brief Work vectors for mps_fhessenberg_shifted_determinants(), that
+ * can be reused across calls.
+ */
+struct mps_hessenberg_workspace {
+  /**
+   * @brief The largest size of the matrices that fits in the workspace.
+   */
+  size_t n;
+
+  /**
+   * @brief The number of blocks of shifts that can be processed at the
+   * same time.
+   */
+  int slots;
+
+  /**
+   * @brief The work vectors for the determinants.
+   */
+  cplx_t * vec;
+
+  /**
+   * @brief The work vectors for their derivatives.
+   */
+  cplx_t * dvec;
+};
+
+mps_hessenberg_workspace * mps_hessenberg_workspace_new (mps_context * ctx, size_t n);
+void mps_hessenberg_workspace_free (mps_context * ctx, mps_hessenberg_workspace * w);
+
 void mps_fhessenberg_determinant (mps_context * ctx, cplx_t * hessenberg_matrix, size_t n, cplx_t output,
 				  long int * exponent);
 void mps_fhessenberg_shifted_determinant (mps_context * ctx, cplx_t * hessenberg_matrix, 
 					  const cplx_t shift, size_t n, cplx_t output, 
 					  long int * exponent);
+void mps_fhessenberg_shifted_determinants (mps_context * ctx, cplx_t * hessenberg_matrix, size_t n,
+                                           cplx_t * shifts, int n_shifts, cplx_t * output,
+                                           cplx_t * doutput, long int * exponents,
+                                           mps_hessenberg_workspace * w);
 
 void mps_dhessenberg_determinant (mps_context * ctx, cdpe_t * hessenberg_matrix, size_t n, cdpe_t output);
 void mps_dhessenberg_shifted_determinant (mps_context * ctx, cdpe_t * hessenberg_matrix, const cdpe_t shift,
@@ -36,6 +36,10 @@ void mps_mhorner_with_error (mps_context * s, mps_monomial_poly * p,
 void mps_mhorner_with_error2 (mps_context * s, mps_monomial_poly * p, mpc_t x,
                               mpc_t value, rdpe_t relative_error, long int wp);
 
+/* Implemented in horner.c */
+void mps_dhorner_compensated (mps_context * s, int n, cdpe_t * hi, cdpe_t * lo, rdpe_t * ap,
+                              cdpe_t x, cdpe_t value, rdpe_t error);
+
 MPS_END_DECLS
 
 #endif /* endif MPS_HORNER_H_ */
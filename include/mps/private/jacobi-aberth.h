@@ -11,7 +11,8 @@
 /**
  * @file
  *
- * @brief Implementation of the iterations using Jacobi-style updates.
+ * @brief Implementation of the iterations using Jacobi-style updates,
+ * and of the block Gauss-Seidel ones.
  */
 
 #ifndef MPS_JACOBI_ABERTH_H_
@@ -21,6 +22,36 @@
 
 MPS_BEGIN_DECLS
 
+/**
+ * @brief Number of consecutive approximations that form a block in the
+ * block Gauss-Seidel iterations.
+ *
+ * The blocks depend only on the degree, so that the result of the
+ * iterations does not depend on the number of threads.
+ */
+#define MPS_ABERTH_BLOCK_SIZE 32
+
+/**
+ * @brief Data passed to the workers that compute the Aberth correction
+ * of a single root in the Jacobi-style iterations, or of a block of
+ * roots in the block Gauss-Seidel ones.
+ *
+ * The corrections are stored in the arrays of the workspace of
+ * the context, in position <code>i</code>.
+ */
+struct mps_jacobi_aberth_step_data {
+  mps_context * ctx;
+  mps_polynomial * p;
+  mps_approximation * root;
+  int i;
+
+  /**
+   * @brief Index following the last root of the block, used only
+   * by the block Gauss-Seidel iterations.
+   */
+  int end;
+};
+
 int mps_faberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_regenerated);
 int mps_daberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_regenerated);
 int mps_maberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_regenerated);
@@ -0,0 +1,137 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Evaluation of the sums needed by the Newton corrections of
+ * the secular equation on a batch of points.
+ *
+ * For every point \f$x\f$ of the batch the functions compute
+ * \f[
+ *   \sum_i \frac{a_i}{x - b_i}, \qquad
+ *   -\sum_i \frac{a_i}{(x - b_i)^2}, \qquad
+ *   \sum_i \frac{1}{x - b_i},
+ * \f]
+ * and the sum of the moduli of the terms of the first one. The
+ * coefficients are processed in tiles of MPS_SECULAR_BATCH_TILE elements,
+ * and each tile is used on all the points before moving to the next one,
+ * so that it is read from memory only once per batch.
+ */
+
+#ifndef MPS_SECULAR_BATCH_H_
+#define MPS_SECULAR_BATCH_H_
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief Number of coefficients processed together by the batch
+ * evaluators.
+ */
+#define MPS_SECULAR_BATCH_TILE 64
+
+/**
+ * @brief Maximum number of points evaluated together by the iteration
+ * workers.
+ */
+#define MPS_SECULAR_BATCH_TARGETS 8
+
+/**
+ * @brief Sums needed by the DPE Newton correction in a point.
+ */
+struct mps_secular_dsum {
+  /**
+   * @brief Sum of \f$a_i / (x - b_i)\f$.
+   */
+  cdpe_t pol;
+
+  /**
+   * @brief Sum of \f$-a_i / (x - b_i)^2\f$.
+   */
+  cdpe_t fp;
+
+  /**
+   * @brief Sum of \f$1 / (x - b_i)\f$.
+   */
+  cdpe_t sumb;
+
+  /**
+   * @brief Sum of the moduli of the terms \f$a_i / (x - b_i)\f$.
+   */
+  rdpe_t asum;
+
+  /**
+   * @brief Index of a \f$b_i\f$ equal to \f$x\f$, or -1 if there is
+   * none. If this is not -1 the other fields are not meaningful.
+   */
+  int index;
+};
+
+/**
+ * @brief Sums needed by the multiprecision Newton correction in a point.
+ *
+ * The struct must be initialized with mps_secular_msum_init () at the
+ * precision of the point, and cleared with mps_secular_msum_clear ().
+ */
+struct mps_secular_msum {
+  /**
+   * @brief Sum of \f$a_i / (x - b_i)\f$.
+   */
+  mpc_t pol;
+
+  /**
+   * @brief Sum of \f$-a_i / (x - b_i)^2\f$.
+   */
+  mpc_t fp;
+
+  /**
+   * @brief Sum of \f$1 / (x - b_i)\f$.
+   */
+  mpc_t sumb;
+
+  /**
+   * @brief Sum of the moduli of the terms \f$a_i / (x - b_i)\f$.
+   */
+  rdpe_t asum;
+
+  /**
+   * @brief Index of a \f$b_i\f$ equal to \f$x\f$, or -1 if there is
+   * none.
+   */
+  int index;
+
+  /**
+   * @brief Temporaries used by the evaluation, allocated once for
+   * the whole batch.
+   */
+  mpc_t t1, t2;
+};
+
+void mps_secular_dbatch_sum (mps_context * s, mps_secular_equation * sec, int m,
+                             cdpe_t * x, mps_secular_dsum * sums);
+
+void mps_secular_msum_init (mps_secular_msum * sum, long int wp);
+
+void mps_secular_msum_set_prec (mps_secular_msum * sum, long int wp);
+
+void mps_secular_msum_clear (mps_secular_msum * sum);
+
+void mps_secular_mbatch_sum (mps_context * s, mps_secular_equation * sec, int m,
+                             mpc_t * x, mps_secular_msum * sums);
+
+/* Functions in secular-newton.c */
+void mps_secular_dnewton_from_sum (mps_context * s, mps_polynomial * p, mps_approximation * root,
+                                   mps_secular_dsum * sum, cdpe_t corr);
+
+void mps_secular_mnewton_from_sum (mps_context * s, mps_polynomial * p, mps_approximation * root,
+                                   mps_secular_msum * sum, mpc_t corr, long int wp);
+
+MPS_END_DECLS
+
+#endif /* MPS_SECULAR_BATCH_H_ */
@@ -21,6 +21,12 @@ MPS_BEGIN_DECLS
 mps_boolean
 mps_secular_ga_regenerate_coefficients_mp (mps_context * s, cdpe_t * old_b, mpc_t * old_mb);
 
+mps_boolean
+mps_secular_ga_regenerate_coefficients_native (mps_context * s, cdpe_t * old_b);
+
+long int
+mps_secular_ga_update_root_wp (mps_context * s, int i, long int wp, mpc_t * bmpc);
+
 MPS_END_DECLS
 
 #endif /* MPS_SECULAR_REGENERATION_H_ */
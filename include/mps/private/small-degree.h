@@ -0,0 +1,40 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Fast path for polynomials of small degree with coefficients
+ * representable in double precision.
+ *
+ * For these polynomials the setup of the standard engine (cluster
+ * analysis, thread pool, multiprecision buffers) costs much more than
+ * the iteration itself. They are solved here with a sequential Aberth
+ * iteration in double precision, whose state lives on the stack, started
+ * from points placed on the circles given by the Newton polygon of the
+ * coefficients.
+ *
+ * The result is accepted only if it can be certified: the Horner
+ * evaluations carry a running bound to their rounding error, the
+ * Newton discs \f$n |p(x_i)| / |p'(x_i)|\f$ must be pairwise disjoint,
+ * so that each of them contains exactly one root, and the radii are
+ * then shrunk to about \f$|p(x_i)| / |p'(x_i)|\f$ using the other
+ * discs. Otherwise the polynomial is handed to the selected algorithm.
+ */
+
+#ifndef MPS_SMALL_DEGREE_H_
+#define MPS_SMALL_DEGREE_H_
+
+MPS_BEGIN_DECLS
+
+mps_boolean mps_small_degree_mpsolve (mps_context * s);
+
+MPS_END_DECLS
+
+#endif /* MPS_SMALL_DEGREE_H_ */
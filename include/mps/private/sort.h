@@ -18,6 +18,38 @@
 
 MPS_BEGIN_DECLS
 
+/**
+ * @brief Key used to sort the approximations in lexicographic order of
+ * their real and imaginary parts.
+ *
+ * The value is a DPE copy of the approximation, obtained with a rounding
+ * that does not change the order of any two numbers, so that two keys
+ * with different values are compared without looking at the
+ * approximations. Only keys with equal values are compared again on the
+ * multiprecision approximations, if root is not NULL, and then on
+ * their indices.
+ */
+struct mps_sort_key {
+  /**
+   * @brief DPE copy of the approximation.
+   */
+  cdpe_t value;
+
+  /**
+   * @brief The approximation whose multiprecision value is used to
+   * break the ties, or NULL if value is exact. It must be either set or
+   * NULL for all the keys sorted together.
+   */
+  mps_approximation * root;
+
+  /**
+   * @brief Index of the approximation.
+   */
+  int index;
+};
+
+void mps_sort_keys (mps_context * s, mps_sort_key * keys, int n);
+
 void mps_fsort (mps_context * s);
 void mps_dsort (mps_context * s);
 void mps_msort (mps_context * s);
@@ -0,0 +1,65 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Square-free factorization of the polynomials with exact real
+ * coefficients.
+ *
+ * A polynomial with multiple roots forces the algorithms to refine
+ * clusters of approximations that can only be shrunk by raising the
+ * working precision. If the coefficients are known exactly the
+ * polynomial can instead be written as
+ * \f[
+ *   p(x) = c \prod_{i} a_i(x)^i,
+ * \f]
+ * where the \f$a_i\f$ are square-free and pairwise coprime, and the
+ * roots of every \f$a_i\f$, that are simple, can be computed separately
+ * and reported \f$i\f$ times.
+ *
+ * The factors are obtained with Yun's algorithm. The GCDs that it needs
+ * are computed modulo a sequence of word sized primes, and reconstructed
+ * with the Chinese remainder theorem until the candidate divides both
+ * the operands exactly.
+ */
+
+#ifndef MPS_SQUARE_FREE_H_
+#define MPS_SQUARE_FREE_H_
+
+MPS_BEGIN_DECLS
+
+/**
+ * @brief A square-free factor of a polynomial, with its multiplicity.
+ */
+struct mps_square_free_factor {
+  /**
+   * @brief The factor, a primitive polynomial with integer coefficients
+   * and positive leading coefficient.
+   */
+  mps_monomial_poly * poly;
+
+  /**
+   * @brief Multiplicity of the roots of the factor in the original
+   * polynomial.
+   */
+  int multiplicity;
+};
+
+int mps_square_free_factorize (mps_context * s, mps_monomial_poly * p,
+                               mps_square_free_factor ** factors);
+
+void mps_square_free_factors_free (mps_context * s, mps_square_free_factor * factors,
+                                   int n_factors);
+
+mps_boolean mps_square_free_mpsolve (mps_context * s);
+
+MPS_END_DECLS
+
+#endif /* MPS_SQUARE_FREE_H_ */
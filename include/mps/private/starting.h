@@ -46,6 +46,20 @@ void mps_file_fstart (mps_context * ctx, mps_polynomial * poly, mps_approximatio
 void mps_file_dstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
 void mps_file_mstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
 
+/* functions in companion-starting.c */
+
+/**
+ * @brief Maximum degree for which the starting points are computed as
+ * the eigenvalues of the companion matrix. The QR iteration costs
+ * \f$O(n^3)\f$ operations, so above this degree it is cheaper to let the
+ * Aberth iterations start from the Newton polygon circles.
+ */
+#define MPS_COMPANION_STARTING_MAX_DEGREE 500
+
+void mps_companion_fstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
+void mps_companion_dstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
+void mps_companion_mstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
+
 MPS_END_DECLS
 
 #endif /* MPS_STARTING_H_ */
@@ -0,0 +1,45 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Reduction of polynomials with exact coefficients that are
+ * functions of \f$x^k\f$, or palindromic.
+ *
+ * If \f$p(x) = q(x^k)\f$ the roots of \f$p\f$ are the k-th roots of the
+ * ones of \f$q\f$, whose degree is \f$n / k\f$.
+ *
+ * If \f$p\f$ is palindromic, i.e., \f$x^n p(1/x) = p(x)\f$, its roots come
+ * in pairs \f$(x, 1/x)\f$. Once the factors \f$x \pm 1\f$ are removed, the
+ * degree is \f$2d\f$ and \f$p(x) = x^d q(x + 1/x)\f$, where \f$q\f$ has
+ * degree \f$d\f$. Every root \f$z\f$ of \f$q\f$ gives the two roots of
+ * \f$x^2 - z x + 1\f$. An anti-palindromic polynomial, with
+ * \f$x^n p(1/x) = -p(x)\f$, is \f$x - 1\f$ times a palindromic one.
+ *
+ * In both cases the reduced polynomial is solved in its own context, and
+ * the inclusion discs of its roots are mapped back to discs containing
+ * the roots of \f$p\f$.
+ */
+
+#ifndef MPS_SYMMETRY_H_
+#define MPS_SYMMETRY_H_
+
+MPS_BEGIN_DECLS
+
+void mps_symmetry_detect (mps_context * s, mps_polynomial * p);
+
+mps_monomial_poly * mps_symmetry_reduce (mps_context * s, mps_monomial_poly * p,
+                                         int * n_unit_roots, int * unit_roots);
+
+mps_boolean mps_symmetry_mpsolve (mps_context * s);
+
+MPS_END_DECLS
+
+#endif /* MPS_SYMMETRY_H_ */
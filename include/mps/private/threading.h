@@ -102,6 +102,22 @@ struct mps_thread_job_queue {
    */
   mps_cluster_item * cluster_item;
 
+  /**
+   * @brief If not NULL, the queue only hands out the roots in this
+   * array, in order, instead of walking the whole clusterization.
+   */
+  int * schedule;
+
+  /**
+   * @brief Number of roots in <code>schedule</code>.
+   */
+  int n_scheduled;
+
+  /**
+   * @brief Position in <code>schedule</code> of the next root.
+   */
+  int position;
+
   /**
    * @brief Internal mutex of the queue used to guarantee
    * exclusive access.
@@ -190,6 +206,125 @@ struct mps_thread_worker_data {
    * may query for other work.
    */
   mps_thread_job_queue *queue;
+
+  /**
+   * @brief Partition of the roots in active and frozen ones, used to
+   * compute the Aberth corrections, or NULL if all the roots are summed
+   * directly.
+   */
+  mps_frozen_roots *frozen;
+};
+
+/**
+ * @brief Scratch memory used by the iteration packets.
+ *
+ * A workspace is allocated by <code>mps_allocate_data()</code>, sized
+ * on the number of roots and on the number of threads, and is then
+ * reused by every packet of floating point, DPE and multiprecision
+ * iterations, both in the secular and in the monomial algorithm.
+ * It is released by <code>mps_free_data()</code>.
+ *
+ * @see mps_thread_workspace_get()
+ */
+struct mps_thread_workspace {
+  /**
+   * @brief Number of roots that the workspace can handle.
+   */
+  int n;
+
+  /**
+   * @brief Number of worker data that have been allocated.
+   */
+  int n_threads;
+
+  /**
+   * @brief Array of <code>n</code> mutexes used to protect the
+   * computation of the Aberth corrections.
+   */
+  pthread_mutex_t *aberth_mutex;
+
+  /**
+   * @brief Array of <code>n</code> mutexes locked when a thread
+   * is iterating over a root.
+   */
+  pthread_mutex_t *roots_mutex;
+
+  /**
+   * @brief Global state mutex shared by the workers of a packet.
+   */
+  pthread_mutex_t gs_mutex;
+
+  /**
+   * @brief Global aberth mutex shared by the workers of a packet.
+   */
+  pthread_mutex_t global_aberth_mutex;
+
+  /**
+   * @brief Data passed to the workers, one for each thread.
+   */
+  mps_thread_worker_data *data;
+
+  /**
+   * @brief Job queue of the packet, reset at the start of each one
+   * with <code>mps_thread_job_queue_reset()</code>.
+   */
+  mps_thread_job_queue queue;
+
+  /**
+   * @brief Per-root data for the Jacobi-style iterations.
+   */
+  mps_jacobi_aberth_step_data *jacobi_data;
+
+  /**
+   * @brief Floating point Aberth corrections of the Jacobi-style
+   * iterations.
+   */
+  cplx_t *fcorrections;
+
+  /**
+   * @brief DPE Aberth corrections of the Jacobi-style iterations.
+   */
+  cdpe_t *dcorrections;
+
+  /**
+   * @brief Multiprecision Aberth corrections of the Jacobi-style
+   * iterations.
+   */
+  mpc_t *mcorrections;
+
+  /**
+   * @brief Precision of the elements of <code>mcorrections</code>.
+   */
+  long int mcorrections_prec;
+
+  /**
+   * @brief Floating point approximations at the last synchronization
+   * point of the block Gauss-Seidel iterations.
+   */
+  cplx_t *fsnapshot;
+
+  /**
+   * @brief DPE approximations at the last synchronization point of
+   * the block Gauss-Seidel iterations.
+   */
+  cdpe_t *dsnapshot;
+
+  /**
+   * @brief Multiprecision approximations at the last synchronization
+   * point of the block Gauss-Seidel iterations.
+   */
+  mpc_t *msnapshot;
+
+  /**
+   * @brief Precision of the elements of <code>msnapshot</code>.
+   */
+  long int msnapshot_prec;
+
+  /**
+   * @brief Approximations that do not move during the packet, whose
+   * contribution to the Aberth corrections is cached.
+   */
+  mps_frozen_roots *frozen;
 };
 
 /**
@@ -256,6 +391,18 @@ struct mps_thread {
    * @brief The argument to be passed to the thread.
    */
   void * args;
+
+  /**
+   * @brief Position of the thread in the pool, used to select the
+   * core on which it is pinned.
+   */
+  int id;
+
+  /**
+   * @brief The core on which the thread is pinned, or -1 if the thread
+   * can be scheduled on any core.
+   */
+  int core;
 };
 
 /**
@@ -351,6 +498,23 @@ struct mps_thread_pool {
    * performance for the cases where only 1 CPU is available on the PC. 
    */
   mps_boolean strict_async;
+
+  /**
+   * @brief Policy used to pin the threads to the cores.
+   */
+  mps_thread_affinity affinity;
+
+  /**
+   * @brief Cores on which the threads are pinned, in the order in which
+   * they are assigned. The thread with id i is pinned on
+   * <code>cores[i % n_cores]</code>.
+   */
+  int * cores;
+
+  /**
+   * @brief Length of the cores vector.
+   */
+  int n_cores;
 };
 
 /* EXPORTED ROUTINES */
@@ -376,6 +540,9 @@ mps_thread_pool * mps_thread_pool_get_system_pool (mps_context * s);
 
 void mps_thread_pool_set_strict_async (mps_thread_pool * pool, mps_boolean strict_async);
 
+void mps_thread_pool_set_affinity (mps_context * s, mps_thread_pool * pool,
+                                   mps_thread_affinity affinity, const int * cores, int n_cores);
+
 mps_thread_pool * mps_thread_pool_new (mps_context * s, int n_threads);
 
 void mps_thread_pool_free (mps_context * s, mps_thread_pool * pool);
@@ -384,6 +551,14 @@ mps_thread_job_queue * mps_thread_job_queue_new (mps_context * s);
 
 void mps_thread_job_queue_free (mps_thread_job_queue * q);
 
+void mps_thread_job_queue_reset (mps_context * s, mps_thread_job_queue * q);
+
+mps_thread_workspace * mps_thread_workspace_new (mps_context * s);
+
+void mps_thread_workspace_free (mps_context * s, mps_thread_workspace * w);
+
+mps_thread_workspace * mps_thread_workspace_get (mps_context * s);
+
 mps_thread_job mps_thread_job_queue_next (mps_context * s, mps_thread_job_queue * q);
 
 void mps_thread_fpolzer (mps_context * s, int *nit, mps_boolean * excep, int required_zeros);
@@ -18,7 +18,43 @@
 
 MPS_BEGIN_DECLS
 
+/**
+ * @brief Floating point copy of an inclusion disc, used to decide
+ * quickly if two discs stored in DPE or multiprecision touch.
+ *
+ * The copy is valid only if the center and the radius, multiplied by the
+ * isolation factor, are in the range of the double type. Pairs of discs
+ * that are too close to the boundary of each other to be decided with
+ * the rounding errors of the copies are checked again with the original
+ * values.
+ */
+struct mps_disc_shadow {
+  /**
+   * @brief The center of the disc rounded to a double.
+   */
+  cplx_t center;
+
+  /**
+   * @brief Modulus of the center.
+   */
+  double mod;
+
+  /**
+   * @brief The radius of the disc, multiplied by the isolation factor.
+   */
+  double rad;
+
+  /**
+   * @brief true if the other fields have been computed.
+   */
+  mps_boolean valid;
+};
+
 /* functions in touch.c */
+void mps_dshadow_discs (mps_context * s, rdpe_t * drad, int n, mps_disc_shadow * shadow);
+void mps_mshadow_discs (mps_context * s, rdpe_t * drad, int n, mps_disc_shadow * shadow);
+mps_boolean mps_dtouchnwt_shadow (mps_context * s, mps_disc_shadow * shadow, rdpe_t * drad, int n, int i, int j);
+mps_boolean mps_mtouchnwt_shadow (mps_context * s, mps_disc_shadow * shadow, rdpe_t * drad, int n, int i, int j);
 mps_boolean mps_ftouchnwt (mps_context * s, double * frad, int n, int i, int j);
 mps_boolean mps_dtouchnwt (mps_context * s, rdpe_t * drad, int n, int i, int j);
 mps_boolean mps_mtouchnwt (mps_context * s, rdpe_t * drad, int n, int i, int j);
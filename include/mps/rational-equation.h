@@ -0,0 +1,197 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Equations given by a sum of rational terms.
+ *
+ * A rational equation has the form
+ * \f[
+ *   \sum_{i=1}^m \frac{c_i}{(x - d_i)^{k_i}} = f(x),
+ * \f]
+ * where the poles \f$d_i\f$ are pairwise distinct, the orders \f$k_i\f$ are
+ * positive integers and \f$f(x) = \sum_{j=0}^q f_j x^j\f$ is a polynomial.
+ * Its solutions are the roots of the polynomial obtained by multiplying both
+ * sides by \f$D(x) = \prod_i (x - d_i)^{k_i}\f$ and taking the difference,
+ * which is never formed explicitly.
+ *
+ * The secular equations are the special case with \f$k_i = 1\f$ and
+ * \f$f(x) = 1\f$, but here the terms are evaluated in their original form,
+ * so the poles are not moved by the iterations.
+ *
+ * The Newton corrections are computed directly from the rational form,
+ * summing the terms pairwise as in the secular equations, and removing the
+ * contribution of the pole closest to the evaluation point before it can
+ * cancel out. The starting points are placed on small circles around the
+ * poles and on a circle enclosing them, and never on the poles themselves.
+ */
+
+#ifndef MPS_RATIONAL_EQUATION_H_
+#define MPS_RATIONAL_EQUATION_H_
+
+MPS_BEGIN_DECLS
+
+ #define MPS_RATIONAL_EQUATION_TYPE_NAME "mps_rational_equation"
+ #define MPS_RATIONAL_EQUATION(t) ((mps_rational_equation*)t)
+ #define MPS_IS_RATIONAL_EQUATION(t) mps_polynomial_check_type (t, "mps_rational_equation")
+
+/**
+ * @brief Position of \f$c_i\f$, \f$d_i\f$ and \f$f_j\f$ in the coefficient
+ * vectors of a mps_rational_equation.
+ */
+#define MPS_RATIONAL_EQUATION_C(re, i) (i)
+#define MPS_RATIONAL_EQUATION_D(re, i) ((re)->n_terms + (i))
+#define MPS_RATIONAL_EQUATION_F(re, j) (2 * (re)->n_terms + (j))
+
+typedef struct {
+  /**
+   * @brief Base implementation of a polynomial.
+   */
+  mps_polynomial super;
+
+  /**
+   * @brief Number of rational terms \f$m\f$.
+   */
+  int n_terms;
+
+  /**
+   * @brief Maximum degree \f$q\f$ of the right hand side.
+   */
+  int rhs_degree;
+
+  /**
+   * @brief Number of coefficients stored, that is
+   * <code>2 * n_terms + rhs_degree + 1</code>.
+   */
+  int n_coeffs;
+
+  /**
+   * @brief Orders \f$k_i\f$ of the poles.
+   */
+  int * orders;
+
+  /**
+   * @brief Indices of the terms with \f$c_i \neq 0\f$, the only ones that
+   * are evaluated.
+   */
+  int * active_terms;
+
+  /**
+   * @brief Number of elements of active_terms.
+   */
+  int n_active;
+
+  /**
+   * @brief Effective degree of the right hand side, or -1 if it is zero.
+   */
+  int f_degree;
+
+  /**
+   * @brief Floating point coefficients.
+   */
+  cplx_t * fpc;
+
+  /**
+   * @brief DPE coefficients.
+   */
+  cdpe_t * dpc;
+
+  /**
+   * @brief Multiprecision coefficients.
+   */
+  mpc_t * mfpc;
+
+  /**
+   * @brief Moduli of the coefficients, used in the floating point error
+   * bounds.
+   */
+  double * fap;
+
+  /**
+   * @brief Moduli of the coefficients, used in the DPE and multiprecision
+   * error bounds.
+   */
+  rdpe_t * dap;
+
+  /**
+   * @brief Real parts of the coefficients.
+   */
+  mpq_t * rational_real_coeffs;
+
+  /**
+   * @brief Imaginary parts of the coefficients.
+   */
+  mpq_t * rational_imag_coeffs;
+
+  /**
+   * @brief Internal mutex used to manage the change of precision.
+   */
+  pthread_mutex_t precision_mutex;
+} mps_rational_equation;
+
+/**
+ * @brief Create a new rational equation with all the terms and the
+ * right hand side set to zero.
+ *
+ * @param ctx The current mps_context.
+ * @param n_terms The number of rational terms \f$m\f$.
+ * @param rhs_degree The maximum degree of the right hand side \f$f\f$.
+ */
+mps_rational_equation * mps_rational_equation_new (mps_context * ctx, int n_terms, int rhs_degree);
+
+/**
+ * @brief Set the i-th term to \f$c / (x - d)^k\f$.
+ *
+ * The degree of the equation is updated accordingly, so all the terms must
+ * be set before passing it to mps_context_set_input_poly(). When the right
+ * hand side is zero the degree is the one obtained assuming that the sum of
+ * the \f$c_i\f$ of the poles of lowest order is not zero.
+ */
+void mps_rational_equation_set_term_q (mps_context * ctx, mps_rational_equation * re, int i,
+                                       mpq_t c_real, mpq_t c_imag, mpq_t d_real, mpq_t d_imag,
+                                       int k);
+
+/**
+ * @brief Integer version of mps_rational_equation_set_term_q().
+ */
+void mps_rational_equation_set_term_i (mps_context * ctx, mps_rational_equation * re, int i,
+                                       long int c_real, long int c_imag,
+                                       long int d_real, long int d_imag, int k);
+
+/**
+ * @brief Set the coefficient of degree j of the right hand side.
+ */
+void mps_rational_equation_set_rhs_coefficient_q (mps_context * ctx, mps_rational_equation * re,
+                                                  int j, mpq_t real_part, mpq_t imag_part);
+
+/**
+ * @brief Integer version of mps_rational_equation_set_rhs_coefficient_q().
+ */
+void mps_rational_equation_set_rhs_coefficient_i (mps_context * ctx, mps_rational_equation * re,
+                                                  int j, long int real_part, long int imag_part);
+
+/**
+ * @brief Parse a rational equation from buffer. The number of terms is the
+ * degree given in the options, and it is followed by the terms, written as
+ * \f$c_i\f$, \f$d_i\f$ and \f$k_i\f$, by the degree \f$q\f$ of the right
+ * hand side (-1 if it is zero), and by its coefficients
+ * \f$f_0, \dots, f_q\f$.
+ */
+mps_rational_equation * mps_rational_equation_read_from_stream (mps_context * ctx, mps_input_buffer * buffer,
+                                                                mps_structure structure,
+                                                                long int precision);
+
+#ifdef _MPS_PRIVATE
+void mps_rational_equation_update_coefficients (mps_context * ctx, mps_rational_equation * re);
+#endif
+
+MPS_END_DECLS
+
+#endif
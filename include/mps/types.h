@@ -94,6 +94,11 @@ struct mps_input_buffer;
 
 /* approximation.h */
 struct mps_approximation;
+struct mps_root_view;
+
+/* events.h */
+struct mps_event;
+struct mps_event_queue;
 
 /* options.h */
 struct mps_opt;
@@ -112,14 +117,32 @@ struct mps_output_configuration;
 struct mps_thread_job;
 struct mps_thread_job_queue;
 struct mps_thread_worker_data;
+struct mps_thread_workspace;
 struct mps_thread;
 struct mps_thread_pool;
 struct mps_thread_pool_queue;
 struct mps_thread_pool_queue_item;
 
+/* jacobi-aberth.h */
+struct mps_jacobi_aberth_step_data;
+
 /* regeneration-driver.h */
 struct mps_regeneration_driver;
 
+/* auto-configuration.h */
+struct mps_polynomial_features;
+struct mps_auto_calibration;
+
+/* frozen-roots.h */
+struct mps_frozen_roots;
+
+/* secular-batch.h */
+struct mps_secular_dsum;
+struct mps_secular_msum;
+
+/* square-free.h */
+struct mps_square_free_factor;
+
 #else
 
 /* Forward declarations of the type used in the headers, so they can be
@@ -152,6 +175,11 @@ typedef struct mps_input_buffer mps_input_buffer;
 
 /* approximation.h */
 typedef struct mps_approximation mps_approximation;
+typedef struct mps_root_view mps_root_view;
+
+/* events.h */
+typedef struct mps_event mps_event;
+typedef struct mps_event_queue mps_event_queue;
 
 /* options.h */
 typedef struct mps_opt mps_opt;
@@ -178,6 +206,8 @@ typedef enum mps_output_goal mps_output_goal;
 typedef enum mps_search_set mps_search_set;
 typedef enum mps_phase mps_phase;
 typedef enum mps_starting_strategy mps_starting_strategy;
+typedef enum mps_thread_affinity mps_thread_affinity;
+typedef enum mps_symmetry mps_symmetry;
 
 typedef struct mps_input_configuration mps_input_configuration;
 typedef struct mps_output_configuration mps_output_configuration;
@@ -186,14 +216,44 @@ typedef struct mps_output_configuration mps_output_configuration;
 typedef struct mps_thread_job mps_thread_job;
 typedef struct mps_thread_job_queue mps_thread_job_queue;
 typedef struct mps_thread_worker_data mps_thread_worker_data;
+typedef struct mps_thread_workspace mps_thread_workspace;
 typedef struct mps_thread mps_thread;
 typedef struct mps_thread_pool mps_thread_pool;
 typedef struct mps_thread_pool_queue mps_thread_pool_queue;
 typedef struct mps_thread_pool_queue_item mps_thread_pool_queue_item;
 
+/* jacobi-aberth.h */
+typedef struct mps_jacobi_aberth_step_data mps_jacobi_aberth_step_data;
+
 /* regeneration-driver.h */
 typedef struct mps_regeneration_driver mps_regeneration_driver;
 
+/* auto-configuration.h */
+typedef struct mps_polynomial_features mps_polynomial_features;
+typedef struct mps_auto_calibration mps_auto_calibration;
+
+/* frozen-roots.h */
+typedef struct mps_frozen_roots mps_frozen_roots;
+
+/* secular-batch.h */
+typedef struct mps_secular_dsum mps_secular_dsum;
+typedef struct mps_secular_msum mps_secular_msum;
+
+/* square-free.h */
+typedef struct mps_square_free_factor mps_square_free_factor;
+
+/* touch.h */
+typedef struct mps_disc_shadow mps_disc_shadow;
+
+/* sort.h */
+typedef struct mps_sort_key mps_sort_key;
+
+/* ball.h */
+typedef struct mps_mball mps_mball;
+
+/* hessenberg-determinant.h */
+typedef struct mps_hessenberg_workspace mps_hessenberg_workspace;
+
 #endif
 
 /**
@@ -328,7 +388,13 @@ enum  mps_algorithm {
   /**
    * @brief Gemignani's approach applied to secular equations.
    */
-  MPS_ALGORITHM_SECULAR_GA
+  MPS_ALGORITHM_SECULAR_GA,
+
+  /**
+   * @brief Choose the algorithm and its tuning from the features
+   * of the input.
+   */
+  MPS_ALGORITHM_AUTO
 };
 
 /**
@@ -358,7 +424,9 @@ enum mps_option_key {
   MPS_KEY_PRECISION,
 
   /* Key introduced in MPSolve 3.1 */
-  MPS_FLAG_CHEBYSHEV
+  MPS_FLAG_CHEBYSHEV,
+
+  MPS_FLAG_RATIONAL_FUNCTION
 };
 
 /**
@@ -476,7 +544,8 @@ enum mps_search_set {
 enum mps_representation {
   MPS_REPRESENTATION_SECULAR,
   MPS_REPRESENTATION_MONOMIAL,
-  MPS_REPRESENTATION_CHEBYSHEV
+  MPS_REPRESENTATION_CHEBYSHEV,
+  MPS_REPRESENTATION_RATIONAL_FUNCTION
 };
 
 /**
@@ -485,7 +554,56 @@ enum mps_representation {
 enum mps_starting_strategy {
   MPS_STARTING_STRATEGY_DEFAULT,
   MPS_STARTING_STRATEGY_RECURSIVE,
-  MPS_STARTING_STRATEGY_FILE
+  MPS_STARTING_STRATEGY_FILE,
+  MPS_STARTING_STRATEGY_COMPANION
+};
+
+/**
+ * @brief Policy used to pin the threads of the thread pool to the
+ * cores of the machine.
+ */
+enum mps_thread_affinity {
+  /**
+   * @brief Do not pin the threads, let the operating system schedule them.
+   */
+  MPS_THREAD_AFFINITY_NONE,
+
+  /**
+   * @brief Fill the cores of a socket before moving to the next one.
+   */
+  MPS_THREAD_AFFINITY_COMPACT,
+
+  /**
+   * @brief Distribute the threads across sockets and physical cores
+   * before using hyperthreaded siblings.
+   */
+  MPS_THREAD_AFFINITY_SCATTER,
+
+  /**
+   * @brief Pin the threads on an explicit list of cores.
+   */
+  MPS_THREAD_AFFINITY_LIST
+};
+
+/**
+ * @brief Symmetry of the coefficients of a polynomial with respect
+ * to the map \f$x \mapsto 1/x\f$.
+ */
+enum mps_symmetry {
+  /**
+   * @brief No symmetry has been detected.
+   */
+  MPS_SYMMETRY_NONE,
+
+  /**
+   * @brief The coefficients satisfy \f$a_i = a_{n-i}\f$.
+   */
+  MPS_SYMMETRY_PALINDROMIC,
+
+  /**
+   * @brief The coefficients satisfy \f$a_i = -a_{n-i}\f$.
+   */
+  MPS_SYMMETRY_ANTI_PALINDROMIC
 };
 
 #endif /* endif MPS_TYPES_H_ */
@@ -26,7 +26,7 @@ mps_chebyshev_poly_meval (mps_context * ctx, mps_polynomial * poly, mpc_t x, mpc
   mpc_t t0, t1, ctmp, ctmp2;
   rdpe_t ax, rtmp, rtmp2;
 
-  mpc_rmod (ax, x);
+  mps_mag_set_mpc (ax, x);
   rdpe_set (error, rdpe_zero);
 
   /* Make sure that we have sufficient precision to perform the computation */
@@ -48,24 +48,22 @@ mps_chebyshev_poly_meval (mps_context * ctx, mps_polynomial * poly, mpc_t x, mpc
   mpc_mul (ctmp, cpoly->mfpc[1], x);
   mpc_add_eq (value, ctmp);
 
-  mpc_rmod (rtmp, ctmp);
-  rdpe_add_eq (error, rtmp);
+  mps_mag_set_mpc (error, ctmp);
 
   for (i = 2; i <= poly->degree; i++)
     {
       mpc_mul (ctmp, x, t1);
       mpc_mul_eq_ui (ctmp, 2U);
-      mpc_rmod (rtmp, ctmp);
+      mps_mag_set_mpc (rtmp, ctmp);
       mpc_sub_eq (ctmp, t0);
 
-      mpc_rmod (rtmp2, t0);
-      rdpe_add_eq (rtmp, rtmp2);
+      mps_mag_set_mpc (rtmp2, t0);
+      mps_mag_add (rtmp, rtmp, rtmp2);
 
       mpc_mul (ctmp2, ctmp, cpoly->mfpc[i]);
       mpc_add_eq (value, ctmp2);
 
-      rdpe_mul_eq (rtmp, ax);
-      rdpe_add_eq (error, rtmp);
+      mps_mag_fma (error, rtmp, ax, error);
 
       mpc_set (t0, t1);
       mpc_set (t1, ctmp);
@@ -77,7 +75,7 @@ mps_chebyshev_poly_meval (mps_context * ctx, mps_polynomial * poly, mpc_t x, mpc
   mpc_clear (ctmp2);
 
   rdpe_set_2dl (rtmp, 2.0, -wp);
-  rdpe_mul_eq (error, rtmp);
+  mps_mag_mul (error, error, rtmp);
 
   return true;
 }
@@ -21,6 +21,7 @@ mps_approximation_new (mps_context * s)
   mpc_init2 (appr->mvalue, s->mpwp);
   appr->again = true;
   appr->approximated = false;
+  appr->frozen = false;
 
   appr->status = MPS_ROOT_STATUS_CLUSTERED;
   appr->attrs = MPS_ROOT_ATTRS_NONE;
@@ -110,6 +111,12 @@ mps_approximation_get_again (mps_context * ctx, mps_approximation * approximatio
   return approximation->again;
 }
 
+long int
+mps_approximation_get_wp (mps_context * ctx, mps_approximation * approximation)
+{
+  return approximation->wp;
+}
+
 /* Public setters functions */
 void
 mps_approximation_set_fvalue (mps_context * ctx, mps_approximation * approximation, const cplx_t value)
@@ -0,0 +1,337 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <float.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/*! @cond PRIVATE */
+
+/* Fields of mps_auto_calibration that can be set from a file. */
+static const struct {
+  const char * key;
+  size_t offset;
+  mps_boolean integer;
+} mps_auto_calibration_keys[] = {
+  { "sparse_ratio", offsetof (mps_auto_calibration, sparse_ratio), false },
+  { "dpe_dynamic_range", offsetof (mps_auto_calibration, dpe_dynamic_range), false },
+  { "companion_max_degree", offsetof (mps_auto_calibration, companion_max_degree), true },
+  { "companion_min_spread", offsetof (mps_auto_calibration, companion_min_spread), false },
+  { "roots_per_thread", offsetof (mps_auto_calibration, roots_per_thread), true },
+  { "block_min_degree", offsetof (mps_auto_calibration, block_min_degree), true },
+  { "block_max_spread", offsetof (mps_auto_calibration, block_max_spread), false },
+};
+
+#define MPS_AUTO_CALIBRATION_KEYS \
+  (sizeof (mps_auto_calibration_keys) / sizeof (mps_auto_calibration_keys[0]))
+
+/*! @endcond */
+
+/**
+ * @brief Set the default thresholds for the automatic configuration.
+ *
+ * @param calibration The calibration to initialize.
+ */
+void
+mps_auto_calibration_set_defaults (mps_auto_calibration * calibration)
+{
+  /* These values have been obtained running tools/mps-calibrate-auto.py
+   * on the polynomials in src/tests/unisolve. On those benchmarks neither
+   * the companion starting points nor the block iterations pay off, so
+   * they are disabled unless a calibration file enables them. */
+  calibration->sparse_ratio = 0.01;
+  calibration->dpe_dynamic_range = 2048.0;
+  calibration->companion_max_degree = 0;
+  calibration->companion_min_spread = 0.0;
+  calibration->roots_per_thread = 32;
+  calibration->block_min_degree = 0;
+  calibration->block_max_spread = 0.0;
+}
+
+/**
+ * @brief Read the thresholds for the automatic configuration from a file.
+ *
+ * @param s The current mps_context, used to report errors.
+ * @param calibration The calibration that will be updated with the values in
+ * the file. Keys that do not appear in the file are left untouched.
+ * @param filename The path of the calibration file.
+ * @return true if the file has been read successfully, false otherwise.
+ */
+mps_boolean
+mps_auto_calibration_load (mps_context * s, mps_auto_calibration * calibration,
+                           const char * filename)
+{
+  char line[256], key[64];
+  double value;
+  int lineno = 0;
+  size_t i;
+  FILE * f = fopen (filename, "r");
+
+  if (!f)
+    {
+      mps_error (s, "Cannot open the calibration file %s", filename);
+      return false;
+    }
+
+  while (fgets (line, sizeof (line), f))
+    {
+      char * comment = strchr (line, '#');
+      lineno++;
+
+      if (comment)
+        *comment = '\0';
+
+      if (sscanf (line, " %63s", key) != 1)
+        continue;
+
+      if (sscanf (line, " %63[a-z_] = %lf", key, &value) != 2)
+        {
+          mps_error (s, "Malformed line %d in the calibration file %s", lineno, filename);
+          fclose (f);
+          return false;
+        }
+
+      for (i = 0; i < MPS_AUTO_CALIBRATION_KEYS; i++)
+        if (strcmp (key, mps_auto_calibration_keys[i].key) == 0)
+          break;
+
+      if (i == MPS_AUTO_CALIBRATION_KEYS)
+        {
+          mps_error (s, "Unknown key %s in the calibration file %s", key, filename);
+          fclose (f);
+          return false;
+        }
+
+      if (mps_auto_calibration_keys[i].integer)
+        *(int*)((char*)calibration + mps_auto_calibration_keys[i].offset) = (int) value;
+      else
+        *(double*)((char*)calibration + mps_auto_calibration_keys[i].offset) = value;
+    }
+
+  fclose (f);
+  return true;
+}
+
+/**
+ * @brief Compute the features of a polynomial used by the automatic
+ * configuration.
+ *
+ * The moduli of the coefficients and the Newton polygon are only
+ * available for polynomials in the monomial basis; for the other
+ * representations the corresponding features are left to zero.
+ *
+ * @param s The current mps_context.
+ * @param p The polynomial whose features should be computed.
+ * @param features The struct that will be filled with the features.
+ */
+void
+mps_polynomial_features_compute (mps_context * s, mps_polynomial * p,
+                                 mps_polynomial_features * features)
+{
+  mps_monomial_poly * mp;
+  double * a, lmin = DBL_MAX, lmax = -DBL_MAX;
+  double r, rmin = DBL_MAX, rmax = -DBL_MAX;
+  int i, iold, zeros = 0, n = p->degree;
+  int * h;
+
+  features->degree = n;
+  features->monomial = MPS_IS_MONOMIAL_POLY (p);
+  features->secular = MPS_IS_SECULAR_EQUATION (p);
+  features->structure = p->structure;
+  features->sparsity = 0.0;
+  features->dynamic_range = 0.0;
+  features->hull_vertices = 0;
+  features->modulus_spread = 0.0;
+
+  /* mps_fconvex () works on s->n + 1 points, so the features can only be
+   * computed on the polynomial that is being solved. */
+  if (!features->monomial || n < 1 || n != s->n)
+    return;
+
+  mp = MPS_MONOMIAL_POLY (p);
+  a = double_valloc (n + 1);
+
+  for (i = 0; i <= n; i++)
+    {
+      if (rdpe_eq (mp->dap[i], rdpe_zero))
+        {
+          zeros++;
+          continue;
+        }
+
+      a[i] = rdpe_log (mp->dap[i]);
+      lmin = MIN (lmin, a[i]);
+      lmax = MAX (lmax, a[i]);
+    }
+
+  if (zeros == n + 1)
+    {
+      free (a);
+      return;
+    }
+
+  features->sparsity = (double) zeros / (n + 1);
+  features->dynamic_range = (lmax - lmin) / LOG2;
+
+  /* Zero coefficients must never be selected as vertices of the
+   * Newton polygon. */
+  for (i = 0; i <= n; i++)
+    if (rdpe_eq (mp->dap[i], rdpe_zero))
+      a[i] = -2.0 * (LONG_MAX * LOG2);
+
+  h = mps_fconvex (s, n, a);
+
+  /* The radii are computed only on the edges that join two non zero
+   * coefficients: the others correspond to zero roots, or to a vanishing
+   * leading coefficient. */
+  iold = -1;
+  for (i = 0; i <= n; i++)
+    {
+      if (!h[i])
+        continue;
+
+      features->hull_vertices++;
+
+      if (iold >= 0 && rdpe_ne (mp->dap[iold], rdpe_zero) && rdpe_ne (mp->dap[i], rdpe_zero))
+        {
+          r = (a[iold] - a[i]) / (i - iold);
+          rmin = MIN (rmin, r);
+          rmax = MAX (rmax, r);
+        }
+
+      iold = i;
+    }
+
+  if (rmax >= rmin)
+    features->modulus_spread = (rmax - rmin) / LOG2;
+
+  free (h);
+  free (a);
+}
+
+/**
+ * @brief Choose the algorithm and tune the context for the computation
+ * on a polynomial with the given features.
+ *
+ * Only the parameters that have been left to their default value are
+ * changed, so explicit choices of the user are always respected. The
+ * thresholds are taken from <code>s->auto_calibration</code>.
+ *
+ * @param s The current mps_context.
+ * @param features The features of the input polynomial.
+ * @return The algorithm that should be used.
+ */
+mps_algorithm
+mps_auto_configure (mps_context * s, mps_polynomial_features * features)
+{
+  mps_auto_calibration * c = s->auto_calibration;
+  mps_algorithm algorithm = MPS_ALGORITHM_SECULAR_GA;
+  int threads;
+
+  /* The regeneration of the secular equation does not preserve the
+   * sparsity of the input, while the Horner scheme of the standard
+   * algorithm can take advantage of it. */
+  if (features->monomial &&
+      (MPS_DENSITY_IS_SPARSE (s->active_poly->density) ||
+       1.0 - features->sparsity <= c->sparse_ratio))
+    algorithm = MPS_ALGORITHM_STANDARD_MPSOLVE;
+
+  /* Too few roots for each thread only add synchronization overhead. */
+  if (c->roots_per_thread > 0)
+    {
+      threads = MAX (1, features->degree / c->roots_per_thread);
+      if (s->n_threads > threads)
+        s->n_threads = threads;
+    }
+
+  /* The standard algorithm decides the starting phase and the starting
+   * points by itself. */
+  if (algorithm == MPS_ALGORITHM_STANDARD_MPSOLVE)
+    return algorithm;
+
+  /* With a large dynamic range the approximations computed in floating
+   * point are mostly underflows, and the float phase is wasted. */
+  if (s->input_config->starting_phase == no_phase &&
+      features->dynamic_range > c->dpe_dynamic_range)
+    s->input_config->starting_phase = dpe_phase;
+
+  if (s->starting_strategy == MPS_STARTING_STRATEGY_DEFAULT && features->monomial &&
+      features->degree <= MIN (c->companion_max_degree, MPS_COMPANION_STARTING_MAX_DEGREE) &&
+      features->modulus_spread > c->companion_min_spread)
+    s->starting_strategy = MPS_STARTING_STRATEGY_COMPANION;
+
+  /* The block iterations are reproducible on any number of threads, but
+   * lack the adaptive handling of the Gauss-Seidel iterations, so they are
+   * only used on well separated moduli. */
+  if (!s->jacobi_iterations && !s->block_iterations && c->block_min_degree > 0 &&
+      s->n_threads > 1 && features->degree >= c->block_min_degree &&
+      features->modulus_spread <= c->block_max_spread)
+    s->block_iterations = true;
+
+  return algorithm;
+}
+
+/**
+ * @brief Entry point of MPS_ALGORITHM_AUTO.
+ *
+ * The features of the active polynomial are used to select the algorithm
+ * and its tuning, and then the selected algorithm is run. The tuning is
+ * only applied to this computation, while <code>s->algorithm</code> keeps
+ * the selected algorithm so that the results can be validated after the
+ * call.
+ *
+ * @param s The current mps_context.
+ */
+void
+mps_auto_mpsolve (mps_context * s)
+{
+  mps_polynomial_features features;
+  mps_phase starting_phase = s->input_config->starting_phase;
+  mps_starting_strategy starting_strategy = s->starting_strategy;
+  mps_boolean block_iterations = s->block_iterations;
+  int n_threads = s->n_threads;
+
+  mps_polynomial_features_compute (s, s->active_poly, &features);
+
+  MPS_DEBUG_WITH_INFO (s, "Auto-configuration features: degree = %d, sparsity = %f, "
+                       "dynamic range = %f bits, Newton polygon vertices = %d, "
+                       "modulus spread = %f bits",
+                       features.degree, features.sparsity, features.dynamic_range,
+                       features.hull_vertices, features.modulus_spread);
+
+  s->algorithm = mps_auto_configure (s, &features);
+
+  MPS_DEBUG_WITH_INFO (s, "Auto-configuration: %s algorithm, %s starting phase, "
+                       "%s starting points, %d threads, %s iterations",
+                       (s->algorithm == MPS_ALGORITHM_SECULAR_GA) ? "secular" : "standard",
+                       (s->input_config->starting_phase == dpe_phase) ? "DPE" : "default",
+                       (s->starting_strategy == MPS_STARTING_STRATEGY_COMPANION) ? "companion" : "default",
+                       s->n_threads,
+                       s->block_iterations ? "block" : "default");
+
+  switch (s->algorithm)
+    {
+    case MPS_ALGORITHM_STANDARD_MPSOLVE:
+      mps_standard_mpsolve (s);
+      break;
+
+    default:
+      mps_secular_ga_mpsolve (s);
+      break;
+    }
+
+  s->input_config->starting_phase = starting_phase;
+  s->starting_strategy = starting_strategy;
+  s->block_iterations = block_iterations;
+  s->n_threads = n_threads;
+}
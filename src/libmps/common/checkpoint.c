@@ -0,0 +1,446 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <stdio.h>
+#include <string.h>
+
+/*! @cond PRIVATE */
+
+#define MPS_CHECKPOINT_BYTE_ORDER 0x01020304
+
+static const char mps_checkpoint_magic[8] = "MPSCKPT";
+
+/* The header records the size of the native types that are dumped
+ * to the file, so that a checkpoint produced on an incompatible
+ * architecture can be detected and refused. */
+struct __mps_checkpoint_header {
+  char magic[8];
+  int version;
+  int byte_order;
+  int limb_size;
+  int long_size;
+  int n;
+  int phase;
+  long int mpwp;
+  long int data_prec_max;
+  int packet;
+  int just_regenerated;
+  int just_raised_precision;
+};
+
+/*! @endcond */
+
+static mps_boolean
+mps_checkpoint_write (FILE * f, const void * ptr, size_t size)
+{
+  return fwrite (ptr, size, 1, f) == 1;
+}
+
+static mps_boolean
+mps_checkpoint_read (FILE * f, void * ptr, size_t size)
+{
+  return fread (ptr, size, 1, f) == 1;
+}
+
+/**
+ * @brief Dump the limbs of a mpf_t to f, together with its precision, so that
+ * it can be restored exactly.
+ */
+static mps_boolean
+mps_checkpoint_write_mpf (FILE * f, mpf_t x)
+{
+  long int prec = mpf_get_prec (x);
+  int size = x->_mp_size;
+  long int exp = x->_mp_exp;
+  size_t limbs = (size < 0) ? -size : size;
+
+  if (!mps_checkpoint_write (f, &prec, sizeof(long int)) ||
+      !mps_checkpoint_write (f, &size, sizeof(int)) ||
+      !mps_checkpoint_write (f, &exp, sizeof(long int)))
+    return false;
+
+  return limbs == 0 || fwrite (x->_mp_d, sizeof(mp_limb_t), limbs, f) == limbs;
+}
+
+static mps_boolean
+mps_checkpoint_read_mpf (FILE * f, mpf_t x)
+{
+  long int prec, exp;
+  int size;
+  size_t limbs;
+
+  if (!mps_checkpoint_read (f, &prec, sizeof(long int)) ||
+      !mps_checkpoint_read (f, &size, sizeof(int)) ||
+      !mps_checkpoint_read (f, &exp, sizeof(long int)) ||
+      prec <= 0)
+    return false;
+
+  mpf_set_prec (x, prec);
+
+  limbs = (size < 0) ? -size : size;
+  if (limbs > (size_t)x->_mp_prec + 1)
+    return false;
+
+  if (limbs != 0 && fread (x->_mp_d, sizeof(mp_limb_t), limbs, f) != limbs)
+    return false;
+
+  x->_mp_size = size;
+  x->_mp_exp = exp;
+
+  return true;
+}
+
+static mps_boolean
+mps_checkpoint_write_mpc (FILE * f, mpc_t x)
+{
+  return mps_checkpoint_write_mpf (f, mpc_Re (x)) &&
+         mps_checkpoint_write_mpf (f, mpc_Im (x));
+}
+
+static mps_boolean
+mps_checkpoint_read_mpc (FILE * f, mpc_t x)
+{
+  return mps_checkpoint_read_mpf (f, mpc_Re (x)) &&
+         mps_checkpoint_read_mpf (f, mpc_Im (x));
+}
+
+static mps_boolean
+mps_checkpoint_write_approximation (FILE * f, mps_approximation * appr)
+{
+  return mps_checkpoint_write (f, appr->fvalue, sizeof(cplx_t)) &&
+         mps_checkpoint_write (f, &appr->frad, sizeof(double)) &&
+         mps_checkpoint_write (f, appr->dvalue, sizeof(cdpe_t)) &&
+         mps_checkpoint_write (f, appr->drad, sizeof(rdpe_t)) &&
+         mps_checkpoint_write_mpc (f, appr->mvalue) &&
+         mps_checkpoint_write (f, &appr->approximated, sizeof(mps_boolean)) &&
+         mps_checkpoint_write (f, &appr->again, sizeof(mps_boolean)) &&
+         mps_checkpoint_write (f, &appr->wp, sizeof(long int)) &&
+         mps_checkpoint_write (f, &appr->status, sizeof(mps_root_status)) &&
+         mps_checkpoint_write (f, &appr->attrs, sizeof(mps_root_attrs)) &&
+         mps_checkpoint_write (f, &appr->inclusion, sizeof(mps_root_inclusion));
+}
+
+static mps_boolean
+mps_checkpoint_read_approximation (FILE * f, mps_approximation * appr)
+{
+  return mps_checkpoint_read (f, appr->fvalue, sizeof(cplx_t)) &&
+         mps_checkpoint_read (f, &appr->frad, sizeof(double)) &&
+         mps_checkpoint_read (f, appr->dvalue, sizeof(cdpe_t)) &&
+         mps_checkpoint_read (f, appr->drad, sizeof(rdpe_t)) &&
+         mps_checkpoint_read_mpc (f, appr->mvalue) &&
+         mps_checkpoint_read (f, &appr->approximated, sizeof(mps_boolean)) &&
+         mps_checkpoint_read (f, &appr->again, sizeof(mps_boolean)) &&
+         mps_checkpoint_read (f, &appr->wp, sizeof(long int)) &&
+         mps_checkpoint_read (f, &appr->status, sizeof(mps_root_status)) &&
+         mps_checkpoint_read (f, &appr->attrs, sizeof(mps_root_attrs)) &&
+         mps_checkpoint_read (f, &appr->inclusion, sizeof(mps_root_inclusion));
+}
+
+static mps_boolean
+mps_checkpoint_write_clusterization (FILE * f, mps_clusterization * c)
+{
+  mps_cluster_item * item;
+  mps_root * root;
+
+  if (!mps_checkpoint_write (f, &c->n, sizeof(long int)))
+    return false;
+
+  for (item = c->first; item != NULL; item = item->next)
+    {
+      if (!mps_checkpoint_write (f, &item->cluster->n, sizeof(long int)))
+        return false;
+
+      for (root = item->cluster->first; root != NULL; root = root->next)
+        if (!mps_checkpoint_write (f, &root->k, sizeof(long int)))
+          return false;
+    }
+
+  return true;
+}
+
+/**
+ * @brief Read a clusterization written by mps_checkpoint_write_clusterization().
+ *
+ * Clusters and roots are inserted at the head of their lists, so they are
+ * inserted in reverse order to obtain the same ordering of the saved
+ * clusterization. This is relevant since the job queues follow it.
+ */
+static mps_clusterization *
+mps_checkpoint_read_clusterization (mps_context * s, FILE * f)
+{
+  mps_clusterization * c = mps_clusterization_empty (s);
+  mps_cluster ** clusters = NULL;
+  long int * indices = mps_newv (long int, s->n);
+  long int n_clusters, n_roots, i, j, total = 0;
+  mps_boolean success = false;
+
+  if (!mps_checkpoint_read (f, &n_clusters, sizeof(long int)) ||
+      n_clusters < 1 || n_clusters > s->n)
+    goto cleanup;
+
+  clusters = mps_newv (mps_cluster *, n_clusters);
+  for (i = 0; i < n_clusters; i++)
+    clusters[i] = NULL;
+
+  for (i = 0; i < n_clusters; i++)
+    {
+      if (!mps_checkpoint_read (f, &n_roots, sizeof(long int)) ||
+          n_roots < 1 || total + n_roots > s->n)
+        goto cleanup;
+
+      for (j = 0; j < n_roots; j++)
+        if (!mps_checkpoint_read (f, &indices[j], sizeof(long int)) ||
+            indices[j] < 0 || indices[j] >= s->n)
+          goto cleanup;
+
+      clusters[i] = mps_cluster_empty (s);
+      for (j = n_roots - 1; j >= 0; j--)
+        mps_cluster_insert_root (s, clusters[i], indices[j]);
+
+      total += n_roots;
+    }
+
+  if (total != s->n)
+    goto cleanup;
+
+  for (i = n_clusters - 1; i >= 0; i--)
+    {
+      mps_clusterization_insert_cluster (s, c, clusters[i]);
+      clusters[i] = NULL;
+    }
+
+  success = true;
+
+cleanup:
+  if (clusters)
+    {
+      for (i = 0; i < n_clusters; i++)
+        if (clusters[i])
+          mps_cluster_free (s, clusters[i]);
+      free (clusters);
+    }
+
+  free (indices);
+
+  if (!success)
+    {
+      mps_clusterization_free (s, c);
+      c = NULL;
+    }
+
+  return c;
+}
+
+/**
+ * @brief Save the state of the secular algorithm in a binary file.
+ *
+ * The checkpoint contains the approximations with their radii, status and
+ * working precision, the clusterization, the coefficients of the current
+ * secular equation, the phase and the working precision of the computation.
+ * The file is written in a temporary location and moved to
+ * <code>filename</code> only when complete, so that an interruption during the
+ * save does not corrupt the previous checkpoint.
+ *
+ * The format uses the native representation of the numbers, so the
+ * checkpoint can be resumed only on a compatible architecture.
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param filename The path of the checkpoint file.
+ * @param packet The number of packets performed since the last restart.
+ * @param just_regenerated true if the coefficients have just been regenerated.
+ * @return true if the checkpoint has been saved successfully.
+ */
+MPS_PRIVATE mps_boolean
+mps_checkpoint_save (mps_context * s, const char * filename,
+                     int packet, mps_boolean just_regenerated)
+{
+  struct __mps_checkpoint_header header;
+  mps_secular_equation * sec = s->secular_equation;
+  char * tmp_filename = mps_newv (char, strlen (filename) + 5);
+  mps_boolean success;
+  FILE * f;
+  int i;
+
+  sprintf (tmp_filename, "%s.tmp", filename);
+
+  f = fopen (tmp_filename, "wb");
+  if (!f)
+    {
+      mps_warn (s, "Cannot open the checkpoint file for writing");
+      free (tmp_filename);
+      return false;
+    }
+
+  memset (&header, 0, sizeof(header));
+  memcpy (header.magic, mps_checkpoint_magic, sizeof(header.magic));
+  header.version = MPS_CHECKPOINT_VERSION;
+  header.byte_order = MPS_CHECKPOINT_BYTE_ORDER;
+  header.limb_size = sizeof(mp_limb_t);
+  header.long_size = sizeof(long int);
+  header.n = s->n;
+  header.phase = s->lastphase;
+  header.mpwp = s->mpwp;
+  header.data_prec_max = s->data_prec_max.value;
+  header.packet = packet;
+  header.just_regenerated = just_regenerated;
+  header.just_raised_precision = s->just_raised_precision;
+
+  success = mps_checkpoint_write (f, &header, sizeof(header));
+
+  for (i = 0; success && i < s->n; i++)
+    success = mps_checkpoint_write_approximation (f, s->root[i]);
+
+  success = success && mps_checkpoint_write_clusterization (f, s->clusterization);
+
+  for (i = 0; success && i < s->n; i++)
+    success = mps_checkpoint_write_mpc (f, sec->ampc[i]) &&
+              mps_checkpoint_write_mpc (f, sec->bmpc[i]);
+
+  /* The magic number is repeated at the end so that truncated files
+   * can be detected. */
+  success = success && mps_checkpoint_write (f, mps_checkpoint_magic,
+                                             sizeof(mps_checkpoint_magic));
+
+  if (fclose (f) != 0)
+    success = false;
+
+  if (success)
+    success = (rename (tmp_filename, filename) == 0);
+
+  if (!success)
+    {
+      mps_warn (s, "Error while saving the checkpoint file");
+      remove (tmp_filename);
+    }
+  else if (s->debug_level & MPS_DEBUG_IO)
+    MPS_DEBUG (s, "Saved checkpoint in %s (phase = %s, mpwp = %ld)", filename,
+               MPS_PHASE_TO_STRING (s->lastphase), s->mpwp);
+
+  free (tmp_filename);
+
+  return success;
+}
+
+/**
+ * @brief Restore the state of the secular algorithm from a file
+ * written by <code>mps_checkpoint_save()</code>.
+ *
+ * The context must already be set up for the same equation that was
+ * being solved when the checkpoint was saved. On failure an error is
+ * set on the context.
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param filename The path of the checkpoint file.
+ * @param packet Will be set to the number of packets performed since the
+ * last restart.
+ * @param just_regenerated Will be set to true if the coefficients had
+ * just been regenerated when the checkpoint was saved.
+ * @return true if the state has been restored.
+ */
+MPS_PRIVATE mps_boolean
+mps_checkpoint_load (mps_context * s, const char * filename,
+                     int * packet, mps_boolean * just_regenerated)
+{
+  struct __mps_checkpoint_header header;
+  mps_secular_equation * sec = s->secular_equation;
+  mps_clusterization * c;
+  char magic[sizeof(mps_checkpoint_magic)];
+  mps_boolean success = false;
+  FILE * f;
+  int i;
+
+  MPS_DEBUG_THIS_CALL (s);
+
+  f = fopen (filename, "rb");
+  if (!f)
+    {
+      mps_error (s, "Cannot open the checkpoint file %s", filename);
+      return false;
+    }
+
+  if (!mps_checkpoint_read (f, &header, sizeof(header)) ||
+      memcmp (header.magic, mps_checkpoint_magic, sizeof(header.magic)) != 0)
+    {
+      mps_error (s, "The file %s is not a valid checkpoint", filename);
+      goto cleanup;
+    }
+
+  if (header.version != MPS_CHECKPOINT_VERSION ||
+      header.byte_order != MPS_CHECKPOINT_BYTE_ORDER ||
+      header.limb_size != sizeof(mp_limb_t) ||
+      header.long_size != sizeof(long int))
+    {
+      mps_error (s, "The checkpoint %s has been created by an incompatible version of MPSolve", filename);
+      goto cleanup;
+    }
+
+  if (header.n != s->n)
+    {
+      mps_error (s, "The checkpoint %s refers to an equation of degree %d", filename, header.n);
+      goto cleanup;
+    }
+
+  if (header.phase != float_phase && header.phase != dpe_phase &&
+      header.phase != mp_phase)
+    {
+      mps_error (s, "The checkpoint %s has an invalid phase", filename);
+      goto cleanup;
+    }
+
+  /* Bring the working precision of the computation, and the
+   * buffers of the coefficients, to the saved one. */
+  if (header.phase == mp_phase)
+    {
+      mps_secular_raise_precision (s, header.mpwp);
+      mps_prepare_data (s, MAX (header.mpwp, header.data_prec_max));
+    }
+
+  s->lastphase = header.phase;
+  s->just_raised_precision = header.just_raised_precision;
+
+  for (i = 0; i < s->n; i++)
+    if (!mps_checkpoint_read_approximation (f, s->root[i]))
+      goto corrupted;
+
+  c = mps_checkpoint_read_clusterization (s, f);
+  if (!c)
+    goto corrupted;
+
+  mps_clusterization_free (s, s->clusterization);
+  s->clusterization = c;
+
+  for (i = 0; i < s->n; i++)
+    if (!mps_checkpoint_read_mpc (f, sec->ampc[i]) ||
+        !mps_checkpoint_read_mpc (f, sec->bmpc[i]))
+      goto corrupted;
+
+  if (!mps_checkpoint_read (f, magic, sizeof(magic)) ||
+      memcmp (magic, mps_checkpoint_magic, sizeof(magic)) != 0)
+    goto corrupted;
+
+  mps_secular_ga_update_coefficients (s);
+
+  *packet = header.packet;
+  *just_regenerated = header.just_regenerated;
+
+  MPS_DEBUG_WITH_INFO (s, "Resuming from %s in %s with %ld bits of working precision",
+                       filename, MPS_PHASE_TO_STRING (s->lastphase), s->mpwp);
+
+  success = true;
+  goto cleanup;
+
+corrupted:
+  mps_error (s, "The checkpoint %s is truncated or corrupted", filename);
+
+cleanup:
+  fclose (f);
+  return success;
+}
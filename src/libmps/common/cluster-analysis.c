@@ -303,14 +303,17 @@ mps_dcluster (mps_context * s, rdpe_t * drad, int nf)
    * general, but can be used if they provide *COMPLETE* Newton
    * isolation. */
   rdpe_t * newton_radii = rdpe_valloc (s->n);
+  mps_disc_shadow * shadow = mps_newv (mps_disc_shadow, s->n);
   for (i = 0; i < s->n; i++)
     rdpe_set (newton_radii[i], s->root[i]->drad);
 
+  mps_dshadow_discs (s, newton_radii, nf, shadow);
+
   for (i = 0; i < s->n; i++)
     {
       for (j = 0; j < s->n; j++)
         {
-          if ((i != j) && mps_dtouchnwt (s, newton_radii, nf, i, j))
+          if ((i != j) && mps_dtouchnwt_shadow (s, shadow, newton_radii, nf, i, j))
             {
               newton_isolation = false;
               break;
@@ -320,6 +323,9 @@ mps_dcluster (mps_context * s, rdpe_t * drad, int nf)
 
   rdpe_vfree (newton_radii);
 
+  /* From now on the discs are the ones with radii drad. */
+  mps_dshadow_discs (s, drad, nf, shadow);
+
   /* If newton isolation has not been reached check with Gerschgorin */
   {
     /* if (MPS_INPUT_CONFIG_IS_USER (s->input_config))  */
@@ -380,7 +386,7 @@ mps_dcluster (mps_context * s, rdpe_t * drad, int nf)
               iter_root = iter_cluster->first;
               while (iter_root)
                 {
-                  if (mps_dtouchnwt (s, drad, nf, base_root->k, iter_root->k))
+                  if (mps_dtouchnwt_shadow (s, shadow, drad, nf, base_root->k, iter_root->k))
                     {
                       mps_root * next_root = iter_root->next;
                       mps_cluster_insert_root (s, new_cluster, iter_root->k);
@@ -421,6 +427,7 @@ mps_dcluster (mps_context * s, rdpe_t * drad, int nf)
       }
   }
 
+  free (shadow);
 
   if (newton_isolation)
     {
@@ -456,6 +463,7 @@ struct _mps_cluster_worker_data {
   int start_root;
   int end_root;
   rdpe_t * drad;
+  mps_disc_shadow * shadow;
   int nf;
   pthread_mutex_t * block_mutex;
   mps_cluster ** original_clusters;
@@ -474,7 +482,7 @@ _mps_mcluster_worker (void * data_ptr)
     {
       if (! data->analyzed_roots[i] && (data->original_clusters[i] == c))
 	{
-	  if (mps_mtouchnwt (data->ctx, data->drad, data->nf, data->base_root, i))
+	  if (mps_mtouchnwt_shadow (data->ctx, data->shadow, data->drad, data->nf, data->base_root, i))
 	    {
               if (! data->analyzed_roots[i])
                 {
@@ -567,14 +575,17 @@ mps_mcluster (mps_context * s, rdpe_t * drad, int nf)
    * general, but can be used if they provide *COMPLETE* Newton
    * isolation. */
   rdpe_t * newton_radii = rdpe_valloc (s->n);
+  mps_disc_shadow * shadow = mps_newv (mps_disc_shadow, s->n);
   for (i = 0; i < s->n; i++)
     rdpe_set (newton_radii[i], s->root[i]->drad);
 
+  mps_mshadow_discs (s, newton_radii, nf, shadow);
+
   for (i = 0; i < s->n; i++)
     {
       for (j = 0; j < s->n; j++)
         {
-          if ((i != j) && mps_mtouchnwt (s, newton_radii, nf, i, j))
+          if ((i != j) && mps_mtouchnwt_shadow (s, shadow, newton_radii, nf, i, j))
             {
               if (s->debug_level & MPS_DEBUG_CLUSTER)
                 MPS_DEBUG (s, "Failing newton isolation on root %d and %d", i, j);
@@ -592,6 +603,8 @@ mps_mcluster (mps_context * s, rdpe_t * drad, int nf)
   rdpe_vfree (newton_radii);
 
   /* Perform parallel analysis of the Gerschgorin disks. */
+  mps_mshadow_discs (s, drad, nf, shadow);
+
   int analyzed_roots = 0;
   int * already_analyzed_roots = mps_newv (int, s->n);
   mps_cluster ** original_clusters = mps_newv (mps_cluster*, s->n);
@@ -653,6 +666,7 @@ mps_mcluster (mps_context * s, rdpe_t * drad, int nf)
 	      data->end_root = MIN ((j+1) * block_size, s->n);
 	      data->analyzed_roots = already_analyzed_roots;
 	      data->drad = drad;
+	      data->shadow = shadow;
 	      data->nf = nf;
               data->block_mutex = &block_mutexes[j];
               data->original_clusters = original_clusters;
@@ -682,6 +696,7 @@ mps_mcluster (mps_context * s, rdpe_t * drad, int nf)
     }
 
   free (block_mutexes);
+  free (shadow);
   free (already_analyzed_roots);
   free (original_clusters);
   mps_clusterization_free (s, s->clusterization);
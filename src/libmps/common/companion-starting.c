@@ -0,0 +1,569 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <float.h>
+#include <math.h>
+
+/**
+ * @brief Maximum number of QR iterations spent on a single eigenvalue
+ * before giving up.
+ */
+#define MPS_COMPANION_MAX_ITERATIONS 30
+
+#define H(i, j) (h[(i) * n + (j)])
+
+/**
+ * @brief Cheap modulus used for the balancing and for the deflation
+ * criterion.
+ */
+static double
+mps_cplx_abs1 (const cplx_t x)
+{
+  return fabs (cplx_Re (x)) + fabs (cplx_Im (x));
+}
+
+/**
+ * @brief Principal square root of a complex number.
+ */
+static void
+mps_cplx_sqrt (cplx_t output, const cplx_t x)
+{
+  double re = cplx_Re (x), im = cplx_Im (x);
+  double m = hypot (re, im);
+  double t;
+
+  if (m == 0.0)
+    {
+      cplx_set (output, cplx_zero);
+      return;
+    }
+
+  if (re >= 0)
+    {
+      t = sqrt ((m + re) / 2);
+      cplx_set_d (output, t, im / (2 * t));
+    }
+  else
+    {
+      t = sqrt ((m - re) / 2);
+      cplx_set_d (output, fabs (im) / (2 * t), (im >= 0) ? t : -t);
+    }
+}
+
+/**
+ * @brief Balance the n x n matrix h by means of a diagonal similarity
+ * with powers of two, so that the norms of the rows and the columns
+ * become comparable. This does not change the eigenvalues but greatly
+ * improves their accuracy when the coefficients have very different
+ * magnitudes.
+ */
+static void
+mps_companion_balance (cplx_t * h, int n)
+{
+  int i, j, iterations = 0;
+  mps_boolean converged = false;
+  double c, r, f, g, s;
+
+  while (!converged && iterations++ < 100)
+    {
+      converged = true;
+
+      for (i = 0; i < n; i++)
+        {
+          c = r = 0.0;
+          for (j = 0; j < n; j++)
+            {
+              if (j == i)
+                continue;
+              c += mps_cplx_abs1 (H (j, i));
+              r += mps_cplx_abs1 (H (i, j));
+            }
+
+          if (c == 0.0 || r == 0.0)
+            continue;
+
+          g = r / 2;
+          f = 1.0;
+          s = c + r;
+
+          while (c < g)
+            {
+              f *= 2;
+              c *= 4;
+            }
+
+          g = r * 2;
+          while (c >= g)
+            {
+              f /= 2;
+              c /= 4;
+            }
+
+          if ((c + r) / f < 0.95 * s)
+            {
+              converged = false;
+              for (j = 0; j < n; j++)
+                {
+                  cplx_div_eq_d (H (i, j), f);
+                  cplx_mul_eq_d (H (j, i), f);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compute the eigenvalues of the n x n upper Hessenberg matrix h
+ * by means of the single shift QR iteration.
+ *
+ * Each sweep is carried out with Givens rotations on the active block
+ * only, and requires \f$O(n^2)\f$ operations, since the Hessenberg structure
+ * is preserved along the iterations. The matrix is overwritten.
+ *
+ * @return true if all the eigenvalues have been computed, false if the
+ * iteration failed to converge.
+ */
+static mps_boolean
+mps_companion_hessenberg_qr (cplx_t * h, int n, cplx_t * eigenvalues)
+{
+  int hi = n - 1, lo, k, j, its = 0;
+  double tst, * c = double_valloc (n);
+  cplx_t * s = cplx_valloc (n);
+  cplx_t mu, p, disc, bc, x, y, t, cs;
+  double r;
+
+  while (hi >= 0)
+    {
+      /* Look for a negligible subdiagonal element */
+      for (lo = hi; lo > 0; lo--)
+        {
+          tst = mps_cplx_abs1 (H (lo, lo)) + mps_cplx_abs1 (H (lo - 1, lo - 1));
+          if (mps_cplx_abs1 (H (lo, lo - 1)) <= DBL_EPSILON * tst ||
+              mps_cplx_abs1 (H (lo, lo - 1)) < DBL_MIN)
+            {
+              cplx_set (H (lo, lo - 1), cplx_zero);
+              break;
+            }
+        }
+
+      if (lo == hi)
+        {
+          cplx_set (eigenvalues[hi], H (hi, hi));
+          hi--;
+          its = 0;
+          continue;
+        }
+
+      if (++its > MPS_COMPANION_MAX_ITERATIONS)
+        {
+          free (c);
+          cplx_vfree (s);
+          return false;
+        }
+
+      /* Choose the shift: the eigenvalue of the trailing 2 x 2 block that
+       * is nearer to the last diagonal element, or an exceptional one
+       * if the iteration does not seem to converge. */
+      if (its % 10 == 0)
+        {
+          cplx_set_d (mu, 0.75 * fabs (cplx_Re (H (hi, hi - 1))), 0.0);
+          cplx_add_eq (mu, H (hi, hi));
+        }
+      else
+        {
+          cplx_sub (p, H (hi - 1, hi - 1), H (hi, hi));
+          cplx_div_eq_d (p, 2.0);
+          cplx_mul (bc, H (hi - 1, hi), H (hi, hi - 1));
+          cplx_sqr (disc, p);
+          cplx_add_eq (disc, bc);
+          mps_cplx_sqrt (disc, disc);
+
+          if (cplx_Re (p) * cplx_Re (disc) + cplx_Im (p) * cplx_Im (disc) < 0)
+            cplx_neg_eq (disc);
+
+          cplx_add_eq (p, disc);
+          cplx_set (mu, H (hi, hi));
+          if (!cplx_eq_zero (p))
+            {
+              cplx_div_eq (bc, p);
+              cplx_sub_eq (mu, bc);
+            }
+        }
+
+      for (k = lo; k <= hi; k++)
+        cplx_sub_eq (H (k, k), mu);
+
+      /* QR factorization of the shifted block ... */
+      for (k = lo; k < hi; k++)
+        {
+          r = hypot (cplx_mod (H (k, k)), cplx_mod (H (k + 1, k)));
+
+          if (r == 0.0)
+            {
+              c[k] = 1.0;
+              cplx_set (s[k], cplx_zero);
+              continue;
+            }
+
+          if (cplx_eq_zero (H (k, k)))
+            {
+              c[k] = 0.0;
+              cplx_set (s[k], cplx_one);
+            }
+          else
+            {
+              c[k] = cplx_mod (H (k, k)) / r;
+              cplx_con (s[k], H (k + 1, k));
+              cplx_mul_eq (s[k], H (k, k));
+              cplx_div_eq_d (s[k], cplx_mod (H (k, k)) * r);
+            }
+
+          for (j = k; j <= hi; j++)
+            {
+              cplx_set (x, H (k, j));
+              cplx_set (y, H (k + 1, j));
+
+              cplx_mul (t, s[k], y);
+              cplx_mul_d (H (k, j), x, c[k]);
+              cplx_add_eq (H (k, j), t);
+
+              cplx_con (cs, s[k]);
+              cplx_mul (t, cs, x);
+              cplx_mul_d (H (k + 1, j), y, c[k]);
+              cplx_sub_eq (H (k + 1, j), t);
+            }
+        }
+
+      /* ... and the product RQ, that is again upper Hessenberg. */
+      for (k = lo; k < hi; k++)
+        {
+          cplx_con (cs, s[k]);
+          for (j = lo; j <= MIN (k + 1, hi); j++)
+            {
+              cplx_set (x, H (j, k));
+              cplx_set (y, H (j, k + 1));
+
+              cplx_mul (t, y, cs);
+              cplx_mul_d (H (j, k), x, c[k]);
+              cplx_add_eq (H (j, k), t);
+
+              cplx_mul (t, x, s[k]);
+              cplx_mul_d (H (j, k + 1), y, c[k]);
+              cplx_sub_eq (H (j, k + 1), t);
+            }
+        }
+
+      for (k = lo; k <= hi; k++)
+        cplx_add_eq (H (k, k), mu);
+    }
+
+  free (c);
+  cplx_vfree (s);
+
+  return true;
+}
+
+/**
+ * @brief Load the coefficients of poly in DPE, normalized so that the
+ * leading one is 1 and that the roots have moduli close to 1.
+ *
+ * @param ctx The current mps_context.
+ * @param poly The polynomial, either a monomial or a Chebyshev one.
+ * @param coeffs The vector where the <code>degree</code> normalized
+ * coefficients of lower degree will be stored.
+ * @param scale The exponent k such that the roots of the normalized
+ * polynomial are the roots of poly multiplied by \f$2^{-k}\f$.
+ *
+ * @return false if the polynomial does not expose its coefficients or if
+ * they cannot be represented in double precision after the scaling.
+ */
+static mps_boolean
+mps_companion_normalized_coefficients (mps_context * ctx, mps_polynomial * poly,
+                                       cplx_t * coeffs, long int * scale)
+{
+  int i, lo, n = poly->degree;
+  mpc_t * mfpc;
+  cdpe_t * dpc;
+  cdpe_t lc;
+  rdpe_t m_lo, m_n, m;
+  mps_boolean success = true;
+
+  *scale = 0;
+
+  if (MPS_IS_MONOMIAL_POLY (poly))
+    mfpc = MPS_MONOMIAL_POLY (poly)->mfpc;
+  else if (MPS_IS_CHEBYSHEV_POLY (poly))
+    mfpc = MPS_CHEBYSHEV_POLY (poly)->mfpc;
+  else
+    return false;
+
+  dpc = cdpe_valloc (n + 1);
+  for (i = 0; i <= n; i++)
+    mpc_get_cdpe (dpc[i], mfpc[i]);
+
+  if (cdpe_eq_zero (dpc[n]))
+    {
+      cdpe_vfree (dpc);
+      return false;
+    }
+
+  cdpe_set (lc, dpc[n]);
+
+  if (MPS_IS_MONOMIAL_POLY (poly))
+    {
+      /* Scale the variable by a power of two close to the geometric mean
+       * of the moduli of the non zero roots. */
+      for (lo = 0; lo < n && cdpe_eq_zero (dpc[lo]); lo++)
+        ;
+
+      if (lo < n)
+        {
+          cdpe_mod (m_lo, dpc[lo]);
+          cdpe_mod (m_n, dpc[n]);
+          *scale = (long int) floor ((rdpe_log (m_lo) - rdpe_log (m_n)) /
+                                     ((n - lo) * LOG2) + 0.5);
+        }
+
+      for (i = 0; i < n; i++)
+        {
+          cdpe_div_eq (dpc[i], lc);
+          if (*scale > 0)
+            cdpe_div_eq_2exp (dpc[i], (unsigned long int) (*scale) * (n - i));
+          else
+            cdpe_mul_eq_2exp (dpc[i], (unsigned long int) (-*scale) * (n - i));
+        }
+    }
+  else
+    {
+      /* The last row of the colleague matrix contains the coefficients
+       * divided by twice the leading one. */
+      cdpe_mul_eq_d (lc, 2.0);
+      for (i = 0; i < n; i++)
+        cdpe_div_eq (dpc[i], lc);
+    }
+
+  for (i = 0; i < n && success; i++)
+    {
+      cdpe_mod (m, dpc[i]);
+
+      if (rdpe_eq_zero (m) || rdpe_Esp (m) < DBL_MIN_EXP + 53)
+        cplx_set (coeffs[i], cplx_zero);
+      else if (rdpe_Esp (m) > DBL_MAX_EXP - 53)
+        success = false;
+      else
+        cdpe_get_x (coeffs[i], dpc[i]);
+    }
+
+  cdpe_vfree (dpc);
+
+  return success;
+}
+
+/**
+ * @brief Compute the roots of poly as the eigenvalues of its companion
+ * matrix (or of the colleague matrix for polynomials in the Chebyshev
+ * basis), after balancing.
+ *
+ * @param ctx The current mps_context.
+ * @param poly The polynomial whose roots should be approximated.
+ * @param roots The vector where the roots will be stored.
+ *
+ * @return true if the roots have been computed, false if this strategy is
+ * not applicable to poly, and the default one should be used instead.
+ */
+static mps_boolean
+mps_companion_roots (mps_context * ctx, mps_polynomial * poly, cdpe_t * roots)
+{
+  int i, j, n = poly->degree;
+  long int scale;
+  cplx_t * h, * coeffs, * eigenvalues, delta;
+  double m;
+  mps_boolean success;
+
+  if (n < 1 || n > MPS_COMPANION_STARTING_MAX_DEGREE)
+    return false;
+
+#ifndef DISABLE_DEBUG
+  clock_t * companion_start_timer = mps_start_timer ();
+#endif
+
+  coeffs = cplx_valloc (n);
+  if (!mps_companion_normalized_coefficients (ctx, poly, coeffs, &scale))
+    {
+      cplx_vfree (coeffs);
+      return false;
+    }
+
+  h = cplx_valloc (n * n);
+  eigenvalues = cplx_valloc (n);
+
+  for (i = 0; i < n * n; i++)
+    cplx_set (h[i], cplx_zero);
+
+  if (MPS_IS_MONOMIAL_POLY (poly))
+    {
+      for (j = 0; j < n; j++)
+        cplx_neg (H (0, j), coeffs[n - 1 - j]);
+      for (i = 1; i < n; i++)
+        cplx_set (H (i, i - 1), cplx_one);
+    }
+  else
+    {
+      /* Transpose of the colleague matrix, that is upper Hessenberg. */
+      for (i = 1; i < n; i++)
+        {
+          cplx_set_d (H (i, i - 1), (i == 1) ? 1.0 : 0.5, 0.0);
+          cplx_set_d (H (i - 1, i), 0.5, 0.0);
+        }
+      for (i = 0; i < n; i++)
+        cplx_sub_eq (H (i, n - 1), coeffs[i]);
+    }
+
+  mps_companion_balance (h, n);
+  success = mps_companion_hessenberg_qr (h, n, eigenvalues);
+
+  if (success)
+    {
+      /* Coincident starting points would break the Aberth correction,
+       * so move them apart by a few ulps. */
+      for (i = 1; i < n; i++)
+        for (j = 0; j < i; j++)
+          if (cplx_eq (eigenvalues[i], eigenvalues[j]))
+            {
+              m = 4 * DBL_EPSILON * MAX (cplx_mod (eigenvalues[i]), 1.0) * (i + 1);
+              cplx_set_d (delta, m * cos (2 * PI * i / n), m * sin (2 * PI * i / n));
+              cplx_add_eq (eigenvalues[i], delta);
+            }
+
+      for (i = 0; i < n; i++)
+        {
+          cdpe_set_x (roots[i], eigenvalues[i]);
+          if (scale > 0)
+            cdpe_mul_eq_2exp (roots[i], (unsigned long int) scale);
+          else
+            cdpe_div_eq_2exp (roots[i], (unsigned long int) -scale);
+        }
+    }
+  else
+    MPS_DEBUG_WITH_INFO (ctx, "The QR iteration on the companion matrix did not converge");
+
+  cplx_vfree (h);
+  cplx_vfree (coeffs);
+  cplx_vfree (eigenvalues);
+
+#ifndef DISABLE_DEBUG
+  long int total_time = mps_stop_timer (companion_start_timer);
+  if (ctx->debug_level & MPS_DEBUG_TIMINGS)
+    MPS_DEBUG (ctx, "Used %ld ms for the companion starting strategy",
+               total_time);
+#endif
+
+  return success;
+}
+
+/**
+ * @brief Select the starting points for the polynomial as the eigenvalues
+ * of its balanced companion (or colleague) matrix, computed in floating
+ * point.
+ *
+ * If the polynomial is not a monomial or a Chebyshev one, if its degree
+ * exceeds MPS_COMPANION_STARTING_MAX_DEGREE, or if the eigenvalues cannot be
+ * represented as doubles, the default starting points are used.
+ *
+ * @param ctx The current mps_context.
+ * @param poly The polynomial whose roots should be approximated.
+ * @param approximations The approximations that will be set.
+ */
+void
+mps_companion_fstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations)
+{
+  MPS_DEBUG_THIS_CALL (ctx);
+
+  int i, n = poly->degree;
+  cdpe_t * roots = cdpe_valloc (MAX (n, 1));
+  mps_boolean representable = mps_companion_roots (ctx, poly, roots);
+  rdpe_t m;
+
+  for (i = 0; i < n && representable; i++)
+    {
+      cdpe_mod (m, roots[i]);
+      if (!rdpe_eq_zero (m) && (rdpe_Esp (m) < DBL_MIN_EXP || rdpe_Esp (m) > DBL_MAX_EXP))
+        representable = false;
+    }
+
+  if (representable)
+    for (i = 0; i < n; i++)
+      cdpe_get_x (approximations[i]->fvalue, roots[i]);
+  else
+    {
+      MPS_DEBUG_WITH_INFO (ctx, "Falling back to the default starting points");
+      (*poly->fstart)(ctx, poly, approximations);
+    }
+
+  cdpe_vfree (roots);
+}
+
+/**
+ * @brief Select the starting points for the polynomial as the eigenvalues
+ * of its balanced companion (or colleague) matrix, and store them in DPE.
+ *
+ * @param ctx The current mps_context.
+ * @param poly The polynomial whose roots should be approximated.
+ * @param approximations The approximations that will be set.
+ */
+void
+mps_companion_dstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations)
+{
+  MPS_DEBUG_THIS_CALL (ctx);
+
+  int i, n = poly->degree;
+  cdpe_t * roots = cdpe_valloc (MAX (n, 1));
+
+  if (mps_companion_roots (ctx, poly, roots))
+    for (i = 0; i < n; i++)
+      cdpe_set (approximations[i]->dvalue, roots[i]);
+  else
+    {
+      MPS_DEBUG_WITH_INFO (ctx, "Falling back to the default starting points");
+      (*poly->dstart)(ctx, poly, approximations);
+    }
+
+  cdpe_vfree (roots);
+}
+
+/**
+ * @brief Select the starting points for the polynomial as the eigenvalues
+ * of its balanced companion (or colleague) matrix, and store them in
+ * multiprecision.
+ *
+ * @param ctx The current mps_context.
+ * @param poly The polynomial whose roots should be approximated.
+ * @param approximations The approximations that will be set.
+ */
+void
+mps_companion_mstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations)
+{
+  MPS_DEBUG_THIS_CALL (ctx);
+
+  int i, n = poly->degree;
+  cdpe_t * roots = cdpe_valloc (MAX (n, 1));
+
+  if (mps_companion_roots (ctx, poly, roots))
+    for (i = 0; i < n; i++)
+      mpc_set_cdpe (approximations[i]->mvalue, roots[i]);
+  else
+    {
+      MPS_DEBUG_WITH_INFO (ctx, "Falling back to the default starting points");
+      (*poly->mstart)(ctx, poly, approximations);
+    }
+
+  cdpe_vfree (roots);
+}
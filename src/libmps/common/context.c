@@ -51,6 +51,8 @@ mps_context_get_degree (mps_context * s)
  * - MPS_ALGORITHM_STANDARD_MPSOLVE for the standard MPSolve algorithm;
  * - MPS_ALGORITHM_SECULAR_GA for the algorithm based on coefficient regeneration
  *   applied to secular equations;
+ * - MPS_ALGORITHM_AUTO to let MPSolve choose one of the above, and its tuning,
+ *   from the features of the input.
  */
 void
 mps_context_select_algorithm (mps_context * s, mps_algorithm algorithm)
@@ -67,6 +69,10 @@ mps_context_select_algorithm (mps_context * s, mps_algorithm algorithm)
     case MPS_ALGORITHM_SECULAR_GA:
       s->mpsolve_ptr = MPS_MPSOLVE_PTR (mps_secular_ga_mpsolve);
       break;
+
+    case MPS_ALGORITHM_AUTO:
+      s->mpsolve_ptr = MPS_MPSOLVE_PTR (mps_auto_mpsolve);
+      break;
     }
 }
 
@@ -92,6 +98,7 @@ mps_context_init (mps_context * s)
   /* Allocate space for the configurations */
   s->input_config = (mps_input_configuration*)mps_malloc (sizeof(mps_input_configuration));
   s->output_config = (mps_output_configuration*)mps_malloc (sizeof(mps_output_configuration));
+  s->auto_calibration = mps_new (mps_auto_calibration);
 
   mps_set_default_values (s);
 
@@ -173,6 +180,19 @@ mps_context_free (mps_context * s)
   free (s->bmpc);
   s->bmpc = NULL;
 
+  /* Checkpoints refer to a single computation, so they should not
+   * be inherited by a recycled context. */
+  free (s->checkpoint_file);
+  free (s->resume_file);
+  s->checkpoint_file = s->resume_file = NULL;
+
+  /* The event queue belongs to the caller. */
+  mps_events_free (s);
+  s->event_queue = NULL;
+
+  /* The same holds for a calibration loaded from a file. */
+  mps_auto_calibration_set_defaults (s->auto_calibration);
+
   pthread_mutex_lock (&context_factory_mutex);
 
   if (context_factory_size < MPS_CONTEXT_FACTORY_MAXIMUM_SIZE)
@@ -192,6 +212,7 @@ mps_context_free (mps_context * s)
 
   free (s->input_config);
   free (s->output_config);
+  free (s->auto_calibration);
 
   s->active_poly = NULL;
 
@@ -386,6 +407,10 @@ mps_context_set_input_poly (mps_context * s, mps_polynomial * p)
         }
     }
 
+  /* Look for a structure that allows to solve a polynomial of
+   * lower degree, that is used if exploit_symmetry is set. */
+  mps_symmetry_detect (s, p);
+
   mps_context_set_degree (s, p->degree);
 }
 
@@ -691,6 +716,89 @@ mps_context_set_jacobi_iterations (mps_context * s, mps_boolean jacobi_iteration
   s->jacobi_iterations = jacobi_iterations;
 }
 
+/**
+ * @brief Set the value of the block iterations switch in the MPSolve context.
+ *
+ * If block_iterations is true then the roots are split in blocks of
+ * MPS_ABERTH_BLOCK_SIZE consecutive approximations, each one iterated
+ * by a single thread in Gauss-Seidel style. The approximations of the
+ * other blocks are only exchanged between the iterations, so the
+ * result does not depend on the number of threads. This switch is
+ * ignored if Jacobi-style iterations have been selected with
+ * mps_context_set_jacobi_iterations().
+ *
+ * @param s The mps_context where the value will be set
+ * @param block_iterations The desired value for the block_iterations switch.
+ */
+void
+mps_context_set_block_iterations (mps_context * s, mps_boolean block_iterations)
+{
+  s->block_iterations = block_iterations;
+}
+
+/**
+ * @brief Set the value of the square-free switch in the MPSolve context.
+ *
+ * If square_free is true and the input is a monomial polynomial with
+ * exact integer or rational real coefficients, it is split in its
+ * square-free factors before the computation. The factors, that only
+ * have simple roots, are solved independently and their roots are
+ * reported with the multiplicity of the factor, with status
+ * MPS_ROOT_STATUS_MULTIPLE when this is larger than one.
+ *
+ * @param s The mps_context where the value will be set
+ * @param square_free The desired value for the square_free switch.
+ */
+void
+mps_context_set_square_free (mps_context * s, mps_boolean square_free)
+{
+  s->square_free = square_free;
+}
+
+/**
+ * @brief Set the value of the symmetry switch in the MPSolve context.
+ *
+ * If exploit_symmetry is true and the input is a monomial polynomial
+ * with exact coefficients that is a polynomial in \f$x^k\f$, or is
+ * palindromic or anti-palindromic, a polynomial of lower degree is
+ * solved in its place, and its roots are mapped back to the ones of the
+ * input. This is only done when the goal is approximating all the roots.
+ *
+ * @param s The mps_context where the value will be set
+ * @param exploit_symmetry The desired value for the symmetry switch.
+ */
+void
+mps_context_set_exploit_symmetry (mps_context * s, mps_boolean exploit_symmetry)
+{
+  s->exploit_symmetry = exploit_symmetry;
+}
+
+/**
+ * @brief Configure s to solve a polynomial derived from the one of
+ * source, with the same options.
+ *
+ * The threads of the pool of s are not changed.
+ *
+ * @param s The mps_context to configure.
+ * @param source The mps_context whose options are copied.
+ */
+void
+mps_context_copy_options (mps_context * s, mps_context * source)
+{
+  mps_context_select_algorithm (s, source->algorithm);
+  mps_context_select_starting_strategy (s, source->starting_strategy);
+  mps_context_set_output_prec (s, source->output_config->prec);
+  mps_context_set_output_goal (s, source->output_config->goal);
+  mps_context_set_starting_phase (s, source->input_config->starting_phase);
+  mps_context_set_jacobi_iterations (s, source->jacobi_iterations);
+  mps_context_set_block_iterations (s, source->block_iterations);
+  mps_context_set_square_free (s, source->square_free);
+  mps_context_set_exploit_symmetry (s, source->exploit_symmetry);
+  mps_context_set_avoid_multiprecision (s, source->avoid_multiprecision);
+  mps_context_set_crude_approximation_mode (s, source->crude_approximation_mode);
+  s->output_config->search_set = source->output_config->search_set;
+}
+
 
 /**
  * @brief Set the debug level in MPSolve.
@@ -785,6 +893,23 @@ mps_context_get_zero_roots (mps_context * s)
   return s->zero_roots;
 }
 
+/**
+ * @brief Get the symmetry detected in the input polynomial by
+ * mps_context_set_input_poly().
+ *
+ * @param s The <code>mps_context</code> of the current computation.
+ * @param power If not NULL, the largest k such that the input
+ * polynomial is a polynomial in \f$x^k\f$ is stored here.
+ */
+mps_symmetry
+mps_context_get_symmetry (mps_context * s, int * power)
+{
+  if (power)
+    *power = s->symmetry_power;
+
+  return s->symmetry;
+}
+
 /**
  * @brief Return true of the computation has passed the maximum
  * admitted precision, and so was unable to reach desired output
@@ -904,3 +1029,116 @@ mps_context_set_regeneration_driver (mps_context * s, mps_regeneration_driver *
 {
   s->regeneration_driver = rd;
 }
+
+/**
+ * @brief Save the state of the computation in a checkpoint file.
+ *
+ * When a checkpoint file is set the secular algorithm writes its state
+ * (approximations, clusterization, coefficients of the secular equation,
+ * phase and working precision) to <code>filename</code> at the end of every
+ * packet of iterations. The computation can then be continued from the last
+ * saved state with <code>mps_context_set_resume_file()</code>.
+ *
+ * @param s The context where the change will have effect.
+ * @param filename The path of the checkpoint, or NULL to disable checkpoints.
+ */
+void
+mps_context_set_checkpoint_file (mps_context * s, const char * filename)
+{
+  free (s->checkpoint_file);
+  s->checkpoint_file = filename ? strdup (filename) : NULL;
+}
+
+/**
+ * @brief Resume the computation from a checkpoint file.
+ *
+ * The checkpoint must have been saved while solving the same equation
+ * with the secular algorithm. The computation restarts from the saved
+ * phase and working precision, without repeating the previous ones.
+ *
+ * @param s The context where the change will have effect.
+ * @param filename The path of the checkpoint, or NULL to start from scratch.
+ */
+void
+mps_context_set_resume_file (mps_context * s, const char * filename)
+{
+  free (s->resume_file);
+  s->resume_file = filename ? strdup (filename) : NULL;
+}
+
+/**
+ * @brief Pin the threads used by the context to the cores of the machine.
+ *
+ * Pinning the threads avoids their migration between the cores, and between
+ * the sockets of NUMA machines, during the computation.
+ * MPS_THREAD_AFFINITY_COMPACT fills the cores of a socket before moving to
+ * the next one, MPS_THREAD_AFFINITY_SCATTER distributes the threads across
+ * the sockets and the physical cores, and MPS_THREAD_AFFINITY_LIST pins the
+ * threads, in order, on the cores given in <code>cores</code>.
+ *
+ * @param s The context where the change will have effect.
+ * @param affinity The pinning policy, or MPS_THREAD_AFFINITY_NONE to let the
+ * operating system schedule the threads.
+ * @param cores The list of cores used by MPS_THREAD_AFFINITY_LIST, ignored
+ * by the other policies.
+ * @param n_cores The length of <code>cores</code>.
+ */
+void
+mps_context_set_thread_affinity (mps_context * s, mps_thread_affinity affinity,
+                                 const int * cores, int n_cores)
+{
+  mps_thread_pool_set_affinity (s, s->pool, affinity, cores, n_cores);
+}
+
+/**
+ * @brief Share the computation among the processes of an MPI job.
+ *
+ * MPSolve must have been built with MPI support, and MPI must be
+ * initialized by the caller before calling this function. All the processes
+ * must then solve the same polynomial with the same options, calling
+ * mps_mpsolve() on their context. With the secular algorithm every process
+ * iterates only on a slice of the approximations and regenerates the
+ * coefficients of the secular equation only on the corresponding nodes;
+ * the results are exchanged at the end of every packet, so that the
+ * approximated roots are available on all the processes at the end of the
+ * computation. The other algorithms are not distributed, and perform the
+ * whole computation on every process.
+ *
+ * @param s The context where the change will have effect.
+ * @param distributed true to distribute the computation, false to perform
+ * it entirely in this process.
+ */
+void
+mps_context_set_distributed (mps_context * s, mps_boolean distributed)
+{
+  if (distributed && !mps_distributed_setup (s))
+    return;
+
+  s->distributed = distributed;
+  if (!distributed)
+    {
+      s->distributed_rank = 0;
+      s->distributed_size = 1;
+    }
+}
+
+/**
+ * @brief Load the thresholds used by MPS_ALGORITHM_AUTO from a file.
+ *
+ * The file is made of lines <code>key = value</code>, where the keys are
+ * the fields of mps_auto_calibration. Keys that are not given keep their
+ * default value. A calibration file for a given machine can be generated
+ * running <code>tools/mps-calibrate-auto.py</code> on a set of benchmarks.
+ *
+ * @param s The context where the change will have effect.
+ * @param filename The path of the calibration file, or NULL to restore the
+ * default thresholds.
+ */
+void
+mps_context_set_auto_calibration_file (mps_context * s, const char * filename)
+{
+  mps_auto_calibration_set_defaults (s->auto_calibration);
+
+  if (filename && !mps_auto_calibration_load (s, s->auto_calibration, filename))
+    mps_auto_calibration_set_defaults (s->auto_calibration);
+}
@@ -35,12 +35,23 @@ mps_set_default_values (mps_context * s)
   s->outstr = stdout;             /* output stream                       */
   s->logstr = stderr;             /* log stream                          */
   s->rtstr = NULL;              /* root stream                         */
+  s->checkpoint_file = NULL;    /* file where the state is saved      */
+  s->resume_file = NULL;        /* checkpoint to resume from           */
+  s->event_queue = NULL;        /* queue where progress is reported    */
+  s->event_status = NULL;
+  s->event_status_size = 0;
+  s->event_packets = 0;
 
   /* constants/parameters */
   s->max_pack = 100000;           /* number of max packets of iterations */
   s->max_it = 20;                /* number of max iterations per packet */
   s->max_newt_it = 15;           /* number of max newton iterations for */
   s->jacobi_iterations = false;
+  s->block_iterations = false;
+  s->square_free = false;
+  s->exploit_symmetry = false;
+  s->symmetry = MPS_SYMMETRY_NONE;
+  s->symmetry_power = 1;
 
   /* Set number of threads to 1.5 * number_of_cores, if this is
    * computable. Set it to 12 otherwise.                     */
@@ -97,9 +108,16 @@ mps_set_default_values (mps_context * s)
   s->mpsolve_ptr = MPS_MPSOLVE_PTR (mps_standard_mpsolve);
   s->algorithm = MPS_ALGORITHM_STANDARD_MPSOLVE;
   s->starting_strategy = MPS_STARTING_STRATEGY_DEFAULT;
+  mps_auto_calibration_set_defaults (s->auto_calibration);
 
   /* Allocate the thread_pool used in computations. */
   s->pool = mps_thread_pool_new (s, 0);
+  s->workspace = NULL;
+
+  /* Computations are not distributed unless requested */
+  s->distributed = false;
+  s->distributed_rank = 0;
+  s->distributed_size = 1;
 
   /* Callbacks for async version */
   s->callback = NULL;
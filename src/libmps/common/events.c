@@ -0,0 +1,425 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Report of the progress of the computation through a queue of
+ * events.
+ *
+ * At the end of every packet of iterations the solver compares the status
+ * of each root with the last one reported, and pushes an event for the
+ * roots that have been isolated or approximated in the meantime. The events
+ * are stored in a bounded queue in the style of the one by D. Vyukov:
+ * every cell carries a sequence number that tells producers and consumers
+ * whether it can be written or read, so that only the reservation of a
+ * position requires an atomic operation.
+ */
+
+#include <mps/mps.h>
+#include <string.h>
+
+/*! @cond PRIVATE */
+struct mps_event_queue_cell {
+  volatile unsigned long sequence;
+  mps_event event;
+};
+/*! @endcond */
+
+static inline unsigned long
+mps_event_queue_load (volatile unsigned long * ptr)
+{
+  unsigned long value = *ptr;
+
+  __sync_synchronize ();
+  return value;
+}
+
+static inline void
+mps_event_queue_store (volatile unsigned long * ptr, unsigned long value)
+{
+  __sync_synchronize ();
+  *ptr = value;
+}
+
+/**
+ * @brief Create a new queue of events.
+ *
+ * @param capacity The maximum number of events that can be waiting to
+ * be consumed, rounded up to the next power of 2. To receive the events
+ * of all the roots even if they are consumed only at the end of the
+ * computation this should be larger than twice the degree.
+ * @return A new mps_event_queue, that should be freed with
+ * mps_event_queue_free().
+ */
+mps_event_queue *
+mps_event_queue_new (int capacity)
+{
+  mps_event_queue * queue = mps_new (mps_event_queue);
+  unsigned long size = 2, i;
+
+  while (size < (unsigned long) capacity)
+    size <<= 1;
+
+  queue->cells = mps_newv (struct mps_event_queue_cell, size);
+  queue->mask = size - 1;
+
+  for (i = 0; i < size; i++)
+    queue->cells[i].sequence = i;
+
+  queue->push_position = 0;
+  queue->pop_position = 0;
+  queue->dropped = 0;
+  queue->producers = 0;
+
+  return queue;
+}
+
+/**
+ * @brief Free a queue of events. No computation should be using it anymore.
+ */
+void
+mps_event_queue_free (mps_event_queue * queue)
+{
+  free (queue->cells);
+  free (queue);
+}
+
+/**
+ * @brief Push an event in the queue.
+ *
+ * @return false if the queue is full, in which case the event is discarded.
+ */
+static mps_boolean
+mps_event_queue_push (mps_event_queue * queue, const mps_event * event)
+{
+  struct mps_event_queue_cell * cell;
+  unsigned long position = mps_event_queue_load (&queue->push_position);
+
+  for (;;)
+    {
+      long int diff;
+
+      cell = queue->cells + (position & queue->mask);
+      diff = (long int) mps_event_queue_load (&cell->sequence) - (long int) position;
+
+      if (diff == 0)
+        {
+          if (__sync_bool_compare_and_swap (&queue->push_position, position, position + 1))
+            break;
+          position = mps_event_queue_load (&queue->push_position);
+        }
+      else if (diff < 0)
+        return false;
+      else
+        position = mps_event_queue_load (&queue->push_position);
+    }
+
+  cell->event = *event;
+  mps_event_queue_store (&cell->sequence, position + 1);
+
+  return true;
+}
+
+/**
+ * @brief Take the oldest event from the queue. This can be called from any
+ * thread, also concurrently with other consumers.
+ *
+ * @param queue The queue to read.
+ * @param event The mps_event where the event will be copied.
+ * @return true if an event has been found, false if the queue was empty.
+ */
+mps_boolean
+mps_event_queue_pop (mps_event_queue * queue, mps_event * event)
+{
+  struct mps_event_queue_cell * cell;
+  unsigned long position = mps_event_queue_load (&queue->pop_position);
+
+  for (;;)
+    {
+      long int diff;
+
+      cell = queue->cells + (position & queue->mask);
+      diff = (long int) mps_event_queue_load (&cell->sequence) - (long int) (position + 1);
+
+      if (diff == 0)
+        {
+          if (__sync_bool_compare_and_swap (&queue->pop_position, position, position + 1))
+            break;
+          position = mps_event_queue_load (&queue->pop_position);
+        }
+      else if (diff < 0)
+        return false;
+      else
+        position = mps_event_queue_load (&queue->pop_position);
+    }
+
+  *event = cell->event;
+  mps_event_queue_store (&cell->sequence, position + queue->mask + 1);
+
+  return true;
+}
+
+/**
+ * @brief Take up to max_events events from the queue.
+ *
+ * @return The number of events copied in events.
+ */
+int
+mps_event_queue_drain (mps_event_queue * queue, mps_event * events, int max_events)
+{
+  int n = 0;
+
+  while (n < max_events && mps_event_queue_pop (queue, events + n))
+    n++;
+
+  return n;
+}
+
+/**
+ * @brief Check if all the computations reporting to this queue have
+ * terminated and all their events have been consumed.
+ *
+ * Since mps_mpsolve_async() registers the computation before returning,
+ * a consumer can safely wait for this condition after starting it.
+ */
+mps_boolean
+mps_event_queue_is_finished (mps_event_queue * queue)
+{
+  unsigned long pop_position, push_position;
+
+  if (__sync_fetch_and_add (&queue->producers, 0) > 0)
+    return false;
+
+  pop_position = mps_event_queue_load (&queue->pop_position);
+  push_position = mps_event_queue_load (&queue->push_position);
+
+  return pop_position == push_position;
+}
+
+/**
+ * @brief Number of events that have been discarded because the queue was
+ * full. Events about the roots are delayed to the next packet instead of
+ * being discarded, unless the computation has terminated.
+ */
+long int
+mps_event_queue_get_dropped (mps_event_queue * queue)
+{
+  return __sync_fetch_and_add (&queue->dropped, 0);
+}
+
+/**
+ * @brief Report the progress of the following computations on s to queue.
+ *
+ * The queue is not owned by the context and can be shared among many of
+ * them, so it should be freed by the caller once all the computations have
+ * terminated.
+ *
+ * @param s The current mps_context.
+ * @param queue The mps_event_queue that will receive the events, or NULL
+ * to disable them.
+ */
+void
+mps_context_set_event_queue (mps_context * s, mps_event_queue * queue)
+{
+  s->event_queue = queue;
+}
+
+/**
+ * @brief Fill the part of event that describes the state of the computation.
+ */
+static void
+mps_events_init_event (mps_context * s, mps_event * event, mps_event_type type)
+{
+  memset (event, 0, sizeof(mps_event));
+
+  event->type = type;
+  event->ctx = s;
+  event->packet = s->event_packets;
+  event->root = -1;
+  event->phase = s->lastphase;
+  event->wp = s->mpwp;
+
+  cdpe_set (event->value, cdpe_zero);
+  rdpe_set (event->radius, rdpe_zero);
+}
+
+/**
+ * @brief Store in event the current approximation of the i-th root.
+ */
+static void
+mps_events_set_root (mps_context * s, mps_event * event, int i)
+{
+  mps_approximation * root = s->root[i];
+
+  event->root = i;
+
+  switch (s->lastphase)
+    {
+    case float_phase:
+      cdpe_set_x (event->value, root->fvalue);
+      rdpe_set_d (event->radius, root->frad);
+      break;
+
+    case dpe_phase:
+      cdpe_set (event->value, root->dvalue);
+      rdpe_set (event->radius, root->drad);
+      break;
+
+    default:
+      mpc_get_cdpe (event->value, root->mvalue);
+      rdpe_set (event->radius, root->drad);
+      break;
+    }
+}
+
+/**
+ * @brief Push an event for each root whose status has improved since the
+ * last call, and count the isolated and approximated ones.
+ *
+ * If the queue is full the status of the root is not updated, so that
+ * the event is sent again the next time.
+ */
+static void
+mps_events_update_roots (mps_context * s, int * isolated, int * approximated)
+{
+  mps_event event;
+  int i;
+
+  /* The approximations do not exist if the computation failed before
+   * allocating them. */
+  int n = s->initialized ? s->n : 0;
+
+  if (s->event_status_size != n)
+    {
+      free (s->event_status);
+      s->event_status = mps_newv (mps_event_type, n);
+      s->event_status_size = n;
+
+      for (i = 0; i < n; i++)
+        s->event_status[i] = MPS_EVENT_PACKET;
+    }
+
+  *isolated = *approximated = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      mps_event_type status = MPS_EVENT_PACKET;
+
+      if (MPS_ROOT_STATUS_IS_APPROXIMATED (s->root[i]->status))
+        {
+          status = MPS_EVENT_ROOT_APPROXIMATED;
+          (*approximated)++;
+        }
+      else if (s->root[i]->status == MPS_ROOT_STATUS_ISOLATED)
+        {
+          status = MPS_EVENT_ROOT_ISOLATED;
+          (*isolated)++;
+        }
+
+      /* Only report improvements, and report only the best status reached
+       * if the root skipped a step. */
+      if (status <= s->event_status[i])
+        continue;
+
+      mps_events_init_event (s, &event, status);
+      mps_events_set_root (s, &event, i);
+
+      if (mps_event_queue_push (s->event_queue, &event))
+        s->event_status[i] = status;
+    }
+}
+
+/**
+ * @brief Register a new computation on the event queue of s, if any.
+ */
+void
+mps_events_begin (mps_context * s)
+{
+  if (!s->event_queue)
+    return;
+
+  free (s->event_status);
+  s->event_status = NULL;
+  s->event_status_size = 0;
+  s->event_packets = 0;
+
+  __sync_add_and_fetch (&s->event_queue->producers, 1);
+}
+
+/**
+ * @brief Report the end of a packet of iterations, and the roots that have
+ * been isolated or approximated during it.
+ */
+void
+mps_events_packet (mps_context * s)
+{
+  mps_event event;
+  int isolated, approximated;
+
+  if (!s->event_queue)
+    return;
+
+  s->event_packets++;
+
+  mps_events_update_roots (s, &isolated, &approximated);
+
+  mps_events_init_event (s, &event, MPS_EVENT_PACKET);
+  event.isolated = isolated;
+  event.approximated = approximated;
+
+  if (!mps_event_queue_push (s->event_queue, &event))
+    __sync_add_and_fetch (&s->event_queue->dropped, 1);
+}
+
+/**
+ * @brief Report the final status of the roots and the end of the
+ * computation, and unregister it from the queue.
+ */
+void
+mps_events_finish (mps_context * s)
+{
+  mps_event event;
+  int isolated, approximated, i;
+
+  if (!s->event_queue)
+    return;
+
+  mps_events_update_roots (s, &isolated, &approximated);
+
+  /* Events that did not fit in the queue cannot be delayed anymore. */
+  for (i = 0; i < s->event_status_size; i++)
+    {
+      if ((MPS_ROOT_STATUS_IS_APPROXIMATED (s->root[i]->status) &&
+           s->event_status[i] != MPS_EVENT_ROOT_APPROXIMATED) ||
+          (s->root[i]->status == MPS_ROOT_STATUS_ISOLATED &&
+           s->event_status[i] != MPS_EVENT_ROOT_ISOLATED))
+        __sync_add_and_fetch (&s->event_queue->dropped, 1);
+    }
+
+  mps_events_init_event (s, &event, MPS_EVENT_DONE);
+  event.isolated = isolated;
+  event.approximated = approximated;
+
+  if (!mps_event_queue_push (s->event_queue, &event))
+    __sync_add_and_fetch (&s->event_queue->dropped, 1);
+
+  __sync_sub_and_fetch (&s->event_queue->producers, 1);
+}
+
+/**
+ * @brief Free the bookkeeping of the events stored in s.
+ */
+void
+mps_events_free (mps_context * s)
+{
+  free (s->event_status);
+  s->event_status = NULL;
+  s->event_status_size = 0;
+}
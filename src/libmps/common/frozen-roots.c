@@ -0,0 +1,327 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <float.h>
+
+/**
+ * @brief Allocate a mps_frozen_roots able to handle <code>n</code>
+ * approximations.
+ */
+mps_frozen_roots *
+mps_frozen_roots_new (int n)
+{
+  mps_frozen_roots * fr = mps_new (mps_frozen_roots);
+
+  fr->n = n;
+  fr->n_active = fr->n_frozen = 0;
+
+  fr->active = mps_newv (int, n);
+  fr->schedule = mps_newv (int, n);
+  fr->frozen = mps_newv (int, n);
+
+  fr->fvalid = mps_boolean_valloc (n);
+  fr->fcenter = cplx_valloc (n);
+  fr->fsum = cplx_valloc (n);
+  fr->fdsum = cplx_valloc (n);
+  fr->fscale = double_valloc (n);
+  fr->fbound = double_valloc (n);
+  fr->fdist = double_valloc (n);
+
+  fr->dvalid = mps_boolean_valloc (n);
+  fr->dcenter = cdpe_valloc (n);
+  fr->dsum = cdpe_valloc (n);
+  fr->ddsum = cdpe_valloc (n);
+  fr->dscale = rdpe_valloc (n);
+  fr->dbound = rdpe_valloc (n);
+  fr->ddist = rdpe_valloc (n);
+
+  return fr;
+}
+
+/**
+ * @brief Free a mps_frozen_roots allocated with mps_frozen_roots_new ().
+ */
+void
+mps_frozen_roots_free (mps_frozen_roots * fr)
+{
+  if (!fr)
+    return;
+
+  free (fr->active);
+  free (fr->schedule);
+  free (fr->frozen);
+
+  free (fr->fvalid);
+  cplx_vfree (fr->fcenter);
+  cplx_vfree (fr->fsum);
+  cplx_vfree (fr->fdsum);
+  free (fr->fscale);
+  free (fr->fbound);
+  free (fr->fdist);
+
+  free (fr->dvalid);
+  cdpe_vfree (fr->dcenter);
+  cdpe_vfree (fr->dsum);
+  cdpe_vfree (fr->ddsum);
+  rdpe_vfree (fr->dscale);
+  rdpe_vfree (fr->dbound);
+  rdpe_vfree (fr->ddist);
+
+  free (fr);
+}
+
+/**
+ * @brief Split the approximations in active and frozen ones at the start
+ * of a packet, and invalidate the expansions computed in the previous one.
+ *
+ * An approximation is frozen if it will not be updated during the packet,
+ * that is if it has already reached a stop condition or if it is owned
+ * by another process.
+ *
+ * @param s The current mps_context.
+ * @param fr The partition to update.
+ */
+void
+mps_frozen_roots_update (mps_context * s, mps_frozen_roots * fr)
+{
+  mps_cluster_item * c_item;
+  mps_root * root;
+  int i;
+
+  fr->n_active = fr->n_frozen = 0;
+
+  for (i = 0; i < s->n; i++)
+    {
+      fr->fvalid[i] = fr->dvalid[i] = false;
+
+      if (s->root[i]->again && !s->root[i]->approximated && MPS_DISTRIBUTED_OWNS (s, i))
+        fr->active[fr->n_active++] = i;
+      else
+        fr->frozen[fr->n_frozen++] = i;
+    }
+
+  /* The active roots are scheduled in the same order used by the job
+   * queue on the whole clusterization. */
+  i = 0;
+  for (c_item = s->clusterization->first; c_item != NULL; c_item = c_item->next)
+    for (root = c_item->cluster->first; root != NULL; root = root->next)
+      if (s->root[root->k]->again && !s->root[root->k]->approximated &&
+          MPS_DISTRIBUTED_OWNS (s, root->k))
+        fr->schedule[i++] = root->k;
+}
+
+/**
+ * @brief Compute the floating point expansion of the frozen contribution
+ * to the Aberth sum of the j-th approximation, centered in <code>center</code>.
+ */
+static void
+mps_frozen_roots_fexpand (mps_context * s, mps_frozen_roots * fr, int j, cplx_t center)
+{
+  cplx_t z, z2;
+  double d;
+  int k;
+
+  cplx_set (fr->fcenter[j], center);
+  cplx_set (fr->fsum[j], cplx_zero);
+  cplx_set (fr->fdsum[j], cplx_zero);
+  fr->fscale[j] = fr->fbound[j] = 0.0;
+  fr->fdist[j] = DBL_MAX;
+
+  for (k = 0; k < fr->n_frozen; k++)
+    {
+      cplx_sub (z, center, s->root[fr->frozen[k]]->fvalue);
+      d = cplx_mod (z);
+      fr->fdist[j] = MIN (fr->fdist[j], d);
+
+      cplx_inv_eq (z);
+      cplx_add_eq (fr->fsum[j], z);
+      cplx_sqr (z2, z);
+      cplx_sub_eq (fr->fdsum[j], z2);
+
+      fr->fscale[j] += 1.0 / d;
+      fr->fbound[j] += 1.0 / (d * d * d);
+    }
+
+  fr->fvalid[j] = fr->fdist[j] > 0.0;
+}
+
+/**
+ * @brief Compute the Aberth sum of the j-th approximation, like
+ * mps_faberth_wl (), using the expansion of the contribution of the
+ * frozen approximations.
+ *
+ * @param s The current mps_context.
+ * @param fr The partition of the approximations of this packet.
+ * @param j The index of the approximation.
+ * @param abcorr The output value.
+ * @param aberth_mutexes The mutexes that protect the values of the
+ * active approximations.
+ */
+void
+mps_faberth_frozen_wl (mps_context * s, mps_frozen_roots * fr, int j, cplx_t abcorr,
+                       pthread_mutex_t * aberth_mutexes)
+{
+  cplx_t z, froot;
+  double d;
+  int i, k;
+
+  if (fr->n_frozen == 0)
+    {
+      mps_faberth_wl (s, j, abcorr, aberth_mutexes);
+      return;
+    }
+
+  pthread_mutex_lock (&aberth_mutexes[j]);
+  cplx_set (froot, s->root[j]->fvalue);
+  pthread_mutex_unlock (&aberth_mutexes[j]);
+
+  cplx_set (abcorr, cplx_zero);
+  for (k = 0; k < fr->n_active; k++)
+    {
+      i = fr->active[k];
+      if (i == j)
+        continue;
+
+      pthread_mutex_lock (&aberth_mutexes[i]);
+      cplx_sub (z, froot, s->root[i]->fvalue);
+      pthread_mutex_unlock (&aberth_mutexes[i]);
+
+      cplx_inv_eq (z);
+      cplx_add_eq (abcorr, z);
+    }
+
+  /* The error of the first order expansion is bounded by
+   * |z - c|^2 * fbound / (1 - |z - c| / fdist). */
+  cplx_sub (z, froot, fr->fcenter[j]);
+  d = cplx_mod (z);
+
+  if (fr->fvalid[j] && d <= 0.5 * fr->fdist[j] &&
+      2.0 * d * d * fr->fbound[j] <= MPS_FROZEN_ROOTS_TOLERANCE * fr->fscale[j])
+    {
+      cplx_mul_eq (z, fr->fdsum[j]);
+      cplx_add_eq (z, fr->fsum[j]);
+    }
+  else
+    {
+      mps_frozen_roots_fexpand (s, fr, j, froot);
+      cplx_set (z, fr->fsum[j]);
+    }
+
+  cplx_add_eq (abcorr, z);
+}
+
+/**
+ * @brief DPE version of mps_frozen_roots_fexpand ().
+ */
+static void
+mps_frozen_roots_dexpand (mps_context * s, mps_frozen_roots * fr, int j, cdpe_t center)
+{
+  cdpe_t z, z2;
+  rdpe_t d, dinv;
+  int k;
+
+  cdpe_set (fr->dcenter[j], center);
+  cdpe_set (fr->dsum[j], cdpe_zero);
+  cdpe_set (fr->ddsum[j], cdpe_zero);
+  rdpe_set (fr->dscale[j], rdpe_zero);
+  rdpe_set (fr->dbound[j], rdpe_zero);
+  rdpe_set (fr->ddist[j], RDPE_MAX);
+
+  for (k = 0; k < fr->n_frozen; k++)
+    {
+      cdpe_sub (z, center, s->root[fr->frozen[k]]->dvalue);
+      cdpe_mod (d, z);
+
+      if (rdpe_lt (d, fr->ddist[j]))
+        rdpe_set (fr->ddist[j], d);
+
+      cdpe_inv_eq (z);
+      cdpe_add_eq (fr->dsum[j], z);
+      cdpe_sqr (z2, z);
+      cdpe_sub_eq (fr->ddsum[j], z2);
+
+      rdpe_inv (dinv, d);
+      rdpe_add_eq (fr->dscale[j], dinv);
+      rdpe_pow_eq_si (dinv, 3);
+      rdpe_add_eq (fr->dbound[j], dinv);
+    }
+
+  fr->dvalid[j] = rdpe_gt (fr->ddist[j], rdpe_zero);
+}
+
+/**
+ * @brief DPE version of mps_faberth_frozen_wl ().
+ */
+void
+mps_daberth_frozen_wl (mps_context * s, mps_frozen_roots * fr, int j, cdpe_t abcorr,
+                       pthread_mutex_t * aberth_mutexes)
+{
+  cdpe_t z, droot;
+  rdpe_t d, err, tol;
+  mps_boolean use_expansion = false;
+  int i, k;
+
+  if (fr->n_frozen == 0)
+    {
+      mps_daberth_wl (s, j, abcorr, aberth_mutexes);
+      return;
+    }
+
+  pthread_mutex_lock (&aberth_mutexes[j]);
+  cdpe_set (droot, s->root[j]->dvalue);
+  pthread_mutex_unlock (&aberth_mutexes[j]);
+
+  cdpe_set (abcorr, cdpe_zero);
+  for (k = 0; k < fr->n_active; k++)
+    {
+      i = fr->active[k];
+      if (i == j)
+        continue;
+
+      pthread_mutex_lock (&aberth_mutexes[i]);
+      cdpe_sub (z, droot, s->root[i]->dvalue);
+      pthread_mutex_unlock (&aberth_mutexes[i]);
+
+      cdpe_inv_eq (z);
+      cdpe_add_eq (abcorr, z);
+    }
+
+  cdpe_sub (z, droot, fr->dcenter[j]);
+  cdpe_mod (d, z);
+
+  /* Same test of the floating point version: |z - c| <= fdist / 2 and
+   * 2 * |z - c|^2 * fbound <= tolerance * fscale. */
+  if (fr->dvalid[j])
+    {
+      rdpe_mul_d (tol, fr->ddist[j], 0.5);
+      if (rdpe_le (d, tol))
+        {
+          rdpe_sqr (err, d);
+          rdpe_mul_eq (err, fr->dbound[j]);
+          rdpe_mul_eq_d (err, 2.0);
+          rdpe_mul_d (tol, fr->dscale[j], MPS_FROZEN_ROOTS_TOLERANCE);
+          use_expansion = rdpe_le (err, tol);
+        }
+    }
+
+  if (use_expansion)
+    {
+      cdpe_mul_eq (z, fr->ddsum[j]);
+      cdpe_add_eq (z, fr->dsum[j]);
+    }
+  else
+    {
+      mps_frozen_roots_dexpand (s, fr, j, droot);
+      cdpe_set (z, fr->dsum[j]);
+    }
+
+  cdpe_add_eq (abcorr, z);
+}
@@ -69,9 +69,16 @@ mps_mpsolve (mps_context * s)
   if (mps_context_has_errors (s))
     return;
 
+  mps_events_begin (s);
   mps_preliminary_setup (s);
 
-  (*s->mpsolve_ptr)(s);
+  if (!mps_count_mpsolve (s) &&
+      !mps_small_degree_mpsolve (s) &&
+      !(s->square_free && mps_square_free_mpsolve (s)) &&
+      !(s->exploit_symmetry && mps_symmetry_mpsolve (s)))
+    (*s->mpsolve_ptr)(s);
+
+  mps_events_finish (s);
 }
 
 static void*
@@ -80,9 +87,17 @@ mps_caller (mps_context * s)
   if (!mps_context_has_errors (s))
     {
       mps_preliminary_setup (s);
-      s->mpsolve_ptr (s);
+      if (!mps_count_mpsolve (s) &&
+          !mps_small_degree_mpsolve (s) &&
+          !(s->square_free && mps_square_free_mpsolve (s)) &&
+          !(s->exploit_symmetry && mps_symmetry_mpsolve (s)))
+        s->mpsolve_ptr (s);
     }
 
+  /* The computation has been registered on the event queue by
+   * mps_mpsolve_async(), before starting this thread. */
+  mps_events_finish (s);
+
   /* Call user defined callback if available */
   if (s->callback == NULL)
     return NULL;
@@ -101,6 +116,8 @@ mps_mpsolve_async (mps_context * s, mps_callback callback, void * user_data)
   s->callback = callback;
   s->user_data = user_data;
 
+  mps_events_begin (s);
+
   mps_thread_pool * private_pool = mps_thread_pool_new (s, 1);
   mps_thread_pool_set_strict_async (private_pool, true);
   s->self_thread_pool = private_pool;
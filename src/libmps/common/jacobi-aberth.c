@@ -10,19 +10,15 @@
 
 #include <mps/mps.h>
 
-/*! @cond PRIVATE */
-struct __mps_fjacobi_aberth_step_data {
-  mps_context * ctx;
-  mps_polynomial * p;
-  mps_approximation * root;
-  cplx_t * correction;
-};
-/*! @endcond */
+/**
+ * @brief True if the block Gauss-Seidel iterations have been selected.
+ */
+#define MPS_BLOCK_ITERATIONS(ctx) ((ctx)->block_iterations && !(ctx)->jacobi_iterations)
 
 static void *
 __mps_fjacobi_aberth_step_worker (void * data_ptr)
 {
-  struct __mps_fjacobi_aberth_step_data *data = (struct __mps_fjacobi_aberth_step_data*)data_ptr;
+  mps_jacobi_aberth_step_data *data = (mps_jacobi_aberth_step_data*)data_ptr;
 
   cplx_t abcorr, corr;
 
@@ -52,14 +48,9 @@ __mps_fjacobi_aberth_step_worker (void * data_ptr)
       else
         cplx_div (corr, corr, abcorr);
 
-      cplx_set (*data->correction, corr);
+      cplx_set (ctx->workspace->fcorrections[data->i], corr);
     }
 
-  /* In case of a unique element in the thread pool
-   * the function call system has been optimized out. */
-  if (ctx->pool->n > 1)
-    free (data);
-
   return NULL;
 }
 
@@ -78,39 +69,34 @@ mps_fjacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
   mps_boolean again = false;
   int i = 0;
 
-  cplx_t * corrections = mps_newv (cplx_t, ctx->n);
+  mps_thread_workspace * w = mps_thread_workspace_get (ctx);
+  cplx_t * corrections = w->fcorrections;
 
   for (i = 0; i < ctx->n; i++)
     {
       if (ctx->root[i]->again)
         {
+	  mps_jacobi_aberth_step_data * data = &w->jacobi_data[i];
+
+	  if (nit)
+	    (*nit)++;
+
+	  /* The roots owned by other processes are iterated there */
+	  if (!MPS_DISTRIBUTED_OWNS (ctx, i))
+	    continue;
+
+	  data->ctx = ctx;
+	  data->p = p;
+	  data->root = ctx->root[i];
+	  data->i = i;
+
 	  /* In case of a unique element in the thread pool
 	   * the function call system has been optimized out. */
 	  if (ctx->pool->n > 1)
-	    {
-	      struct __mps_fjacobi_aberth_step_data * data = mps_new (struct __mps_fjacobi_aberth_step_data);
-
-	      data->ctx = ctx;
-	      data->p = p;
-	      data->root = ctx->root[i];
-	      data->correction = &corrections[i];
-
-	      /* The worker is in charge of freeing the data that we have allocated
-	       * here, so we can't ignore this issue in the main thread. */
-	      mps_thread_pool_assign (ctx, ctx->pool,
-				      __mps_fjacobi_aberth_step_worker, data);
-	    }
+	    mps_thread_pool_assign (ctx, ctx->pool,
+				    __mps_fjacobi_aberth_step_worker, data);
 	  else
-	    {
-	      struct __mps_fjacobi_aberth_step_data data = {
-		ctx, p, ctx->root[i], &corrections[i]
-	      };
-
-	      __mps_fjacobi_aberth_step_worker (&data);
-	    }
-
-	  if (nit)
-	    (*nit)++;
+	    __mps_fjacobi_aberth_step_worker (data);
 	}
     }
 
@@ -119,7 +105,7 @@ mps_fjacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
   /* Update again */
   for (i = 0; i < ctx->n; i++)
     {
-      if (ctx->root[i]->again)
+      if (ctx->root[i]->again && MPS_DISTRIBUTED_OWNS (ctx, i))
         {
           cplx_sub_eq (ctx->root[i]->fvalue, corrections[i]);
           ctx->root[i]->frad += cplx_mod (corrections[i]);
@@ -127,9 +113,136 @@ mps_fjacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
         }
     }
 
-  cplx_vfree (corrections);
+  /* Collect the approximations updated by the other processes */
+  mps_distributed_gather_roots (ctx);
 
-  return again;
+  return mps_distributed_any (ctx, again);
+}
+
+/**
+ * @brief Iterate, in Gauss-Seidel style, on the roots of a block.
+ *
+ * The approximations of the block are used as soon as they are updated,
+ * while the ones of the other blocks are read from the snapshot taken
+ * at the start of the step, so that the result does not depend on the
+ * order in which the blocks are processed.
+ */
+static void *
+__mps_fblock_aberth_step_worker (void * data_ptr)
+{
+  mps_jacobi_aberth_step_data *data = (mps_jacobi_aberth_step_data*)data_ptr;
+
+  cplx_t abcorr, corr, z;
+  int i, j;
+
+  mps_context * ctx = data->ctx;
+  mps_polynomial * p = data->p;
+  cplx_t * snapshot = ctx->workspace->fsnapshot;
+
+  for (i = data->i; i < data->end; i++)
+    {
+      mps_approximation * root = ctx->root[i];
+
+      if (!root->again || !MPS_DISTRIBUTED_OWNS (ctx, i))
+        continue;
+
+      mps_polynomial_fnewton (ctx, p, root, corr);
+
+      if (root->approximated)
+        root->again = false;
+
+      if (!root->again)
+        continue;
+
+      cplx_set (abcorr, cplx_zero);
+      for (j = 0; j < ctx->n; j++)
+        {
+          if (j == i)
+            continue;
+
+          if (j >= data->i && j < data->end)
+            cplx_sub (z, root->fvalue, ctx->root[j]->fvalue);
+          else
+            cplx_sub (z, root->fvalue, snapshot[j]);
+
+          cplx_inv_eq (z);
+          cplx_add_eq (abcorr, z);
+        }
+
+      cplx_mul_eq (abcorr, corr);
+      cplx_sub (abcorr, cplx_one, abcorr);
+
+      if (cplx_check_fpe (abcorr))
+        {
+          root->again = false;
+          root->status = MPS_ROOT_STATUS_NOT_FLOAT;
+        }
+
+      if (cplx_eq_zero (abcorr))
+        root->again = false;
+      else
+        cplx_div (corr, corr, abcorr);
+
+      if (root->again)
+        {
+          cplx_sub_eq (root->fvalue, corr);
+          root->frad += cplx_mod (corr);
+        }
+    }
+
+  return NULL;
+}
+
+/**
+ * @brief Perform a step of Aberth method in block Gauss-Seidel style.
+ *
+ * @param ctx The context in which this instance of MPSolve is running.
+ * @param p The polynomial on which Aberth method should be applied.
+ * @param nit Number of iterations performed in the packet.
+ */
+static mps_boolean
+mps_fblock_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
+{
+  mps_boolean again = false;
+  int i = 0;
+
+  mps_thread_workspace * w = mps_thread_workspace_get (ctx);
+
+  for (i = 0; i < ctx->n; i++)
+    {
+      cplx_set (w->fsnapshot[i], ctx->root[i]->fvalue);
+
+      if (ctx->root[i]->again && nit)
+        (*nit)++;
+    }
+
+  for (i = 0; i < ctx->n; i += MPS_ABERTH_BLOCK_SIZE)
+    {
+      mps_jacobi_aberth_step_data * data = &w->jacobi_data[i];
+
+      data->ctx = ctx;
+      data->p = p;
+      data->root = ctx->root[i];
+      data->i = i;
+      data->end = MIN (i + MPS_ABERTH_BLOCK_SIZE, ctx->n);
+
+      if (ctx->pool->n > 1)
+        mps_thread_pool_assign (ctx, ctx->pool,
+                                __mps_fblock_aberth_step_worker, data);
+      else
+        __mps_fblock_aberth_step_worker (data);
+    }
+
+  mps_thread_pool_wait (ctx, ctx->pool);
+
+  for (i = 0; i < ctx->n; i++)
+    if (ctx->root[i]->again && MPS_DISTRIBUTED_OWNS (ctx, i))
+      again = true;
+
+  /* Collect the approximations updated by the other processes */
+  mps_distributed_gather_roots (ctx);
+
+  return mps_distributed_any (ctx, again);
 }
 
 /**
@@ -167,7 +280,9 @@ mps_faberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
 
       if (ctx->debug_level & MPS_DEBUG_APPROXIMATIONS)
         MPS_DEBUG (ctx, "Carrying out a packet of floating point Aberth iterations (packet = %d)", packet);
-    } while (mps_fjacobi_aberth_step (ctx, p, &iterations) && packet <= ctx->max_it);
+    } while ((MPS_BLOCK_ITERATIONS (ctx) ?
+              mps_fblock_aberth_step (ctx, p, &iterations) :
+              mps_fjacobi_aberth_step (ctx, p, &iterations)) && packet <= ctx->max_it);
 
   MPS_DEBUG_WITH_INFO (ctx, "Performed %d iterations in floating point", iterations);
 
@@ -193,26 +308,18 @@ mps_faberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
   return root_neighborhood_roots;
 }
 
-/*! @cond PRIVATE */
-struct __mps_djacobi_aberth_step_data {
-  mps_context * ctx;
-  mps_polynomial * p;
-  mps_approximation * root;
-  cdpe_t * aberth_correction;
-};
-/*! @endcond */
-
 static void *
 __mps_djacobi_aberth_step_worker (void * data_ptr)
 {
-  struct __mps_djacobi_aberth_step_data *data = (struct __mps_djacobi_aberth_step_data*)data_ptr;
+  mps_jacobi_aberth_step_data *data = (mps_jacobi_aberth_step_data*)data_ptr;
   cdpe_t abcorr;
 
   mps_context * ctx = data->ctx;
   mps_approximation * root = data->root;
   mps_polynomial * p = data->p;
+  cdpe_t * aberth_correction = &ctx->workspace->dcorrections[data->i];
 
-  mps_polynomial_dnewton (ctx, p, root, *data->aberth_correction);
+  mps_polynomial_dnewton (ctx, p, root, *aberth_correction);
 
   if (root->approximated)
     root->again = false;
@@ -220,16 +327,15 @@ __mps_djacobi_aberth_step_worker (void * data_ptr)
   if (root->again)
     {
       mps_daberth (ctx, root, abcorr);
-      cdpe_mul_eq (abcorr, *data->aberth_correction);
+      cdpe_mul_eq (abcorr, *aberth_correction);
       cdpe_sub (abcorr, cdpe_one, abcorr);
 
       if (!cdpe_eq_zero (abcorr))
-        cdpe_div (*data->aberth_correction, *data->aberth_correction, abcorr);
+        cdpe_div (*aberth_correction, *aberth_correction, abcorr);
       else
         root->again = false;
     }
 
-  free (data);
   return NULL;
 }
 
@@ -244,30 +350,31 @@ __mps_djacobi_aberth_step_worker (void * data_ptr)
 static mps_boolean
 mps_djacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
 {
-  cdpe_t * daberth_corrections = NULL;
+  mps_thread_workspace * w = mps_thread_workspace_get (ctx);
+  cdpe_t * daberth_corrections = w->dcorrections;
   mps_boolean again = false;
   int i = 0;
 
-  daberth_corrections = cdpe_valloc (ctx->n);
-
   for (i = 0; i < ctx->n; i++)
     {
       if (ctx->root[i]->again)
         {
-          struct __mps_djacobi_aberth_step_data * data = mps_new (struct __mps_djacobi_aberth_step_data);
+          mps_jacobi_aberth_step_data * data = &w->jacobi_data[i];
+
+          if (nit)
+            (*nit)++;
+
+          /* The roots owned by other processes are iterated there */
+          if (!MPS_DISTRIBUTED_OWNS (ctx, i))
+            continue;
 
           data->ctx = ctx;
           data->p = p;
           data->root = ctx->root[i];
-          data->aberth_correction = &daberth_corrections[i];
+          data->i = i;
 
-          /* The worker is in charge of freeing the data that we have allocated
-           * here, so we can't ignore this issue in the main thread. */
           mps_thread_pool_assign (ctx, ctx->pool, __mps_djacobi_aberth_step_worker,
                                   data);
-
-          if (nit)
-            (*nit)++;
         }
     }
 
@@ -276,7 +383,7 @@ mps_djacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
   /* Update again */
   for (i = 0; i < ctx->n; i++)
     {
-      if (ctx->root[i]->again)
+      if (ctx->root[i]->again && MPS_DISTRIBUTED_OWNS (ctx, i))
         {
           rdpe_t correction_module;
           again = true;
@@ -287,8 +394,126 @@ mps_djacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
         }
     }
 
-  cdpe_vfree (daberth_corrections);
-  return again;
+  /* Collect the approximations updated by the other processes */
+  mps_distributed_gather_roots (ctx);
+
+  return mps_distributed_any (ctx, again);
+}
+
+/**
+ * @brief Iterate, in Gauss-Seidel style, on the roots of a block using
+ * DPE arithmetic.
+ *
+ * @see __mps_fblock_aberth_step_worker()
+ */
+static void *
+__mps_dblock_aberth_step_worker (void * data_ptr)
+{
+  mps_jacobi_aberth_step_data *data = (mps_jacobi_aberth_step_data*)data_ptr;
+
+  cdpe_t abcorr, corr, z;
+  rdpe_t correction_module;
+  int i, j;
+
+  mps_context * ctx = data->ctx;
+  mps_polynomial * p = data->p;
+  cdpe_t * snapshot = ctx->workspace->dsnapshot;
+
+  for (i = data->i; i < data->end; i++)
+    {
+      mps_approximation * root = ctx->root[i];
+
+      if (!root->again || !MPS_DISTRIBUTED_OWNS (ctx, i))
+        continue;
+
+      mps_polynomial_dnewton (ctx, p, root, corr);
+
+      if (root->approximated)
+        root->again = false;
+
+      if (!root->again)
+        continue;
+
+      cdpe_set (abcorr, cdpe_zero);
+      for (j = 0; j < ctx->n; j++)
+        {
+          if (j == i)
+            continue;
+
+          if (j >= data->i && j < data->end)
+            cdpe_sub (z, root->dvalue, ctx->root[j]->dvalue);
+          else
+            cdpe_sub (z, root->dvalue, snapshot[j]);
+
+          cdpe_inv_eq (z);
+          cdpe_add_eq (abcorr, z);
+        }
+
+      cdpe_mul_eq (abcorr, corr);
+      cdpe_sub (abcorr, cdpe_one, abcorr);
+
+      if (cdpe_eq_zero (abcorr))
+        {
+          root->again = false;
+          continue;
+        }
+
+      cdpe_div (corr, corr, abcorr);
+      cdpe_sub_eq (root->dvalue, corr);
+      cdpe_mod (correction_module, corr);
+      rdpe_add_eq (root->drad, correction_module);
+    }
+
+  return NULL;
+}
+
+/**
+ * @brief Perform a step of Aberth method in block Gauss-Seidel style
+ * using DPE arithmetic.
+ *
+ * @param ctx The context in which this instance of MPSolve is running.
+ * @param p The polynomial on which Aberth method should be applied.
+ * @param nit Number of iterations performed in the packet.
+ */
+static mps_boolean
+mps_dblock_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
+{
+  mps_thread_workspace * w = mps_thread_workspace_get (ctx);
+  mps_boolean again = false;
+  int i = 0;
+
+  for (i = 0; i < ctx->n; i++)
+    {
+      cdpe_set (w->dsnapshot[i], ctx->root[i]->dvalue);
+
+      if (ctx->root[i]->again && nit)
+        (*nit)++;
+    }
+
+  for (i = 0; i < ctx->n; i += MPS_ABERTH_BLOCK_SIZE)
+    {
+      mps_jacobi_aberth_step_data * data = &w->jacobi_data[i];
+
+      data->ctx = ctx;
+      data->p = p;
+      data->root = ctx->root[i];
+      data->i = i;
+      data->end = MIN (i + MPS_ABERTH_BLOCK_SIZE, ctx->n);
+
+      mps_thread_pool_assign (ctx, ctx->pool, __mps_dblock_aberth_step_worker,
+                              data);
+    }
+
+  mps_thread_pool_wait (ctx, ctx->pool);
+
+  for (i = 0; i < ctx->n; i++)
+    if (ctx->root[i]->again && MPS_DISTRIBUTED_OWNS (ctx, i))
+      again = true;
+
+  /* Collect the approximations updated by the other processes */
+  mps_distributed_gather_roots (ctx);
+
+  return mps_distributed_any (ctx, again);
 }
 
 /**
@@ -324,7 +549,9 @@ mps_daberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
 
       if (ctx->debug_level & MPS_DEBUG_APPROXIMATIONS)
         MPS_DEBUG (ctx, "Carrying out a packet of CDPE Aberth iterations (packet = %d)", packet);
-    } while (mps_djacobi_aberth_step (ctx, p, &iterations));
+    } while (MPS_BLOCK_ITERATIONS (ctx) ?
+             mps_dblock_aberth_step (ctx, p, &iterations) :
+             mps_djacobi_aberth_step (ctx, p, &iterations));
 
   MPS_DEBUG_WITH_INFO (ctx, "Performed %d iterations in CDPE", iterations);
 
@@ -350,19 +577,10 @@ mps_daberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
   return root_neighborhood_roots;
 }
 
-/*! @cond PRIVATE */
-struct __mps_mjacobi_aberth_step_data {
-  mps_context * ctx;
-  mps_polynomial * p;
-  mps_approximation * root;
-  mpc_t * aberth_correction;
-};
-/*! @endcond */
-
 static void *
 __mps_mjacobi_aberth_step_worker (void * data_ptr)
 {
-  struct __mps_mjacobi_aberth_step_data *data = (struct __mps_mjacobi_aberth_step_data*)data_ptr;
+  mps_jacobi_aberth_step_data *data = (mps_jacobi_aberth_step_data*)data_ptr;
   mpc_t corr, abcorr;
 
   mps_context * ctx = data->ctx;
@@ -388,14 +606,12 @@ __mps_mjacobi_aberth_step_worker (void * data_ptr)
       else
         root->again = false;
 
-      mpc_set (*data->aberth_correction, abcorr);
+      mpc_set (ctx->workspace->mcorrections[data->i], abcorr);
     }
 
   mpc_clear (corr);
   mpc_clear (abcorr);
 
-  free (data);
-
   return NULL;
 }
 
@@ -410,31 +626,40 @@ __mps_mjacobi_aberth_step_worker (void * data_ptr)
 static mps_boolean
 mps_mjacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
 {
-  mpc_t * maberth_corrections = NULL;
+  mps_thread_workspace * w = mps_thread_workspace_get (ctx);
+  mpc_t * maberth_corrections = w->mcorrections;
   mps_boolean again = false;
   int i = 0;
 
-  maberth_corrections = mpc_valloc (ctx->n);
-  mpc_vinit2 (maberth_corrections, ctx->n, ctx->mpwp);
+  /* Adjust the precision of the corrections only when the working
+   * precision has changed since the last step. */
+  if (w->mcorrections_prec != ctx->mpwp)
+    {
+      for (i = 0; i < w->n; i++)
+        mpc_set_prec (maberth_corrections[i], ctx->mpwp);
+      w->mcorrections_prec = ctx->mpwp;
+    }
 
   for (i = 0; i < ctx->n; i++)
     {
       if (ctx->root[i]->again)
         {
-          struct __mps_mjacobi_aberth_step_data * data = mps_new (struct __mps_mjacobi_aberth_step_data);
+          mps_jacobi_aberth_step_data * data = &w->jacobi_data[i];
+
+          if (nit)
+            (*nit)++;
+
+          /* The roots owned by other processes are iterated there */
+          if (!MPS_DISTRIBUTED_OWNS (ctx, i))
+            continue;
 
           data->ctx = ctx;
           data->p = p;
           data->root = ctx->root[i];
-          data->aberth_correction = &maberth_corrections[i];
+          data->i = i;
 
-          /* The worker is in charge of freeing the data that we have allocated
-           * here, so we can't ignore this issue in the main thread. */
           mps_thread_pool_assign (ctx, ctx->pool, __mps_mjacobi_aberth_step_worker,
                                   data);
-
-          if (nit)
-            (*nit)++;
         }
     }
 
@@ -443,7 +668,7 @@ mps_mjacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
   /* Update again */
   for (i = 0; i < ctx->n; i++)
     {
-      if (ctx->root[i]->again)
+      if (ctx->root[i]->again && MPS_DISTRIBUTED_OWNS (ctx, i))
         {
           rdpe_t correction_module;
           again = true;
@@ -454,10 +679,143 @@ mps_mjacobi_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
         }
     }
 
-  mpc_vclear (maberth_corrections, ctx->n);
-  mpc_vfree (maberth_corrections);
+  /* Collect the approximations updated by the other processes */
+  mps_distributed_gather_roots (ctx);
+
+  return mps_distributed_any (ctx, again);
+}
+
+/**
+ * @brief Iterate, in Gauss-Seidel style, on the roots of a block using
+ * multiprecision arithmetic.
+ *
+ * @see __mps_fblock_aberth_step_worker()
+ */
+static void *
+__mps_mblock_aberth_step_worker (void * data_ptr)
+{
+  mps_jacobi_aberth_step_data *data = (mps_jacobi_aberth_step_data*)data_ptr;
+  mpc_t corr, abcorr, diff;
+  cdpe_t z, temp;
+  rdpe_t correction_module;
+  int i, j;
+
+  mps_context * ctx = data->ctx;
+  mps_polynomial * p = data->p;
+  mpc_t * snapshot = ctx->workspace->msnapshot;
+
+  mpc_init2 (corr, ctx->mpwp);
+  mpc_init2 (abcorr, ctx->mpwp);
+  mpc_init2 (diff, ctx->mpwp);
+
+  for (i = data->i; i < data->end; i++)
+    {
+      mps_approximation * root = ctx->root[i];
+
+      if (!root->again || !MPS_DISTRIBUTED_OWNS (ctx, i))
+        continue;
+
+      mps_polynomial_mnewton (ctx, p, root, corr, mpc_get_prec (root->mvalue));
+
+      if (root->approximated)
+        root->again = false;
+
+      if (!root->again)
+        continue;
+
+      cdpe_set (temp, cdpe_zero);
+      for (j = 0; j < ctx->n; j++)
+        {
+          if (j == i)
+            continue;
+
+          if (j >= data->i && j < data->end)
+            mpc_sub (diff, root->mvalue, ctx->root[j]->mvalue);
+          else
+            mpc_sub (diff, root->mvalue, snapshot[j]);
+
+          mpc_get_cdpe (z, diff);
+          cdpe_inv_eq (z);
+          cdpe_add_eq (temp, z);
+        }
+      mpc_set_cdpe (abcorr, temp);
+
+      mpc_mul_eq (abcorr, corr);
+      mpc_ui_sub (abcorr, 1U, 0U, abcorr);
+
+      if (mpc_eq_zero (abcorr))
+        {
+          root->again = false;
+          continue;
+        }
+
+      mpc_div (abcorr, corr, abcorr);
+      mpc_sub_eq (root->mvalue, abcorr);
+      mpc_rmod (correction_module, abcorr);
+      rdpe_add_eq (root->drad, correction_module);
+    }
+
+  mpc_clear (corr);
+  mpc_clear (abcorr);
+  mpc_clear (diff);
+
+  return NULL;
+}
+
+/**
+ * @brief Perform a step of Aberth method in block Gauss-Seidel style
+ * using multiprecision arithmetic.
+ *
+ * @param ctx The context in which this instance of MPSolve is running.
+ * @param p The polynomial on which Aberth method should be applied.
+ * @param nit Number of iterations performed in the packet.
+ */
+static mps_boolean
+mps_mblock_aberth_step (mps_context * ctx, mps_polynomial * p, int * nit)
+{
+  mps_thread_workspace * w = mps_thread_workspace_get (ctx);
+  mps_boolean again = false;
+  int i = 0;
+
+  if (w->msnapshot_prec != ctx->mpwp)
+    {
+      for (i = 0; i < w->n; i++)
+        mpc_set_prec (w->msnapshot[i], ctx->mpwp);
+      w->msnapshot_prec = ctx->mpwp;
+    }
+
+  for (i = 0; i < ctx->n; i++)
+    {
+      mpc_set (w->msnapshot[i], ctx->root[i]->mvalue);
+
+      if (ctx->root[i]->again && nit)
+        (*nit)++;
+    }
+
+  for (i = 0; i < ctx->n; i += MPS_ABERTH_BLOCK_SIZE)
+    {
+      mps_jacobi_aberth_step_data * data = &w->jacobi_data[i];
+
+      data->ctx = ctx;
+      data->p = p;
+      data->root = ctx->root[i];
+      data->i = i;
+      data->end = MIN (i + MPS_ABERTH_BLOCK_SIZE, ctx->n);
+
+      mps_thread_pool_assign (ctx, ctx->pool, __mps_mblock_aberth_step_worker,
+                              data);
+    }
+
+  mps_thread_pool_wait (ctx, ctx->pool);
+
+  for (i = 0; i < ctx->n; i++)
+    if (ctx->root[i]->again && MPS_DISTRIBUTED_OWNS (ctx, i))
+      again = true;
+
+  /* Collect the approximations updated by the other processes */
+  mps_distributed_gather_roots (ctx);
 
-  return again;
+  return mps_distributed_any (ctx, again);
 }
 
 /**
@@ -493,7 +851,9 @@ mps_maberth_packet (mps_context * ctx, mps_polynomial * p, mps_boolean just_rege
 
       if (ctx->debug_level & MPS_DEBUG_APPROXIMATIONS)
         MPS_DEBUG (ctx, "Carrying out a packet of multiprecision Aberth iterations (packet = %d)", packet);
-    } while (mps_mjacobi_aberth_step (ctx, p, &iterations));
+    } while (MPS_BLOCK_ITERATIONS (ctx) ?
+             mps_mblock_aberth_step (ctx, p, &iterations) :
+             mps_mjacobi_aberth_step (ctx, p, &iterations));
 
   MPS_DEBUG_WITH_INFO (ctx, "Performed %d iterations in multiprecision", iterations);
 
@@ -170,6 +170,8 @@ mps_parse_option_line (mps_context * s, char *line, size_t length)
     input_option.flag = MPS_FLAG_MONOMIAL;
   if (mps_is_option (s, option, "chebyshev"))
     input_option.flag = MPS_FLAG_CHEBYSHEV;
+  if (mps_is_option (s, option, "rationalfunction"))
+    input_option.flag = MPS_FLAG_RATIONAL_FUNCTION;
 
   /* Parsing keys with values. If = is not found in the
    * input string, than an error has occurred so we should
@@ -330,6 +332,8 @@ mps_parse_abstract_stream (mps_context * s, mps_abstract_input_stream * stream)
             representation = MPS_REPRESENTATION_MONOMIAL;
           else if (input_option.flag == MPS_FLAG_CHEBYSHEV)
             representation = MPS_REPRESENTATION_CHEBYSHEV;
+          else if (input_option.flag == MPS_FLAG_RATIONAL_FUNCTION)
+            representation = MPS_REPRESENTATION_RATIONAL_FUNCTION;
 
           /* And of dense and or sparse input */
           else if (input_option.flag == MPS_FLAG_SPARSE)
@@ -413,6 +417,15 @@ mps_parse_abstract_stream (mps_context * s, mps_abstract_input_stream * stream)
       poly = MPS_POLYNOMIAL (mps_chebyshev_poly_read_from_stream (s, buffer, structure, density, input_precision));
       break;
 
+    case MPS_REPRESENTATION_RATIONAL_FUNCTION:
+      if (s->debug_level & MPS_DEBUG_IO)
+        MPS_DEBUG (s, "Parsing mps_rational_equation from stream");
+      poly = MPS_POLYNOMIAL (mps_rational_equation_read_from_stream (s, buffer, structure, input_precision));
+
+      /* The coefficients are not the ones of a monomial basis. */
+      density = MPS_DENSITY_USER;
+      break;
+
     case MPS_REPRESENTATION_MONOMIAL:
     default:
       if (s->debug_level & MPS_DEBUG_IO)
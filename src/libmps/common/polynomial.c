@@ -125,6 +125,9 @@ mps_polynomial_fstart (mps_context * ctx, mps_polynomial * p, mps_approximation
       /* The FILE starting strategy is one-shot only. */
       mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
       break;
+    case MPS_STARTING_STRATEGY_COMPANION:
+      mps_companion_fstart (ctx, p, approximations);
+      break;
     }
 }
 
@@ -147,6 +150,9 @@ mps_polynomial_dstart (mps_context * ctx, mps_polynomial * p, mps_approximation
       /* The FILE starting strategy is one-shot only. */
       mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
       break;
+    case MPS_STARTING_STRATEGY_COMPANION:
+      mps_companion_dstart (ctx, p, approximations);
+      break;
     }
 }
 
@@ -169,6 +175,9 @@ mps_polynomial_mstart (mps_context * ctx, mps_polynomial * p, mps_approximation
       /* The FILE starting strategy is one-shot only. */
       mps_context_select_starting_strategy (ctx, MPS_STARTING_STRATEGY_DEFAULT);
       break;
+    case MPS_STARTING_STRATEGY_COMPANION:
+      mps_companion_mstart (ctx, p, approximations);
+      break;
     }
 }
 
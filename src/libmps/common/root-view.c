@@ -0,0 +1,349 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/**
+ * @file
+ * @brief Access to the computed roots without copying them, and export
+ * of all of them to arrays provided by the caller.
+ *
+ * mps_context_get_roots_d() and mps_context_get_roots_m() may allocate
+ * the output and, in the multiprecision case, resize every element to the
+ * precision of the root. The exporters here write instead in place, in
+ * the format chosen by the caller, and can split the work among the
+ * threads of the context.
+ */
+
+#include <math.h>
+#include <mps/mps.h>
+
+/**
+ * @brief Number of roots below which the exporters never use the thread
+ * pool, since the synchronization would cost more than the conversion.
+ */
+#define MPS_ROOT_EXPORT_PARALLEL_THRESHOLD 1024
+
+/*! @cond PRIVATE */
+typedef struct mps_root_export_job mps_root_export_job;
+
+struct mps_root_export_job {
+  mps_context * s;
+
+  /**
+   * @brief Range of the roots exported by this job.
+   */
+  int first, last;
+
+  /**
+   * @brief Function that exports the i-th root.
+   */
+  void (*export_root)(mps_root_export_job * job, int i);
+
+  /* Output vectors, only the ones of the selected format are used. */
+  double * re, * im, * radius;
+  long double * lre, * lim, * lradius;
+  mpc_t * mroots;
+  rdpe_t * mradius;
+
+  /**
+   * @brief Temporary used by the long double conversions.
+   */
+  mpf_t tmp;
+};
+/*! @endcond */
+
+/**
+ * @brief Fill view with the approximations stored in s, without copying
+ * them.
+ *
+ * @param s The current mps_context.
+ * @param view The mps_root_view to fill.
+ * @return 0 on success, or -1 if s does not hold any approximation.
+ */
+int
+mps_context_get_root_view (mps_context * s, mps_root_view * view)
+{
+  if (!s->root)
+    return -1;
+
+  view->n = s->n;
+  view->zero_roots = s->zero_roots;
+  view->phase = s->lastphase;
+  view->root = s->root;
+
+  return 0;
+}
+
+/**
+ * @brief Convert a DPE number to a long double, whose exponent range is
+ * wider than the one of a double.
+ */
+static long double
+mps_rdpe_get_ld (const rdpe_t x)
+{
+  return ldexpl ((long double) rdpe_Mnt (x), rdpe_Esp (x));
+}
+
+/**
+ * @brief Convert a multiprecision number to a long double, keeping more
+ * digits than the 53 returned by <code>mpf_get_d()</code>.
+ */
+static long double
+mps_mpf_get_ld (mpf_t x, mpf_t tmp)
+{
+  long int e, e2;
+  double hi, lo;
+
+  hi = mpf_get_d_2exp (&e, x);
+  mpf_set_d (tmp, hi);
+  if (e >= 0)
+    mpf_mul_2exp (tmp, tmp, e);
+  else
+    mpf_div_2exp (tmp, tmp, -e);
+  mpf_sub (tmp, x, tmp);
+  lo = mpf_get_d_2exp (&e2, tmp);
+
+  return ldexpl (hi, e) + ldexpl (lo, e2);
+}
+
+static void
+mps_export_root_d (mps_root_export_job * job, int i)
+{
+  mps_approximation * root = job->s->root[i];
+  cplx_t value;
+
+  switch (job->s->lastphase)
+    {
+    case float_phase:
+      cplx_set (value, root->fvalue);
+      break;
+    case dpe_phase:
+      cdpe_get_x (value, root->dvalue);
+      break;
+    default:
+      mpc_get_cplx (value, root->mvalue);
+      break;
+    }
+
+  if (job->re)
+    job->re[i] = cplx_Re (value);
+  if (job->im)
+    job->im[i] = cplx_Im (value);
+
+  if (job->radius)
+    {
+      if (job->s->lastphase == float_phase || job->s->lastphase == dpe_phase)
+        job->radius[i] = root->frad;
+      else
+        job->radius[i] = rdpe_get_d (root->drad);
+    }
+}
+
+static void
+mps_export_root_ld (mps_root_export_job * job, int i)
+{
+  mps_approximation * root = job->s->root[i];
+
+  switch (job->s->lastphase)
+    {
+    case float_phase:
+      if (job->lre)
+        job->lre[i] = cplx_Re (root->fvalue);
+      if (job->lim)
+        job->lim[i] = cplx_Im (root->fvalue);
+      break;
+    case dpe_phase:
+      if (job->lre)
+        job->lre[i] = mps_rdpe_get_ld (cdpe_Re (root->dvalue));
+      if (job->lim)
+        job->lim[i] = mps_rdpe_get_ld (cdpe_Im (root->dvalue));
+      break;
+    default:
+      if (job->lre)
+        job->lre[i] = mps_mpf_get_ld (mpc_Re (root->mvalue), job->tmp);
+      if (job->lim)
+        job->lim[i] = mps_mpf_get_ld (mpc_Im (root->mvalue), job->tmp);
+      break;
+    }
+
+  if (job->lradius)
+    {
+      if (job->s->lastphase == float_phase || job->s->lastphase == dpe_phase)
+        job->lradius[i] = root->frad;
+      else
+        job->lradius[i] = mps_rdpe_get_ld (root->drad);
+    }
+}
+
+static void
+mps_export_root_m (mps_root_export_job * job, int i)
+{
+  mps_approximation * root = job->s->root[i];
+
+  if (job->mroots)
+    {
+      switch (job->s->lastphase)
+        {
+        case float_phase:
+          mpc_set_cplx (job->mroots[i], root->fvalue);
+          break;
+        case dpe_phase:
+          mpc_set_cdpe (job->mroots[i], root->dvalue);
+          break;
+        default:
+          mpc_set (job->mroots[i], root->mvalue);
+          break;
+        }
+    }
+
+  if (job->mradius)
+    {
+      if (job->s->lastphase == float_phase || job->s->lastphase == dpe_phase)
+        rdpe_set_d (job->mradius[i], root->frad);
+      else
+        rdpe_set (job->mradius[i], root->drad);
+    }
+}
+
+static void *
+mps_root_export_worker (void * data_ptr)
+{
+  mps_root_export_job * job = (mps_root_export_job *) data_ptr;
+  int i;
+
+  mpf_init2 (job->tmp, 128);
+
+  for (i = job->first; i < job->last; i++)
+    (*job->export_root)(job, i);
+
+  mpf_clear (job->tmp);
+
+  return NULL;
+}
+
+/**
+ * @brief Run the export described by the template job on all the roots,
+ * splitting them among the threads of s if parallel is true.
+ */
+static int
+mps_root_export (mps_context * s, mps_root_export_job * template_job, mps_boolean parallel)
+{
+  mps_root_export_job * jobs;
+  int n_jobs, chunk, i;
+
+  if (!s->root)
+    return -1;
+
+  n_jobs = (parallel && s->n >= MPS_ROOT_EXPORT_PARALLEL_THRESHOLD) ? s->n_threads : 1;
+
+  if (n_jobs <= 1)
+    {
+      template_job->s = s;
+      template_job->first = 0;
+      template_job->last = s->n;
+      mps_root_export_worker (template_job);
+      return 0;
+    }
+
+  jobs = mps_newv (mps_root_export_job, n_jobs);
+  chunk = (s->n + n_jobs - 1) / n_jobs;
+
+  for (i = 0; i < n_jobs; i++)
+    {
+      jobs[i] = *template_job;
+      jobs[i].s = s;
+      jobs[i].first = MIN (i * chunk, s->n);
+      jobs[i].last = MIN ((i + 1) * chunk, s->n);
+
+      mps_thread_pool_assign (s, s->pool, mps_root_export_worker, jobs + i);
+    }
+
+  mps_thread_pool_wait (s, s->pool);
+  free (jobs);
+
+  return 0;
+}
+
+/**
+ * @brief Store the real and imaginary parts of the roots and their
+ * inclusion radii in the vectors provided.
+ *
+ * Any of the vectors can be <code>NULL</code>, and the others must have
+ * room for mps_context_get_degree() elements.
+ *
+ * @param s The current mps_context.
+ * @param re The vector where the real parts will be stored.
+ * @param im The vector where the imaginary parts will be stored.
+ * @param radius The vector where the inclusion radii will be stored.
+ * @param parallel If true the roots are converted using the threads of
+ * the context.
+ * @return 0 on success, or -1 if s does not hold any approximation.
+ */
+int
+mps_context_export_roots_d (mps_context * s, double * re, double * im, double * radius,
+                            mps_boolean parallel)
+{
+  mps_root_export_job job = { 0 };
+
+  job.export_root = mps_export_root_d;
+  job.re = re;
+  job.im = im;
+  job.radius = radius;
+
+  return mps_root_export (s, &job, parallel);
+}
+
+/**
+ * @brief Long double version of mps_context_export_roots_d().
+ *
+ * The roots computed in multiprecision are rounded to the full precision
+ * of a long double, and the ones that do not fit in a double are
+ * represented if they fit in the wider exponent range.
+ */
+int
+mps_context_export_roots_ld (mps_context * s, long double * re, long double * im,
+                             long double * radius, mps_boolean parallel)
+{
+  mps_root_export_job job = { 0 };
+
+  job.export_root = mps_export_root_ld;
+  job.lre = re;
+  job.lim = im;
+  job.lradius = radius;
+
+  return mps_root_export (s, &job, parallel);
+}
+
+/**
+ * @brief Store the roots and their inclusion radii in the multiprecision
+ * vectors provided.
+ *
+ * Unlike mps_context_get_roots_m() the elements of roots are not resized:
+ * they must be initialized by the caller, and each root is rounded to the
+ * precision chosen there. Any of the vectors can be <code>NULL</code>.
+ *
+ * @param s The current mps_context.
+ * @param roots The vector where the roots will be stored.
+ * @param radius The vector where the inclusion radii will be stored.
+ * @param parallel If true the roots are converted using the threads of
+ * the context.
+ * @return 0 on success, or -1 if s does not hold any approximation.
+ */
+int
+mps_context_export_roots_m (mps_context * s, mpc_t * roots, rdpe_t * radius,
+                            mps_boolean parallel)
+{
+  mps_root_export_job job = { 0 };
+
+  job.export_root = mps_export_root_m;
+  job.mroots = roots;
+  job.mradius = radius;
+
+  return mps_root_export (s, &job, parallel);
+}
@@ -12,56 +12,191 @@
 
 
 #include <mps/mps.h>
+#include <string.h>
 
 /**
- * @brief Compare two approximations.
+ * @brief Below this number of keys mps_sort_keys() does not use the
+ * thread pool.
+ */
+#define MPS_SORT_PARALLEL_THRESHOLD 4096
+
+/**
+ * @brief Compare two normalized DPE numbers, using the sign and the
+ * exponent before the mantissa.
  */
 static int
-mps_fcmp (const void *a, const void *b)
+mps_sort_rdpe_cmp (const rdpe_t a, const rdpe_t b)
 {
-  double dif;
+  double ma = rdpe_Mnt (a), mb = rdpe_Mnt (b);
+  int sa = (ma > 0) - (ma < 0);
+  int sb = (mb > 0) - (mb < 0);
 
-  dif = cplx_Re (cplx_Addr (a)) - cplx_Re (cplx_Addr (b));
-  if (dif > 0)
-    return 1;
-  else if (dif == 0.0)
+  if (sa != sb)
+    return (sa < sb) ? -1 : 1;
+  if (sa == 0)
     return 0;
-  return -1;
+  if (rdpe_Esp (a) != rdpe_Esp (b))
+    return (rdpe_Esp (a) > rdpe_Esp (b)) ? sa : -sa;
+
+  return (ma > mb) - (ma < mb);
 }
 
 /**
- * @brief Sort the approximations saved in the current mps_context.
- *
- * @param s A pointer to the current mps_context.
+ * @brief Compare two mps_sort_key.
  */
-MPS_PRIVATE void
-mps_fsort (mps_context * s)
+static int
+mps_sort_key_cmp (const void *a, const void *b)
 {
-  int i;
-  cplx_t *real_parts = cplx_valloc (s->n);
+  const mps_sort_key * ka = (const mps_sort_key *) a;
+  const mps_sort_key * kb = (const mps_sort_key *) b;
+  int cmp;
 
-  for (i = 0; i < s->n; i++)
+  if ((cmp = mps_sort_rdpe_cmp (cdpe_Re (ka->value), cdpe_Re (kb->value))) != 0)
+    return cmp;
+  if ((cmp = mps_sort_rdpe_cmp (cdpe_Im (ka->value), cdpe_Im (kb->value))) != 0)
+    return cmp;
+
+  if (ka->root && kb->root)
     {
-      cplx_set_d (real_parts[i],
-                  cplx_Re (s->root[i]->fvalue),
-                  i);
+      if ((cmp = mpf_cmp (mpc_Re (ka->root->mvalue), mpc_Re (kb->root->mvalue))) != 0)
+        return (cmp > 0) - (cmp < 0);
+      if ((cmp = mpf_cmp (mpc_Im (ka->root->mvalue), mpc_Im (kb->root->mvalue))) != 0)
+        return (cmp > 0) - (cmp < 0);
     }
 
-  qsort (real_parts, s->n, sizeof(cplx_t), mps_fcmp);
+  return (ka->index > kb->index) - (ka->index < kb->index);
+}
 
-  for (i = 0; i < s->n; i++)
-    s->order[i] = (int)cplx_Im (real_parts[i]);
+struct mps_sort_worker_data {
+  mps_sort_key * keys;
+  mps_sort_key * tmp;
+  int start;
+  int middle;
+  int end;
+};
+
+/**
+ * @brief Sort the keys from start to end with qsort().
+ */
+static void *
+mps_sort_worker (void * data_ptr)
+{
+  struct mps_sort_worker_data * data = (struct mps_sort_worker_data *) data_ptr;
+
+  qsort (data->keys + data->start, data->end - data->start, sizeof(mps_sort_key),
+         mps_sort_key_cmp);
 
-  cplx_vfree (real_parts);
+  return NULL;
 }
 
 /**
- * @brief DPE version mps_fcmp().
+ * @brief Merge the sorted runs of keys from start to middle and from
+ * middle to end in the same positions of tmp.
  */
-static int
-mps_dcmp (const void *a, const void *b)
+static void *
+mps_sort_merge_worker (void * data_ptr)
+{
+  struct mps_sort_worker_data * data = (struct mps_sort_worker_data *) data_ptr;
+  int i = data->start, j = data->middle, k = data->start;
+
+  while (i < data->middle && j < data->end)
+    {
+      if (mps_sort_key_cmp (&data->keys[j], &data->keys[i]) < 0)
+        data->tmp[k++] = data->keys[j++];
+      else
+        data->tmp[k++] = data->keys[i++];
+    }
+
+  while (i < data->middle)
+    data->tmp[k++] = data->keys[i++];
+  while (j < data->end)
+    data->tmp[k++] = data->keys[j++];
+
+  return NULL;
+}
+
+/**
+ * @brief Sort a vector of mps_sort_key in increasing order.
+ *
+ * Large vectors are split in a run for each thread, the runs are
+ * sorted in parallel and then merged in pairs, again in parallel, until
+ * a single run is left. The result does not depend on the number of
+ * threads, since the indices break all the ties.
+ *
+ * @param s A pointer to the current mps_context.
+ * @param keys The keys to sort.
+ * @param n The length of keys.
+ */
+MPS_PRIVATE void
+mps_sort_keys (mps_context * s, mps_sort_key * keys, int n)
 {
-  return rdpe_cmp (cdpe_Re (cdpe_Addr (a)), cdpe_Re (cdpe_Addr (b)));
+  struct mps_sort_worker_data * data;
+  mps_sort_key * sorted = keys, * tmp, * swap;
+  int * bounds;
+  int i, runs = s->n_threads;
+
+  if (n < MPS_SORT_PARALLEL_THRESHOLD || runs <= 1 || !s->pool)
+    {
+      qsort (keys, n, sizeof(mps_sort_key), mps_sort_key_cmp);
+      return;
+    }
+
+  tmp = mps_newv (mps_sort_key, n);
+  data = mps_newv (struct mps_sort_worker_data, runs);
+  bounds = mps_newv (int, runs + 1);
+
+  for (i = 0; i <= runs; i++)
+    bounds[i] = (int) ((long) n * i / runs);
+
+  for (i = 0; i < runs; i++)
+    {
+      data[i].keys = keys;
+      data[i].start = bounds[i];
+      data[i].end = bounds[i + 1];
+      mps_thread_pool_assign (s, s->pool, mps_sort_worker, data + i);
+    }
+  mps_thread_pool_wait (s, s->pool);
+
+  while (runs > 1)
+    {
+      for (i = 0; i < runs / 2; i++)
+        {
+          data[i].keys = keys;
+          data[i].tmp = tmp;
+          data[i].start = bounds[2 * i];
+          data[i].middle = bounds[2 * i + 1];
+          data[i].end = bounds[2 * i + 2];
+          mps_thread_pool_assign (s, s->pool, mps_sort_merge_worker, data + i);
+        }
+
+      /* An odd run is left alone in this pass. */
+      if (runs % 2)
+        memcpy (tmp + bounds[runs - 1], keys + bounds[runs - 1],
+                sizeof(mps_sort_key) * (n - bounds[runs - 1]));
+
+      mps_thread_pool_wait (s, s->pool);
+
+      for (i = 0; i <= runs / 2; i++)
+        bounds[i] = bounds[MIN (2 * i, runs)];
+      runs = (runs + 1) / 2;
+      bounds[runs] = n;
+
+      swap = keys;
+      keys = tmp;
+      tmp = swap;
+    }
+
+  /* After an odd number of passes the result is in the auxiliary
+   * vector. */
+  if (keys != sorted)
+    {
+      memcpy (sorted, keys, sizeof(mps_sort_key) * n);
+      tmp = keys;
+    }
+
+  free (tmp);
+  free (bounds);
+  free (data);
 }
 
 /**
@@ -70,32 +205,50 @@ mps_dcmp (const void *a, const void *b)
  * @param s A pointer to the current mps_context.
  */
 MPS_PRIVATE void
-mps_dsort (mps_context * s)
+mps_fsort (mps_context * s)
 {
-  cdpe_t * real_parts = cdpe_valloc (s->n);
   int i;
+  mps_sort_key * keys = mps_newv (mps_sort_key, s->n);
 
   for (i = 0; i < s->n; i++)
     {
-      rdpe_set (cdpe_Re (real_parts[i]), cdpe_Re (s->root[i]->dvalue));
-      rdpe_set_d (cdpe_Im (real_parts[i]), i);
+      cdpe_set_x (keys[i].value, s->root[i]->fvalue);
+      keys[i].root = NULL;
+      keys[i].index = i;
     }
 
-  qsort (real_parts, s->n, sizeof(cdpe_t), mps_dcmp);
+  mps_sort_keys (s, keys, s->n);
 
   for (i = 0; i < s->n; i++)
-    s->order[i] = (int)rdpe_get_d (cdpe_Im (real_parts[i]));
+    s->order[i] = keys[i].index;
 
-  cdpe_vfree (real_parts);
+  free (keys);
 }
 
 /**
- * @brief Multiprecision version of mps_fcmp().
+ * @brief Sort the approximations saved in the current mps_context.
+ *
+ * @param s A pointer to the current mps_context.
  */
-static int
-mps_mcmp (const void *a, const void *b)
+MPS_PRIVATE void
+mps_dsort (mps_context * s)
 {
-  return mpf_cmp (mpc_Re (mpc_Addr (a)), mpc_Re (mpc_Addr (b)));
+  int i;
+  mps_sort_key * keys = mps_newv (mps_sort_key, s->n);
+
+  for (i = 0; i < s->n; i++)
+    {
+      cdpe_set (keys[i].value, s->root[i]->dvalue);
+      keys[i].root = NULL;
+      keys[i].index = i;
+    }
+
+  mps_sort_keys (s, keys, s->n);
+
+  for (i = 0; i < s->n; i++)
+    s->order[i] = keys[i].index;
+
+  free (keys);
 }
 
 /**
@@ -107,21 +260,19 @@ MPS_PRIVATE void
 mps_msort (mps_context * s)
 {
   int i;
-  mpc_t * real_parts = mpc_valloc (s->n);
-
-  mpc_vinit2 (real_parts, s->n, s->mpwp);
+  mps_sort_key * keys = mps_newv (mps_sort_key, s->n);
 
   for (i = 0; i < s->n; i++)
     {
-      mpf_set (mpc_Re (real_parts[i]), mpc_Re (s->root[i]->mvalue));
-      mpf_set_ui (mpc_Im (real_parts[i]), i);
+      mpc_get_cdpe (keys[i].value, s->root[i]->mvalue);
+      keys[i].root = s->root[i];
+      keys[i].index = i;
     }
 
-  qsort (real_parts, s->n, sizeof(mpc_t), mps_mcmp);
+  mps_sort_keys (s, keys, s->n);
 
   for (i = 0; i < s->n; i++)
-    s->order[i] = (int)mpf_get_d (mpc_Im (real_parts[i]));
+    s->order[i] = keys[i].index;
 
-  mpc_vclear (real_parts, s->n);
-  mpc_vfree (real_parts);
+  free (keys);
 }
@@ -131,6 +131,174 @@ mps_mtouchnwt (mps_context * s, rdpe_t * drad, int n, int i, int j)
   return rdpe_ge (dtmp1, dtmp2);
 }
 
+/**
+ * @brief Largest binary exponent of the DPE numbers that are copied in a
+ * mps_disc_shadow, so that the squares of the differences of the copies
+ * cannot overflow.
+ */
+#define MPS_SHADOW_MAX_EXPONENT 500
+
+static mps_boolean
+mps_shadow_in_range (const rdpe_t e)
+{
+  return rdpe_Mnt (e) == 0.0 ||
+         (rdpe_Esp (e) < MPS_SHADOW_MAX_EXPONENT && rdpe_Esp (e) > -MPS_SHADOW_MAX_EXPONENT);
+}
+
+static void
+mps_shadow_disc (mps_disc_shadow * shadow, cdpe_t center, rdpe_t rad, int n)
+{
+  rdpe_t r;
+
+  rdpe_mul_d (r, rad, (double) n);
+
+  shadow->valid = mps_shadow_in_range (cdpe_Re (center)) &&
+                  mps_shadow_in_range (cdpe_Im (center)) &&
+                  mps_shadow_in_range (r);
+
+  if (shadow->valid)
+    {
+      cdpe_get_x (shadow->center, center);
+      shadow->mod = cplx_mod (shadow->center);
+      shadow->rad = rdpe_get_d (r);
+    }
+}
+
+/**
+ * @brief Compute the floating point copies of the discs with centers
+ * in the DPE approximations and radii drad, for the isolation factor n.
+ *
+ * @param s mps_context struct.
+ * @param drad The inclusion radii.
+ * @param n The isolation factor, as in mps_dtouchnwt().
+ * @param shadow A vector of <code>s->n</code> mps_disc_shadow where the
+ * copies will be stored.
+ */
+MPS_PRIVATE void
+mps_dshadow_discs (mps_context * s, rdpe_t * drad, int n, mps_disc_shadow * shadow)
+{
+  int i;
+
+  for (i = 0; i < s->n; i++)
+    mps_shadow_disc (&shadow[i], s->root[i]->dvalue, drad[i], n);
+}
+
+/**
+ * @brief Compute the floating point copies of the discs with centers
+ * in the multiprecision approximations and radii drad, for the isolation
+ * factor n.
+ *
+ * @param s mps_context struct.
+ * @param drad The inclusion radii.
+ * @param n The isolation factor, as in mps_mtouchnwt().
+ * @param shadow A vector of <code>s->n</code> mps_disc_shadow where the
+ * copies will be stored.
+ */
+MPS_PRIVATE void
+mps_mshadow_discs (mps_context * s, rdpe_t * drad, int n, mps_disc_shadow * shadow)
+{
+  cdpe_t ctmp;
+  int i;
+
+  for (i = 0; i < s->n; i++)
+    {
+      mpc_get_cdpe (ctmp, s->root[i]->mvalue);
+      mps_shadow_disc (&shadow[i], ctmp, drad[i], n);
+    }
+}
+
+/**
+ * @brief Decide if the i-th and the j-th discs touch using their
+ * floating point copies.
+ *
+ * The centers are known with a relative error of at most 2 ulp, and
+ * the distance and the radii are computed with a few more roundings, so
+ * the result is certain if the sum of the radii and the distance of the
+ * centers differ by more than the margin below. The last term of the
+ * margin accounts for the squares that underflow.
+ *
+ * @return 1 if the discs touch, 0 if they do not, and -1 if the copies
+ * are not accurate enough to decide.
+ */
+static int
+mps_shadow_touch (mps_disc_shadow * shadow, int i, int j)
+{
+  double dx, dy, dist, sum, margin;
+
+  if (!shadow[i].valid || !shadow[j].valid)
+    return -1;
+
+  dx = fabs (cplx_Re (shadow[i].center) - cplx_Re (shadow[j].center));
+  dy = fabs (cplx_Im (shadow[i].center) - cplx_Im (shadow[j].center));
+  sum = shadow[i].rad + shadow[j].rad;
+  margin = 4 * DBL_EPSILON * (shadow[i].mod + shadow[j].mod + dx + dy + sum) +
+           ldexp (1.0, -MPS_SHADOW_MAX_EXPONENT);
+
+  /* Most of the pairs are far from each other, and the distance of the
+   * centers is at least the largest of dx and dy. */
+  if (sum + margin < MAX (dx, dy))
+    return 0;
+
+  dist = sqrt (dx * dx + dy * dy);
+
+  if (sum >= dist + margin)
+    return 1;
+  if (sum + margin < dist)
+    return 0;
+
+  return -1;
+}
+
+/**
+ * @brief Check if the i-th and the j-th discs are newton-isolated,
+ * as mps_dtouchnwt(), deciding from the copies computed by
+ * mps_dshadow_discs() when they are accurate enough.
+ *
+ * @param s mps_context struct.
+ * @param shadow The copies of the discs with radii drad.
+ * @param drad The inclusion radii.
+ * @param n The isolation factor.
+ * @param i the first root.
+ * @param j the second root.
+ * @return false if the disc <code>i</code> and <code>j</code>
+ *   are newton-isolated.
+ */
+MPS_PRIVATE mps_boolean
+mps_dtouchnwt_shadow (mps_context * s, mps_disc_shadow * shadow, rdpe_t * drad, int n, int i, int j)
+{
+  int touch = mps_shadow_touch (shadow, i, j);
+
+  if (touch >= 0)
+    return touch;
+
+  return mps_dtouchnwt (s, drad, n, i, j);
+}
+
+/**
+ * @brief Check if the i-th and the j-th discs are newton-isolated,
+ * as mps_mtouchnwt(), deciding from the copies computed by
+ * mps_mshadow_discs() when they are accurate enough.
+ *
+ * @param s mps_context struct.
+ * @param shadow The copies of the discs with radii drad.
+ * @param drad The inclusion radii.
+ * @param n The isolation factor.
+ * @param i the first root.
+ * @param j the second root.
+ * @return false if the disc <code>i</code> and <code>j</code>
+ *   are newton-isolated.
+ */
+MPS_PRIVATE mps_boolean
+mps_mtouchnwt_shadow (mps_context * s, mps_disc_shadow * shadow, rdpe_t * drad, int n, int i, int j)
+{
+  int touch = mps_shadow_touch (shadow, i, j);
+
+  if (touch >= 0)
+    return touch;
+
+  return mps_mtouchnwt (s, drad, n, i, j);
+}
+
 /**
  * @brief Return true if the disk intersects the real axis, false otherwise (floating point version).
  *
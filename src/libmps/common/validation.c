@@ -24,6 +24,11 @@ switch_to_mp (mps_context * ctx)
       mps_mp_set_prec (ctx, 2 * DBL_MANT_DIG);
       mps_prepare_data (ctx, ctx->mpwp);
       break;
+
+    case MPS_ALGORITHM_AUTO:
+      /* mps_auto_mpsolve () replaces this with the selected algorithm
+       * before solving, so there is nothing to validate. */
+      break;
     }
 }
 
@@ -0,0 +1,394 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/********************************************************
+   The polynomial p_k and its derivative are computed by
+   running the recurrence
+     p_l = sum_j c_j(x) p_{l-1}^j,
+     p'_l = sum_j (c'_j(x) p_{l-1}^j + j c_j(x) p_{l-1}^{j-1} p'_{l-1}),
+   where c_j(x) = sum_i f_ij x^i, with a Horner scheme in y
+   that updates the value and the derivative at the same time.
+
+   The rounding errors are bounded by a running error analysis:
+   if e_{l-1} bounds the error on p_{l-1}, the one on p_l is
+   bounded by
+     e_l = |df/dy| e_{l-1} + u K sum_ij |f_ij| |x|^i |p_{l-1}|^j,
+   where |df/dy| is bounded with the moduli of the coefficients
+   and K = 4 (deg_x f + deg_y f + 2) accounts for the operations
+   of the Horner scheme.
+ **********************************************************/
+
+#include <float.h>
+#include <mps/mps.h>
+
+/**
+ * @brief Floating point evaluation of the composed polynomial and of its
+ * derivative.
+ *
+ * @param cp The polynomial to evaluate.
+ * @param x The point of evaluation.
+ * @param value The value of the polynomial in x.
+ * @param deriv The value of the derivative in x.
+ * @param error A bound to the absolute error on value.
+ */
+static void
+mps_composed_poly_fhorner (mps_composed_poly * cp, cplx_t x, cplx_t value,
+                           cplx_t deriv, double * error)
+{
+  int i, j, l, k;
+  double ax = cplx_mod (x);
+  double ay, a, e, rho, drho, cm;
+  cplx_t y, dy, v, dv, c, dc, tmp;
+
+  /* Base polynomial */
+  cplx_set (y, cp->fpc[cp->base_degree]);
+  cplx_set (dy, cplx_zero);
+  a = cp->fap[cp->base_degree];
+  for (i = cp->base_degree - 1; i >= 0; i--)
+    {
+      cplx_mul_eq (dy, x);
+      cplx_add_eq (dy, y);
+      cplx_mul_eq (y, x);
+      cplx_add_eq (y, cp->fpc[i]);
+      a = a * ax + cp->fap[i];
+    }
+  e = 4.0 * (cp->base_degree + 1) * a;
+
+  for (l = 1; l <= cp->levels; l++)
+    {
+      ay = cplx_mod (y);
+      cplx_set (v, cplx_zero);
+      cplx_set (dv, cplx_zero);
+      rho = drho = 0.0;
+
+      for (j = cp->y_degree; j >= 0; j--)
+        {
+          k = MPS_COMPOSED_POLY_INDEX (cp, cp->x_degree, j);
+          cplx_set (c, cp->fpc[k]);
+          cplx_set (dc, cplx_zero);
+          cm = cp->fap[k];
+          for (i = cp->x_degree - 1; i >= 0; i--)
+            {
+              k = MPS_COMPOSED_POLY_INDEX (cp, i, j);
+              cplx_mul_eq (dc, x);
+              cplx_add_eq (dc, c);
+              cplx_mul_eq (c, x);
+              cplx_add_eq (c, cp->fpc[k]);
+              cm = cm * ax + cp->fap[k];
+            }
+
+          cplx_mul_eq (dv, y);
+          cplx_mul (tmp, v, dy);
+          cplx_add_eq (dv, tmp);
+          cplx_add_eq (dv, dc);
+          cplx_mul_eq (v, y);
+          cplx_add_eq (v, c);
+
+          drho = drho * ay + rho;
+          rho = rho * ay + cm;
+        }
+
+      e = drho * e + 4.0 * (cp->x_degree + cp->y_degree + 2) * rho;
+      cplx_set (y, v);
+      cplx_set (dy, dv);
+    }
+
+  cplx_set (value, y);
+  if (deriv)
+    cplx_set (deriv, dy);
+  *error = e * DBL_EPSILON;
+}
+
+/**
+ * @brief DPE version of mps_composed_poly_fhorner().
+ */
+static void
+mps_composed_poly_dhorner (mps_composed_poly * cp, cdpe_t x, cdpe_t value,
+                           cdpe_t deriv, rdpe_t error)
+{
+  int i, j, l, k;
+  rdpe_t ax, ay, a, rho, drho, cm, rtmp;
+  cdpe_t y, dy, v, dv, c, dc, tmp;
+
+  cdpe_mod (ax, x);
+
+  /* Base polynomial */
+  cdpe_set (y, cp->dpc[cp->base_degree]);
+  cdpe_set (dy, cdpe_zero);
+  rdpe_set (a, cp->dap[cp->base_degree]);
+  for (i = cp->base_degree - 1; i >= 0; i--)
+    {
+      cdpe_mul_eq (dy, x);
+      cdpe_add_eq (dy, y);
+      cdpe_mul_eq (y, x);
+      cdpe_add_eq (y, cp->dpc[i]);
+      rdpe_mul_eq (a, ax);
+      rdpe_add_eq (a, cp->dap[i]);
+    }
+  rdpe_mul_d (error, a, 4.0 * (cp->base_degree + 1));
+
+  for (l = 1; l <= cp->levels; l++)
+    {
+      cdpe_mod (ay, y);
+      cdpe_set (v, cdpe_zero);
+      cdpe_set (dv, cdpe_zero);
+      rdpe_set (rho, rdpe_zero);
+      rdpe_set (drho, rdpe_zero);
+
+      for (j = cp->y_degree; j >= 0; j--)
+        {
+          k = MPS_COMPOSED_POLY_INDEX (cp, cp->x_degree, j);
+          cdpe_set (c, cp->dpc[k]);
+          cdpe_set (dc, cdpe_zero);
+          rdpe_set (cm, cp->dap[k]);
+          for (i = cp->x_degree - 1; i >= 0; i--)
+            {
+              k = MPS_COMPOSED_POLY_INDEX (cp, i, j);
+              cdpe_mul_eq (dc, x);
+              cdpe_add_eq (dc, c);
+              cdpe_mul_eq (c, x);
+              cdpe_add_eq (c, cp->dpc[k]);
+              rdpe_mul_eq (cm, ax);
+              rdpe_add_eq (cm, cp->dap[k]);
+            }
+
+          cdpe_mul_eq (dv, y);
+          cdpe_mul (tmp, v, dy);
+          cdpe_add_eq (dv, tmp);
+          cdpe_add_eq (dv, dc);
+          cdpe_mul_eq (v, y);
+          cdpe_add_eq (v, c);
+
+          rdpe_mul_eq (drho, ay);
+          rdpe_add_eq (drho, rho);
+          rdpe_mul_eq (rho, ay);
+          rdpe_add_eq (rho, cm);
+        }
+
+      rdpe_mul_eq (error, drho);
+      rdpe_mul_d (rtmp, rho, 4.0 * (cp->x_degree + cp->y_degree + 2));
+      rdpe_add_eq (error, rtmp);
+      cdpe_set (y, v);
+      cdpe_set (dy, dv);
+    }
+
+  cdpe_set (value, y);
+  if (deriv)
+    cdpe_set (deriv, dy);
+  rdpe_mul_eq_d (error, DBL_EPSILON);
+}
+
+/**
+ * @brief Multiprecision version of mps_composed_poly_fhorner(). The
+ * computation is carried out with the precision of value.
+ */
+static void
+mps_composed_poly_mhorner (mps_composed_poly * cp, mpc_t x, mpc_t value,
+                           mpc_t deriv, rdpe_t error)
+{
+  int i, j, l, k;
+  long int wp = mpc_get_prec (value);
+  rdpe_t ax, ay, a, rho, drho, cm, rtmp;
+  mpc_t y, dy, v, dv, c, dc, tmp;
+
+  mpc_init2 (y, wp);
+  mpc_init2 (dy, wp);
+  mpc_init2 (v, wp);
+  mpc_init2 (dv, wp);
+  mpc_init2 (c, wp);
+  mpc_init2 (dc, wp);
+  mpc_init2 (tmp, wp);
+
+  mpc_rmod (ax, x);
+
+  /* Base polynomial */
+  mpc_set (y, cp->mfpc[cp->base_degree]);
+  mpc_set_ui (dy, 0U, 0U);
+  rdpe_set (a, cp->dap[cp->base_degree]);
+  for (i = cp->base_degree - 1; i >= 0; i--)
+    {
+      mpc_mul_eq (dy, x);
+      mpc_add_eq (dy, y);
+      mpc_mul_eq (y, x);
+      mpc_add_eq (y, cp->mfpc[i]);
+      rdpe_mul_eq (a, ax);
+      rdpe_add_eq (a, cp->dap[i]);
+    }
+  rdpe_mul_d (error, a, 4.0 * (cp->base_degree + 1));
+
+  for (l = 1; l <= cp->levels; l++)
+    {
+      mpc_rmod (ay, y);
+      mpc_set_ui (v, 0U, 0U);
+      mpc_set_ui (dv, 0U, 0U);
+      rdpe_set (rho, rdpe_zero);
+      rdpe_set (drho, rdpe_zero);
+
+      for (j = cp->y_degree; j >= 0; j--)
+        {
+          k = MPS_COMPOSED_POLY_INDEX (cp, cp->x_degree, j);
+          mpc_set (c, cp->mfpc[k]);
+          mpc_set_ui (dc, 0U, 0U);
+          rdpe_set (cm, cp->dap[k]);
+          for (i = cp->x_degree - 1; i >= 0; i--)
+            {
+              k = MPS_COMPOSED_POLY_INDEX (cp, i, j);
+              mpc_mul_eq (dc, x);
+              mpc_add_eq (dc, c);
+              mpc_mul_eq (c, x);
+              mpc_add_eq (c, cp->mfpc[k]);
+              rdpe_mul_eq (cm, ax);
+              rdpe_add_eq (cm, cp->dap[k]);
+            }
+
+          mpc_mul_eq (dv, y);
+          mpc_mul (tmp, v, dy);
+          mpc_add_eq (dv, tmp);
+          mpc_add_eq (dv, dc);
+          mpc_mul_eq (v, y);
+          mpc_add_eq (v, c);
+
+          rdpe_mul_eq (drho, ay);
+          rdpe_add_eq (drho, rho);
+          rdpe_mul_eq (rho, ay);
+          rdpe_add_eq (rho, cm);
+        }
+
+      rdpe_mul_eq (error, drho);
+      rdpe_mul_d (rtmp, rho, 4.0 * (cp->x_degree + cp->y_degree + 2));
+      rdpe_add_eq (error, rtmp);
+      mpc_set (y, v);
+      mpc_set (dy, dv);
+    }
+
+  mpc_set (value, y);
+  if (deriv)
+    mpc_set (deriv, dy);
+  rdpe_set_2dl (rtmp, 1.0, -wp);
+  rdpe_mul_eq (error, rtmp);
+
+  mpc_clear (y);
+  mpc_clear (dy);
+  mpc_clear (v);
+  mpc_clear (dv);
+  mpc_clear (c);
+  mpc_clear (dc);
+  mpc_clear (tmp);
+}
+
+mps_boolean
+mps_composed_poly_feval (mps_context * ctx, mps_polynomial * poly, cplx_t x, cplx_t value, double * error)
+{
+  double err;
+
+  mps_composed_poly_fhorner (MPS_COMPOSED_POLY (poly), x, value, NULL, &err);
+  if (error)
+    *error = err;
+
+  return true;
+}
+
+mps_boolean
+mps_composed_poly_deval (mps_context * ctx, mps_polynomial * poly, cdpe_t x, cdpe_t value, rdpe_t error)
+{
+  mps_composed_poly_dhorner (MPS_COMPOSED_POLY (poly), x, value, NULL, error);
+  return true;
+}
+
+mps_boolean
+mps_composed_poly_meval (mps_context * ctx, mps_polynomial * poly, mpc_t x, mpc_t value, rdpe_t error)
+{
+  long int wp = mpc_get_prec (x);
+  mpc_t v;
+
+  /* Make sure that we have sufficient precision to perform the computation */
+  mps_polynomial_raise_data (ctx, poly, wp);
+
+  mpc_init2 (v, wp);
+  mps_composed_poly_mhorner (MPS_COMPOSED_POLY (poly), x, v, NULL, error);
+  mpc_set (value, v);
+  mpc_clear (v);
+
+  return true;
+}
+
+void
+mps_composed_poly_fnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, cplx_t corr)
+{
+  cplx_t p, pp;
+  double apeps, ap, app;
+
+  mps_composed_poly_fhorner (MPS_COMPOSED_POLY (poly), root->fvalue, p, pp, &apeps);
+  cplx_div (corr, p, pp);
+
+  ap = cplx_mod (p);
+  app = cplx_mod (pp);
+
+  root->again = ap > apeps;
+  root->frad = poly->degree * (ap + apeps) / app;
+}
+
+void
+mps_composed_poly_dnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, cdpe_t corr)
+{
+  cdpe_t p, pp;
+  rdpe_t apeps, ap, app, ax;
+
+  mps_composed_poly_dhorner (MPS_COMPOSED_POLY (poly), root->dvalue, p, pp, apeps);
+  cdpe_div (corr, p, pp);
+
+  cdpe_mod (ap, p);
+  cdpe_mod (app, pp);
+
+  root->again = rdpe_gt (ap, apeps);
+
+  rdpe_add (root->drad, ap, apeps);
+  rdpe_mul_eq_d (root->drad, (double) poly->degree);
+  rdpe_div_eq (root->drad, app);
+  if (rdpe_eq (root->drad, rdpe_zero))
+    {
+      cdpe_mod (ax, root->dvalue);
+      rdpe_mul_d (root->drad, ax, 4.0 * poly->degree * DBL_EPSILON);
+    }
+}
+
+void
+mps_composed_poly_mnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, mpc_t corr,
+                           long int wp)
+{
+  mpc_t p, pp;
+  rdpe_t apeps, ap, app, ax;
+
+  mps_polynomial_raise_data (ctx, poly, wp);
+
+  mpc_init2 (p, wp);
+  mpc_init2 (pp, wp);
+
+  mps_composed_poly_mhorner (MPS_COMPOSED_POLY (poly), root->mvalue, p, pp, apeps);
+  mpc_div (corr, p, pp);
+
+  mpc_rmod (ap, p);
+  mpc_rmod (app, pp);
+
+  root->again = rdpe_gt (ap, apeps);
+
+  rdpe_add (root->drad, ap, apeps);
+  rdpe_mul_eq_d (root->drad, (double) poly->degree);
+  rdpe_div_eq (root->drad, app);
+  if (rdpe_eq (root->drad, rdpe_zero))
+    {
+      mpc_rmod (ax, root->mvalue);
+      rdpe_set_2dl (apeps, 4.0 * poly->degree, -wp);
+      rdpe_mul (root->drad, ax, apeps);
+    }
+
+  mpc_clear (p);
+  mpc_clear (pp);
+}
@@ -0,0 +1,353 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <string.h>
+
+void mps_composed_poly_free (mps_context * ctx, mps_polynomial * poly);
+long int mps_composed_poly_raise_data (mps_context * ctx, mps_polynomial * poly, long int wp);
+void mps_composed_poly_get_leading_coefficient (mps_context * ctx, mps_polynomial * poly, mpc_t lc);
+
+/* These are implemented in composed-evaluation.c */
+mps_boolean mps_composed_poly_feval (mps_context * ctx, mps_polynomial * poly, cplx_t x, cplx_t value, double * error);
+mps_boolean mps_composed_poly_deval (mps_context * ctx, mps_polynomial * poly, cdpe_t x, cdpe_t value, rdpe_t error);
+mps_boolean mps_composed_poly_meval (mps_context * ctx, mps_polynomial * poly, mpc_t x, mpc_t value, rdpe_t error);
+void mps_composed_poly_fnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, cplx_t corr);
+void mps_composed_poly_dnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, cdpe_t corr);
+void mps_composed_poly_mnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, mpc_t corr,
+                                long int wp);
+
+/* These are implemented in composed-starting.c */
+void mps_composed_poly_fstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
+void mps_composed_poly_dstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
+
+mps_composed_poly *
+mps_composed_poly_new (mps_context * ctx, int base_degree, int x_degree,
+                       int y_degree, int levels)
+{
+  mps_composed_poly * cp = mps_new (mps_composed_poly);
+  int n = base_degree + 1 + (x_degree + 1) * (y_degree + 1);
+
+  /* The degree is computed when the coefficients are set. */
+  MPS_POLYNOMIAL (cp)->degree = 0;
+  mps_polynomial_init (ctx, MPS_POLYNOMIAL (cp));
+
+  MPS_POLYNOMIAL (cp)->structure = MPS_STRUCTURE_REAL_INTEGER;
+  MPS_POLYNOMIAL (cp)->density = MPS_DENSITY_USER;
+
+  cp->levels = levels;
+  cp->base_degree = base_degree;
+  cp->x_degree = x_degree;
+  cp->y_degree = y_degree;
+  cp->n_coeffs = n;
+
+  cp->degrees = mps_newv (int, levels + 1);
+  memset (cp->degrees, -1, sizeof(int) * (levels + 1));
+
+  cp->rational_real_coeffs = mps_newv (mpq_t, n);
+  cp->rational_imag_coeffs = mps_newv (mpq_t, n);
+  mpq_vinit (cp->rational_real_coeffs, n);
+  mpq_vinit (cp->rational_imag_coeffs, n);
+
+  cp->fpc = cplx_valloc (n);
+  cp->dpc = cdpe_valloc (n);
+  cp->mfpc = mpc_valloc (n);
+  cp->fap = mps_newv (double, n);
+  cp->dap = rdpe_valloc (n);
+
+  mpc_vinit2 (cp->mfpc, n, ctx->mpwp);
+  cplx_vinit (cp->fpc, n);
+  cdpe_vinit (cp->dpc, n);
+  memset (cp->fap, 0, sizeof(double) * n);
+  rdpe_vinit (cp->dap, n);
+
+  /* Construct the polynomial vtable */
+  MPS_POLYNOMIAL (cp)->free = mps_composed_poly_free;
+  MPS_POLYNOMIAL (cp)->raise_data = mps_composed_poly_raise_data;
+  MPS_POLYNOMIAL (cp)->feval = mps_composed_poly_feval;
+  MPS_POLYNOMIAL (cp)->deval = mps_composed_poly_deval;
+  MPS_POLYNOMIAL (cp)->meval = mps_composed_poly_meval;
+  MPS_POLYNOMIAL (cp)->fnewton = mps_composed_poly_fnewton;
+  MPS_POLYNOMIAL (cp)->dnewton = mps_composed_poly_dnewton;
+  MPS_POLYNOMIAL (cp)->mnewton = mps_composed_poly_mnewton;
+  MPS_POLYNOMIAL (cp)->fstart = mps_composed_poly_fstart;
+  MPS_POLYNOMIAL (cp)->dstart = mps_composed_poly_dstart;
+  MPS_POLYNOMIAL (cp)->get_leading_coefficient = mps_composed_poly_get_leading_coefficient;
+
+  MPS_POLYNOMIAL (cp)->type_name = MPS_COMPOSED_POLY_TYPE_NAME;
+
+  pthread_mutex_init (&cp->precision_mutex, NULL);
+
+  return cp;
+}
+
+void
+mps_composed_poly_free (mps_context * ctx, mps_polynomial * poly)
+{
+  mps_composed_poly * cp = MPS_COMPOSED_POLY (poly);
+
+  mpc_vclear (cp->mfpc, cp->n_coeffs);
+  mpq_vclear (cp->rational_real_coeffs, cp->n_coeffs);
+  mpq_vclear (cp->rational_imag_coeffs, cp->n_coeffs);
+
+  mpc_vfree (cp->mfpc);
+  cplx_vfree (cp->fpc);
+  cdpe_vfree (cp->dpc);
+  free (cp->fap);
+  rdpe_vfree (cp->dap);
+
+  free (cp->rational_real_coeffs);
+  free (cp->rational_imag_coeffs);
+  free (cp->degrees);
+
+  pthread_mutex_destroy (&cp->precision_mutex);
+
+  free (poly);
+}
+
+long int
+mps_composed_poly_raise_data (mps_context * ctx, mps_polynomial * poly, long int wp)
+{
+  mps_composed_poly * cp = MPS_COMPOSED_POLY (poly);
+  int i;
+
+  pthread_mutex_lock (&cp->precision_mutex);
+
+  /* The coefficients are left untouched if they are already accurate
+   * enough, so that the concurrent evaluations are not disturbed. */
+  if (wp <= mpc_get_prec (cp->mfpc[0]))
+    {
+      pthread_mutex_unlock (&cp->precision_mutex);
+      return mpc_get_prec (cp->mfpc[0]);
+    }
+
+  /* Regenerate the coefficients from the exact input. */
+  for (i = 0; i < cp->n_coeffs; i++)
+    {
+      mpc_set_prec (cp->mfpc[i], wp);
+      mpf_set_q (mpc_Re (cp->mfpc[i]), cp->rational_real_coeffs[i]);
+      mpf_set_q (mpc_Im (cp->mfpc[i]), cp->rational_imag_coeffs[i]);
+    }
+
+  pthread_mutex_unlock (&cp->precision_mutex);
+
+  return mpc_get_prec (cp->mfpc[0]);
+}
+
+static mps_boolean
+mps_composed_poly_coefficient_is_zero (mps_composed_poly * cp, int k)
+{
+  return mpq_sgn (cp->rational_real_coeffs[k]) == 0 &&
+         mpq_sgn (cp->rational_imag_coeffs[k]) == 0;
+}
+
+/**
+ * @brief Degree of the term \f$f_{ij} x^i p_{l-1}(x)^j\f$, or -1 if it is
+ * zero.
+ */
+static int
+mps_composed_poly_term_degree (mps_composed_poly * cp, int i, int j, int previous_degree)
+{
+  if (mps_composed_poly_coefficient_is_zero (cp, MPS_COMPOSED_POLY_INDEX (cp, i, j)))
+    return -1;
+
+  if (j == 0)
+    return i;
+
+  if (previous_degree < 0)
+    return -1;
+
+  return i + j * previous_degree;
+}
+
+/**
+ * @brief Recompute the degrees of the levels and the structure of the
+ * polynomial after a change in the coefficients.
+ */
+static void
+mps_composed_poly_update (mps_context * ctx, mps_composed_poly * cp)
+{
+  mps_polynomial * poly = MPS_POLYNOMIAL (cp);
+  mps_boolean real = true, integer = true;
+  int i, j, l, d;
+
+  for (i = 0; i < cp->n_coeffs; i++)
+    {
+      if (mpq_sgn (cp->rational_imag_coeffs[i]) != 0)
+        real = false;
+      if (mpz_cmp_ui (mpq_denref (cp->rational_real_coeffs[i]), 1U) != 0 ||
+          mpz_cmp_ui (mpq_denref (cp->rational_imag_coeffs[i]), 1U) != 0)
+        integer = false;
+    }
+
+  if (real)
+    poly->structure = integer ? MPS_STRUCTURE_REAL_INTEGER : MPS_STRUCTURE_REAL_RATIONAL;
+  else
+    poly->structure = integer ? MPS_STRUCTURE_COMPLEX_INTEGER : MPS_STRUCTURE_COMPLEX_RATIONAL;
+
+  cp->degrees[0] = -1;
+  for (i = 0; i <= cp->base_degree; i++)
+    if (!mps_composed_poly_coefficient_is_zero (cp, i))
+      cp->degrees[0] = i;
+
+  for (l = 1; l <= cp->levels; l++)
+    {
+      cp->degrees[l] = -1;
+      for (j = 0; j <= cp->y_degree; j++)
+        for (i = 0; i <= cp->x_degree; i++)
+          {
+            d = mps_composed_poly_term_degree (cp, i, j, cp->degrees[l - 1]);
+            cp->degrees[l] = MAX (cp->degrees[l], d);
+          }
+    }
+
+  poly->degree = cp->degrees[cp->levels];
+}
+
+static void
+mps_composed_poly_set_coefficient (mps_context * ctx, mps_composed_poly * cp, int k,
+                                   mpq_t real_part, mpq_t imag_part)
+{
+  mpq_set (cp->rational_real_coeffs[k], real_part);
+  mpq_set (cp->rational_imag_coeffs[k], imag_part);
+
+  mpf_set_q (mpc_Re (cp->mfpc[k]), real_part);
+  mpf_set_q (mpc_Im (cp->mfpc[k]), imag_part);
+
+  mpc_get_cplx (cp->fpc[k], cp->mfpc[k]);
+  mpc_get_cdpe (cp->dpc[k], cp->mfpc[k]);
+  cp->fap[k] = cplx_mod (cp->fpc[k]);
+  cdpe_mod (cp->dap[k], cp->dpc[k]);
+
+  mps_composed_poly_update (ctx, cp);
+}
+
+void
+mps_composed_poly_set_base_coefficient_q (mps_context * ctx, mps_composed_poly * cp, int i,
+                                          mpq_t real_part, mpq_t imag_part)
+{
+  if (i < 0 || i > cp->base_degree)
+    {
+      mps_error (ctx, "Coefficient index out of the bounds of the base polynomial");
+      return;
+    }
+
+  mps_composed_poly_set_coefficient (ctx, cp, i, real_part, imag_part);
+}
+
+void
+mps_composed_poly_set_base_coefficient_i (mps_context * ctx, mps_composed_poly * cp, int i,
+                                          long int real_part, long int imag_part)
+{
+  mpq_t re, im;
+
+  mpq_init (re);
+  mpq_init (im);
+  mpq_set_si (re, real_part, 1L);
+  mpq_set_si (im, imag_part, 1L);
+
+  mps_composed_poly_set_base_coefficient_q (ctx, cp, i, re, im);
+
+  mpq_clear (re);
+  mpq_clear (im);
+}
+
+void
+mps_composed_poly_set_coefficient_q (mps_context * ctx, mps_composed_poly * cp, int i, int j,
+                                     mpq_t real_part, mpq_t imag_part)
+{
+  if (i < 0 || i > cp->x_degree || j < 0 || j > cp->y_degree)
+    {
+      mps_error (ctx, "Coefficient index out of the bounds of the step map");
+      return;
+    }
+
+  mps_composed_poly_set_coefficient (ctx, cp, MPS_COMPOSED_POLY_INDEX (cp, i, j),
+                                     real_part, imag_part);
+}
+
+void
+mps_composed_poly_set_coefficient_i (mps_context * ctx, mps_composed_poly * cp, int i, int j,
+                                     long int real_part, long int imag_part)
+{
+  mpq_t re, im;
+
+  mpq_init (re);
+  mpq_init (im);
+  mpq_set_si (re, real_part, 1L);
+  mpq_set_si (im, imag_part, 1L);
+
+  mps_composed_poly_set_coefficient_q (ctx, cp, i, j, re, im);
+
+  mpq_clear (re);
+  mpq_clear (im);
+}
+
+/**
+ * @brief Compute the leading coefficient of the polynomial through the
+ * recurrence \f$\mathrm{lc}(p_l) = \sum f_{ij} \mathrm{lc}(p_{l-1})^j\f$,
+ * where the sum runs over the terms of maximum degree.
+ */
+void
+mps_composed_poly_get_leading_coefficient (mps_context * ctx, mps_polynomial * poly, mpc_t lc)
+{
+  mps_composed_poly * cp = MPS_COMPOSED_POLY (poly);
+  long int wp = mpc_get_prec (lc);
+  mpc_t previous, term, coeff;
+  int i, j, l;
+
+  if (poly->degree < 0)
+    {
+      mpc_set_ui (lc, 0U, 0U);
+      return;
+    }
+
+  mpc_init2 (previous, wp);
+  mpc_init2 (term, wp);
+  mpc_init2 (coeff, wp);
+
+  if (cp->degrees[0] >= 0)
+    {
+      mpf_set_q (mpc_Re (previous), cp->rational_real_coeffs[cp->degrees[0]]);
+      mpf_set_q (mpc_Im (previous), cp->rational_imag_coeffs[cp->degrees[0]]);
+    }
+  else
+    mpc_set_ui (previous, 0U, 0U);
+
+  for (l = 1; l <= cp->levels; l++)
+    {
+      mpc_set_ui (lc, 0U, 0U);
+
+      for (j = 0; j <= cp->y_degree; j++)
+        for (i = 0; i <= cp->x_degree; i++)
+          {
+            int k = MPS_COMPOSED_POLY_INDEX (cp, i, j);
+
+            if (cp->degrees[l] < 0 ||
+                mps_composed_poly_term_degree (cp, i, j, cp->degrees[l - 1]) != cp->degrees[l])
+              continue;
+
+            mpf_set_q (mpc_Re (coeff), cp->rational_real_coeffs[k]);
+            mpf_set_q (mpc_Im (coeff), cp->rational_imag_coeffs[k]);
+
+            mpc_pow_si (term, previous, j);
+            mpc_mul_eq (term, coeff);
+            mpc_add_eq (lc, term);
+          }
+
+      mpc_set (previous, lc);
+    }
+
+  mpc_set (lc, previous);
+
+  mpc_clear (previous);
+  mpc_clear (term);
+  mpc_clear (coeff);
+}
@@ -0,0 +1,449 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <float.h>
+#include <math.h>
+#include <mps/mps.h>
+
+#define pi2 6.283184
+
+/**
+ * @brief Polynomials of degree lower than this are started from the unit
+ * circle, as the general polynomials.
+ */
+#define MPS_COMPOSED_POLY_HIERARCHICAL_DEGREE 32
+
+/**
+ * @brief Maximum degree of the equations solved to compute the preimages
+ * of a point.
+ */
+#define MPS_COMPOSED_POLY_PREIMAGE_DEGREE 16
+
+/**
+ * @brief Maximum number of Aberth iterations used to compute the
+ * preimages of a point.
+ */
+#define MPS_COMPOSED_POLY_PREIMAGE_ITERATIONS 100
+
+/*! @cond PRIVATE */
+typedef struct {
+  /**
+   * @brief Coefficients of the polynomial \f$g\f$ whose preimages are
+   * computed.
+   */
+  cplx_t * coeffs;
+
+  /**
+   * @brief Degree of \f$g\f$.
+   */
+  int degree;
+
+  /**
+   * @brief The points \f$r\f$ whose preimages are computed.
+   */
+  cplx_t * targets;
+
+  /**
+   * @brief Range of the targets handled by this job.
+   */
+  int first, last;
+
+  /**
+   * @brief Output vector, where the roots of \f$g(y) - r_k\f$ are stored
+   * starting from the position <code>k * degree</code>.
+   */
+  cplx_t * roots;
+} mps_composed_preimage_job;
+/*! @endcond */
+
+/**
+ * @brief Approximate the roots of \f$g(y) - r\f$, where \f$g\f$ has degree
+ * at most MPS_COMPOSED_POLY_PREIMAGE_DEGREE, with the Aberth method in
+ * floating point.
+ *
+ * The results are only used as starting points, so no inclusion radius is
+ * computed.
+ */
+static void
+mps_composed_froots (cplx_t * coeffs, int n, cplx_t target, cplx_t * roots)
+{
+  cplx_t a[MPS_COMPOSED_POLY_PREIMAGE_DEGREE + 1];
+  double ap[MPS_COMPOSED_POLY_PREIMAGE_DEGREE + 1];
+  mps_boolean again[MPS_COMPOSED_POLY_PREIMAGE_DEGREE];
+  cplx_t p, pp, abcorr, corr, tmp;
+  double r = 0.0, az, apz;
+  int i, t, s, it, n_again;
+
+  for (i = 0; i <= n; i++)
+    cplx_set (a[i], coeffs[i]);
+  cplx_sub_eq (a[0], target);
+
+  if (n == 1)
+    {
+      cplx_div (roots[0], a[0], a[1]);
+      cplx_neg_eq (roots[0]);
+      return;
+    }
+
+  /* Start from a circle whose radius is a rough estimate of the moduli
+   * of the roots. */
+  for (i = 0; i <= n; i++)
+    ap[i] = cplx_mod (a[i]);
+  for (i = 0; i < n; i++)
+    r = MAX (r, pow (ap[i] / ap[n], 1.0 / (n - i)));
+  if (r == 0.0)
+    r = 1.0;
+
+  for (t = 0; t < n; t++)
+    {
+      cplx_set_d (roots[t], r * cos (pi2 * t / n + 0.4), r * sin (pi2 * t / n + 0.4));
+      again[t] = true;
+    }
+
+  n_again = n;
+  for (it = 0; it < MPS_COMPOSED_POLY_PREIMAGE_ITERATIONS && n_again > 0; it++)
+    {
+      for (t = 0; t < n; t++)
+        {
+          if (!again[t])
+            continue;
+
+          az = cplx_mod (roots[t]);
+          cplx_set (p, a[n]);
+          cplx_set (pp, cplx_zero);
+          apz = ap[n];
+          for (i = n - 1; i >= 0; i--)
+            {
+              cplx_mul_eq (pp, roots[t]);
+              cplx_add_eq (pp, p);
+              cplx_mul_eq (p, roots[t]);
+              cplx_add_eq (p, a[i]);
+              apz = apz * az + ap[i];
+            }
+
+          if (cplx_mod (p) <= 4.0 * n * DBL_EPSILON * apz || cplx_eq_zero (pp))
+            {
+              again[t] = false;
+              n_again--;
+              continue;
+            }
+
+          cplx_set (abcorr, cplx_zero);
+          for (s = 0; s < n; s++)
+            {
+              if (s == t)
+                continue;
+              cplx_sub (tmp, roots[t], roots[s]);
+              if (!cplx_eq_zero (tmp))
+                {
+                  cplx_inv_eq (tmp);
+                  cplx_add_eq (abcorr, tmp);
+                }
+            }
+
+          /* corr = N / (1 - N * abcorr), where N = p / p' */
+          cplx_div (corr, p, pp);
+          cplx_mul (tmp, corr, abcorr);
+          cplx_sub (tmp, cplx_one, tmp);
+          cplx_div_eq (corr, tmp);
+          cplx_sub_eq (roots[t], corr);
+        }
+    }
+}
+
+static void *
+mps_composed_preimage_worker (void * data_ptr)
+{
+  mps_composed_preimage_job * job = (mps_composed_preimage_job *) data_ptr;
+  int k;
+
+  for (k = job->first; k < job->last; k++)
+    mps_composed_froots (job->coeffs, job->degree, job->targets[k],
+                         job->roots + k * job->degree);
+
+  return NULL;
+}
+
+/**
+ * @brief Compute the preimages of the points in targets through the
+ * polynomial with the given coefficients, splitting the work among the
+ * threads of the context.
+ */
+static void
+mps_composed_preimages (mps_context * ctx, cplx_t * coeffs, int degree,
+                        cplx_t * targets, int n_targets, cplx_t * roots)
+{
+  int n_jobs = MAX (1, MIN (n_targets, ctx->n_threads));
+  int chunk = (n_targets + n_jobs - 1) / n_jobs;
+  mps_composed_preimage_job * jobs = mps_newv (mps_composed_preimage_job, n_jobs);
+  int i;
+
+  for (i = 0; i < n_jobs; i++)
+    {
+      jobs[i].coeffs = coeffs;
+      jobs[i].degree = degree;
+      jobs[i].targets = targets;
+      jobs[i].first = MIN (i * chunk, n_targets);
+      jobs[i].last = MIN ((i + 1) * chunk, n_targets);
+      jobs[i].roots = roots;
+
+      mps_thread_pool_assign (ctx, ctx->pool, mps_composed_preimage_worker, jobs + i);
+    }
+
+  mps_thread_pool_wait (ctx, ctx->pool);
+
+  free (jobs);
+}
+
+/**
+ * @brief Degree of the step map of a composition, that is of \f$g(y) =
+ * f(x, y)\f$, or -1 if the step map depends on \f$x\f$.
+ */
+static int
+mps_composed_poly_composition_degree (mps_composed_poly * cp)
+{
+  int i, j, degree = -1;
+
+  for (j = 0; j <= cp->y_degree; j++)
+    for (i = 0; i <= cp->x_degree; i++)
+      {
+        int k = MPS_COMPOSED_POLY_INDEX (cp, i, j);
+
+        if (mpq_sgn (cp->rational_real_coeffs[k]) == 0 &&
+            mpq_sgn (cp->rational_imag_coeffs[k]) == 0)
+          continue;
+
+        if (i > 0)
+          return -1;
+
+        degree = j;
+      }
+
+  return degree;
+}
+
+/**
+ * @brief Starting points for the composition \f$g^{\circ k} \circ p_0\f$.
+ *
+ * The roots are exactly the preimages of 0 through \f$k\f$ applications
+ * of \f$g\f$ followed by one of \f$p_0\f$, so they are computed one level
+ * at a time by solving \f$g(y) = r\f$ for every point \f$r\f$ of the
+ * previous level, in parallel.
+ */
+static void
+mps_composed_poly_preimage_fstart (mps_context * ctx, mps_composed_poly * cp, int g_degree,
+                                   mps_approximation ** approximations)
+{
+  int n = MPS_POLYNOMIAL (cp)->degree;
+  cplx_t * g = cplx_valloc (g_degree + 1);
+  cplx_t * targets = cplx_valloc (n);
+  cplx_t * preimages = cplx_valloc (n);
+  cplx_t * swap;
+  int i, l, count = 1;
+
+  MPS_DEBUG_WITH_INFO (ctx, "Computing the starting points as preimages of %d levels", cp->levels);
+
+  for (i = 0; i <= g_degree; i++)
+    cplx_set (g[i], cp->fpc[MPS_COMPOSED_POLY_INDEX (cp, 0, i)]);
+
+  cplx_set (targets[0], cplx_zero);
+  for (l = 0; l < cp->levels; l++)
+    {
+      mps_composed_preimages (ctx, g, g_degree, targets, count, preimages);
+      count *= g_degree;
+
+      swap = targets;
+      targets = preimages;
+      preimages = swap;
+    }
+
+  mps_composed_preimages (ctx, cp->fpc, cp->degrees[0], targets, count, preimages);
+
+  for (i = 0; i < n; i++)
+    cplx_set (approximations[i]->fvalue, preimages[i]);
+
+  cplx_vfree (g);
+  cplx_vfree (targets);
+  cplx_vfree (preimages);
+}
+
+/**
+ * @brief Create the composed polynomial with the same coefficients of cp
+ * and one level less.
+ */
+static mps_composed_poly *
+mps_composed_poly_lower (mps_context * ctx, mps_composed_poly * cp)
+{
+  mps_composed_poly * lower = mps_composed_poly_new (ctx, cp->base_degree, cp->x_degree,
+                                                     cp->y_degree, cp->levels - 1);
+  int i, j;
+
+  for (i = 0; i <= cp->base_degree; i++)
+    mps_composed_poly_set_base_coefficient_q (ctx, lower, i,
+                                              cp->rational_real_coeffs[i],
+                                              cp->rational_imag_coeffs[i]);
+
+  for (j = 0; j <= cp->y_degree; j++)
+    for (i = 0; i <= cp->x_degree; i++)
+      {
+        int k = MPS_COMPOSED_POLY_INDEX (cp, i, j);
+        mps_composed_poly_set_coefficient_q (ctx, lower, i, j,
+                                             cp->rational_real_coeffs[k],
+                                             cp->rational_imag_coeffs[k]);
+      }
+
+  return lower;
+}
+
+/**
+ * @brief Starting points obtained from the roots of the previous level.
+ *
+ * The roots of \f$p_{k-1}\f$ are approximated in a separate mps_context,
+ * where the same strategy is applied recursively, with a single packet of
+ * Aberth iterations. Each of them is then used as the center of
+ * \f$\lfloor d_k / d_{k-1} \rfloor\f$ starting points of \f$p_k\f$, and the
+ * remaining ones are placed on a circle that encloses all the others.
+ *
+ * @return false if the roots of the previous level could not be computed.
+ */
+static mps_boolean
+mps_composed_poly_lift_fstart (mps_context * ctx, mps_composed_poly * cp,
+                               mps_approximation ** approximations)
+{
+  int n = MPS_POLYNOMIAL (cp)->degree;
+  int e = cp->degrees[cp->levels - 1];
+  int i, t, m, k = 0;
+  double sigma, radius = 0.0;
+  mps_approximation ** lower_approximations;
+  mps_composed_poly * lower;
+  mps_context * rctx;
+
+  if (e < 1)
+    return false;
+
+  MPS_DEBUG_WITH_INFO (ctx, "Lifting the %d roots of the level %d to the level %d", e,
+                       cp->levels - 1, cp->levels);
+
+  rctx = mps_context_new ();
+  lower = mps_composed_poly_lower (rctx, cp);
+
+  mps_context_add_debug_domain (rctx, ctx->debug_level);
+  mps_context_select_algorithm (rctx, MPS_ALGORITHM_SECULAR_GA);
+  mps_context_set_output_goal (rctx, MPS_OUTPUT_GOAL_ISOLATE);
+  mps_context_set_output_prec (rctx, 16);
+  mps_context_set_avoid_multiprecision (rctx, true);
+  mps_context_set_crude_approximation_mode (rctx, true);
+
+  mps_context_set_input_poly (rctx, MPS_POLYNOMIAL (lower));
+  mps_mpsolve (rctx);
+
+  lower_approximations = mps_context_has_errors (rctx) ? NULL : mps_context_get_approximations (rctx);
+
+  if (!lower_approximations)
+    {
+      mps_polynomial_free (rctx, MPS_POLYNOMIAL (lower));
+      mps_context_free (rctx);
+      return false;
+    }
+
+  sigma = (ctx->random_seed) ? drand () : 0.66 * PI / n;
+  m = n / e;
+
+  for (i = 0; i < e; i++)
+    {
+      cplx_t r;
+      double rho;
+
+      cplx_set (r, lower_approximations[i]->fvalue);
+      radius = MAX (radius, cplx_mod (r));
+      rho = 0.5 * (1.0 + cplx_mod (r)) / n;
+
+      for (t = 0; t < m; t++, k++)
+        {
+          cplx_set_d (approximations[k]->fvalue,
+                      cplx_Re (r) + rho * cos (pi2 * t / m + sigma),
+                      cplx_Im (r) + rho * sin (pi2 * t / m + sigma));
+        }
+    }
+
+  for (t = 0; k < n; t++, k++)
+    {
+      cplx_set_d (approximations[k]->fvalue,
+                  (1.0 + radius) * cos (pi2 * t / (n - m * e) + sigma),
+                  (1.0 + radius) * sin (pi2 * t / (n - m * e) + sigma));
+    }
+
+  for (i = 0; i < e; i++)
+    mps_approximation_free (rctx, lower_approximations[i]);
+  free (lower_approximations);
+
+  mps_polynomial_free (rctx, MPS_POLYNOMIAL (lower));
+  mps_context_free (rctx);
+
+  return true;
+}
+
+/**
+ * @brief Select the starting points for a composed polynomial.
+ *
+ * The compositions whose maps have small degree are started from the
+ * preimages of 0, and the other polynomials from the roots of the
+ * previous level. Polynomials of small degree are started from the unit
+ * circle.
+ */
+void
+mps_composed_poly_fstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations)
+{
+  mps_composed_poly * cp = MPS_COMPOSED_POLY (poly);
+  int g_degree;
+
+  if (poly->degree < MPS_COMPOSED_POLY_HIERARCHICAL_DEGREE || cp->levels == 0)
+    {
+      mps_general_fstart (ctx, poly, approximations);
+      return;
+    }
+
+  g_degree = mps_composed_poly_composition_degree (cp);
+
+  if (g_degree >= 1 && g_degree <= MPS_COMPOSED_POLY_PREIMAGE_DEGREE &&
+      cp->degrees[0] >= 1 && cp->degrees[0] <= MPS_COMPOSED_POLY_PREIMAGE_DEGREE)
+    {
+      mps_composed_poly_preimage_fstart (ctx, cp, g_degree, approximations);
+      return;
+    }
+
+  if (!mps_composed_poly_lift_fstart (ctx, cp, approximations))
+    mps_general_fstart (ctx, poly, approximations);
+}
+
+/**
+ * @brief DPE version of mps_composed_poly_fstart(). The starting points
+ * are computed in floating point and then converted.
+ */
+void
+mps_composed_poly_dstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations)
+{
+  int i;
+
+  mps_composed_poly_fstart (ctx, poly, approximations);
+
+  for (i = 0; i < poly->degree; i++)
+    {
+      if (!isfinite (cplx_Re (approximations[i]->fvalue)) ||
+          !isfinite (cplx_Im (approximations[i]->fvalue)))
+        {
+          mps_general_dstart (ctx, poly, approximations);
+          return;
+        }
+    }
+
+  for (i = 0; i < poly->degree; i++)
+    cdpe_set_x (approximations[i]->dvalue, approximations[i]->fvalue);
+}
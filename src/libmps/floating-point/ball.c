@@ -0,0 +1,237 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+
+/* Factor applied to every result, that covers the few roundings of a
+ * fused operation in double precision. */
+#define MPS_MAG_ROUND (1.0 + 4 * DBL_EPSILON)
+
+/* Addends smaller than 2^-MPS_MAG_NBT times the other one are dropped,
+ * and covered by MPS_MAG_ROUND. */
+#define MPS_MAG_NBT 100
+
+static long
+mps_mag_esp_add (long e1, long e2)
+{
+  if (e1 > 0 && e2 > LONG_MAX - e1)
+    return LONG_MAX;
+  return e1 + e2;
+}
+
+static void
+mps_mag_set_2dl (rdpe_t r, double m, long e)
+{
+  int k;
+
+  if (m == 0.0)
+    {
+      rdpe_set (r, rdpe_zero);
+      return;
+    }
+
+  rdpe_Mnt (r) = frexp (m * MPS_MAG_ROUND, &k);
+  if (k > 0 && e > LONG_MAX - k)
+    rdpe_set (r, RDPE_MAX);
+  else
+    rdpe_Esp (r) = e + k;
+}
+
+/* Set r to an upper bound to m 2^e + b, with m >= 0. */
+static void
+mps_mag_add_2dl (rdpe_t r, double m, long e, const rdpe_t b)
+{
+  long delta;
+
+  if (rdpe_Mnt (b) == 0.0)
+    {
+      mps_mag_set_2dl (r, m, e);
+      return;
+    }
+  if (m == 0.0)
+    {
+      rdpe_set (r, b);
+      return;
+    }
+
+  delta = e - rdpe_Esp (b);
+  if (delta >= 0)
+    {
+      if (delta <= MPS_MAG_NBT)
+        m += ldexp (rdpe_Mnt (b), -delta);
+    }
+  else if (delta >= -MPS_MAG_NBT)
+    {
+      m = ldexp (m, delta) + rdpe_Mnt (b);
+      e = rdpe_Esp (b);
+    }
+  else
+    {
+      m = rdpe_Mnt (b);
+      e = rdpe_Esp (b);
+    }
+
+  mps_mag_set_2dl (r, m, e);
+}
+
+/**
+ * @brief Set r to an upper bound to the modulus of c.
+ *
+ * @param r The bound to \f$|c|\f$.
+ * @param c The multiprecision complex number.
+ */
+void
+mps_mag_set_mpc (rdpe_t r, mpc_t c)
+{
+  long int er, ei;
+  double dr = fabs (mpf_get_d_2exp (&er, mpc_Re (c)));
+  double di = fabs (mpf_get_d_2exp (&ei, mpc_Im (c)));
+
+  if (dr == 0.0)
+    {
+      mps_mag_set_2dl (r, di, ei);
+      return;
+    }
+  if (di == 0.0)
+    {
+      mps_mag_set_2dl (r, dr, er);
+      return;
+    }
+
+  if (er >= ei)
+    di = (er - ei > MPS_MAG_NBT) ? 0.0 : ldexp (di, ei - er);
+  else
+    {
+      dr = (ei - er > MPS_MAG_NBT) ? 0.0 : ldexp (dr, er - ei);
+      er = ei;
+    }
+
+  mps_mag_set_2dl (r, sqrt (dr * dr + di * di), er);
+}
+
+/**
+ * @brief Set r to an upper bound to a + b, for non negative a and b.
+ */
+void
+mps_mag_add (rdpe_t r, const rdpe_t a, const rdpe_t b)
+{
+  mps_mag_add_2dl (r, rdpe_Mnt (a), rdpe_Esp (a), b);
+}
+
+/**
+ * @brief Set r to an upper bound to a * b, for non negative a and b.
+ */
+void
+mps_mag_mul (rdpe_t r, const rdpe_t a, const rdpe_t b)
+{
+  mps_mag_set_2dl (r, rdpe_Mnt (a) * rdpe_Mnt (b),
+                   mps_mag_esp_add (rdpe_Esp (a), rdpe_Esp (b)));
+}
+
+/**
+ * @brief Set r to an upper bound to a * d, for non negative a and d.
+ */
+void
+mps_mag_mul_d (rdpe_t r, const rdpe_t a, double d)
+{
+  mps_mag_set_2dl (r, rdpe_Mnt (a) * d, rdpe_Esp (a));
+}
+
+/**
+ * @brief Set r to an upper bound to a * b + c, for non negative a, b
+ * and c. The result is normalized only once.
+ */
+void
+mps_mag_fma (rdpe_t r, const rdpe_t a, const rdpe_t b, const rdpe_t c)
+{
+  mps_mag_add_2dl (r, rdpe_Mnt (a) * rdpe_Mnt (b),
+                   mps_mag_esp_add (rdpe_Esp (a), rdpe_Esp (b)), c);
+}
+
+/**
+ * @brief Set r to an upper bound to a * d + c, for non negative a, d
+ * and c. The result is normalized only once.
+ */
+void
+mps_mag_fma_d (rdpe_t r, const rdpe_t a, double d, const rdpe_t c)
+{
+  mps_mag_add_2dl (r, rdpe_Mnt (a) * d, rdpe_Esp (a), c);
+}
+
+/**
+ * @brief Init a ball whose midpoint has precision <code>prec</code>, and
+ * set it to zero.
+ */
+void
+mps_mball_init2 (mps_mball * b, long int prec)
+{
+  mpc_init2 (b->mid, prec);
+  mpc_set_ui (b->mid, 0U, 0U);
+  rdpe_set (b->rad, rdpe_zero);
+
+  /* Bound to the error of a product and a sum of complex numbers, the
+   * former being computed with three real multiplications. */
+  rdpe_set_2dl (b->eps, 1.0, 5 - prec);
+}
+
+/**
+ * @brief Free the midpoint of a ball.
+ */
+void
+mps_mball_clear (mps_mball * b)
+{
+  mpc_clear (b->mid);
+}
+
+/**
+ * @brief Set the ball to the rounding of c to the precision of the
+ * midpoint.
+ *
+ * @param b The ball.
+ * @param c The value of the midpoint.
+ * @param ac An upper bound to \f$|c|\f$.
+ */
+void
+mps_mball_set_mpc (mps_mball * b, mpc_t c, const rdpe_t ac)
+{
+  mpc_set (b->mid, c);
+  mps_mag_mul (b->rad, ac, b->eps);
+}
+
+/**
+ * @brief Replace b with a ball containing \f$b x + c\f$, i.e., perform
+ * a step of the Horner scheme.
+ *
+ * The point x is assumed to be exact, while c is rounded to the
+ * precision of the midpoint.
+ *
+ * @param b The ball.
+ * @param x The multiplier.
+ * @param ax An upper bound to \f$|x|\f$.
+ * @param c The addend.
+ * @param ac An upper bound to \f$|c|\f$.
+ */
+void
+mps_mball_fma (mps_mball * b, mpc_t x, const rdpe_t ax, mpc_t c, const rdpe_t ac)
+{
+  rdpe_t r;
+
+  /* The new radius is (rad + eps |mid|) |x| + eps |c| */
+  mps_mag_set_mpc (r, b->mid);
+  mps_mag_fma (r, r, b->eps, b->rad);
+  mps_mag_mul (r, r, ax);
+  mps_mag_fma (b->rad, ac, b->eps, r);
+
+  mpc_mul_eq (b->mid, x);
+  mpc_add_eq (b->mid, c);
+}
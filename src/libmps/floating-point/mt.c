@@ -2234,11 +2234,11 @@ cdpe_div_eq (cdpe_t rc, const cdpe_t c)
   cdpe_smod (e1, c);
   cdpe_div_e (t, c, e1);
   rdpe_Mnt (cdpe_Im (t)) = -rdpe_Mnt (cdpe_Im (t));
-  rdpe_mul (e1, cdpe_Re (c), cdpe_Re (t));
-  rdpe_mul (e2, cdpe_Im (c), cdpe_Im (t));
+  rdpe_mul (e1, cdpe_Re (rc), cdpe_Re (t));
+  rdpe_mul (e2, cdpe_Im (rc), cdpe_Im (t));
   rdpe_sub (e3, e1, e2);
-  rdpe_mul (e1, cdpe_Im (c), cdpe_Re (t));
-  rdpe_mul (e2, cdpe_Re (c), cdpe_Im (t));
+  rdpe_mul (e1, cdpe_Im (rc), cdpe_Re (t));
+  rdpe_mul (e2, cdpe_Re (rc), cdpe_Im (t));
   rdpe_Move (cdpe_Re (rc), e3);
   rdpe_add (cdpe_Im (rc), e1, e2);
 }
@@ -9,6 +9,7 @@
  */
 
 #include <mps/mps.h>
+#include <math.h>
 #include <string.h>
 
 /**
@@ -40,63 +41,280 @@ void
 mps_fhessenberg_shifted_determinant (mps_context * ctx, cplx_t * hessenberg_matrix, const cplx_t shift, 
 				     size_t n, cplx_t output, long int *acc_exponent)
 {
-  cplx_t *vec = mps_newv (cplx_t, n);
-  size_t local_n = n;
-  int i, j;
-  *acc_exponent = 0;
+  cplx_t shifts[1];
 
-  /* Copy the last column in vec */
+  cplx_set (shifts[0], shift);
+  mps_fhessenberg_shifted_determinants (ctx, hessenberg_matrix, n, shifts, 1,
+                                        (cplx_t *) output, NULL, acc_exponent, NULL);
+}
+
+/**
+ * @brief Allocate a workspace for mps_fhessenberg_shifted_determinants().
+ *
+ * @param ctx The current mps_context
+ * @param n The size of the matrices. The workspace is enlarged when it is
+ * used with a larger one.
+ * @return A new workspace, to be freed with mps_hessenberg_workspace_free().
+ */
+mps_hessenberg_workspace *
+mps_hessenberg_workspace_new (mps_context * ctx, size_t n)
+{
+  mps_hessenberg_workspace * w = mps_new (mps_hessenberg_workspace);
+
+  w->n = MAX (n, 1);
+  w->slots = MAX (1, ctx->n_threads);
+  w->vec = mps_newv (cplx_t, w->slots * w->n * MPS_HESSENBERG_BLOCK);
+  w->dvec = mps_newv (cplx_t, w->slots * w->n * MPS_HESSENBERG_BLOCK);
+
+  return w;
+}
+
+/**
+ * @brief Free a workspace allocated with mps_hessenberg_workspace_new().
+ */
+void
+mps_hessenberg_workspace_free (mps_context * ctx, mps_hessenberg_workspace * w)
+{
+  free (w->vec);
+  free (w->dvec);
+  free (w);
+}
+
+struct mps_hessenberg_job {
+  cplx_t * matrix;
+  size_t n;
+  cplx_t * shifts;
+  int n_shifts;
+  cplx_t * output;
+  cplx_t * doutput;
+  long int * exponents;
+
+  /* Work vectors of this job, with MPS_HESSENBERG_BLOCK entries for each
+   * row of the matrix. */
+  cplx_t * vec;
+  cplx_t * dvec;
+
+  /* The job processes the blocks first, first + step, ... */
+  int first;
+  int step;
+};
+
+/* Compute the determinants for the shifts start, ..., start + b - 1. The
+ * work vectors store the values for the b shifts of a row one after the
+ * other, so that every element of the matrix is read once per block. */
+static void
+mps_fhessenberg_block (struct mps_hessenberg_job * job, int start, int b)
+{
+  cplx_t * matrix = job->matrix;
+  cplx_t * shifts = job->shifts + start;
+  cplx_t * vec = job->vec, * dvec = job->dvec;
+  mps_boolean derivative = (job->doutput != NULL);
+  size_t n = job->n, k, i;
+  long int exponents[MPS_HESSENBERG_BLOCK];
+  cplx_t s, t, d, sub;
+  int j;
+
+  /* Copy the last column in vec, for each shift */
   for (i = 0; i < n; i++)
+    for (j = 0; j < b; j++)
+      {
+        cplx_set (vec[i * MPS_HESSENBERG_BLOCK + j], MPS_MATRIX_ELEM (matrix, i, n - 1, n));
+        if (derivative)
+          cplx_set (dvec[i * MPS_HESSENBERG_BLOCK + j], cplx_zero);
+      }
+
+  for (j = 0; j < b; j++)
     {
-      cplx_set (vec[i], MPS_MATRIX_ELEM (hessenberg_matrix, i, n - 1, n));
+      cplx_sub_eq (vec[(n - 1) * MPS_HESSENBERG_BLOCK + j], shifts[j]);
+      if (derivative)
+        cplx_set_d (dvec[(n - 1) * MPS_HESSENBERG_BLOCK + j], -1.0, 0.0);
+      exponents[j] = 0;
     }
-  cplx_sub_eq (vec[n-1], shift);
 
-  while (local_n-- > 1)
+  for (k = n - 1; k > 0; k--)
     {
+      cplx_t * vk = vec + k * MPS_HESSENBERG_BLOCK;
+      cplx_t * dvk = dvec + k * MPS_HESSENBERG_BLOCK;
+      cplx_t * vl = vec + (k - 1) * MPS_HESSENBERG_BLOCK;
+      cplx_t * dvl = dvec + (k - 1) * MPS_HESSENBERG_BLOCK;
+
+      cplx_set (sub, MPS_MATRIX_ELEM (matrix, k, k - 1, n));
+
       /* Compress the last two cols of the matrix */
-      cplx_t t, s;
+      for (i = 0; i + 1 < k; i++)
+        {
+          cplx_t * vi = vec + i * MPS_HESSENBERG_BLOCK;
+          cplx_t * dvi = dvec + i * MPS_HESSENBERG_BLOCK;
+
+          cplx_set (d, MPS_MATRIX_ELEM (matrix, i, k - 1, n));
+
+          for (j = 0; j < b; j++)
+            {
+              cplx_mul (s, d, vk[j]);
+              cplx_mul (t, vi[j], sub);
+              cplx_sub (vi[j], s, t);
+            }
+
+          if (derivative)
+            for (j = 0; j < b; j++)
+              {
+                cplx_mul (s, d, dvk[j]);
+                cplx_mul (t, dvi[j], sub);
+                cplx_sub (dvi[j], s, t);
+              }
+        }
 
-      for (i = 0; i < local_n - 1; i++)
+      /* The last step require the extra accounting for the shifted case,
+       * and the derivative of the shift. */
+      for (j = 0; j < b; j++)
         {
-          cplx_mul (s, MPS_MATRIX_ELEM (hessenberg_matrix, i, local_n - 1, n), 
-		    vec[local_n]);
-          cplx_mul (t, vec[i], MPS_MATRIX_ELEM (hessenberg_matrix, local_n, local_n - 1, n));
-          cplx_sub (vec[i], s, t);
+          cplx_sub (d, MPS_MATRIX_ELEM (matrix, k - 1, k - 1, n), shifts[j]);
+
+          if (derivative)
+            {
+              cplx_mul (s, d, dvk[j]);
+              cplx_sub_eq (s, vk[j]);
+              cplx_mul (t, dvl[j], sub);
+              cplx_sub (dvl[j], s, t);
+            }
+
+          cplx_mul (s, d, vk[j]);
+          cplx_mul (t, vl[j], sub);
+          cplx_sub (vl[j], s, t);
         }
 
-      /* The last step require the extra accounting for the shifted case. */
-      cplx_sub (s, MPS_MATRIX_ELEM (hessenberg_matrix, local_n - 1, local_n - 1, n), shift);
-      cplx_mul_eq (s, vec[local_n]);
-      cplx_mul (t, vec[local_n-1], MPS_MATRIX_ELEM (hessenberg_matrix, local_n, local_n - 1, n));
-      cplx_sub (vec[local_n - 1], s, t);
-
-      if (i % 50 == 0)
-	{
-	  int exponent;
-	  double max = 0.0;
-
-	  for (j = 0; j < local_n; j++)
-	    {
-	      double m = cplx_mod (vec[j]);
-	      if (m > max)
-		max = m;
-	    }
-
-	  frexp (max, &exponent);
-	  max = pow(2.0, exponent);
-	  
-	  for (j = 0; j < local_n; j++)
-	    {
-	      cplx_div_eq_d (vec[j], max);
-	    }
-
-	  *acc_exponent += exponent;
-	}
+      /* Rescale the rows that are still in use by a power of 2, so that
+       * the determinants cannot overflow. */
+      if ((k - 1) % MPS_HESSENBERG_RESCALE == 0)
+        for (j = 0; j < b; j++)
+          {
+            int exponent;
+            double max = 0.0, scale;
+
+            for (i = 0; i < k; i++)
+              {
+                cplx_t * v = vec + i * MPS_HESSENBERG_BLOCK + j;
+                max = MAX (max, MAX (fabs (cplx_Re (*v)), fabs (cplx_Im (*v))));
+                if (derivative)
+                  {
+                    v = dvec + i * MPS_HESSENBERG_BLOCK + j;
+                    max = MAX (max, MAX (fabs (cplx_Re (*v)), fabs (cplx_Im (*v))));
+                  }
+              }
+
+            frexp (max, &exponent);
+            scale = ldexp (1.0, -exponent);
+
+            for (i = 0; i < k; i++)
+              {
+                cplx_mul_eq_d (vec[i * MPS_HESSENBERG_BLOCK + j], scale);
+                if (derivative)
+                  cplx_mul_eq_d (dvec[i * MPS_HESSENBERG_BLOCK + j], scale);
+              }
+
+            exponents[j] += exponent;
+          }
     }
 
-  cplx_set (output, *vec);
-  free (vec);
+  for (j = 0; j < b; j++)
+    {
+      cplx_set (job->output[start + j], vec[j]);
+      if (derivative)
+        cplx_set (job->doutput[start + j], dvec[j]);
+      job->exponents[start + j] = exponents[j];
+    }
+}
+
+static void *
+mps_fhessenberg_worker (void * data_ptr)
+{
+  struct mps_hessenberg_job * job = (struct mps_hessenberg_job *) data_ptr;
+  int start;
+
+  for (start = job->first * MPS_HESSENBERG_BLOCK; start < job->n_shifts;
+       start += job->step * MPS_HESSENBERG_BLOCK)
+    mps_fhessenberg_block (job, start, MIN (MPS_HESSENBERG_BLOCK, job->n_shifts - start));
+
+  return NULL;
+}
+
+/**
+ * @brief Compute the determinants of \f$H - \lambda_i I\f$ for a set of
+ * shifts \f$\lambda_i\f$, and optionally their derivatives with respect to
+ * \f$\lambda_i\f$.
+ *
+ * The shifts are processed in blocks of MPS_HESSENBERG_BLOCK, in a single
+ * pass over the matrix for each block, and the blocks are distributed
+ * among the threads of the pool of ctx.
+ *
+ * @param ctx The current mps_context
+ * @param hessenberg_matrix The hessenberg matrix, stored in row-major order.
+ * @param n The size of the matrix.
+ * @param shifts The values of \f$\lambda_i\f$.
+ * @param n_shifts The number of shifts.
+ * @param output The vector where the determinants will be stored.
+ * @param doutput The vector where the derivatives of the determinants will
+ * be stored, or NULL if they are not needed.
+ * @param exponents The i-th determinant and its derivative are
+ * <code>output[i]</code> and <code>doutput[i]</code> multiplied by
+ * \f$2^{exponents[i]}\f$.
+ * @param w A workspace allocated with mps_hessenberg_workspace_new(), or
+ * NULL to use a temporary one.
+ */
+void
+mps_fhessenberg_shifted_determinants (mps_context * ctx, cplx_t * hessenberg_matrix, size_t n,
+                                      cplx_t * shifts, int n_shifts, cplx_t * output,
+                                      cplx_t * doutput, long int * exponents,
+                                      mps_hessenberg_workspace * w)
+{
+  mps_hessenberg_workspace * workspace = w;
+  int blocks = (n_shifts + MPS_HESSENBERG_BLOCK - 1) / MPS_HESSENBERG_BLOCK;
+  int i, jobs;
+  struct mps_hessenberg_job * data;
+
+  if (n_shifts <= 0)
+    return;
+
+  if (workspace == NULL)
+    workspace = mps_hessenberg_workspace_new (ctx, n);
+  else if (workspace->n < n)
+    {
+      workspace->n = n;
+      workspace->vec = mps_realloc (workspace->vec, sizeof(cplx_t) * workspace->slots * n * MPS_HESSENBERG_BLOCK);
+      workspace->dvec = mps_realloc (workspace->dvec, sizeof(cplx_t) * workspace->slots * n * MPS_HESSENBERG_BLOCK);
+    }
+
+  /* Threads are only worth their synchronization on larger matrices. */
+  jobs = (n < MPS_HESSENBERG_THREAD_THRESHOLD) ? 1 : MIN (workspace->slots, blocks);
+  data = mps_newv (struct mps_hessenberg_job, jobs);
+
+  for (i = 0; i < jobs; i++)
+    {
+      data[i].matrix = hessenberg_matrix;
+      data[i].n = n;
+      data[i].shifts = shifts;
+      data[i].n_shifts = n_shifts;
+      data[i].output = output;
+      data[i].doutput = doutput;
+      data[i].exponents = exponents;
+      data[i].vec = workspace->vec + i * workspace->n * MPS_HESSENBERG_BLOCK;
+      data[i].dvec = workspace->dvec + i * workspace->n * MPS_HESSENBERG_BLOCK;
+      data[i].first = i;
+      data[i].step = jobs;
+
+      if (jobs == 1)
+        mps_fhessenberg_worker (data + i);
+      else
+        mps_thread_pool_assign (ctx, ctx->pool, mps_fhessenberg_worker, data + i);
+    }
+
+  if (jobs > 1)
+    mps_thread_pool_wait (ctx, ctx->pool);
+
+  free (data);
+
+  if (w == NULL)
+    mps_hessenberg_workspace_free (ctx, workspace);
 }
 
 /**
@@ -136,7 +354,7 @@ mps_dhessenberg_shifted_determinant (mps_context * ctx, cdpe_t * hessenberg_matr
     {
       cdpe_set (vec[i], MPS_MATRIX_ELEM (hessenberg_matrix, i, n - 1, n));
     }
-  cdpe_sub_eq (vec[n], shift);
+  cdpe_sub_eq (vec[n - 1], shift);
 
   while (local_n-- > 1)
     {
@@ -0,0 +1,608 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+
+/**
+ * @brief The relative error of a DPE sum or product is bounded by
+ * 2^-MPS_COUNT_EPS_EXPONENT, with a large margin.
+ */
+#define MPS_COUNT_EPS_EXPONENT 48
+
+/**
+ * @brief The bounds on the errors are enlarged by a factor
+ * 1 + 2^-MPS_COUNT_SAFETY_EXPONENT to take into account the rounding
+ * errors made when computing them.
+ */
+#define MPS_COUNT_SAFETY_EXPONENT 44
+
+/**
+ * @brief Maximum number of Graeffe iterations done before giving up.
+ */
+#define MPS_COUNT_MAX_GRAEFFE_STEPS 10
+
+/**
+ * @brief Polynomials of larger degree are counted with the standard
+ * iteration, since the Graeffe steps cost \f$O(n^2)\f$ each.
+ */
+#define MPS_COUNT_MAX_DEGREE 2048
+
+/**
+ * @brief Terms of the Graeffe iterates that are smaller than
+ * 2^-MPS_COUNT_MAX_SHIFT times the largest one are not computed, and
+ * only their modulus is added to the error bound.
+ */
+#define MPS_COUNT_MAX_SHIFT 900
+
+/**
+ * @brief Value of the exponent of a coefficient that is exactly zero.
+ */
+#define MPS_COUNT_ZERO_EXPONENT LONG_MIN
+
+/**
+ * @brief Coefficients of a polynomial scaled to the double range.
+ *
+ * The i-th coefficient is \f$(re_i + i \, im_i) 2^{e_i}\f$, with a bound
+ * \f$rad_i 2^{e_i}\f$ to its distance from the exact one, and \f$e_i\f$ is
+ * chosen so that all these numbers have modulus at most 1. mod[i] is
+ * \f$|re_i| + |im_i|\f$, an upper bound to the modulus.
+ */
+struct mps_count_scaled_poly {
+  double * re;
+  double * im;
+  double * mod;
+  double * rad;
+  long int * e;
+};
+
+struct mps_count_graeffe_data {
+  struct mps_count_scaled_poly * p;
+  cdpe_t * b;
+  rdpe_t * brad;
+  int n;
+  int first;
+  int step;
+};
+
+/**
+ * @brief Enlarge the error bound r to take into account the rounding
+ * errors made while computing it.
+ */
+static void
+mps_count_inflate (rdpe_t r)
+{
+  rdpe_t tmp;
+
+  rdpe_div_2exp (tmp, r, MPS_COUNT_SAFETY_EXPONENT);
+  rdpe_add_eq (r, tmp);
+}
+
+/**
+ * @brief Add to r a bound to the rounding error of an operation with
+ * result of modulus at most m.
+ */
+static void
+mps_count_add_rounding (rdpe_t r, const rdpe_t m)
+{
+  rdpe_t tmp;
+
+  rdpe_div_2exp (tmp, m, MPS_COUNT_EPS_EXPONENT);
+  rdpe_add_eq (r, tmp);
+}
+
+/**
+ * @brief Replace the polynomial with coefficients a[0], ..., a[n] by
+ * \f$p(x + t)\f$, with \f$t = \pm 1\f$.
+ *
+ * The computed coefficients differ from the exact ones by at most
+ * \f$2n\epsilon\f$ times the coefficients of \f$\hat p(x + 1)\f$, where
+ * \f$\hat p\f$ has coefficients \f$|a_i|\f$. The bound on the errors is
+ * then the shift by 1 of \f$rad_i + 2n\epsilon |a_i|\f$, that is computed
+ * together with the coefficients.
+ */
+static void
+mps_count_taylor_shift (cdpe_t * a, rdpe_t * rad, int n, int t)
+{
+  rdpe_t m;
+  int i, j;
+
+  for (i = 0; i <= n; i++)
+    {
+      cdpe_mod (m, a[i]);
+      rdpe_mul_eq_d (m, 2 * n + 2);
+      mps_count_add_rounding (rad[i], m);
+    }
+
+  for (i = 0; i < n; i++)
+    for (j = n - 1; j >= i; j--)
+      {
+        if (t > 0)
+          cdpe_add_eq (a[j], a[j + 1]);
+        else
+          cdpe_sub_eq (a[j], a[j + 1]);
+
+        rdpe_add_eq (rad[j], rad[j + 1]);
+      }
+
+  /* The sums in rad have been computed with a relative error bounded by
+   * n times the unit roundoff. */
+  for (i = 0; i <= n; i++)
+    {
+      rdpe_div_2exp (m, rad[i], MPS_COUNT_EPS_EXPONENT);
+      rdpe_mul_eq_d (m, n + 1);
+      rdpe_add_eq (rad[i], m);
+      mps_count_inflate (rad[i]);
+    }
+}
+
+/**
+ * @brief Map the right half-plane to the unit disc.
+ *
+ * The coefficients of p are replaced by the ones of
+ * \f$q(w) = (1 - w)^n p((1 + w) / (1 - w))\f$, whose roots in the unit
+ * disc are the images of the roots of p with positive real part. Since
+ * \f$z + 1 = 2 / (1 - w)\f$, q is obtained by shifting p by -1, reversing
+ * and scaling the coefficients, and shifting again.
+ */
+static void
+mps_count_moebius (cdpe_t * a, rdpe_t * rad, int n)
+{
+  int i;
+
+  mps_count_taylor_shift (a, rad, n, -1);
+
+  for (i = 0; i <= n; i++)
+    {
+      cdpe_mul_eq_2exp (a[i], (unsigned long int) i);
+      rdpe_mul_eq_2exp (rad[i], (unsigned long int) i);
+    }
+
+  for (i = 0; i < n - i; i++)
+    {
+      cdpe_swap (a[i], a[n - i]);
+      rdpe_swap (rad[i], rad[n - i]);
+    }
+
+  /* Compute s(1 + v), and then replace v by -w. */
+  mps_count_taylor_shift (a, rad, n, 1);
+  for (i = 1; i <= n; i += 2)
+    cdpe_neg_eq (a[i]);
+}
+
+/**
+ * @brief Compute the coefficients of the Graeffe iterate with index
+ * first, first + step, ...
+ *
+ * The coefficients of \f$(-1)^n p(x) p(-x) = q(x^2)\f$ are
+ * \f$b_i = (-1)^{n+i} (a_i^2 + 2 \sum_{l \geq 1} (-1)^l a_{i-l} a_{i+l})\f$.
+ * The exponent of the largest term is computed first, so that the sum
+ * can be carried out in floating point arithmetic.
+ */
+static void *
+mps_count_graeffe_worker (void * data_ptr)
+{
+  struct mps_count_graeffe_data * data = (struct mps_count_graeffe_data *) data_ptr;
+  struct mps_count_scaled_poly * p = data->p;
+  int i, l, n = data->n;
+  long int * e = p->e;
+
+  for (i = data->first; i <= n; i += data->step)
+    {
+      int terms = MIN (i, n - i), neglected = 0;
+      long int emax = MPS_COUNT_ZERO_EXPONENT;
+      double sr = 0.0, si = 0.0, prop = 0.0, mag = 0.0, scale;
+
+      for (l = 0; l <= terms; l++)
+        if (e[i - l] != MPS_COUNT_ZERO_EXPONENT && e[i + l] != MPS_COUNT_ZERO_EXPONENT)
+          emax = MAX (emax, e[i - l] + e[i + l]);
+
+      if (emax == MPS_COUNT_ZERO_EXPONENT)
+        {
+          cdpe_set (data->b[i], cdpe_zero);
+          rdpe_set (data->brad[i], rdpe_zero);
+          continue;
+        }
+
+      /* The terms with l > 0 appear twice, and the central one only once,
+       * so it is added after doubling the sum. */
+      for (l = terms; l >= 0; l--)
+        {
+          int j = i - l, k = i + l;
+          long int d;
+
+          if (l == 0)
+            {
+              sr *= 2;
+              si *= 2;
+              prop *= 2;
+              mag *= 2;
+            }
+
+          if (e[j] == MPS_COUNT_ZERO_EXPONENT || e[k] == MPS_COUNT_ZERO_EXPONENT)
+            continue;
+
+          d = e[j] + e[k] - emax;
+          if (d < -MPS_COUNT_MAX_SHIFT)
+            {
+              neglected += (l == 0) ? 1 : 2;
+              continue;
+            }
+
+          scale = ldexp (1.0, (int) d);
+          if (l & 1)
+            scale = -scale;
+
+          sr += (p->re[j] * p->re[k] - p->im[j] * p->im[k]) * scale;
+          si += (p->re[j] * p->im[k] + p->im[j] * p->re[k]) * scale;
+
+          scale = fabs (scale);
+          prop += (p->mod[j] * p->rad[k] + p->rad[j] * p->mod[k] + p->rad[j] * p->rad[k]) * scale;
+          mag += p->mod[j] * p->mod[k] * scale;
+        }
+
+      if ((n + i) & 1)
+        {
+          sr = -sr;
+          si = -si;
+        }
+
+      /* Rounding errors of the terms and of the sums, and the terms that
+       * have been neglected or may have underflowed, whose modulus is at
+       * most 4 * 2^-MPS_COUNT_MAX_SHIFT. */
+      prop += ldexp (mag * (2 * terms + 4), -MPS_COUNT_EPS_EXPONENT);
+      prop += ldexp ((double) (neglected + 2 * terms + 4), 2 - MPS_COUNT_MAX_SHIFT);
+
+      cdpe_set_2dl (data->b[i], sr, emax, si, emax);
+      rdpe_set_2dl (data->brad[i], prop, emax);
+      mps_count_inflate (data->brad[i]);
+    }
+
+  return NULL;
+}
+
+/**
+ * @brief Scale the coefficients in a and rad to the double range,
+ * storing them in p.
+ */
+static void
+mps_count_scale (struct mps_count_scaled_poly * p, cdpe_t * a, rdpe_t * rad, int n)
+{
+  int i;
+
+  for (i = 0; i <= n; i++)
+    {
+      long int e = MPS_COUNT_ZERO_EXPONENT;
+
+      if (rdpe_Mnt (cdpe_Re (a[i])) != 0.0)
+        e = MAX (e, rdpe_Esp (cdpe_Re (a[i])));
+      if (rdpe_Mnt (cdpe_Im (a[i])) != 0.0)
+        e = MAX (e, rdpe_Esp (cdpe_Im (a[i])));
+      if (rdpe_Mnt (rad[i]) != 0.0)
+        e = MAX (e, rdpe_Esp (rad[i]));
+
+      p->e[i] = e;
+      if (e == MPS_COUNT_ZERO_EXPONENT)
+        continue;
+
+      /* The components that are much smaller than 2^e underflow, but they
+       * are covered by the bound on the neglected terms in
+       * mps_count_graeffe_worker(). */
+      p->re[i] = ldexp (rdpe_Mnt (cdpe_Re (a[i])),
+                        (int) MAX (rdpe_Esp (cdpe_Re (a[i])) - e, -2 * MPS_COUNT_MAX_SHIFT));
+      p->im[i] = ldexp (rdpe_Mnt (cdpe_Im (a[i])),
+                        (int) MAX (rdpe_Esp (cdpe_Im (a[i])) - e, -2 * MPS_COUNT_MAX_SHIFT));
+      p->rad[i] = ldexp (rdpe_Mnt (rad[i]),
+                         (int) MAX (rdpe_Esp (rad[i]) - e, -2 * MPS_COUNT_MAX_SHIFT));
+      p->mod[i] = fabs (p->re[i]) + fabs (p->im[i]);
+    }
+}
+
+/**
+ * @brief Apply Pellet's test to the polynomial with coefficients in the
+ * discs of center a[i] and radius rad[i], and store the modulus of a[i]
+ * in mod[i].
+ *
+ * The ratio between the lower bound to the modulus of the largest
+ * coefficient and the upper bound to the sum of the moduli of the other
+ * ones, that must be larger than 1 for the test to succeed, is stored
+ * in ratio. It is zero if all the discs contain zero.
+ *
+ * @return The number of roots in the unit disc of every polynomial with
+ * coefficients in these discs, or -1 if the test fails.
+ */
+static int
+mps_count_pellet (cdpe_t * a, rdpe_t * rad, rdpe_t * mod, int n, rdpe_t ratio)
+{
+  rdpe_t lower, best, sum, rtmp;
+  int i, k = -1;
+
+  rdpe_set (best, rdpe_zero);
+  for (i = 0; i <= n; i++)
+    {
+      cdpe_mod (mod[i], a[i]);
+
+      /* The modulus is computed with a small relative error. */
+      rdpe_div_2exp (rtmp, mod[i], MPS_COUNT_EPS_EXPONENT);
+      rdpe_sub (lower, mod[i], rtmp);
+      rdpe_sub_eq (lower, rad[i]);
+
+      /* rdpe_gt() only compares correctly non-negative numbers. */
+      if (rdpe_Mnt (lower) > 0.0 && rdpe_gt (lower, best))
+        {
+          rdpe_set (best, lower);
+          k = i;
+        }
+    }
+
+  rdpe_set (ratio, rdpe_zero);
+  if (k < 0)
+    return -1;
+
+  rdpe_set (sum, rdpe_zero);
+  for (i = 0; i <= n; i++)
+    {
+      if (i == k)
+        continue;
+
+      rdpe_add_eq (sum, mod[i]);
+      rdpe_add_eq (sum, rad[i]);
+    }
+
+  /* Take into account the errors in the moduli and in the sum. */
+  rdpe_mul_d (rtmp, sum, n + 2);
+  mps_count_add_rounding (sum, rtmp);
+  mps_count_inflate (sum);
+
+  if (rdpe_Mnt (sum) == 0.0)
+    {
+      rdpe_set (ratio, RDPE_MAX);
+      return k;
+    }
+
+  rdpe_div (ratio, best, sum);
+  return rdpe_gt (best, sum) ? k : -1;
+}
+
+/**
+ * @brief Count the roots in the unit disc of the polynomials with
+ * coefficients in the discs of center a[i] and radius rad[i], for
+ * \f$i = 0, \dots, n\f$.
+ *
+ * Pellet's test is applied to the polynomial and to its Graeffe
+ * iterates, that are computed on the thread pool of s. The vectors a
+ * and rad are overwritten.
+ *
+ * @param s The current mps_context.
+ * @param a The centers of the coefficients.
+ * @param rad The radii of the coefficients.
+ * @param n The degree of the polynomial.
+ * @return The number of roots in the open unit disc, counted with
+ * multiplicity, if the test succeeded and certified that no root lies on
+ * the unit circle, or -1 otherwise.
+ */
+int
+mps_count_unit_disc (mps_context * s, cdpe_t * a, rdpe_t * rad, int n)
+{
+  cdpe_t * b = cdpe_valloc (n + 1);
+  rdpe_t * brad = rdpe_valloc (n + 1);
+  rdpe_t * mod = rdpe_valloc (n + 1);
+  int i, step, jobs = MAX (1, MIN (s->n_threads, n + 1)), k;
+  rdpe_t ratio, last_ratio;
+  struct mps_count_graeffe_data * data = mps_newv (struct mps_count_graeffe_data, jobs);
+  struct mps_count_scaled_poly p;
+
+  p.re = double_valloc (n + 1);
+  p.im = double_valloc (n + 1);
+  p.mod = double_valloc (n + 1);
+  p.rad = double_valloc (n + 1);
+  p.e = long_valloc (n + 1);
+
+  for (step = 0; ; step++)
+    {
+      k = mps_count_pellet (a, rad, mod, n, ratio);
+
+      if (k >= 0)
+        {
+          MPS_DEBUG_WITH_INFO (s, "Pellet's test succeeded after %d Graeffe steps", step);
+          break;
+        }
+
+      /* When the roots are separated from the unit circle the ratio
+       * eventually grows doubly exponentially, and it may only decrease
+       * slightly in the first steps. If it is halved the errors in the
+       * coefficients are growing faster, and the test will not succeed. */
+      if (rdpe_Mnt (ratio) == 0.0 || step == MPS_COUNT_MAX_GRAEFFE_STEPS ||
+          (step > 0 && rdpe_lt (ratio, last_ratio)))
+        break;
+
+      rdpe_div_2exp (last_ratio, ratio, 1U);
+
+      mps_count_scale (&p, a, rad, n);
+
+      for (i = 0; i < jobs; i++)
+        {
+          data[i].p = &p;
+          data[i].b = b;
+          data[i].brad = brad;
+          data[i].n = n;
+          data[i].first = i;
+          data[i].step = jobs;
+
+          if (jobs == 1)
+            mps_count_graeffe_worker (data + i);
+          else
+            mps_thread_pool_assign (s, s->pool, mps_count_graeffe_worker, data + i);
+        }
+
+      if (jobs > 1)
+        mps_thread_pool_wait (s, s->pool);
+
+      for (i = 0; i <= n; i++)
+        {
+          cdpe_set (a[i], b[i]);
+          rdpe_set (rad[i], brad[i]);
+        }
+    }
+
+  free (data);
+  free (p.re);
+  free (p.im);
+  free (p.mod);
+  free (p.rad);
+  free (p.e);
+  cdpe_vfree (b);
+  rdpe_vfree (brad);
+  rdpe_vfree (mod);
+
+  return k;
+}
+
+/**
+ * @brief Count the roots of the active polynomial in the search set
+ * without approximating them.
+ *
+ * This is used when the output goal is MPS_OUTPUT_GOAL_COUNT and the
+ * search set is the complex plane, the unit disc, its complement or a
+ * half-plane. The roots are then marked as included in the search set or
+ * excluded from it, so that mps_countroots() returns the certified count,
+ * but their approximations are left undetermined, with an infinite
+ * inclusion radius.
+ *
+ * @param s The current mps_context.
+ * @return false if the count is not supported for the search set, or if
+ * it cannot be certified, e.g., because there are roots on its boundary.
+ * In this case the polynomial must be solved with the selected
+ * algorithm. true if the roots have been counted.
+ */
+mps_boolean
+mps_count_mpsolve (mps_context * s)
+{
+  mps_polynomial * poly = s->active_poly;
+  mps_monomial_poly * p;
+  mps_search_set search_set = s->output_config->search_set;
+  cdpe_t * a, w, wi;
+  rdpe_t * rad, m;
+  int i, inside, n = s->n;
+
+  if (s->output_config->goal != MPS_OUTPUT_GOAL_COUNT ||
+      s->output_config->multiplicity || s->output_config->root_properties ||
+      !MPS_IS_MONOMIAL_POLY (poly) || s->distributed || s->resume_file ||
+      n < 1 || n > MPS_COUNT_MAX_DEGREE)
+    return false;
+
+  p = MPS_MONOMIAL_POLY (poly);
+
+  switch (search_set)
+    {
+    case MPS_SEARCH_SET_COMPLEX_PLANE:
+      inside = n;
+      break;
+
+    case MPS_SEARCH_SET_UNITARY_DISC:
+    case MPS_SEARCH_SET_UNITARY_DISC_COMPL:
+    case MPS_SEARCH_SET_POSITIVE_REAL_PART:
+    case MPS_SEARCH_SET_NEGATIVE_REAL_PART:
+    case MPS_SEARCH_SET_POSITIVE_IMAG_PART:
+    case MPS_SEARCH_SET_NEGATIVE_IMAG_PART:
+      a = cdpe_valloc (n + 1);
+      rad = rdpe_valloc (n + 1);
+
+      /* The half-planes are rotated to the right one, replacing p(z) by
+       * p(w z) with w = -1 or +-i. */
+      switch (search_set)
+        {
+        case MPS_SEARCH_SET_NEGATIVE_REAL_PART:
+          cdpe_set_d (w, -1.0, 0.0);
+          break;
+
+        case MPS_SEARCH_SET_POSITIVE_IMAG_PART:
+          cdpe_set (w, cdpe_i);
+          break;
+
+        case MPS_SEARCH_SET_NEGATIVE_IMAG_PART:
+          cdpe_set_d (w, 0.0, -1.0);
+          break;
+
+        default:
+          cdpe_set (w, cdpe_one);
+          break;
+        }
+
+      /* The powers of w have components in {0, 1, -1}, so the products
+       * are exact. */
+      cdpe_set (wi, cdpe_one);
+      for (i = 0; i <= n; i++)
+        {
+          cdpe_mul (a[i], p->dpc[i], wi);
+          cdpe_mul_eq (wi, w);
+        }
+
+      for (i = 0; i <= n; i++)
+        {
+          /* dpc is a truncation of the coefficients, that are only known
+           * up to the input precision if they are floating point. */
+          cdpe_mod (m, a[i]);
+          rdpe_div_2exp (rad[i], m, MPS_COUNT_EPS_EXPONENT);
+          if (MPS_STRUCTURE_IS_FP (poly->structure) && poly->prec > 0)
+            {
+              rdpe_div_eq_2exp (m, (unsigned long int) poly->prec);
+              rdpe_add_eq (rad[i], m);
+            }
+        }
+
+      if (search_set != MPS_SEARCH_SET_UNITARY_DISC &&
+          search_set != MPS_SEARCH_SET_UNITARY_DISC_COMPL)
+        mps_count_moebius (a, rad, n);
+
+      inside = mps_count_unit_disc (s, a, rad, n);
+
+      cdpe_vfree (a);
+      rdpe_vfree (rad);
+
+      if (inside < 0)
+        {
+          MPS_DEBUG_WITH_INFO (s, "The count of the roots cannot be certified, solving the polynomial");
+          return false;
+        }
+
+      if (search_set == MPS_SEARCH_SET_UNITARY_DISC_COMPL)
+        inside = n - inside;
+      break;
+
+    default:
+      return false;
+    }
+
+  MPS_DEBUG_WITH_INFO (s, "%d roots of %d are in the search set", inside, n);
+
+  mps_allocate_data (s);
+
+  for (i = 0; i < n; i++)
+    {
+      mps_approximation * root = s->root[i];
+
+      mpc_set_ui (root->mvalue, 0U, 0U);
+      cdpe_set (root->dvalue, cdpe_zero);
+      cplx_set (root->fvalue, cplx_zero);
+      rdpe_set (root->drad, RDPE_MAX);
+      root->frad = DBL_MAX;
+      root->status = MPS_ROOT_STATUS_CLUSTERED;
+      root->inclusion = (i < inside) ? MPS_ROOT_INCLUSION_IN : MPS_ROOT_INCLUSION_OUT;
+      s->order[i] = i;
+    }
+
+  s->lastphase = dpe_phase;
+  s->over_max = false;
+
+  return true;
+}
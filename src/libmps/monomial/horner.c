@@ -12,6 +12,8 @@
 
 
 #include <mps/mps.h>
+#include <math.h>
+#include <limits.h>
 
 MPS_PRIVATE void
 mps_mhorner_sparse (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t value);
@@ -77,7 +79,6 @@ mps_mhorner_with_error2 (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t
 {
   int i;
   rdpe_t apol, ax, u;
-  cdpe_t cx;
 
   pthread_mutex_lock (&p->mfpc_mutex[0]);
   if (mpc_get_prec (p->mfpc[0]) < wp)
@@ -98,24 +99,16 @@ mps_mhorner_with_error2 (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t
   mps_mhorner (s, p, x, value);
 
   /* Compute ap(|x|) using horner */
-  mpc_get_cdpe (cx, x);
-  cdpe_mod (ax, cx);
+  mps_mag_set_mpc (ax, x);
 
   rdpe_set (apol, p->dap[MPS_POLYNOMIAL (p)->degree]);
   for (i = MPS_POLYNOMIAL (p)->degree - 1; i >= 0; i--)
-    {
-      rdpe_mul_eq (apol, ax);
-      rdpe_add_eq (apol, p->dap[i]);
-    }
+    mps_mag_fma (apol, apol, ax, p->dap[i]);
 
   /* Compute ap(|x|) / |p(x)| */
-  mpc_get_cdpe (cx, value);
-  cdpe_mod (ax, cx);
-
-  rdpe_set (error, apol);
-  rdpe_add_eq (error, ax);
-
-  rdpe_mul_eq (error, u);
+  mps_mag_set_mpc (ax, value);
+  mps_mag_add (error, apol, ax);
+  mps_mag_mul (error, error, u);
 }
 
 /**
@@ -123,6 +116,8 @@ mps_mhorner_with_error2 (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t
  * and save it in <code>value</code>.
  *
  * A upper bound to the relative error of the evaluation will be stored in <code>relative_error</code>.
+ * The value is carried along the Horner scheme as a ball, whose radius is
+ * divided by \f$|p(x)|\f$ at the end.
  *
  * @param s The <code>mps_context</code> of the computation.
  * @param p The <code>monomial_poly</code> to evaluate.
@@ -135,53 +130,25 @@ mps_mhorner_with_error2 (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t
 MPS_PRIVATE void
 mps_mhorner_with_error (mps_context * s, mps_monomial_poly * p, mpc_t x, mpc_t value, rdpe_t relative_error, long int wp)
 {
-  int j, my_wp;
-  mpc_t ss;
-
-  cdpe_t cdtmp;
-  rdpe_t r_ss, r_value, pol_on_ss;
-  rdpe_t my_eps, rtmp;
+  int j;
+  mps_mball ss;
+  rdpe_t ax, r_value;
 
-  if (wp == 0)
-    my_wp = s->mpwp;
-  else
-    my_wp = wp;
+  mps_mball_init2 (&ss, (wp == 0) ? s->mpwp : wp);
 
-  /* Set up precision related variables */
-  rdpe_set_2dl (my_eps, 0.5, -my_wp);
+  mps_mag_set_mpc (ax, x);
 
-  /* Init multiprecision temporary values */
-  mpc_init2 (ss, my_wp);
+  mps_mball_set_mpc (&ss, p->mfpc[MPS_POLYNOMIAL (p)->degree],
+                     p->dap[MPS_POLYNOMIAL (p)->degree]);
+  for (j = MPS_POLYNOMIAL (p)->degree - 1; j >= 0; j--)
+    mps_mball_fma (&ss, x, ax, p->mfpc[j], p->dap[j]);
 
-  rdpe_set (relative_error, rdpe_zero);
+  mpc_set (value, ss.mid);
 
-  mpc_set (value, p->mfpc[MPS_POLYNOMIAL (p)->degree]);
-  for (j = MPS_POLYNOMIAL (p)->degree - 1; j >= 0; j--)
-    {
-      /* Normal horner computation */
-      mpc_mul (ss, value, x);
-      mpc_add_eq (ss, p->mfpc[j]);
-
-      /* Error estimate */
-      mpc_get_cdpe (cdtmp, ss);
-      cdpe_mod (r_ss, cdtmp);
-      mpc_get_cdpe (cdtmp, value);
-      cdpe_mod (r_value, cdtmp);
-
-      rdpe_div (pol_on_ss, r_value, r_ss);
-      rdpe_add (rtmp, relative_error, my_eps);
-      rdpe_mul_eq (rtmp, pol_on_ss);
-      rdpe_add_eq (relative_error, rtmp);
-
-      rdpe_div (rtmp, p->dap[j], r_ss);
-      rdpe_mul_eq (rtmp, my_eps);
-      rdpe_add_eq (relative_error, rtmp);
-
-      /* Update horner value */
-      mpc_set (value, ss);
-    }
+  mpc_rmod (r_value, value);
+  rdpe_div (relative_error, ss.rad, r_value);
 
-  mpc_clear (ss);
+  mps_mball_clear (&ss);
 }
 
 /**
@@ -380,3 +347,137 @@ mps_fhorner_with_error (mps_context * s, mps_monomial_poly * p, cplx_t x, cplx_t
 
   *error *= DBL_EPSILON;
 }
+
+/*
+ * Error-free transformations used by mps_dhorner_compensated(). The two
+ * functions return the rounded result and store the exact rounding error
+ * in <code>err</code>, so that <code>a + b = s + err</code> and
+ * <code>a * b = p + err</code> hold exactly.
+ */
+static inline double
+__mps_two_sum (double a, double b, double * err)
+{
+  double s = a + b;
+  double z = s - a;
+
+  *err = (a - (s - z)) + (b - z);
+  return s;
+}
+
+static inline double
+__mps_two_prod (double a, double b, double * err)
+{
+  double p = a * b;
+
+  *err = fma (a, b, -p);
+  return p;
+}
+
+/**
+ * @brief Evaluate the polynomial whose coefficients are
+ * <code>hi[i] + lo[i]</code> in the point <code>x</code> by means of the
+ * compensated Horner scheme, and give a certified bound to the absolute
+ * error of the result.
+ *
+ * The evaluation is carried out in standard floating point after scaling
+ * the point and the coefficients by powers of two, so that the range of the
+ * DPE numbers is never an issue and no overflow can happen. The rounding
+ * errors of the products and sums are recovered exactly with TwoProduct and
+ * TwoSum and accumulated in a second Horner scheme, which makes the result
+ * as accurate as if it was computed with twice the working precision. The
+ * error bound is
+ * \f[
+ *   u |\tilde p(x)| + 8 \gamma_{4n+4}^2 \, ap(|x|)
+ * \f]
+ * plus a term that accounts for gradual underflow in the scaled
+ * computation.
+ *
+ * @param s The <code>mps_context</code> of the computation.
+ * @param n The degree of the polynomial.
+ * @param hi The leading part of the coefficients.
+ * @param lo The trailing part of the coefficients. It may be NULL.
+ * @param ap The moduli of the coefficients.
+ * @param x The point where the polynomial will be evaluated.
+ * @param value The value computed by the function.
+ * @param error A bound to the absolute error of the computation.
+ */
+MPS_PRIVATE void
+mps_dhorner_compensated (mps_context * s, int n, cdpe_t * hi, cdpe_t * lo, rdpe_t * ap,
+                         cdpe_t x, cdpe_t value, rdpe_t error)
+{
+  int j;
+  long int ex, scale = LONG_MIN, sk;
+  double xr, xi, rr, ri, cr, ci, dr, di, apol;
+  double p1, p2, p3, p4, e1, e2, e3, e4, f1, f2, g1, g2, er, ei, tr, ti, ax;
+  double gamma, u = DBL_EPSILON / 2, eta = 8 * DBL_MIN * DBL_EPSILON;
+  rdpe_t rtmp;
+
+  /* Scale x so that |x| 2^(-ex) <= 1 */
+  cdpe_mod (rtmp, x);
+  ex = rdpe_eq_zero (rtmp) ? 0 : rdpe_Esp (rtmp);
+
+  xr = ldexp (rdpe_Mnt (cdpe_Re (x)), rdpe_Esp (cdpe_Re (x)) - ex);
+  xi = ldexp (rdpe_Mnt (cdpe_Im (x)), rdpe_Esp (cdpe_Im (x)) - ex);
+  ax = sqrt (xr * xr + xi * xi) * (1 + 2 * u);
+
+  /* Find the largest term |a_j| 2^(j ex) and use it to scale the coefficients
+   * so that they are all bounded by 1 in modulus. */
+  for (j = 0; j <= n; j++)
+    if (!rdpe_eq_zero (ap[j]) && rdpe_Esp (ap[j]) + j * ex > scale)
+      scale = rdpe_Esp (ap[j]) + j * ex;
+
+  if (scale == LONG_MIN)
+    {
+      cdpe_set (value, cdpe_zero);
+      rdpe_set (error, rdpe_zero);
+      return;
+    }
+
+  rr = ri = cr = ci = apol = 0.0;
+  for (j = n; j >= 0; j--)
+    {
+      sk = j * ex - scale;
+
+      /* Horner step on the leading part, r = r * x + hi[j], where all the
+       * rounding errors are collected in er and ei. */
+      p1 = __mps_two_prod (rr, xr, &e1);
+      p2 = __mps_two_prod (ri, xi, &e2);
+      p3 = __mps_two_prod (rr, xi, &e3);
+      p4 = __mps_two_prod (ri, xr, &e4);
+
+      tr = __mps_two_sum (p1, -p2, &f1);
+      ti = __mps_two_sum (p3, p4, &f2);
+
+      dr = ldexp (rdpe_Mnt (cdpe_Re (hi[j])), rdpe_Esp (cdpe_Re (hi[j])) + sk);
+      di = ldexp (rdpe_Mnt (cdpe_Im (hi[j])), rdpe_Esp (cdpe_Im (hi[j])) + sk);
+
+      rr = __mps_two_sum (tr, dr, &g1);
+      ri = __mps_two_sum (ti, di, &g2);
+
+      er = e1 - e2 + f1 + g1;
+      ei = e3 + e4 + f2 + g2;
+
+      /* Horner step on the errors and on the trailing part of the coefficients. */
+      tr = cr * xr - ci * xi + er;
+      ci = cr * xi + ci * xr + ei;
+      cr = tr;
+
+      if (lo)
+        {
+          cr += ldexp (rdpe_Mnt (cdpe_Re (lo[j])), rdpe_Esp (cdpe_Re (lo[j])) + sk);
+          ci += ldexp (rdpe_Mnt (cdpe_Im (lo[j])), rdpe_Esp (cdpe_Im (lo[j])) + sk);
+        }
+
+      /* Scaled ap(|x|) */
+      apol = apol * ax + ldexp (rdpe_Mnt (ap[j]), rdpe_Esp (ap[j]) + sk);
+    }
+
+  rr += cr;
+  ri += ci;
+
+  cdpe_set_2dl (value, rr, scale, ri, scale);
+
+  gamma = (4 * n + 4) * u / (1 - (4 * n + 4) * u);
+  rdpe_set_2dl (error, (u * sqrt (rr * rr + ri * ri) + 8 * gamma * gamma * apol * (1 + gamma) +
+                        (n + 1) * eta) * (1 + 4 * u), scale);
+}
@@ -135,20 +135,8 @@ mps_thread_fpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
 {
   int i, nzeros = 0, n_threads = s->n_threads;
 
+  mps_thread_workspace *w;
   mps_thread_worker_data *data;
-  pthread_mutex_t *aberth_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-  pthread_mutex_t *roots_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-
-  for (i = 0; i < s->n; i++)
-    {
-      pthread_mutex_init (roots_mutex + i, NULL);
-      pthread_mutex_init (aberth_mutex + i, NULL);
-    }
-
-  /* Create a new job queue */
-  mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
 
   *it = 0;
   *excep = false;
@@ -158,15 +146,11 @@ mps_thread_fpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
     if (!s->root[i]->again)
       nzeros++;
   if (nzeros == s->n)
-    {
-      free (roots_mutex);
-      free (aberth_mutex);
-      mps_thread_job_queue_free (queue);
-      return;
-    }
+    return;
 
-  data = (mps_thread_worker_data*)mps_malloc (sizeof(mps_thread_worker_data)
-                                              * n_threads);
+  /* Take mutexes, thread data and the job queue from the workspace */
+  w = mps_thread_workspace_get (s);
+  data = w->data;
 
   for (i = 0; i < n_threads; i++)
     {
@@ -176,9 +160,9 @@ mps_thread_fpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
       data[i].excep = excep;
       data[i].thread = i;
       data[i].n_threads = n_threads;
-      data[i].aberth_mutex = aberth_mutex;
-      data[i].roots_mutex = roots_mutex;
-      data[i].queue = queue;
+      data[i].aberth_mutex = w->aberth_mutex;
+      data[i].roots_mutex = w->roots_mutex;
+      data[i].queue = &w->queue;
       data[i].required_zeros = required_zeros;
       /* pthread_create (&threads[i], NULL, &mps_thread_fpolzer_worker, */
       /* data + i); */
@@ -186,11 +170,6 @@ mps_thread_fpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
     }
 
   mps_thread_pool_wait (s, s->pool);
-
-  free (data);
-  free (roots_mutex);
-  free (aberth_mutex);
-  mps_thread_job_queue_free (queue);
 }
 
 /**
@@ -299,8 +278,8 @@ mps_thread_dpolzer_worker (void *data_ptr)
 MPS_PRIVATE void
 mps_thread_dpolzer (mps_context * s, int *it, mps_boolean * excep, int required_zeros)
 {
+  mps_thread_workspace *w;
   mps_thread_worker_data *data;
-  pthread_mutex_t *aberth_mutex, *roots_mutex;
   int i, nzeros = 0;
 
   /* initialize the iteration counter */
@@ -314,35 +293,20 @@ mps_thread_dpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
   if (nzeros == s->n)
     return;
 
-  /* Prepare queue */
-  mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
-
-  /* Allocate space for thread data */
-  data = (mps_thread_worker_data*)mps_malloc (sizeof(mps_thread_worker_data)
-                                              * s->n_threads);
-
-  /* Allocate mutexes and init them */
-  aberth_mutex = (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-  roots_mutex = (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-  for (i = 0; i < s->n; i++)
-    {
-      if (s->pool->n > 1)
-	{
-	  pthread_mutex_init (&aberth_mutex[i], NULL);
-	  pthread_mutex_init (&roots_mutex[i], NULL);
-	}
-    }
+  /* Prepare queue, thread data and mutexes */
+  w = mps_thread_workspace_get (s);
+  data = w->data;
 
   /* Start spawning thread */
   for (i = 0; i < s->n_threads; i++)
     {
-      data[i].aberth_mutex = aberth_mutex;
+      data[i].aberth_mutex = w->aberth_mutex;
       data[i].excep = excep;
       data[i].it = it;
       data[i].n_threads = s->n_threads;
       data[i].nzeros = &nzeros;
-      data[i].queue = queue;
-      data[i].roots_mutex = roots_mutex;
+      data[i].queue = &w->queue;
+      data[i].roots_mutex = w->roots_mutex;
       data[i].s = s;
       data[i].thread = i;
       data[i].required_zeros = required_zeros;
@@ -351,11 +315,6 @@ mps_thread_dpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
 
   /* Wait for the thread to complete */
   mps_thread_pool_wait (s, s->pool);
-
-  free (aberth_mutex);
-  free (roots_mutex);
-  free (data);
-  mps_thread_job_queue_free (queue);
 }
 
 /**
@@ -547,26 +506,9 @@ mps_thread_mpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
 
   MPS_DEBUG_WITH_INFO (s, "Spawning %d worker", n_threads);
 
-  mps_thread_worker_data *data;
-
-  /* Allocate and the init mutexes needed by the routine */
-  pthread_mutex_t *roots_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-  pthread_mutex_t *aberth_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-  pthread_mutex_t global_aberth_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-  for (i = 0; i < s->n; i++)
-    {
-      pthread_mutex_init (&aberth_mutex[i], NULL);
-      pthread_mutex_init (&roots_mutex[i], NULL);
-    }
-
-  /* Create a new work queue */
-  mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
-
-  data = (mps_thread_worker_data*)mps_malloc (sizeof(mps_thread_worker_data)
-                                              * n_threads);
+  /* Get the mutexes, the work queue and the thread data */
+  mps_thread_workspace *w = mps_thread_workspace_get (s);
+  mps_thread_worker_data *data = w->data;
 
   /* Set data to be passed to every thread and actually spawn the threads. */
   for (i = 0; i < n_threads; i++)
@@ -577,25 +519,14 @@ mps_thread_mpolzer (mps_context * s, int *it, mps_boolean * excep, int required_
       data[i].excep = excep;
       data[i].thread = i;
       data[i].n_threads = n_threads;
-      data[i].aberth_mutex = aberth_mutex;
-      data[i].global_aberth_mutex = &global_aberth_mutex;
-      data[i].queue = queue;
-      data[i].roots_mutex = roots_mutex;
+      data[i].aberth_mutex = w->aberth_mutex;
+      data[i].global_aberth_mutex = &w->global_aberth_mutex;
+      data[i].queue = &w->queue;
+      data[i].roots_mutex = w->roots_mutex;
       data[i].required_zeros = required_zeros;
       mps_thread_pool_assign (s, s->pool, mps_thread_mpolzer_worker, data + i);
     }
 
   /* Wait for the threads to complete */
   mps_thread_pool_wait (s, s->pool);
-
-  /* Free data and exit */
-  free (data);
-  for (i = 0; i < s->n; i++)
-    {
-      pthread_mutex_destroy (&roots_mutex[i]);
-      pthread_mutex_destroy (&aberth_mutex[i]);
-    }
-  free (roots_mutex);
-  free (aberth_mutex);
-  mps_thread_job_queue_free (queue);
 }
@@ -0,0 +1,559 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+
+/**
+ * @brief Polynomials of larger degree are solved by the selected
+ * algorithm.
+ */
+#define MPS_SMALL_MAX_DEGREE 64
+
+/**
+ * @brief Maximum number of Aberth sweeps over all the approximations
+ * before giving up.
+ */
+#define MPS_SMALL_MAX_SWEEPS 100
+
+/**
+ * @brief Largest output precision, in bits, that is requested to the
+ * double precision approximations when the goal is
+ * MPS_OUTPUT_GOAL_APPROXIMATE.
+ */
+#define MPS_SMALL_MAX_OUTPUT_PREC 48
+
+/**
+ * @brief Coefficients whose binary exponent is more than
+ * MPS_SMALL_MAX_RANGE smaller than the one of the largest coefficient
+ * would not be normal doubles once the polynomial is scaled.
+ */
+#define MPS_SMALL_MAX_RANGE 1000
+
+/**
+ * @brief Unit roundoff of double precision.
+ */
+#define MPS_SMALL_U (DBL_EPSILON / 2)
+
+/**
+ * @brief Smallest positive subnormal double, that bounds the absolute
+ * error of an operation which underflows.
+ */
+#define MPS_SMALL_ETA (DBL_MIN * DBL_EPSILON)
+
+/**
+ * @brief Rotation of the starting points, the same used by mps_fstart().
+ */
+#define MPS_SMALL_STARTING_SIGMA (0.66 * (PI / n))
+
+/**
+ * @brief The polynomial, scaled so that its largest coefficient has
+ * modulus at most 1, padded with zeros up to MPS_SMALL_MAX_DEGREE.
+ *
+ * mod[k] is \f$|re_k| + |im_k|\f$, an upper bound to the modulus of the
+ * k-th coefficient, and one[k] is 1 for \f$k \leq n\f$ and 0 otherwise.
+ * delta is a bound to the relative distance of the coefficients from the
+ * exact ones.
+ */
+struct mps_small_poly {
+  int n;
+  double delta;
+  double re[MPS_SMALL_MAX_DEGREE + 1];
+  double im[MPS_SMALL_MAX_DEGREE + 1];
+  double mod[MPS_SMALL_MAX_DEGREE + 1];
+  double one[MPS_SMALL_MAX_DEGREE + 1];
+};
+
+/**
+ * @brief Value of the polynomial and of its derivative at a point, with
+ * upper bounds to their distance from the exact ones.
+ */
+struct mps_small_eval {
+  double pr, pi;
+  double dr, di;
+  double perr;
+  double derr;
+};
+
+typedef void (*mps_small_horner_t)(const struct mps_small_poly * p, double xr, double xi,
+                                   struct mps_small_eval * e);
+
+/*
+ * One step of the Horner scheme for p and p', with the running sums
+ * mu = sum |b_k| |x|^k of the moduli of the computed values, ap and apd
+ * for the moduli of the coefficients, and nu, nud for the underflows.
+ */
+#define MPS_SMALL_HORNER_STEP(k)                                \
+  {                                                             \
+    t = dr * xr - di * xi + br;                                 \
+    di = dr * xi + di * xr + bi;                                \
+    dr = t;                                                     \
+    t = br * xr - bi * xi + p->re[k];                           \
+    bi = br * xi + bi * xr + p->im[k];                          \
+    br = t;                                                     \
+    mu = mu * ax + (fabs (br) + fabs (bi));                     \
+    apd = apd * ax + ap;                                        \
+    ap = ap * ax + p->mod[k];                                   \
+    nud = nud * ax + nu;                                        \
+    nu = nu * ax + p->one[k];                                   \
+  }
+
+/**
+ * @brief Evaluate p and p' at x, as if p had degree N.
+ *
+ * N is a compile time constant multiple of 4 in the callers below, so
+ * that the loop has a fixed trip count and is unrolled four times.
+ *
+ * The error of each step is at most \f$2 \sqrt 2 u |b_{k+1}| |x| + u
+ * (|b_k| + |a_k|)\f$, with or without fused multiply-adds, and it is
+ * multiplied by \f$x^k\f$ in the following steps. The error on p' is
+ * bounded a priori by \f$\gamma_{8n} \sum k |a_k| |x|^{k-1}\f$.
+ */
+static inline void
+mps_small_horner (const struct mps_small_poly * p, const int N,
+                  double xr, double xi, struct mps_small_eval * e)
+{
+  int k, n = p->n;
+  double t, ax = sqrt (xr * xr + xi * xi) * (1 + 4 * MPS_SMALL_U);
+  double br = p->re[N], bi = p->im[N], dr = 0.0, di = 0.0;
+  double mu = fabs (br) + fabs (bi), ap = p->mod[N], apd = 0.0;
+  double nu = p->one[N], nud = 0.0;
+
+  for (k = N - 1; k >= 0; k -= 4)
+    {
+      MPS_SMALL_HORNER_STEP (k);
+      MPS_SMALL_HORNER_STEP (k - 1);
+      MPS_SMALL_HORNER_STEP (k - 2);
+      MPS_SMALL_HORNER_STEP (k - 3);
+    }
+
+  e->pr = br;
+  e->pi = bi;
+  e->dr = dr;
+  e->di = di;
+  e->perr = 5 * MPS_SMALL_U * mu + (2 * MPS_SMALL_U + p->delta) * ap +
+            4 * MPS_SMALL_ETA * nu;
+  e->derr = ((8 * n + 16) * MPS_SMALL_U + p->delta) * apd +
+            4 * (n + 1) * MPS_SMALL_ETA * nud;
+}
+
+#define MPS_SMALL_DEFINE_HORNER(N)                                      \
+  static void                                                           \
+  mps_small_horner_ ## N (const struct mps_small_poly * p,              \
+                          double xr, double xi, struct mps_small_eval * e) \
+  {                                                                     \
+    mps_small_horner (p, N, xr, xi, e);                                 \
+  }
+
+MPS_SMALL_DEFINE_HORNER (8)
+MPS_SMALL_DEFINE_HORNER (16)
+MPS_SMALL_DEFINE_HORNER (32)
+MPS_SMALL_DEFINE_HORNER (64)
+
+/**
+ * @brief Select the Horner kernel for the smallest padded degree that
+ * contains n.
+ */
+static mps_small_horner_t
+mps_small_select_horner (int n)
+{
+  if (n <= 8)
+    return mps_small_horner_8;
+  else if (n <= 16)
+    return mps_small_horner_16;
+  else if (n <= 32)
+    return mps_small_horner_32;
+  else
+    return mps_small_horner_64;
+}
+
+/**
+ * @brief Set r to \f$x 2^{-e}\f$.
+ *
+ * @return false if the result is not zero and not a normal double.
+ */
+static mps_boolean
+mps_small_scale_component (double * r, rdpe_t x, long int e)
+{
+  if (rdpe_Mnt (x) == 0.0)
+    {
+      *r = 0.0;
+      return true;
+    }
+
+  if (rdpe_Esp (x) < e - MPS_SMALL_MAX_RANGE)
+    return false;
+
+  *r = ldexp (rdpe_Mnt (x), (int)(rdpe_Esp (x) - e));
+  return true;
+}
+
+/**
+ * @brief Check if a component of a coefficient, given as the rational q
+ * or the floating point f according to the structure of the polynomial,
+ * is exactly represented by its DPE approximation d.
+ */
+static mps_boolean
+mps_small_is_exact (mps_structure structure, mpq_t q, mpf_t f, rdpe_t d)
+{
+  /* Integer and rational coefficients are converted to DPE through mfpc,
+   * whose precision is at least DBL_MANT_DIG. */
+  if (MPS_STRUCTURE_IS_INTEGER (structure) || MPS_STRUCTURE_IS_RATIONAL (structure))
+    return mpz_cmp_ui (mpq_denref (q), 1U) == 0 &&
+           mpz_sizeinbase (mpq_numref (q), 2) <= DBL_MANT_DIG;
+
+  if (rdpe_Mnt (d) == 0.0)
+    return mpf_sgn (f) == 0;
+
+  return labs (rdpe_Esp (d)) <= MPS_SMALL_MAX_RANGE &&
+         mpf_cmp_d (f, ldexp (rdpe_Mnt (d), (int) rdpe_Esp (d))) == 0;
+}
+
+/**
+ * @brief Read the coefficients of the active polynomial, scaled by a
+ * power of 2.
+ *
+ * @return false if some of them cannot be represented, after the scaling,
+ * as normal double precision numbers.
+ */
+static mps_boolean
+mps_small_scale (mps_context * s, mps_monomial_poly * mp, struct mps_small_poly * p)
+{
+  mps_polynomial * poly = MPS_POLYNOMIAL (mp);
+  int i, n = s->n;
+  long int e = LONG_MIN;
+
+  for (i = 0; i <= n; i++)
+    {
+      if (!mp->spar[i])
+        continue;
+      if (rdpe_Mnt (cdpe_Re (mp->dpc[i])) != 0.0)
+        e = MAX (e, rdpe_Esp (cdpe_Re (mp->dpc[i])));
+      if (rdpe_Mnt (cdpe_Im (mp->dpc[i])) != 0.0)
+        e = MAX (e, rdpe_Esp (cdpe_Im (mp->dpc[i])));
+    }
+
+  if (e == LONG_MIN)
+    return false;
+
+  for (i = 0; i <= MPS_SMALL_MAX_DEGREE; i++)
+    {
+      p->re[i] = p->im[i] = 0.0;
+      if (i <= n && mp->spar[i] &&
+          !(mps_small_scale_component (&p->re[i], cdpe_Re (mp->dpc[i]), e) &&
+            mps_small_scale_component (&p->im[i], cdpe_Im (mp->dpc[i]), e)))
+        return false;
+
+      p->mod[i] = fabs (p->re[i]) + fabs (p->im[i]);
+      p->one[i] = (i <= n) ? 1.0 : 0.0;
+    }
+
+  if (p->mod[0] == 0.0 || p->mod[n] == 0.0)
+    return false;
+
+  /* dpc is a truncation of the coefficients, that are only known up to
+   * the input precision if they are floating point. */
+  p->n = n;
+  p->delta = 0.0;
+  for (i = 0; i <= n; i++)
+    if (mp->spar[i] &&
+        !(mps_small_is_exact (poly->structure, mp->initial_mqp_r[i],
+                              mpc_Re (mp->mfpc[i]), cdpe_Re (mp->dpc[i])) &&
+          mps_small_is_exact (poly->structure, mp->initial_mqp_i[i],
+                              mpc_Im (mp->mfpc[i]), cdpe_Im (mp->dpc[i]))))
+      {
+        p->delta = 2 * DBL_EPSILON;
+        break;
+      }
+  if (MPS_STRUCTURE_IS_FP (poly->structure) && poly->prec > 0)
+    p->delta += ldexp (1.0, 1 - (int) MIN (poly->prec, INT_MAX / 2));
+
+  return true;
+}
+
+/**
+ * @brief Place the starting points on the circles whose radii are given
+ * by the slopes of the Newton polygon of the coefficients, i.e., of the
+ * upper convex hull of the points \f$(k, \log |a_k|)\f$.
+ */
+static void
+mps_small_starting_points (const struct mps_small_poly * p, double * xr, double * xi)
+{
+  int h[MPS_SMALL_MAX_DEGREE + 1];
+  double lg[MPS_SMALL_MAX_DEGREE + 1];
+  int i, j, k, m = 0, n = p->n;
+  double r, ang, th = 2 * PI / n, sigma = MPS_SMALL_STARTING_SIGMA;
+
+  for (k = 0; k <= n; k++)
+    {
+      if (p->mod[k] == 0.0)
+        continue;
+
+      lg[k] = log2 (p->mod[k]);
+
+      /* Drop the vertices that are not above the segment joining their
+       * neighbours. */
+      while (m >= 2 &&
+             (lg[h[m - 1]] - lg[h[m - 2]]) * (k - h[m - 2]) <=
+             (lg[k] - lg[h[m - 2]]) * (h[m - 1] - h[m - 2]))
+        m--;
+
+      h[m++] = k;
+    }
+
+  /* Since a_0 and a_n are not zero, the hull goes from 0 to n. */
+  for (i = 0; i < m - 1; i++)
+    {
+      int nzeros = h[i + 1] - h[i];
+
+      r = exp2 ((lg[h[i]] - lg[h[i + 1]]) / nzeros);
+      ang = 2 * PI / nzeros;
+
+      for (j = h[i]; j < h[i + 1]; j++)
+        {
+          int jj = j - h[i];
+
+          xr[j] = r * cos (ang * jj + th * h[i + 1] + sigma);
+          xi[j] = r * sin (ang * jj + th * h[i + 1] + sigma);
+        }
+    }
+}
+
+/**
+ * @brief Run the Aberth iteration in Gauss-Seidel style, until the value
+ * of the polynomial at every approximation is below the bound to its
+ * rounding error.
+ *
+ * @return false if some approximation has not converged.
+ */
+static mps_boolean
+mps_small_aberth (const struct mps_small_poly * p, mps_small_horner_t horner,
+                  double * xr, double * xi)
+{
+  mps_boolean again[MPS_SMALL_MAX_DEGREE];
+  struct mps_small_eval e;
+  int i, j, it, n = p->n, left = n;
+  double nr, ni, sr, si, dr, di, d, cr, ci;
+
+  for (i = 0; i < n; i++)
+    again[i] = true;
+
+  for (it = 0; it < MPS_SMALL_MAX_SWEEPS && left > 0; it++)
+    for (i = 0; i < n; i++)
+      {
+        if (!again[i])
+          continue;
+
+        horner (p, xr[i], xi[i], &e);
+
+        if (fabs (e.pr) + fabs (e.pi) <= e.perr)
+          {
+            again[i] = false;
+            left--;
+            continue;
+          }
+
+        d = e.dr * e.dr + e.di * e.di;
+        if (d == 0.0 || !isfinite (d))
+          continue;
+
+        /* Newton correction p / p' */
+        nr = (e.pr * e.dr + e.pi * e.di) / d;
+        ni = (e.pi * e.dr - e.pr * e.di) / d;
+
+        /* Sum of 1 / (x_i - x_j) */
+        sr = si = 0.0;
+        for (j = 0; j < n; j++)
+          {
+            if (j == i)
+              continue;
+
+            dr = xr[i] - xr[j];
+            di = xi[i] - xi[j];
+            d = dr * dr + di * di;
+            sr += dr / d;
+            si -= di / d;
+          }
+
+        /* Aberth correction N / (1 - N S) */
+        cr = 1.0 - (nr * sr - ni * si);
+        ci = -(nr * si + ni * sr);
+        d = cr * cr + ci * ci;
+        if (d == 0.0)
+          continue;
+
+        xr[i] -= (nr * cr + ni * ci) / d;
+        xi[i] -= (ni * cr - nr * ci) / d;
+
+        if (!isfinite (xr[i]) || !isfinite (xi[i]))
+          return false;
+      }
+
+  return left == 0;
+}
+
+/**
+ * @brief Compute certified inclusion radii for the approximations.
+ *
+ * The Newton discs of radius \f$R_i = n |p(x_i)| / |p'(x_i)|\f$ contain
+ * at least one root each, and exactly one if they are pairwise disjoint.
+ * In that case, if \f$\zeta_i\f$ is the root in the i-th disc,
+ * \f$p'(x_i) / p(x_i) = 1 / (x_i - \zeta_i) + \sum_{j \neq i} 1 / (x_i -
+ * \zeta_j)\f$, where the moduli of the terms of the sum are at most
+ * \f$1 / (|x_i - x_j| - R_j)\f$, and this gives a bound to \f$|x_i -
+ * \zeta_i|\f$ that is about n times smaller.
+ *
+ * @return false if the Newton discs are not disjoint.
+ */
+static mps_boolean
+mps_small_radii (const struct mps_small_poly * p, mps_small_horner_t horner,
+                 const double * xr, const double * xi, double * rad)
+{
+  double P[MPS_SMALL_MAX_DEGREE], D[MPS_SMALL_MAX_DEGREE];
+  struct mps_small_eval e;
+  int i, j, n = p->n;
+  const double u = MPS_SMALL_U;
+  double dist, sigma, den, r;
+
+  for (i = 0; i < n; i++)
+    {
+      horner (p, xr[i], xi[i], &e);
+
+      P[i] = sqrt (e.pr * e.pr + e.pi * e.pi) * (1 + 4 * u) + e.perr;
+      D[i] = sqrt (e.dr * e.dr + e.di * e.di) * (1 - 4 * u) - e.derr;
+
+      if (!(D[i] > 0.0) || !isfinite (P[i]))
+        return false;
+
+      rad[i] = n * P[i] / D[i] * (1 + 4 * u);
+      if (!isfinite (rad[i]))
+        return false;
+    }
+
+  for (i = 0; i < n; i++)
+    for (j = i + 1; j < n; j++)
+      {
+        dist = hypot (xr[i] - xr[j], xi[i] - xi[j]) * (1 - 8 * u);
+        if ((rad[i] + rad[j]) * (1 + 2 * u) >= dist)
+          return false;
+      }
+
+  /* The Newton discs of all the roots are needed to shrink each one,
+   * so the new radii are stored in D. */
+  for (i = 0; i < n; i++)
+    {
+      sigma = 0.0;
+      for (j = 0; j < n; j++)
+        if (j != i)
+          {
+            dist = hypot (xr[i] - xr[j], xi[i] - xi[j]) * (1 - 8 * u);
+            sigma += 1.0 / ((dist - rad[j]) * (1 - 2 * u));
+          }
+      sigma *= 1 + 2 * (n + 2) * u;
+
+      den = (D[i] - sigma * P[i] * (1 + 2 * u)) * (1 - 2 * u);
+      r = (den > 0.0) ? P[i] / den * (1 + 2 * u) : rad[i];
+      D[i] = MIN (r, rad[i]);
+    }
+
+  for (i = 0; i < n; i++)
+    rad[i] = D[i];
+
+  return true;
+}
+
+/**
+ * @brief Solve the active polynomial with the fast path for small
+ * degrees, if possible.
+ *
+ * This is used when the goal is MPS_OUTPUT_GOAL_ISOLATE, or
+ * MPS_OUTPUT_GOAL_APPROXIMATE with an output precision that double
+ * precision can reach, the search set is the complex plane and the
+ * active polynomial is a monomial one of degree at most
+ * MPS_SMALL_MAX_DEGREE, with non zero constant and leading coefficients
+ * that fit the double range once scaled.
+ *
+ * @param s The current mps_context.
+ * @return true if the roots have been approximated and isolated, and
+ * false if the polynomial must be solved with the selected algorithm,
+ * because it is not supported or because the inclusion discs cannot be
+ * certified, e.g., when there are multiple roots.
+ */
+mps_boolean
+mps_small_degree_mpsolve (mps_context * s)
+{
+  mps_polynomial * poly = s->active_poly;
+  struct mps_small_poly p;
+  mps_small_horner_t horner;
+  double xr[MPS_SMALL_MAX_DEGREE], xi[MPS_SMALL_MAX_DEGREE];
+  double rad[MPS_SMALL_MAX_DEGREE];
+  double eps_out;
+  mps_boolean approximate = s->output_config->goal == MPS_OUTPUT_GOAL_APPROXIMATE;
+  int i, n = s->n;
+
+  if ((s->output_config->goal != MPS_OUTPUT_GOAL_ISOLATE && !approximate) ||
+      (approximate && s->output_config->prec > MPS_SMALL_MAX_OUTPUT_PREC) ||
+      s->output_config->search_set != MPS_SEARCH_SET_COMPLEX_PLANE ||
+      s->output_config->multiplicity || s->output_config->root_properties ||
+      !MPS_IS_MONOMIAL_POLY (poly) || s->distributed || s->resume_file ||
+      n < 1 || n > MPS_SMALL_MAX_DEGREE)
+    return false;
+
+  if (!mps_small_scale (s, MPS_MONOMIAL_POLY (poly), &p))
+    return false;
+
+  /* The same value is set in s->eps_out by the standard algorithm, after
+   * mps_setup(). */
+  eps_out = ldexp (1.0, -(int) MIN (s->output_config->prec, 2 * DBL_MAX_EXP));
+
+  horner = mps_small_select_horner (n);
+
+  mps_small_starting_points (&p, xr, xi);
+
+  if (!mps_small_aberth (&p, horner, xr, xi) ||
+      !mps_small_radii (&p, horner, xr, xi, rad))
+    {
+      MPS_DEBUG_WITH_INFO (s, "The roots cannot be isolated in double precision, using the selected algorithm");
+      return false;
+    }
+
+  if (approximate)
+    for (i = 0; i < n; i++)
+      if (!(rad[i] < sqrt (xr[i] * xr[i] + xi[i] * xi[i]) * (1 - 4 * MPS_SMALL_U) * eps_out))
+        {
+          MPS_DEBUG_WITH_INFO (s, "The roots cannot be approximated in double precision, using the selected algorithm");
+          return false;
+        }
+
+  mps_allocate_data (s);
+
+  for (i = 0; i < n; i++)
+    {
+      mps_approximation * root = s->root[i];
+
+      cplx_set_d (root->fvalue, xr[i], xi[i]);
+      cdpe_set_x (root->dvalue, root->fvalue);
+      root->frad = rad[i];
+      rdpe_set_d (root->drad, rad[i]);
+      root->wp = DBL_MANT_DIG;
+      root->status = (rad[i] < cplx_mod (root->fvalue) * eps_out) ?
+                     MPS_ROOT_STATUS_APPROXIMATED : MPS_ROOT_STATUS_ISOLATED;
+      root->inclusion = MPS_ROOT_INCLUSION_IN;
+      s->order[i] = i;
+    }
+
+  s->lastphase = float_phase;
+  s->over_max = false;
+  mps_copy_roots (s);
+
+  return true;
+}
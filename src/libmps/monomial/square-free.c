@@ -0,0 +1,709 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <stdint.h>
+
+/*! @cond PRIVATE */
+
+/**
+ * @brief A polynomial with integer coefficients. The zero polynomial
+ * has degree -1.
+ */
+typedef struct {
+  int degree;
+  mpz_t * c;
+} mps_zpoly;
+
+/**
+ * @brief Smallest prime used by the modular GCD. Primes below
+ * \f$2^{31}\f$ are used, so that the product of two residues fits
+ * in 64 bits.
+ */
+#define MPS_SQUARE_FREE_FIRST_PRIME (1UL << 30)
+
+/*! @endcond */
+
+static void
+mps_zpoly_init (mps_zpoly * p, int degree)
+{
+  p->degree = degree;
+  p->c = mpz_valloc (MAX (degree, 0) + 1);
+  mpz_vinit (p->c, MAX (degree, 0) + 1);
+}
+
+static void
+mps_zpoly_clear (mps_zpoly * p)
+{
+  mpz_vclear (p->c, MAX (p->degree, 0) + 1);
+  mpz_vfree (p->c);
+}
+
+/**
+ * @brief Replace <code>dest</code> with <code>src</code>, that is
+ * cleared.
+ */
+static void
+mps_zpoly_move (mps_zpoly * dest, mps_zpoly * src)
+{
+  mps_zpoly_clear (dest);
+  *dest = *src;
+}
+
+static void
+mps_zpoly_set (mps_zpoly * dest, mps_zpoly * src)
+{
+  int i;
+
+  mps_zpoly_init (dest, src->degree);
+  for (i = 0; i <= src->degree; i++)
+    mpz_set (dest->c[i], src->c[i]);
+}
+
+/**
+ * @brief Degree of p, ignoring the vanishing leading coefficients.
+ */
+static int
+mps_zpoly_normalize (mps_zpoly * p)
+{
+  int i;
+
+  for (i = p->degree; i >= 0 && mpz_sgn (p->c[i]) == 0; i--) ;
+
+  return i;
+}
+
+static mps_boolean
+mps_zpoly_equal (mps_zpoly * a, mps_zpoly * b)
+{
+  int i;
+
+  if (a->degree != b->degree)
+    return false;
+
+  for (i = 0; i <= a->degree; i++)
+    if (mpz_cmp (a->c[i], b->c[i]) != 0)
+      return false;
+
+  return true;
+}
+
+/**
+ * @brief Divide p by its content, and make its leading coefficient
+ * positive.
+ */
+static void
+mps_zpoly_primitive_part (mps_zpoly * p)
+{
+  mpz_t g;
+  int i;
+
+  if (p->degree < 0)
+    return;
+
+  mpz_init (g);
+  for (i = 0; i <= p->degree && mpz_cmp_ui (g, 1) != 0; i++)
+    mpz_gcd (g, g, p->c[i]);
+
+  if (mpz_sgn (p->c[p->degree]) < 0)
+    mpz_neg (g, g);
+
+  for (i = 0; i <= p->degree; i++)
+    mpz_divexact (p->c[i], p->c[i], g);
+
+  mpz_clear (g);
+}
+
+static void
+mps_zpoly_derivative (mps_zpoly * d, mps_zpoly * p)
+{
+  int i;
+
+  mps_zpoly_init (d, p->degree - 1);
+  for (i = 1; i <= p->degree; i++)
+    mpz_mul_ui (d->c[i - 1], p->c[i], i);
+}
+
+/**
+ * @brief Compute r = a - b.
+ */
+static void
+mps_zpoly_sub (mps_zpoly * r, mps_zpoly * a, mps_zpoly * b)
+{
+  int i;
+
+  mps_zpoly_init (r, MAX (a->degree, b->degree));
+  for (i = 0; i <= r->degree; i++)
+    {
+      if (i <= a->degree)
+        mpz_set (r->c[i], a->c[i]);
+      if (i <= b->degree)
+        mpz_sub (r->c[i], r->c[i], b->c[i]);
+    }
+
+  /* Keep the allocated size in the degree, so that mps_zpoly_clear ()
+   * frees all the coefficients, and shift the zero ones out. */
+  i = mps_zpoly_normalize (r);
+  if (i < r->degree)
+    {
+      mps_zpoly t;
+      int j;
+
+      mps_zpoly_init (&t, i);
+      for (j = 0; j <= i; j++)
+        mpz_swap (t.c[j], r->c[j]);
+      mps_zpoly_move (r, &t);
+    }
+}
+
+/**
+ * @brief Compute q = a / b if b divides a over the integers.
+ *
+ * @return true if the division is exact, false otherwise. In the latter
+ * case q is not initialized.
+ */
+static mps_boolean
+mps_zpoly_divexact (mps_zpoly * q, mps_zpoly * a, mps_zpoly * b)
+{
+  mps_zpoly r;
+  mps_boolean exact = true;
+  int i, j;
+
+  if (a->degree < 0)
+    {
+      mps_zpoly_init (q, -1);
+      return true;
+    }
+
+  if (b->degree > a->degree)
+    return false;
+
+  mps_zpoly_set (&r, a);
+  mps_zpoly_init (q, a->degree - b->degree);
+
+  for (i = a->degree - b->degree; i >= 0 && exact; i--)
+    {
+      if (!mpz_divisible_p (r.c[i + b->degree], b->c[b->degree]))
+        exact = false;
+      else
+        {
+          mpz_divexact (q->c[i], r.c[i + b->degree], b->c[b->degree]);
+          for (j = 0; j <= b->degree; j++)
+            mpz_submul (r.c[i + j], q->c[i], b->c[j]);
+        }
+    }
+
+  for (i = 0; i < b->degree && exact; i++)
+    if (mpz_sgn (r.c[i]) != 0)
+      exact = false;
+
+  mps_zpoly_clear (&r);
+
+  if (!exact)
+    mps_zpoly_clear (q);
+
+  return exact;
+}
+
+static uint64_t
+mps_zp_pow (uint64_t a, uint64_t e, uint64_t p)
+{
+  uint64_t r = 1;
+
+  for (; e; e >>= 1, a = a * a % p)
+    if (e & 1)
+      r = r * a % p;
+
+  return r;
+}
+
+static uint64_t
+mps_zp_inv (uint64_t a, uint64_t p)
+{
+  return mps_zp_pow (a, p - 2, p);
+}
+
+/**
+ * @brief Replace a with the remainder of its division by b modulo p, and
+ * return its degree.
+ */
+static int
+mps_zp_rem (uint64_t * a, int da, uint64_t * b, int db, uint64_t p)
+{
+  uint64_t inv = mps_zp_inv (b[db], p), q;
+  int i, j;
+
+  for (i = da; i >= db; i--)
+    {
+      if (a[i] == 0)
+        continue;
+
+      q = a[i] * inv % p;
+      for (j = 0; j <= db; j++)
+        a[i - db + j] = (a[i - db + j] + p - q * b[j] % p) % p;
+    }
+
+  for (da = MIN (da, db - 1); da >= 0 && a[da] == 0; da--) ;
+
+  return da;
+}
+
+/**
+ * @brief Compute the monic GCD of a and b modulo p with the Euclidean
+ * algorithm. Both the vectors are overwritten.
+ *
+ * @return The degree of the GCD, whose coefficients are stored in
+ * <code>g</code>.
+ */
+static int
+mps_zp_gcd (uint64_t * a, int da, uint64_t * b, int db, uint64_t * g, uint64_t p)
+{
+  uint64_t * t, inv;
+  int dt, i;
+
+  while (db >= 0)
+    {
+      da = mps_zp_rem (a, da, b, db, p);
+      t = a; a = b; b = t;
+      dt = da; da = db; db = dt;
+    }
+
+  inv = mps_zp_inv (a[da], p);
+  for (i = 0; i <= da; i++)
+    g[i] = a[i] * inv % p;
+
+  return da;
+}
+
+/**
+ * @brief Reduce p modulo the prime q. The leading coefficient must not
+ * be divisible by q.
+ */
+static void
+mps_zp_reduce (uint64_t * r, mps_zpoly * p, uint64_t q)
+{
+  int i;
+
+  for (i = 0; i <= p->degree; i++)
+    r[i] = mpz_fdiv_ui (p->c[i], q);
+}
+
+/**
+ * @brief Compute the primitive GCD of a nonzero polynomial a and of b.
+ *
+ * The GCD is computed modulo a sequence of primes that do not divide
+ * the leading coefficients. Its images are scaled so that their leading
+ * coefficient is the one of \f$\gamma g\f$, where \f$g\f$ is the GCD over
+ * the integers and \f$\gamma\f$ is the GCD of the leading coefficients,
+ * and are combined with the Chinese remainder theorem. The primes where
+ * the degree of the GCD is larger than the smallest one found are unlucky
+ * and are discarded. The reconstruction stops as soon as the primitive
+ * part of the result stays the same after a new prime and divides both
+ * the polynomials.
+ */
+static void
+mps_zpoly_gcd (mps_zpoly * g, mps_zpoly * a, mps_zpoly * b)
+{
+  mps_zpoly h, candidate, quotient;
+  mpz_t gamma, modulus, prime, half;
+  uint64_t *ap, *bp, *gp, p, inv, gamma_p, r;
+  int d = MIN (a->degree, b->degree) + 1, e, i;
+  mps_boolean have_candidate = false, done = false;
+
+  if (b->degree < 0)
+    {
+      mps_zpoly_set (g, a);
+      mps_zpoly_primitive_part (g);
+      return;
+    }
+
+  if (a->degree == 0 || b->degree == 0)
+    {
+      mps_zpoly_init (g, 0);
+      mpz_set_ui (g->c[0], 1U);
+      return;
+    }
+
+  mpz_init (gamma);
+  mpz_init (modulus);
+  mpz_init (half);
+  mpz_init_set_ui (prime, MPS_SQUARE_FREE_FIRST_PRIME);
+  mpz_gcd (gamma, a->c[a->degree], b->c[b->degree]);
+
+  ap = mps_newv (uint64_t, a->degree + 1);
+  bp = mps_newv (uint64_t, b->degree + 1);
+  gp = mps_newv (uint64_t, d);
+
+  mps_zpoly_init (&h, 0);
+  mps_zpoly_init (&candidate, 0);
+  mps_zpoly_init (&quotient, 0);
+
+  while (!done)
+    {
+      mpz_nextprime (prime, prime);
+      p = mpz_get_ui (prime);
+
+      if (mpz_divisible_ui_p (a->c[a->degree], p) ||
+          mpz_divisible_ui_p (b->c[b->degree], p))
+        continue;
+
+      mps_zp_reduce (ap, a, p);
+      mps_zp_reduce (bp, b, p);
+      e = mps_zp_gcd (ap, a->degree, bp, b->degree, gp, p);
+
+      /* The degree of the GCD modulo a lucky prime is the degree over the
+       * integers, and it cannot be lower on any prime that does not divide
+       * the leading coefficients. */
+      if (e == 0)
+        {
+          mps_zpoly_clear (&candidate);
+          mps_zpoly_init (&candidate, 0);
+          mpz_set_ui (candidate.c[0], 1U);
+          break;
+        }
+
+      if (e > d)
+        continue;
+
+      gamma_p = mpz_fdiv_ui (gamma, p);
+      for (i = 0; i <= e; i++)
+        gp[i] = gp[i] * gamma_p % p;
+
+      if (e < d)
+        {
+          /* All the previous primes were unlucky. */
+          d = e;
+          mps_zpoly_clear (&h);
+          mps_zpoly_init (&h, e);
+          for (i = 0; i <= e; i++)
+            mpz_set_ui (h.c[i], gp[i]);
+          mpz_set_ui (modulus, p);
+          have_candidate = false;
+        }
+      else
+        {
+          inv = mps_zp_inv (mpz_fdiv_ui (modulus, p), p);
+          for (i = 0; i <= e; i++)
+            {
+              r = (gp[i] + p - mpz_fdiv_ui (h.c[i], p)) % p;
+              mpz_addmul_ui (h.c[i], modulus, r * inv % p);
+            }
+          mpz_mul_ui (modulus, modulus, p);
+        }
+
+      /* Take the symmetric representation of the coefficients, and
+       * compare its primitive part with the previous one. */
+      mps_zpoly_clear (&quotient);
+      mps_zpoly_set (&quotient, &h);
+      mpz_fdiv_q_2exp (half, modulus, 1);
+      for (i = 0; i <= e; i++)
+        if (mpz_cmp (quotient.c[i], half) > 0)
+          mpz_sub (quotient.c[i], quotient.c[i], modulus);
+      mps_zpoly_primitive_part (&quotient);
+
+      if (have_candidate && mps_zpoly_equal (&quotient, &candidate))
+        {
+          mps_zpoly t;
+
+          if (mps_zpoly_divexact (&t, a, &candidate))
+            {
+              mps_zpoly_clear (&t);
+              if (mps_zpoly_divexact (&t, b, &candidate))
+                {
+                  mps_zpoly_clear (&t);
+                  done = true;
+                }
+            }
+        }
+      else
+        {
+          mps_zpoly t = candidate;
+          candidate = quotient;
+          quotient = t;
+          have_candidate = true;
+        }
+    }
+
+  *g = candidate;
+
+  mps_zpoly_clear (&h);
+  mps_zpoly_clear (&quotient);
+  free (ap);
+  free (bp);
+  free (gp);
+  mpz_clear (gamma);
+  mpz_clear (modulus);
+  mpz_clear (prime);
+  mpz_clear (half);
+}
+
+/**
+ * @brief Allocate a mps_monomial_poly with the integer coefficients of a.
+ */
+static mps_monomial_poly *
+mps_zpoly_to_monomial (mps_context * s, mps_zpoly * a)
+{
+  mps_monomial_poly * mp = mps_monomial_poly_new (s, a->degree);
+  mpq_t re, im;
+  int i;
+
+  MPS_POLYNOMIAL (mp)->structure = MPS_STRUCTURE_REAL_INTEGER;
+  MPS_POLYNOMIAL (mp)->prec = 0;
+
+  mpq_init (re);
+  mpq_init (im);
+
+  for (i = 0; i <= a->degree; i++)
+    {
+      mpq_set_z (re, a->c[i]);
+      mps_monomial_poly_set_coefficient_q (s, mp, i, re, im);
+    }
+
+  mpq_clear (re);
+  mpq_clear (im);
+
+  return mp;
+}
+
+/**
+ * @brief Compute the square-free factorization of a polynomial with
+ * exact real coefficients.
+ *
+ * The factorization is computed with Yun's algorithm, on the primitive
+ * polynomial with integer coefficients obtained from p by clearing the
+ * denominators. Since all the GCDs are primitive the exact divisions
+ * needed by the algorithm are carried out over the integers.
+ *
+ * @param s The current mps_context.
+ * @param p The polynomial to factor.
+ * @param factors The location where the vector of the factors, in
+ * increasing order of multiplicity, is stored. It must be freed with
+ * mps_square_free_factors_free ().
+ * @return The number of factors, or -1 if the coefficients of p are not
+ * exact integer or rational real numbers. In the latter case factors is
+ * set to NULL.
+ */
+int
+mps_square_free_factorize (mps_context * s, mps_monomial_poly * p,
+                           mps_square_free_factor ** factors)
+{
+  mps_polynomial * poly = MPS_POLYNOMIAL (p);
+  mps_zpoly f, df, a, b, c, d, db, t;
+  mpz_t lcm;
+  int i, k, n_factors = 0;
+
+  *factors = NULL;
+
+  if (poly->prec != 0 || !MPS_STRUCTURE_IS_REAL (poly->structure) ||
+      !(MPS_STRUCTURE_IS_INTEGER (poly->structure) || MPS_STRUCTURE_IS_RATIONAL (poly->structure)) ||
+      poly->degree < 1 || mpq_sgn (p->initial_mqp_r[poly->degree]) == 0)
+    return -1;
+
+  /* Clear the denominators */
+  mpz_init_set_ui (lcm, 1U);
+  for (i = 0; i <= poly->degree; i++)
+    mpz_lcm (lcm, lcm, mpq_denref (p->initial_mqp_r[i]));
+
+  mps_zpoly_init (&f, poly->degree);
+  for (i = 0; i <= poly->degree; i++)
+    {
+      mpz_divexact (f.c[i], lcm, mpq_denref (p->initial_mqp_r[i]));
+      mpz_mul (f.c[i], f.c[i], mpq_numref (p->initial_mqp_r[i]));
+    }
+  mpz_clear (lcm);
+
+  mps_zpoly_primitive_part (&f);
+
+  /* The GCDs are verified by trial division, so all the divisions below
+   * are exact. */
+  mps_zpoly_derivative (&df, &f);
+  mps_zpoly_gcd (&a, &f, &df);
+  mps_zpoly_divexact (&b, &f, &a);
+  mps_zpoly_divexact (&c, &df, &a);
+  mps_zpoly_derivative (&db, &b);
+  mps_zpoly_sub (&d, &c, &db);
+
+  *factors = mps_newv (mps_square_free_factor, poly->degree);
+
+  for (k = 1; b.degree > 0; k++)
+    {
+      mps_zpoly_clear (&a);
+      mps_zpoly_gcd (&a, &b, &d);
+
+      if (a.degree > 0)
+        {
+          (*factors)[n_factors].poly = mps_zpoly_to_monomial (s, &a);
+          (*factors)[n_factors].multiplicity = k;
+          n_factors++;
+        }
+
+      mps_zpoly_divexact (&t, &b, &a);
+      mps_zpoly_move (&b, &t);
+
+      mps_zpoly_clear (&c);
+      mps_zpoly_divexact (&c, &d, &a);
+
+      mps_zpoly_clear (&db);
+      mps_zpoly_derivative (&db, &b);
+
+      mps_zpoly_clear (&d);
+      mps_zpoly_sub (&d, &c, &db);
+    }
+
+  mps_zpoly_clear (&f);
+  mps_zpoly_clear (&df);
+  mps_zpoly_clear (&a);
+  mps_zpoly_clear (&b);
+  mps_zpoly_clear (&c);
+  mps_zpoly_clear (&d);
+  mps_zpoly_clear (&db);
+
+  return n_factors;
+}
+
+/**
+ * @brief Free the factors computed by mps_square_free_factorize ().
+ */
+void
+mps_square_free_factors_free (mps_context * s, mps_square_free_factor * factors,
+                              int n_factors)
+{
+  int i;
+
+  for (i = 0; i < n_factors; i++)
+    mps_polynomial_free (s, MPS_POLYNOMIAL (factors[i].poly));
+
+  free (factors);
+}
+
+static void *
+mps_square_free_solve_factor (void * data)
+{
+  mps_mpsolve ((mps_context *) data);
+  return NULL;
+}
+
+/**
+ * @brief Solve the active polynomial through its square-free factorization.
+ *
+ * The factors are solved in parallel, each one in its own mps_context
+ * configured like s, and the roots are collected in s, where the
+ * ones of a factor of multiplicity m are repeated m times. Multiple roots
+ * are marked with status MPS_ROOT_STATUS_MULTIPLE, while the simple ones
+ * keep the status obtained in the computation.
+ *
+ * @param s The current mps_context.
+ * @return false if the active polynomial is not suitable for the
+ * factorization or is square-free, so that it must be solved with the
+ * selected algorithm, true if it has been solved.
+ */
+mps_boolean
+mps_square_free_mpsolve (mps_context * s)
+{
+  mps_square_free_factor * factors;
+  mps_context ** ctxs;
+  mps_approximation * root;
+  long int prec = 0, data_prec = 0;
+  int n_factors, i, j, k, m, n = 0;
+
+  if (!MPS_IS_MONOMIAL_POLY (s->active_poly) || s->distributed || s->resume_file)
+    return false;
+
+  n_factors = mps_square_free_factorize (s, MPS_MONOMIAL_POLY (s->active_poly), &factors);
+
+  if (n_factors < 0)
+    return false;
+
+  if (n_factors == 1 && factors[0].multiplicity == 1)
+    {
+      MPS_DEBUG_WITH_INFO (s, "The polynomial is square-free");
+      mps_square_free_factors_free (s, factors, n_factors);
+      return false;
+    }
+
+  MPS_DEBUG_WITH_INFO (s, "Solving %d square-free factors", n_factors);
+
+  ctxs = mps_newv (mps_context *, n_factors);
+  for (i = 0; i < n_factors; i++)
+    {
+      mps_context * ctx = ctxs[i] = mps_context_new ();
+
+      MPS_DEBUG_WITH_INFO (s, "Factor %d has degree %d and multiplicity %d", i,
+                           MPS_POLYNOMIAL (factors[i].poly)->degree, factors[i].multiplicity);
+
+      mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (factors[i].poly));
+      mps_context_copy_options (ctx, s);
+      mps_context_set_square_free (ctx, false);
+
+      /* Share the threads of s among the factors. */
+      mps_thread_pool_set_concurrency_limit (ctx, ctx->pool, MAX (1, s->n_threads / n_factors));
+
+      mps_thread_pool_assign (s, s->pool, mps_square_free_solve_factor, ctx);
+    }
+
+  mps_thread_pool_wait (s, s->pool);
+
+  /* Collect the roots */
+  mps_allocate_data (s);
+
+  for (i = 0; i < n_factors; i++)
+    {
+      mps_context * ctx = ctxs[i];
+
+      if (mps_context_has_errors (ctx))
+        {
+          mps_error (s, "%s", ctx->last_error);
+          continue;
+        }
+
+      s->over_max = s->over_max || ctx->over_max;
+      prec = MAX (prec, ctx->mpwp);
+      data_prec = MAX (data_prec, mps_context_get_data_prec_max (ctx));
+
+      m = factors[i].multiplicity;
+      for (j = 0; j < ctx->n; j++)
+        for (k = 0; k < m; k++, n++)
+          {
+            root = s->root[n];
+
+            mpc_set_prec (root->mvalue, mpc_get_prec (ctx->root[j]->mvalue));
+            mpc_set (root->mvalue, ctx->root[j]->mvalue);
+            mpc_get_cdpe (root->dvalue, root->mvalue);
+            mpc_get_cplx (root->fvalue, root->mvalue);
+            rdpe_set (root->drad, ctx->root[j]->drad);
+            root->frad = rdpe_get_d (root->drad);
+            root->wp = ctx->root[j]->wp;
+            root->attrs = ctx->root[j]->attrs;
+            root->inclusion = ctx->root[j]->inclusion;
+            root->status = (m > 1) ? MPS_ROOT_STATUS_MULTIPLE : ctx->root[j]->status;
+          }
+    }
+
+  if (!mps_context_has_errors (s))
+    {
+      mps_mp_set_prec (s, prec);
+      MPS_LOCK (s->data_prec_max);
+      s->data_prec_max.value = data_prec;
+      MPS_UNLOCK (s->data_prec_max);
+
+      s->lastphase = mp_phase;
+      for (i = 0; i < s->n; i++)
+        s->order[i] = i;
+      mps_copy_roots (s);
+    }
+
+  for (i = 0; i < n_factors; i++)
+    mps_context_free (ctxs[i]);
+  free (ctxs);
+
+  mps_square_free_factors_free (s, factors, n_factors);
+
+  return true;
+}
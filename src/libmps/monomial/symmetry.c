@@ -0,0 +1,656 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <math.h>
+
+/**
+ * @brief Guard bits used when the roots of the reduced polynomial are
+ * mapped back to the ones of the input.
+ */
+#define MPS_SYMMETRY_GUARD_BITS 16
+
+/**
+ * @brief Largest degree of the polynomial in \f$x + 1/x\f$ that is solved
+ * in place of a palindromic one.
+ *
+ * The coefficients of \f$x^j + x^{-j}\f$ in the monomial basis of
+ * \f$x + 1/x\f$ grow exponentially with j, and the reduced polynomial is
+ * so ill-conditioned for larger degrees that solving it takes longer than
+ * solving the original one.
+ */
+#define MPS_SYMMETRY_PALINDROMIC_MAX_DEGREE 24
+
+static mps_boolean
+mps_symmetry_is_exact (mps_polynomial * p)
+{
+  return p->prec == 0 &&
+         (MPS_STRUCTURE_IS_INTEGER (p->structure) || MPS_STRUCTURE_IS_RATIONAL (p->structure));
+}
+
+static int
+mps_symmetry_gcd (int a, int b)
+{
+  while (b)
+    {
+      int t = a % b;
+      a = b;
+      b = t;
+    }
+
+  return a;
+}
+
+/**
+ * @brief Check if a = s b, with s = 1 or s = -1.
+ */
+static mps_boolean
+mps_symmetry_equal (mpq_t a, mpq_t b, int s, mpq_t tmp)
+{
+  if (s > 0)
+    return mpq_equal (a, b);
+
+  mpq_neg (tmp, b);
+  return mpq_equal (a, tmp);
+}
+
+/**
+ * @brief Detect the structure of the exact coefficients of p, and store
+ * it in the symmetry_power and symmetry fields of s.
+ *
+ * The polynomial must have already been deflated, so that
+ * \f$p(0) \neq 0\f$.
+ *
+ * @param s The current mps_context.
+ * @param p The input polynomial.
+ */
+void
+mps_symmetry_detect (mps_context * s, mps_polynomial * p)
+{
+  mps_monomial_poly * mp;
+  mps_boolean palindromic = true, anti_palindromic = true;
+  int i, k = 0, n = p->degree;
+  mpq_t tmp;
+
+  s->symmetry = MPS_SYMMETRY_NONE;
+  s->symmetry_power = 1;
+
+  if (!MPS_IS_MONOMIAL_POLY (p) || !mps_symmetry_is_exact (p) || n < 2)
+    return;
+
+  mp = MPS_MONOMIAL_POLY (p);
+
+  for (i = 1; i <= n; i++)
+    if (mpq_sgn (mp->initial_mqp_r[i]) != 0 || mpq_sgn (mp->initial_mqp_i[i]) != 0)
+      k = mps_symmetry_gcd (k, i);
+
+  s->symmetry_power = MAX (k, 1);
+
+  mpq_init (tmp);
+  for (i = 0; i <= n / 2; i++)
+    {
+      palindromic = palindromic &&
+                    mps_symmetry_equal (mp->initial_mqp_r[i], mp->initial_mqp_r[n - i], 1, tmp) &&
+                    mps_symmetry_equal (mp->initial_mqp_i[i], mp->initial_mqp_i[n - i], 1, tmp);
+      anti_palindromic = anti_palindromic &&
+                         mps_symmetry_equal (mp->initial_mqp_r[i], mp->initial_mqp_r[n - i], -1, tmp) &&
+                         mps_symmetry_equal (mp->initial_mqp_i[i], mp->initial_mqp_i[n - i], -1, tmp);
+    }
+  mpq_clear (tmp);
+
+  if (palindromic)
+    s->symmetry = MPS_SYMMETRY_PALINDROMIC;
+  else if (anti_palindromic)
+    s->symmetry = MPS_SYMMETRY_ANTI_PALINDROMIC;
+
+  if (s->symmetry_power > 1 || s->symmetry != MPS_SYMMETRY_NONE)
+    MPS_DEBUG_WITH_INFO (s, "The polynomial is a polynomial in x^%d%s", s->symmetry_power,
+                         (s->symmetry == MPS_SYMMETRY_PALINDROMIC) ? " and is palindromic" :
+                         (s->symmetry == MPS_SYMMETRY_ANTI_PALINDROMIC) ? " and is anti-palindromic" : "");
+}
+
+/**
+ * @brief Divide the polynomial with coefficients cr + i ci of degree n
+ * by \f$x - t\f$, with \f$t = \pm 1\f$, in place. The division must be
+ * exact.
+ */
+static void
+mps_symmetry_deflate_unit_root (mpq_t * cr, mpq_t * ci, int n, int t, mpq_t tmp)
+{
+  int i;
+
+  /* The quotient b_{i-1} = a_i + t b_i, with b_{n-1} = a_n, is computed
+   * in place, storing b_{i-1} in the place of a_i. */
+  for (i = n - 1; i >= 1; i--)
+    {
+      mpq_set_si (tmp, t, 1U);
+      mpq_mul (tmp, tmp, cr[i + 1]);
+      mpq_add (cr[i], cr[i], tmp);
+
+      mpq_set_si (tmp, t, 1U);
+      mpq_mul (tmp, tmp, ci[i + 1]);
+      mpq_add (ci[i], ci[i], tmp);
+    }
+
+  /* Shift the quotient down, dropping the remainder. */
+  for (i = 0; i < n; i++)
+    {
+      mpq_swap (cr[i], cr[i + 1]);
+      mpq_swap (ci[i], ci[i + 1]);
+    }
+}
+
+/**
+ * @brief Compute the polynomial q of degree d such that
+ * \f$p(x) = x^d q(x + 1/x)\f$, where p is palindromic of degree 2d.
+ *
+ * The functions \f$x^j + x^{-j}\f$ are the polynomials \f$D_j\f$ in
+ * \f$z = x + 1/x\f$ with \f$D_0 = 2\f$, \f$D_1 = z\f$ and
+ * \f$D_{j+1} = z D_j - D_{j-1}\f$, that have integer coefficients.
+ */
+static mps_monomial_poly *
+mps_symmetry_palindromic_reduce (mps_context * s, mpq_t * cr, mpq_t * ci, int d)
+{
+  mps_monomial_poly * q = mps_monomial_poly_new (s, d);
+  mpz_t * dp = mps_newv (mpz_t, d + 1);
+  mpz_t * dc = mps_newv (mpz_t, d + 1);
+  mpz_t * dn = mps_newv (mpz_t, d + 1);
+  mpq_t * qr = mps_newv (mpq_t, d + 1);
+  mpq_t * qi = mps_newv (mpq_t, d + 1);
+  mpq_t tmp;
+  int i, j;
+
+  mpq_init (tmp);
+  for (j = 0; j <= d; j++)
+    {
+      mpz_init (dp[j]);
+      mpz_init (dc[j]);
+      mpz_init (dn[j]);
+      mpq_init (qr[j]);
+      mpq_init (qi[j]);
+    }
+
+  mpq_set (qr[0], cr[d]);
+  mpq_set (qi[0], ci[d]);
+
+  /* dp = D_0, dc = D_1 */
+  mpz_set_ui (dp[0], 2U);
+  mpz_set_ui (dc[1], 1U);
+
+  for (i = 1; i <= d; i++)
+    {
+      for (j = 0; j <= i; j++)
+        {
+          if (mpz_sgn (dc[j]) == 0)
+            continue;
+
+          mpq_set_z (tmp, dc[j]);
+          mpq_mul (tmp, tmp, cr[d + i]);
+          mpq_add (qr[j], qr[j], tmp);
+
+          mpq_set_z (tmp, dc[j]);
+          mpq_mul (tmp, tmp, ci[d + i]);
+          mpq_add (qi[j], qi[j], tmp);
+        }
+
+      if (i == d)
+        break;
+
+      /* D_{i+1} = z D_i - D_{i-1} */
+      mpz_neg (dn[0], dp[0]);
+      for (j = 1; j <= i + 1; j++)
+        mpz_sub (dn[j], dc[j - 1], dp[j]);
+
+      for (j = 0; j <= i + 1; j++)
+        {
+          mpz_swap (dp[j], dc[j]);
+          mpz_swap (dc[j], dn[j]);
+        }
+    }
+
+  for (j = 0; j <= d; j++)
+    mps_monomial_poly_set_coefficient_q (s, q, j, qr[j], qi[j]);
+
+  for (j = 0; j <= d; j++)
+    {
+      mpz_clear (dp[j]);
+      mpz_clear (dc[j]);
+      mpz_clear (dn[j]);
+      mpq_clear (qr[j]);
+      mpq_clear (qi[j]);
+    }
+  mpq_clear (tmp);
+
+  free (dp);
+  free (dc);
+  free (dn);
+  free (qr);
+  free (qi);
+
+  return q;
+}
+
+/**
+ * @brief Build the polynomial of lower degree that is solved in place of
+ * p, according to the structure detected by mps_symmetry_detect().
+ *
+ * If p is a polynomial in \f$x^k\f$ with \f$k > 1\f$ this is q with
+ * \f$p(x) = q(x^k)\f$. Otherwise, if p is palindromic or anti-palindromic,
+ * the factors \f$x - 1\f$ and \f$x + 1\f$ that make its degree odd or its
+ * coefficients anti-symmetric are removed, and their roots are stored in
+ * unit_roots, that must have room for 2 elements. The result is the
+ * polynomial q with \f$p(x) = x^d q(x + 1/x)\f$ for the remaining part,
+ * if d is at most MPS_SYMMETRY_PALINDROMIC_MAX_DEGREE.
+ *
+ * @return The reduced polynomial, or NULL if p does not have any of these
+ * structures.
+ */
+mps_monomial_poly *
+mps_symmetry_reduce (mps_context * s, mps_monomial_poly * p, int * n_unit_roots, int * unit_roots)
+{
+  mps_polynomial * poly = MPS_POLYNOMIAL (p);
+  mps_monomial_poly * q = NULL;
+  mpq_t * cr, * ci;
+  mpq_t tmp;
+  int i, n = poly->degree, k = s->symmetry_power;
+
+  *n_unit_roots = 0;
+
+  if (k > 1)
+    {
+      q = mps_monomial_poly_new (s, n / k);
+      for (i = 0; i <= n / k; i++)
+        mps_monomial_poly_set_coefficient_q (s, q, i, p->initial_mqp_r[i * k],
+                                             p->initial_mqp_i[i * k]);
+      return q;
+    }
+
+  if (s->symmetry == MPS_SYMMETRY_NONE)
+    return NULL;
+
+  if ((n - (s->symmetry == MPS_SYMMETRY_ANTI_PALINDROMIC)) / 2 > MPS_SYMMETRY_PALINDROMIC_MAX_DEGREE)
+    return NULL;
+
+  cr = mps_newv (mpq_t, n + 1);
+  ci = mps_newv (mpq_t, n + 1);
+  mpq_vinit (cr, n + 1);
+  mpq_vinit (ci, n + 1);
+  mpq_init (tmp);
+
+  for (i = 0; i <= n; i++)
+    {
+      mpq_set (cr[i], p->initial_mqp_r[i]);
+      mpq_set (ci[i], p->initial_mqp_i[i]);
+    }
+
+  /* An anti-palindromic polynomial is x - 1 times a palindromic one,
+   * and a palindromic one of odd degree is x + 1 times a palindromic one
+   * of even degree. */
+  if (s->symmetry == MPS_SYMMETRY_ANTI_PALINDROMIC)
+    {
+      mps_symmetry_deflate_unit_root (cr, ci, n--, 1, tmp);
+      unit_roots[(*n_unit_roots)++] = 1;
+    }
+
+  if (n % 2)
+    {
+      mps_symmetry_deflate_unit_root (cr, ci, n--, -1, tmp);
+      unit_roots[(*n_unit_roots)++] = -1;
+    }
+
+  if (n >= 2)
+    q = mps_symmetry_palindromic_reduce (s, cr, ci, n / 2);
+
+  mpq_vclear (cr, poly->degree + 1);
+  mpq_vclear (ci, poly->degree + 1);
+  mpq_clear (tmp);
+  free (cr);
+  free (ci);
+
+  return q;
+}
+
+/**
+ * @brief Compute the l-th k-th root of y, i.e.,
+ * \f$|y|^{1/k} e^{i (\arg y + 2 \pi l) / k}\f$, in x.
+ *
+ * A starting point obtained in DPE is refined with Newton's method at
+ * the precision of x.
+ */
+static void
+mps_symmetry_mroot (mpc_t x, mpc_t y, int k, int l)
+{
+  long int wp = mpc_get_prec (x);
+  rdpe_t m;
+  cdpe_t c;
+  cplx_t u;
+  mpc_t t, v;
+  double theta;
+  int it;
+
+  mpc_get_cdpe (c, y);
+  cdpe_mod (m, c);
+
+  if (rdpe_eq (m, rdpe_zero))
+    {
+      mpc_set_ui (x, 0U, 0U);
+      return;
+    }
+
+  cdpe_div_e (c, c, m);
+  cdpe_get_x (u, c);
+
+  theta = (atan2 (cplx_Im (u), cplx_Re (u)) + 2.0 * PI * l) / k;
+  rdpe_pow_eq_d (m, 1.0 / k);
+  cdpe_set_d (c, cos (theta), sin (theta));
+  cdpe_mul_e (c, c, m);
+  mpc_set_cdpe (x, c);
+
+  mpc_init2 (t, wp);
+  mpc_init2 (v, wp);
+
+  /* Newton's method doubles the correct bits at every step. */
+  for (it = 0; (DBL_MANT_DIG - 8) << it < 2 * wp; it++)
+    {
+      mpc_pow_si (t, x, k - 1);
+      mpc_mul (v, t, x);
+      mpc_sub_eq (v, y);
+      mpc_mul_ui (t, t, (unsigned long int) k);
+      mpc_div_eq (v, t);
+      mpc_sub_eq (x, v);
+    }
+
+  mpc_clear (t);
+  mpc_clear (v);
+}
+
+/**
+ * @brief Radius of a disc centered in x, a k-th root of y, that contains
+ * the k-th roots of the disc of center y and radius r that are closest
+ * to x.
+ *
+ * If \f$r < |y|\f$ the bound follows from
+ * \f$|(1 + t)^{1/k} - 1| \leq 1 - (1 - |t|)^{1/k} \leq |t| / (k (1 - |t|))\f$
+ * for \f$|t| < 1\f$.
+ */
+static void
+mps_symmetry_power_radius (rdpe_t rad, mpc_t x, mpc_t y, rdpe_t r, int k)
+{
+  rdpe_t ax, ay, t;
+
+  mpc_rmod (ax, x);
+  mpc_rmod (ay, y);
+
+  if (rdpe_lt (r, ay))
+    {
+      rdpe_div (t, r, ay);
+      rdpe_sub (rad, rdpe_one, t);
+      rdpe_mul_eq_d (rad, (double) k);
+      rdpe_div (rad, t, rad);
+      rdpe_mul_eq (rad, ax);
+    }
+  else
+    {
+      rdpe_add (rad, ay, r);
+      rdpe_pow_eq_d (rad, 1.0 / k);
+      rdpe_add_eq (rad, ax);
+    }
+}
+
+/**
+ * @brief Radius of a disc centered in x, a root of \f$x^2 - z x + 1\f$,
+ * that contains the root closest to x of \f$x^2 - z' x + 1\f$ for any
+ * \f$z'\f$ with \f$|z' - z| \leq r\f$.
+ *
+ * If x' is such a root and \f$\bar x = 1 / x\f$ is the other root for z,
+ * then \f$(x' - x)(x' - \bar x) = (z' - z) x'\f$. Writing
+ * \f$g = |x - \bar x|\f$ and \f$a = |x|\f$, every \f$\rho = |x' - x|\f$
+ * satisfies \f$\rho (g - \rho) \leq r (a + \rho)\f$, so x' cannot leave
+ * the disc of radius equal to the smallest root of
+ * \f$\rho^2 - (g - r) \rho + r a\f$, when this is real. Otherwise the
+ * roots are close to \f$\pm 1\f$, and both lie within
+ * \f$g + \sqrt{r (|z| + r + 2)}\f$ from x.
+ */
+static void
+mps_symmetry_palindromic_radius (rdpe_t rad, mpc_t x, mpc_t z, rdpe_t r, rdpe_t g)
+{
+  rdpe_t a, gr, disc, tmp;
+
+  mpc_rmod (a, x);
+  rdpe_sub (gr, g, r);
+
+  rdpe_mul (tmp, r, a);
+  rdpe_mul_eq_d (tmp, 4.0);
+  rdpe_sqr (disc, gr);
+  rdpe_sub_eq (disc, tmp);
+
+  if (rdpe_gt (gr, rdpe_zero) && rdpe_gt (disc, rdpe_zero))
+    {
+      /* 2 r a / ((g - r) + sqrt(disc)) */
+      rdpe_sqrt_eq (disc);
+      rdpe_add_eq (disc, gr);
+      rdpe_mul (rad, r, a);
+      rdpe_mul_eq_d (rad, 2.0);
+      rdpe_div_eq (rad, disc);
+    }
+  else
+    {
+      mpc_rmod (tmp, z);
+      rdpe_add_eq (tmp, r);
+      rdpe_add_eq_d (tmp, 2.0);
+      rdpe_mul_eq (tmp, r);
+      rdpe_sqrt_eq (tmp);
+      rdpe_add (rad, g, tmp);
+    }
+}
+
+/**
+ * @brief Set the approximation root to x with the inclusion radius rad,
+ * increased to take into account the rounding errors in x, and check if
+ * it is as accurate as required when the approximation of the reduced
+ * polynomial it comes from was.
+ */
+static mps_boolean
+mps_symmetry_set_root (mps_context * s, mps_approximation * root, mpc_t x, rdpe_t rad,
+                       mps_approximation * reduced_root)
+{
+  rdpe_t ax, rtmp;
+  long int wp = mpc_get_prec (x);
+
+  mpc_rmod (ax, x);
+  rdpe_mul_2exp (rtmp, ax, 3);
+  rdpe_div_eq_2exp (rtmp, (unsigned long int) wp);
+  rdpe_add_eq (rad, rtmp);
+
+  mpc_set_prec (root->mvalue, wp);
+  mpc_set (root->mvalue, x);
+  rdpe_set (root->drad, rad);
+  root->wp = wp;
+  root->status = reduced_root->status;
+  root->inclusion = reduced_root->inclusion;
+
+  if (reduced_root->status != MPS_ROOT_STATUS_APPROXIMATED)
+    return true;
+
+  rdpe_mul_2exp (rtmp, rad, (unsigned long int) s->output_config->prec + 1);
+  return rdpe_le (rtmp, ax);
+}
+
+/**
+ * @brief Solve the active polynomial through the reduced polynomial
+ * computed by mps_symmetry_reduce().
+ *
+ * The reduced polynomial is solved in a new mps_context configured like
+ * s, and its roots and inclusion radii are mapped back to the ones of
+ * the active polynomial.
+ *
+ * @param s The current mps_context.
+ * @return false if the active polynomial cannot be reduced, or if some
+ * of the approximations obtained do not reach the output precision
+ * anymore after the transformation. In this case it must be solved with
+ * the selected algorithm. true if it has been solved.
+ */
+mps_boolean
+mps_symmetry_mpsolve (mps_context * s)
+{
+  mps_monomial_poly * q;
+  mps_context * ctx;
+  mps_approximation ** reduced, ** roots;
+  mps_boolean accurate = true;
+  long int prec = 0;
+  int i, j, l, m, n = 0, k = s->symmetry_power;
+  int unit_roots[2], n_unit_roots;
+
+  if ((k == 1 && s->symmetry == MPS_SYMMETRY_NONE) || !MPS_IS_MONOMIAL_POLY (s->active_poly) ||
+      s->distributed || s->resume_file ||
+      s->output_config->goal != MPS_OUTPUT_GOAL_APPROXIMATE ||
+      s->output_config->search_set != MPS_SEARCH_SET_COMPLEX_PLANE)
+    return false;
+
+  q = mps_symmetry_reduce (s, MPS_MONOMIAL_POLY (s->active_poly), &n_unit_roots, unit_roots);
+  if (!q)
+    return false;
+
+  MPS_DEBUG_WITH_INFO (s, "Solving a reduced polynomial of degree %d", MPS_POLYNOMIAL (q)->degree);
+
+  ctx = mps_context_new ();
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (q));
+  mps_context_copy_options (ctx, s);
+  mps_mpsolve (ctx);
+
+  if (mps_context_has_errors (ctx))
+    {
+      mps_error (s, "%s", ctx->last_error);
+      mps_context_free (ctx);
+      mps_polynomial_free (s, MPS_POLYNOMIAL (q));
+      return true;
+    }
+
+  reduced = mps_context_get_approximations (ctx);
+  m = ctx->n + ctx->zero_roots;
+
+  roots = mps_newv (mps_approximation *, s->n);
+  for (i = 0; i < s->n; i++)
+    roots[i] = mps_approximation_new (s);
+
+  for (j = 0; j < m; j++)
+    {
+      long int wp = mpc_get_prec (reduced[j]->mvalue) + MPS_SYMMETRY_GUARD_BITS;
+      mpc_t x, w;
+      rdpe_t rad, rtmp, g;
+
+      mpc_init2 (x, wp);
+      mpc_init2 (w, wp);
+
+      if (k > 1)
+        {
+          for (l = 0; l < k; l++, n++)
+            {
+              mps_symmetry_mroot (x, reduced[j]->mvalue, k, l);
+              mps_symmetry_power_radius (rad, x, reduced[j]->mvalue, reduced[j]->drad, k);
+              accurate = mps_symmetry_set_root (s, roots[n], x, rad, reduced[j]) && accurate;
+            }
+        }
+      else
+        {
+          /* The roots of x^2 - z x + 1 are (z +- w) / 2, with w^2 = z^2 - 4.
+           * The one of largest modulus is computed first, and the other is
+           * its reciprocal. */
+          mpc_sqr (w, reduced[j]->mvalue);
+          mpc_sub_eq_ui (w, 4U, 0U);
+          mpc_set (x, w);
+          mps_symmetry_mroot (w, x, 2, 0);
+          mpc_rmod (g, w);
+
+          mpc_add (x, reduced[j]->mvalue, w);
+          mpc_sub (w, reduced[j]->mvalue, w);
+          mpc_rmod (rad, x);
+          mpc_rmod (rtmp, w);
+          if (rdpe_lt (rad, rtmp))
+            mpc_set (x, w);
+          mpc_div_eq_ui (x, 2U);
+
+          for (l = 0; l < 2; l++, n++)
+            {
+              if (l == 1)
+                mpc_inv_eq (x);
+
+              mps_symmetry_palindromic_radius (rad, x, reduced[j]->mvalue, reduced[j]->drad, g);
+              accurate = mps_symmetry_set_root (s, roots[n], x, rad, reduced[j]) && accurate;
+            }
+        }
+
+      prec = MAX (prec, wp);
+
+      mpc_clear (x);
+      mpc_clear (w);
+    }
+
+  for (i = 0; i < n_unit_roots; i++, n++)
+    {
+      mpc_set_prec (roots[n]->mvalue, prec);
+      mpc_set_si (roots[n]->mvalue, unit_roots[i], 0);
+      roots[n]->wp = prec;
+      /* The roots are exact, but a zero radius would not be handled when
+       * printing them. */
+      rdpe_set (roots[n]->drad, rdpe_one);
+      rdpe_div_eq_2exp (roots[n]->drad, (unsigned long int) prec);
+      roots[n]->status = MPS_ROOT_STATUS_APPROXIMATED;
+      roots[n]->attrs = MPS_ROOT_ATTRS_REAL;
+      roots[n]->inclusion = MPS_ROOT_INCLUSION_IN;
+    }
+
+  if (accurate)
+    {
+      mps_allocate_data (s);
+
+      for (i = 0; i < s->n; i++)
+        {
+          mps_approximation * root = s->root[i];
+
+          mpc_set_prec (root->mvalue, mpc_get_prec (roots[i]->mvalue));
+          mpc_set (root->mvalue, roots[i]->mvalue);
+          mpc_get_cdpe (root->dvalue, root->mvalue);
+          mpc_get_cplx (root->fvalue, root->mvalue);
+          rdpe_set (root->drad, roots[i]->drad);
+          root->frad = rdpe_get_d (root->drad);
+          root->wp = roots[i]->wp;
+          root->attrs = roots[i]->attrs;
+          root->inclusion = roots[i]->inclusion;
+          root->status = roots[i]->status;
+        }
+
+      s->over_max = ctx->over_max;
+      mps_mp_set_prec (s, prec);
+      MPS_LOCK (s->data_prec_max);
+      s->data_prec_max.value = mps_context_get_data_prec_max (ctx);
+      MPS_UNLOCK (s->data_prec_max);
+
+      s->lastphase = mp_phase;
+      for (i = 0; i < s->n; i++)
+        s->order[i] = i;
+      mps_copy_roots (s);
+    }
+  else
+    MPS_DEBUG_WITH_INFO (s, "The roots of the reduced polynomial are not accurate enough");
+
+  for (i = 0; i < s->n; i++)
+    mps_approximation_free (s, roots[i]);
+  free (roots);
+
+  for (j = 0; j < m; j++)
+    mps_approximation_free (ctx, reduced[j]);
+  free (reduced);
+
+  mps_context_free (ctx);
+  mps_polynomial_free (s, MPS_POLYNOMIAL (q));
+
+  return accurate;
+}
@@ -0,0 +1,367 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <string.h>
+
+void mps_rational_equation_free (mps_context * ctx, mps_polynomial * poly);
+long int mps_rational_equation_raise_data (mps_context * ctx, mps_polynomial * poly, long int wp);
+void mps_rational_equation_get_leading_coefficient (mps_context * ctx, mps_polynomial * poly, mpc_t lc);
+
+/* These are implemented in rational-evaluation.c */
+mps_boolean mps_rational_equation_feval (mps_context * ctx, mps_polynomial * poly, cplx_t x, cplx_t value, double * error);
+mps_boolean mps_rational_equation_deval (mps_context * ctx, mps_polynomial * poly, cdpe_t x, cdpe_t value, rdpe_t error);
+mps_boolean mps_rational_equation_meval (mps_context * ctx, mps_polynomial * poly, mpc_t x, mpc_t value, rdpe_t error);
+void mps_rational_equation_fnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, cplx_t corr);
+void mps_rational_equation_dnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, cdpe_t corr);
+void mps_rational_equation_mnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, mpc_t corr,
+                                    long int wp);
+
+/* These are implemented in rational-starting.c */
+void mps_rational_equation_fstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
+void mps_rational_equation_dstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations);
+
+mps_rational_equation *
+mps_rational_equation_new (mps_context * ctx, int n_terms, int rhs_degree)
+{
+  mps_rational_equation * re = mps_new (mps_rational_equation);
+  int n = 2 * n_terms + rhs_degree + 1;
+
+  /* The degree is computed when the coefficients are set. */
+  MPS_POLYNOMIAL (re)->degree = 0;
+  mps_polynomial_init (ctx, MPS_POLYNOMIAL (re));
+
+  MPS_POLYNOMIAL (re)->structure = MPS_STRUCTURE_REAL_INTEGER;
+  MPS_POLYNOMIAL (re)->density = MPS_DENSITY_USER;
+
+  re->n_terms = n_terms;
+  re->rhs_degree = rhs_degree;
+  re->n_coeffs = n;
+  re->n_active = 0;
+  re->f_degree = -1;
+
+  re->orders = mps_newv (int, n_terms + 1);
+  re->active_terms = mps_newv (int, n_terms + 1);
+  memset (re->orders, 0, sizeof(int) * (n_terms + 1));
+
+  re->rational_real_coeffs = mps_newv (mpq_t, n);
+  re->rational_imag_coeffs = mps_newv (mpq_t, n);
+  mpq_vinit (re->rational_real_coeffs, n);
+  mpq_vinit (re->rational_imag_coeffs, n);
+
+  re->fpc = cplx_valloc (n);
+  re->dpc = cdpe_valloc (n);
+  re->mfpc = mpc_valloc (n);
+  re->fap = mps_newv (double, n);
+  re->dap = rdpe_valloc (n);
+
+  mpc_vinit2 (re->mfpc, n, ctx->mpwp);
+  cplx_vinit (re->fpc, n);
+  cdpe_vinit (re->dpc, n);
+  memset (re->fap, 0, sizeof(double) * n);
+  rdpe_vinit (re->dap, n);
+
+  /* Construct the polynomial vtable */
+  MPS_POLYNOMIAL (re)->free = mps_rational_equation_free;
+  MPS_POLYNOMIAL (re)->raise_data = mps_rational_equation_raise_data;
+  MPS_POLYNOMIAL (re)->feval = mps_rational_equation_feval;
+  MPS_POLYNOMIAL (re)->deval = mps_rational_equation_deval;
+  MPS_POLYNOMIAL (re)->meval = mps_rational_equation_meval;
+  MPS_POLYNOMIAL (re)->fnewton = mps_rational_equation_fnewton;
+  MPS_POLYNOMIAL (re)->dnewton = mps_rational_equation_dnewton;
+  MPS_POLYNOMIAL (re)->mnewton = mps_rational_equation_mnewton;
+  MPS_POLYNOMIAL (re)->fstart = mps_rational_equation_fstart;
+  MPS_POLYNOMIAL (re)->dstart = mps_rational_equation_dstart;
+  MPS_POLYNOMIAL (re)->get_leading_coefficient = mps_rational_equation_get_leading_coefficient;
+
+  MPS_POLYNOMIAL (re)->type_name = MPS_RATIONAL_EQUATION_TYPE_NAME;
+
+  pthread_mutex_init (&re->precision_mutex, NULL);
+
+  return re;
+}
+
+void
+mps_rational_equation_free (mps_context * ctx, mps_polynomial * poly)
+{
+  mps_rational_equation * re = MPS_RATIONAL_EQUATION (poly);
+
+  mpc_vclear (re->mfpc, re->n_coeffs);
+  mpq_vclear (re->rational_real_coeffs, re->n_coeffs);
+  mpq_vclear (re->rational_imag_coeffs, re->n_coeffs);
+
+  mpc_vfree (re->mfpc);
+  cplx_vfree (re->fpc);
+  cdpe_vfree (re->dpc);
+  free (re->fap);
+  rdpe_vfree (re->dap);
+
+  free (re->rational_real_coeffs);
+  free (re->rational_imag_coeffs);
+  free (re->orders);
+  free (re->active_terms);
+
+  pthread_mutex_destroy (&re->precision_mutex);
+
+  free (poly);
+}
+
+long int
+mps_rational_equation_raise_data (mps_context * ctx, mps_polynomial * poly, long int wp)
+{
+  mps_rational_equation * re = MPS_RATIONAL_EQUATION (poly);
+  int i;
+
+  pthread_mutex_lock (&re->precision_mutex);
+
+  /* The coefficients are left untouched if they are already accurate
+   * enough, so that the concurrent evaluations are not disturbed. */
+  if (wp <= mpc_get_prec (re->mfpc[0]))
+    {
+      pthread_mutex_unlock (&re->precision_mutex);
+      return mpc_get_prec (re->mfpc[0]);
+    }
+
+  /* Regenerate the coefficients from the exact input. */
+  for (i = 0; i < re->n_coeffs; i++)
+    {
+      mpc_set_prec (re->mfpc[i], wp);
+      mpf_set_q (mpc_Re (re->mfpc[i]), re->rational_real_coeffs[i]);
+      mpf_set_q (mpc_Im (re->mfpc[i]), re->rational_imag_coeffs[i]);
+    }
+
+  pthread_mutex_unlock (&re->precision_mutex);
+
+  return mpc_get_prec (re->mfpc[0]);
+}
+
+static mps_boolean
+mps_rational_equation_coefficient_is_zero (mps_rational_equation * re, int k)
+{
+  return mpq_sgn (re->rational_real_coeffs[k]) == 0 &&
+         mpq_sgn (re->rational_imag_coeffs[k]) == 0;
+}
+
+/**
+ * @brief Lowest order of the active poles, or 0 if there are none.
+ */
+static int
+mps_rational_equation_min_order (mps_rational_equation * re)
+{
+  int i, k = 0;
+
+  for (i = 0; i < re->n_active; i++)
+    {
+      int o = re->orders[re->active_terms[i]];
+      k = (i == 0) ? o : MIN (k, o);
+    }
+
+  return k;
+}
+
+/**
+ * @brief Recompute the active terms, the degree and the structure of the
+ * equation after a change in the coefficients.
+ */
+static void
+mps_rational_equation_update (mps_context * ctx, mps_rational_equation * re)
+{
+  mps_polynomial * poly = MPS_POLYNOMIAL (re);
+  mps_boolean real = true, integer = true;
+  int i, j, orders = 0;
+
+  for (i = 0; i < re->n_coeffs; i++)
+    {
+      if (mpq_sgn (re->rational_imag_coeffs[i]) != 0)
+        real = false;
+      if (mpz_cmp_ui (mpq_denref (re->rational_real_coeffs[i]), 1U) != 0 ||
+          mpz_cmp_ui (mpq_denref (re->rational_imag_coeffs[i]), 1U) != 0)
+        integer = false;
+    }
+
+  if (real)
+    poly->structure = integer ? MPS_STRUCTURE_REAL_INTEGER : MPS_STRUCTURE_REAL_RATIONAL;
+  else
+    poly->structure = integer ? MPS_STRUCTURE_COMPLEX_INTEGER : MPS_STRUCTURE_COMPLEX_RATIONAL;
+
+  re->n_active = 0;
+  for (i = 0; i < re->n_terms; i++)
+    {
+      if (re->orders[i] > 0 &&
+          !mps_rational_equation_coefficient_is_zero (re, MPS_RATIONAL_EQUATION_C (re, i)))
+        {
+          re->active_terms[re->n_active++] = i;
+          orders += re->orders[i];
+        }
+    }
+
+  re->f_degree = -1;
+  for (j = 0; j <= re->rhs_degree; j++)
+    if (!mps_rational_equation_coefficient_is_zero (re, MPS_RATIONAL_EQUATION_F (re, j)))
+      re->f_degree = j;
+
+  /* The term D(x) f(x) has the highest degree, unless f is zero. */
+  if (re->f_degree >= 0)
+    poly->degree = orders + re->f_degree;
+  else
+    poly->degree = orders - mps_rational_equation_min_order (re);
+}
+
+static void
+mps_rational_equation_set_coefficient (mps_context * ctx, mps_rational_equation * re, int k,
+                                       mpq_t real_part, mpq_t imag_part)
+{
+  mpq_set (re->rational_real_coeffs[k], real_part);
+  mpq_set (re->rational_imag_coeffs[k], imag_part);
+
+  mpf_set_q (mpc_Re (re->mfpc[k]), real_part);
+  mpf_set_q (mpc_Im (re->mfpc[k]), imag_part);
+
+  mpc_get_cplx (re->fpc[k], re->mfpc[k]);
+  mpc_get_cdpe (re->dpc[k], re->mfpc[k]);
+  re->fap[k] = cplx_mod (re->fpc[k]);
+  cdpe_mod (re->dap[k], re->dpc[k]);
+}
+
+void
+mps_rational_equation_set_term_q (mps_context * ctx, mps_rational_equation * re, int i,
+                                  mpq_t c_real, mpq_t c_imag, mpq_t d_real, mpq_t d_imag,
+                                  int k)
+{
+  if (i < 0 || i >= re->n_terms)
+    {
+      mps_error (ctx, "Term index out of the bounds of the rational equation");
+      return;
+    }
+
+  if (k <= 0)
+    {
+      mps_error (ctx, "The order of the poles must be a positive integer");
+      return;
+    }
+
+  re->orders[i] = k;
+  mps_rational_equation_set_coefficient (ctx, re, MPS_RATIONAL_EQUATION_C (re, i), c_real, c_imag);
+  mps_rational_equation_set_coefficient (ctx, re, MPS_RATIONAL_EQUATION_D (re, i), d_real, d_imag);
+
+  mps_rational_equation_update (ctx, re);
+}
+
+/**
+ * @brief Recompute all the floating point coefficients and the degree from
+ * the rational coefficients and the orders stored in re, that have been
+ * written directly, as the parser does.
+ */
+void
+mps_rational_equation_update_coefficients (mps_context * ctx, mps_rational_equation * re)
+{
+  int i;
+
+  for (i = 0; i < re->n_coeffs; i++)
+    mps_rational_equation_set_coefficient (ctx, re, i, re->rational_real_coeffs[i],
+                                           re->rational_imag_coeffs[i]);
+
+  mps_rational_equation_update (ctx, re);
+}
+
+void
+mps_rational_equation_set_term_i (mps_context * ctx, mps_rational_equation * re, int i,
+                                  long int c_real, long int c_imag,
+                                  long int d_real, long int d_imag, int k)
+{
+  mpq_t cr, ci, dr, di;
+
+  mpq_init (cr);
+  mpq_init (ci);
+  mpq_init (dr);
+  mpq_init (di);
+  mpq_set_si (cr, c_real, 1L);
+  mpq_set_si (ci, c_imag, 1L);
+  mpq_set_si (dr, d_real, 1L);
+  mpq_set_si (di, d_imag, 1L);
+
+  mps_rational_equation_set_term_q (ctx, re, i, cr, ci, dr, di, k);
+
+  mpq_clear (cr);
+  mpq_clear (ci);
+  mpq_clear (dr);
+  mpq_clear (di);
+}
+
+void
+mps_rational_equation_set_rhs_coefficient_q (mps_context * ctx, mps_rational_equation * re,
+                                             int j, mpq_t real_part, mpq_t imag_part)
+{
+  if (j < 0 || j > re->rhs_degree)
+    {
+      mps_error (ctx, "Coefficient index out of the bounds of the right hand side");
+      return;
+    }
+
+  mps_rational_equation_set_coefficient (ctx, re, MPS_RATIONAL_EQUATION_F (re, j),
+                                         real_part, imag_part);
+  mps_rational_equation_update (ctx, re);
+}
+
+void
+mps_rational_equation_set_rhs_coefficient_i (mps_context * ctx, mps_rational_equation * re,
+                                             int j, long int real_part, long int imag_part)
+{
+  mpq_t re_part, im_part;
+
+  mpq_init (re_part);
+  mpq_init (im_part);
+  mpq_set_si (re_part, real_part, 1L);
+  mpq_set_si (im_part, imag_part, 1L);
+
+  mps_rational_equation_set_rhs_coefficient_q (ctx, re, j, re_part, im_part);
+
+  mpq_clear (re_part);
+  mpq_clear (im_part);
+}
+
+/**
+ * @brief The leading coefficient is \f$-f_q\f$, or the sum of the
+ * \f$c_i\f$ of the poles of lowest order if the right hand side is zero.
+ */
+void
+mps_rational_equation_get_leading_coefficient (mps_context * ctx, mps_polynomial * poly, mpc_t lc)
+{
+  mps_rational_equation * re = MPS_RATIONAL_EQUATION (poly);
+  long int wp = mpc_get_prec (lc);
+  int i, kmin = mps_rational_equation_min_order (re);
+  mpc_t coeff;
+
+  if (re->f_degree >= 0)
+    {
+      int k = MPS_RATIONAL_EQUATION_F (re, re->f_degree);
+      mpf_set_q (mpc_Re (lc), re->rational_real_coeffs[k]);
+      mpf_set_q (mpc_Im (lc), re->rational_imag_coeffs[k]);
+      mpc_neg (lc, lc);
+      return;
+    }
+
+  mpc_init2 (coeff, wp);
+  mpc_set_ui (lc, 0U, 0U);
+
+  for (i = 0; i < re->n_active; i++)
+    {
+      int t = re->active_terms[i];
+
+      if (re->orders[t] != kmin)
+        continue;
+
+      mpf_set_q (mpc_Re (coeff), re->rational_real_coeffs[MPS_RATIONAL_EQUATION_C (re, t)]);
+      mpf_set_q (mpc_Im (coeff), re->rational_imag_coeffs[MPS_RATIONAL_EQUATION_C (re, t)]);
+      mpc_add_eq (lc, coeff);
+    }
+
+  mpc_clear (coeff);
+}
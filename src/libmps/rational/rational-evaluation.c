@@ -0,0 +1,740 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+/********************************************************
+   The equation is solved as P(x) = D(x) F(x), where
+     F(x) = sum_i c_i t_i^k_i - f(x),  t_i = 1 / (x - d_i),
+     D(x) = prod_i (x - d_i)^k_i.
+   Since P'/P = F'/F + sum_i k_i t_i, the Newton correction
+   only needs the sums
+     S0 = sum_i c_i t_i^k_i,
+     S1 = sum_i k_i c_i t_i^(k_i + 1),
+     Sk = sum_i k_i t_i,
+   which are computed pairwise, as in the secular equations.
+
+   Near a pole d = d_l of order k the terms of F' and of
+   F Sk in l cancel out, so the term l is left out of the
+   sums (marked by a prime) and both P and P' are divided by
+   the remaining part of D, i.e., we use
+     Fh = (S0' - f) h + c_l,
+     Gh = (S0' - f) (Sk' h + k (x - d)^(k-1))
+          + c_l Sk' - (S1' + f') h,
+   with h = (x - d)^k, so that P/P' = Fh/Gh. These are finite
+   also when x = d, where P(d) is a multiple of c_l.
+
+   The rounding errors on Fh are bounded by
+     u ((k + 2) (sum' (2 k_i + 4) |c_i t_i^k_i|
+                 + 4 (q + 1) |f|(|x|)) |h| + (2 k + 4) |c_l|),
+   where |f| is the polynomial with the moduli of the
+   coefficients of f, and the moduli of the partial sums
+   of S0' are added to the sum over the terms.
+
+   Since x is itself rounded, |Fh| cannot be expected to
+   get below u |x| |Gh|, which is added to the bound when
+   deciding if a Newton correction is still useful.
+ **********************************************************/
+
+#include <float.h>
+#include <mps/mps.h>
+
+/**
+ * @brief Number of terms that are summed sequentially in the leaves
+ * of the pairwise summation.
+ */
+#define MPS_RATIONAL_EQUATION_SUM_BLOCK 4
+
+/**
+ * @brief Compute the sums \f$S_0\f$, \f$S_1\f$ and \f$S_k\f$ over the active
+ * terms from first to last - 1, except skip, by splitting them in halves.
+ *
+ * @param as The sum of \f$(2 k_i + 4) |c_i t_i^{k_i}|\f$ and of twice the
+ * moduli of the partial sums of \f$S_0\f$, used in the error bound.
+ */
+static void
+mps_rational_equation_fsum (mps_rational_equation * re, cplx_t x, int first, int last, int skip,
+                            cplx_t s0, cplx_t s1, cplx_t sk, double * as)
+{
+  cplx_t t, u, tmp;
+  double las;
+  int l, mid;
+
+  if (last - first <= MPS_RATIONAL_EQUATION_SUM_BLOCK)
+    {
+      cplx_set (s0, cplx_zero);
+      cplx_set (s1, cplx_zero);
+      cplx_set (sk, cplx_zero);
+      *as = 0.0;
+
+      for (l = first; l < last; l++)
+        {
+          int i = re->active_terms[l];
+          int k = re->orders[i];
+
+          if (i == skip)
+            continue;
+
+          /* Compute t_i = (x - d_i)^{-1} and c_i t_i^k_i */
+          cplx_sub (t, x, re->fpc[MPS_RATIONAL_EQUATION_D (re, i)]);
+          cplx_inv_eq (t);
+          cplx_pow_si (u, t, k);
+          cplx_mul_eq (u, re->fpc[MPS_RATIONAL_EQUATION_C (re, i)]);
+
+          cplx_add_eq (s0, u);
+          cplx_mul (tmp, u, t);
+          cplx_mul_eq_d (tmp, (double) k);
+          cplx_add_eq (s1, tmp);
+          cplx_mul_d (tmp, t, (double) k);
+          cplx_add_eq (sk, tmp);
+
+          *as += (2.0 * k + 4.0) * cplx_mod (u);
+        }
+
+      return;
+    }
+
+  mid = (first + last) / 2;
+
+  mps_rational_equation_fsum (re, x, first, mid, skip, s0, s1, sk, as);
+  mps_rational_equation_fsum (re, x, mid, last, skip, t, u, tmp, &las);
+
+  cplx_add_eq (s0, t);
+  cplx_add_eq (s1, u);
+  cplx_add_eq (sk, tmp);
+  *as += las + 2.0 * cplx_mod (s0);
+}
+
+/**
+ * @brief Index of the active term whose pole is closest to x, or -1 if
+ * there are no active terms.
+ */
+static int
+mps_rational_equation_fclosest_pole (mps_rational_equation * re, cplx_t x)
+{
+  int l, closest = -1;
+  double dist, min_dist = 0.0;
+  cplx_t diff;
+
+  for (l = 0; l < re->n_active; l++)
+    {
+      int i = re->active_terms[l];
+
+      cplx_sub (diff, x, re->fpc[MPS_RATIONAL_EQUATION_D (re, i)]);
+      dist = cplx_smod (diff);
+
+      if (closest < 0 || dist < min_dist)
+        {
+          closest = i;
+          min_dist = dist;
+        }
+    }
+
+  return closest;
+}
+
+/**
+ * @brief Floating point evaluation of the scaled values \f$\hat F\f$ and
+ * \f$\hat G\f$ described at the beginning of this file.
+ *
+ * @param re The equation to evaluate.
+ * @param x The point of evaluation.
+ * @param fh The value of \f$\hat F\f$ in x.
+ * @param gh The value of \f$\hat G\f$ in x.
+ * @param error A bound to the absolute error on fh.
+ * @return The index of the pole that has been left out of the sums, or -1.
+ */
+static int
+mps_rational_equation_fscaled (mps_rational_equation * re, cplx_t x, cplx_t fh, cplx_t gh,
+                               double * error)
+{
+  int j, k = 0, q = re->f_degree;
+  int closest = mps_rational_equation_fclosest_pole (re, x);
+  double ax = cplx_mod (x), as, fa = 0.0, ac = 0.0;
+  cplx_t s0, s1, sk, fv, fd, h, h1, c, tmp;
+
+  mps_rational_equation_fsum (re, x, 0, re->n_active, closest, s0, s1, sk, &as);
+
+  /* Right hand side and its derivative */
+  cplx_set (fv, cplx_zero);
+  cplx_set (fd, cplx_zero);
+  for (j = q; j >= 0; j--)
+    {
+      cplx_mul_eq (fd, x);
+      cplx_add_eq (fd, fv);
+      cplx_mul_eq (fv, x);
+      cplx_add_eq (fv, re->fpc[MPS_RATIONAL_EQUATION_F (re, j)]);
+      fa = fa * ax + re->fap[MPS_RATIONAL_EQUATION_F (re, j)];
+    }
+
+  if (closest >= 0)
+    {
+      k = re->orders[closest];
+      cplx_sub (tmp, x, re->fpc[MPS_RATIONAL_EQUATION_D (re, closest)]);
+      cplx_pow_si (h1, tmp, k - 1);
+      cplx_mul (h, h1, tmp);
+      cplx_mul_eq_d (h1, (double) k);
+      cplx_set (c, re->fpc[MPS_RATIONAL_EQUATION_C (re, closest)]);
+      ac = re->fap[MPS_RATIONAL_EQUATION_C (re, closest)];
+    }
+  else
+    {
+      cplx_set (h, cplx_one);
+      cplx_set (h1, cplx_zero);
+      cplx_set (c, cplx_zero);
+    }
+
+  /* fh = (S0' - f) h + c */
+  cplx_sub_eq (s0, fv);
+  cplx_mul (fh, s0, h);
+  cplx_add_eq (fh, c);
+
+  /* gh = (S0' - f) (Sk' h + h1) + c Sk' - (S1' + f') h */
+  cplx_mul (tmp, sk, h);
+  cplx_add_eq (tmp, h1);
+  cplx_mul (gh, s0, tmp);
+  cplx_mul (tmp, c, sk);
+  cplx_add_eq (gh, tmp);
+  cplx_add_eq (s1, fd);
+  cplx_mul_eq (s1, h);
+  cplx_sub_eq (gh, s1);
+
+  *error = ((k + 2.0) * (as + 4.0 * (q + 1) * fa) * cplx_mod (h) +
+            (2.0 * k + 4.0) * ac) * DBL_EPSILON;
+
+  return closest;
+}
+
+/**
+ * @brief DPE version of mps_rational_equation_fsum().
+ */
+static void
+mps_rational_equation_dsum (mps_rational_equation * re, cdpe_t x, int first, int last, int skip,
+                            cdpe_t s0, cdpe_t s1, cdpe_t sk, rdpe_t as)
+{
+  cdpe_t t, u, tmp;
+  rdpe_t las;
+  int l, mid;
+
+  if (last - first <= MPS_RATIONAL_EQUATION_SUM_BLOCK)
+    {
+      cdpe_set (s0, cdpe_zero);
+      cdpe_set (s1, cdpe_zero);
+      cdpe_set (sk, cdpe_zero);
+      rdpe_set (as, rdpe_zero);
+
+      for (l = first; l < last; l++)
+        {
+          int i = re->active_terms[l];
+          int k = re->orders[i];
+
+          if (i == skip)
+            continue;
+
+          cdpe_sub (t, x, re->dpc[MPS_RATIONAL_EQUATION_D (re, i)]);
+          cdpe_inv_eq (t);
+          cdpe_pow_si (u, t, k);
+          cdpe_mul_eq (u, re->dpc[MPS_RATIONAL_EQUATION_C (re, i)]);
+
+          cdpe_add_eq (s0, u);
+          cdpe_mul (tmp, u, t);
+          cdpe_mul_eq_d (tmp, (double) k);
+          cdpe_add_eq (s1, tmp);
+          cdpe_mul_d (tmp, t, (double) k);
+          cdpe_add_eq (sk, tmp);
+
+          cdpe_mod (las, u);
+          rdpe_mul_eq_d (las, 2.0 * k + 4.0);
+          rdpe_add_eq (as, las);
+        }
+
+      return;
+    }
+
+  mid = (first + last) / 2;
+
+  mps_rational_equation_dsum (re, x, first, mid, skip, s0, s1, sk, as);
+  mps_rational_equation_dsum (re, x, mid, last, skip, t, u, tmp, las);
+
+  cdpe_add_eq (s0, t);
+  cdpe_add_eq (s1, u);
+  cdpe_add_eq (sk, tmp);
+  rdpe_add_eq (as, las);
+  cdpe_mod (las, s0);
+  rdpe_mul_eq_d (las, 2.0);
+  rdpe_add_eq (as, las);
+}
+
+/**
+ * @brief DPE version of mps_rational_equation_fclosest_pole().
+ */
+static int
+mps_rational_equation_dclosest_pole (mps_rational_equation * re, cdpe_t x)
+{
+  int l, closest = -1;
+  rdpe_t dist, min_dist;
+  cdpe_t diff;
+
+  rdpe_set (min_dist, rdpe_zero);
+
+  for (l = 0; l < re->n_active; l++)
+    {
+      int i = re->active_terms[l];
+
+      cdpe_sub (diff, x, re->dpc[MPS_RATIONAL_EQUATION_D (re, i)]);
+      cdpe_mod (dist, diff);
+
+      if (closest < 0 || rdpe_lt (dist, min_dist))
+        {
+          closest = i;
+          rdpe_set (min_dist, dist);
+        }
+    }
+
+  return closest;
+}
+
+/**
+ * @brief DPE version of mps_rational_equation_fscaled().
+ */
+static int
+mps_rational_equation_dscaled (mps_rational_equation * re, cdpe_t x, cdpe_t fh, cdpe_t gh,
+                               rdpe_t error)
+{
+  int j, k = 0, q = re->f_degree;
+  int closest = mps_rational_equation_dclosest_pole (re, x);
+  rdpe_t ax, as, fa, ac, rtmp;
+  cdpe_t s0, s1, sk, fv, fd, h, h1, c, tmp;
+
+  mps_rational_equation_dsum (re, x, 0, re->n_active, closest, s0, s1, sk, as);
+
+  cdpe_mod (ax, x);
+  cdpe_set (fv, cdpe_zero);
+  cdpe_set (fd, cdpe_zero);
+  rdpe_set (fa, rdpe_zero);
+  for (j = q; j >= 0; j--)
+    {
+      cdpe_mul_eq (fd, x);
+      cdpe_add_eq (fd, fv);
+      cdpe_mul_eq (fv, x);
+      cdpe_add_eq (fv, re->dpc[MPS_RATIONAL_EQUATION_F (re, j)]);
+      rdpe_mul_eq (fa, ax);
+      rdpe_add_eq (fa, re->dap[MPS_RATIONAL_EQUATION_F (re, j)]);
+    }
+
+  if (closest >= 0)
+    {
+      k = re->orders[closest];
+      cdpe_sub (tmp, x, re->dpc[MPS_RATIONAL_EQUATION_D (re, closest)]);
+      cdpe_pow_si (h1, tmp, k - 1);
+      cdpe_mul (h, h1, tmp);
+      cdpe_mul_eq_d (h1, (double) k);
+      cdpe_set (c, re->dpc[MPS_RATIONAL_EQUATION_C (re, closest)]);
+      rdpe_set (ac, re->dap[MPS_RATIONAL_EQUATION_C (re, closest)]);
+    }
+  else
+    {
+      cdpe_set (h, cdpe_one);
+      cdpe_set (h1, cdpe_zero);
+      cdpe_set (c, cdpe_zero);
+      rdpe_set (ac, rdpe_zero);
+    }
+
+  cdpe_sub_eq (s0, fv);
+  cdpe_mul (fh, s0, h);
+  cdpe_add_eq (fh, c);
+
+  cdpe_mul (tmp, sk, h);
+  cdpe_add_eq (tmp, h1);
+  cdpe_mul (gh, s0, tmp);
+  cdpe_mul (tmp, c, sk);
+  cdpe_add_eq (gh, tmp);
+  cdpe_add_eq (s1, fd);
+  cdpe_mul_eq (s1, h);
+  cdpe_sub_eq (gh, s1);
+
+  rdpe_mul_eq_d (fa, 4.0 * (q + 1));
+  rdpe_add (error, as, fa);
+  rdpe_mul_eq_d (error, k + 2.0);
+  cdpe_mod (rtmp, h);
+  rdpe_mul_eq (error, rtmp);
+  rdpe_mul_d (rtmp, ac, 2.0 * k + 4.0);
+  rdpe_add_eq (error, rtmp);
+  rdpe_mul_eq_d (error, DBL_EPSILON);
+
+  return closest;
+}
+
+/**
+ * @brief Multiprecision version of mps_rational_equation_fsum(). The
+ * computation is carried out with the precision of s0.
+ */
+static void
+mps_rational_equation_msum (mps_rational_equation * re, mpc_t x, int first, int last, int skip,
+                            mpc_t s0, mpc_t s1, mpc_t sk, rdpe_t as)
+{
+  long int wp = mpc_get_prec (s0);
+  mpc_t t, u, tmp;
+  rdpe_t las;
+  int l, mid;
+
+  mpc_init2 (t, wp);
+  mpc_init2 (u, wp);
+  mpc_init2 (tmp, wp);
+
+  if (last - first <= MPS_RATIONAL_EQUATION_SUM_BLOCK)
+    {
+      mpc_set_ui (s0, 0U, 0U);
+      mpc_set_ui (s1, 0U, 0U);
+      mpc_set_ui (sk, 0U, 0U);
+      rdpe_set (as, rdpe_zero);
+
+      for (l = first; l < last; l++)
+        {
+          int i = re->active_terms[l];
+          int k = re->orders[i];
+
+          if (i == skip)
+            continue;
+
+          mpc_sub (t, x, re->mfpc[MPS_RATIONAL_EQUATION_D (re, i)]);
+          mpc_inv_eq (t);
+          mpc_pow_si (u, t, k);
+          mpc_mul_eq (u, re->mfpc[MPS_RATIONAL_EQUATION_C (re, i)]);
+
+          mpc_add_eq (s0, u);
+          mpc_mul (tmp, u, t);
+          mpc_mul_eq_ui (tmp, (unsigned long int) k);
+          mpc_add_eq (s1, tmp);
+          mpc_mul_ui (tmp, t, (unsigned long int) k);
+          mpc_add_eq (sk, tmp);
+
+          mpc_rmod (las, u);
+          rdpe_mul_eq_d (las, 2.0 * k + 4.0);
+          rdpe_add_eq (as, las);
+        }
+    }
+  else
+    {
+      mid = (first + last) / 2;
+
+      mps_rational_equation_msum (re, x, first, mid, skip, s0, s1, sk, as);
+      mps_rational_equation_msum (re, x, mid, last, skip, t, u, tmp, las);
+
+      mpc_add_eq (s0, t);
+      mpc_add_eq (s1, u);
+      mpc_add_eq (sk, tmp);
+      rdpe_add_eq (as, las);
+      mpc_rmod (las, s0);
+      rdpe_mul_eq_d (las, 2.0);
+      rdpe_add_eq (as, las);
+    }
+
+  mpc_clear (t);
+  mpc_clear (u);
+  mpc_clear (tmp);
+}
+
+/**
+ * @brief Multiprecision version of mps_rational_equation_fscaled(). The
+ * computation is carried out with the precision of fh.
+ */
+static int
+mps_rational_equation_mscaled (mps_rational_equation * re, mpc_t x, mpc_t fh, mpc_t gh,
+                               rdpe_t error)
+{
+  long int wp = mpc_get_prec (fh);
+  int j, k = 0, q = re->f_degree;
+  int closest;
+  rdpe_t ax, as, fa, ac, rtmp;
+  cdpe_t cx;
+  mpc_t s0, s1, sk, fv, fd, h, h1, tmp;
+
+  /* The choice of the pole only affects the accuracy, so it can be made
+   * in DPE. */
+  mpc_get_cdpe (cx, x);
+  closest = mps_rational_equation_dclosest_pole (re, cx);
+
+  mpc_init2 (s0, wp);
+  mpc_init2 (s1, wp);
+  mpc_init2 (sk, wp);
+  mpc_init2 (fv, wp);
+  mpc_init2 (fd, wp);
+  mpc_init2 (h, wp);
+  mpc_init2 (h1, wp);
+  mpc_init2 (tmp, wp);
+
+  mps_rational_equation_msum (re, x, 0, re->n_active, closest, s0, s1, sk, as);
+
+  mpc_rmod (ax, x);
+  mpc_set_ui (fv, 0U, 0U);
+  mpc_set_ui (fd, 0U, 0U);
+  rdpe_set (fa, rdpe_zero);
+  for (j = q; j >= 0; j--)
+    {
+      mpc_mul_eq (fd, x);
+      mpc_add_eq (fd, fv);
+      mpc_mul_eq (fv, x);
+      mpc_add_eq (fv, re->mfpc[MPS_RATIONAL_EQUATION_F (re, j)]);
+      rdpe_mul_eq (fa, ax);
+      rdpe_add_eq (fa, re->dap[MPS_RATIONAL_EQUATION_F (re, j)]);
+    }
+
+  mpc_sub_eq (s0, fv);
+
+  if (closest >= 0)
+    {
+      k = re->orders[closest];
+      mpc_sub (tmp, x, re->mfpc[MPS_RATIONAL_EQUATION_D (re, closest)]);
+      mpc_pow_si (h1, tmp, k - 1);
+      mpc_mul (h, h1, tmp);
+      mpc_mul_eq_ui (h1, (unsigned long int) k);
+      rdpe_set (ac, re->dap[MPS_RATIONAL_EQUATION_C (re, closest)]);
+
+      /* fh = (S0' - f) h + c */
+      mpc_mul (fh, s0, h);
+      mpc_add_eq (fh, re->mfpc[MPS_RATIONAL_EQUATION_C (re, closest)]);
+
+      /* gh = (S0' - f) (Sk' h + h1) + c Sk' - (S1' + f') h */
+      mpc_mul (tmp, sk, h);
+      mpc_add_eq (tmp, h1);
+      mpc_mul (gh, s0, tmp);
+      mpc_mul (tmp, re->mfpc[MPS_RATIONAL_EQUATION_C (re, closest)], sk);
+      mpc_add_eq (gh, tmp);
+    }
+  else
+    {
+      mpc_set_ui (h, 1U, 0U);
+      rdpe_set (ac, rdpe_zero);
+
+      mpc_set (fh, s0);
+      mpc_mul (gh, s0, sk);
+    }
+
+  mpc_add_eq (s1, fd);
+  mpc_mul_eq (s1, h);
+  mpc_sub_eq (gh, s1);
+
+  rdpe_mul_eq_d (fa, 4.0 * (q + 1));
+  rdpe_add (error, as, fa);
+  rdpe_mul_eq_d (error, k + 2.0);
+  mpc_rmod (rtmp, h);
+  rdpe_mul_eq (error, rtmp);
+  rdpe_mul_d (rtmp, ac, 2.0 * k + 4.0);
+  rdpe_add_eq (error, rtmp);
+  rdpe_set_2dl (rtmp, 1.0, -wp);
+  rdpe_mul_eq (error, rtmp);
+
+  mpc_clear (s0);
+  mpc_clear (s1);
+  mpc_clear (sk);
+  mpc_clear (fv);
+  mpc_clear (fd);
+  mpc_clear (h);
+  mpc_clear (h1);
+  mpc_clear (tmp);
+
+  return closest;
+}
+
+mps_boolean
+mps_rational_equation_feval (mps_context * ctx, mps_polynomial * poly, cplx_t x, cplx_t value, double * error)
+{
+  mps_rational_equation * re = MPS_RATIONAL_EQUATION (poly);
+  cplx_t gh, d, tmp;
+  double err;
+  int l, closest = mps_rational_equation_fscaled (re, x, value, gh, &err);
+
+  /* Multiply by the part of D(x) that has not been divided out. */
+  cplx_set (d, cplx_one);
+  for (l = 0; l < re->n_active; l++)
+    {
+      int i = re->active_terms[l];
+
+      if (i == closest)
+        continue;
+
+      cplx_sub (tmp, x, re->fpc[MPS_RATIONAL_EQUATION_D (re, i)]);
+      cplx_pow_si (tmp, tmp, re->orders[i]);
+      cplx_mul_eq (d, tmp);
+    }
+
+  err = (err + 2.0 * poly->degree * DBL_EPSILON * cplx_mod (value)) * cplx_mod (d);
+  cplx_mul_eq (value, d);
+
+  if (error)
+    *error = err;
+
+  return true;
+}
+
+mps_boolean
+mps_rational_equation_deval (mps_context * ctx, mps_polynomial * poly, cdpe_t x, cdpe_t value, rdpe_t error)
+{
+  mps_rational_equation * re = MPS_RATIONAL_EQUATION (poly);
+  cdpe_t gh, d, tmp;
+  rdpe_t rtmp;
+  int l, closest = mps_rational_equation_dscaled (re, x, value, gh, error);
+
+  cdpe_set (d, cdpe_one);
+  for (l = 0; l < re->n_active; l++)
+    {
+      int i = re->active_terms[l];
+
+      if (i == closest)
+        continue;
+
+      cdpe_sub (tmp, x, re->dpc[MPS_RATIONAL_EQUATION_D (re, i)]);
+      cdpe_pow_si (tmp, tmp, re->orders[i]);
+      cdpe_mul_eq (d, tmp);
+    }
+
+  cdpe_mod (rtmp, value);
+  rdpe_mul_eq_d (rtmp, 2.0 * poly->degree * DBL_EPSILON);
+  rdpe_add_eq (error, rtmp);
+  cdpe_mod (rtmp, d);
+  rdpe_mul_eq (error, rtmp);
+  cdpe_mul_eq (value, d);
+
+  return true;
+}
+
+mps_boolean
+mps_rational_equation_meval (mps_context * ctx, mps_polynomial * poly, mpc_t x, mpc_t value, rdpe_t error)
+{
+  mps_rational_equation * re = MPS_RATIONAL_EQUATION (poly);
+  long int wp = mpc_get_prec (x);
+  mpc_t v, gh, d, tmp;
+  rdpe_t rtmp;
+  int l, closest;
+
+  /* Make sure that we have sufficient precision to perform the computation */
+  mps_polynomial_raise_data (ctx, poly, wp);
+
+  mpc_init2 (v, wp);
+  mpc_init2 (gh, wp);
+  mpc_init2 (d, wp);
+  mpc_init2 (tmp, wp);
+
+  closest = mps_rational_equation_mscaled (re, x, v, gh, error);
+
+  mpc_set_ui (d, 1U, 0U);
+  for (l = 0; l < re->n_active; l++)
+    {
+      int i = re->active_terms[l];
+
+      if (i == closest)
+        continue;
+
+      mpc_sub (tmp, x, re->mfpc[MPS_RATIONAL_EQUATION_D (re, i)]);
+      mpc_pow_si (tmp, tmp, re->orders[i]);
+      mpc_mul_eq (d, tmp);
+    }
+
+  mpc_rmod (rtmp, v);
+  rdpe_mul_eq_d (rtmp, 2.0 * poly->degree);
+  rdpe_div_eq_2exp (rtmp, (unsigned long int) wp);
+  rdpe_add_eq (error, rtmp);
+  mpc_rmod (rtmp, d);
+  rdpe_mul_eq (error, rtmp);
+
+  mpc_mul (value, v, d);
+
+  mpc_clear (v);
+  mpc_clear (gh);
+  mpc_clear (d);
+  mpc_clear (tmp);
+
+  return true;
+}
+
+void
+mps_rational_equation_fnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, cplx_t corr)
+{
+  cplx_t fh, gh;
+  double apeps, ap, agp;
+
+  mps_rational_equation_fscaled (MPS_RATIONAL_EQUATION (poly), root->fvalue, fh, gh, &apeps);
+  cplx_div (corr, fh, gh);
+
+  ap = cplx_mod (fh);
+  agp = cplx_mod (gh);
+
+  apeps += DBL_EPSILON * cplx_mod (root->fvalue) * agp;
+
+  root->again = ap > apeps;
+  root->frad = poly->degree * (ap + apeps) / agp;
+}
+
+void
+mps_rational_equation_dnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, cdpe_t corr)
+{
+  cdpe_t fh, gh;
+  rdpe_t apeps, ap, agp, ax;
+
+  mps_rational_equation_dscaled (MPS_RATIONAL_EQUATION (poly), root->dvalue, fh, gh, apeps);
+  cdpe_div (corr, fh, gh);
+
+  cdpe_mod (ap, fh);
+  cdpe_mod (agp, gh);
+
+  cdpe_mod (ax, root->dvalue);
+  rdpe_mul_eq (ax, agp);
+  rdpe_mul_eq_d (ax, DBL_EPSILON);
+  rdpe_add_eq (apeps, ax);
+
+  root->again = rdpe_gt (ap, apeps);
+
+  rdpe_add (root->drad, ap, apeps);
+  rdpe_mul_eq_d (root->drad, (double) poly->degree);
+  rdpe_div_eq (root->drad, agp);
+  if (rdpe_eq (root->drad, rdpe_zero))
+    {
+      cdpe_mod (ax, root->dvalue);
+      rdpe_mul_d (root->drad, ax, 4.0 * poly->degree * DBL_EPSILON);
+    }
+}
+
+void
+mps_rational_equation_mnewton (mps_context * ctx, mps_polynomial * poly, mps_approximation * root, mpc_t corr,
+                               long int wp)
+{
+  mpc_t fh, gh;
+  rdpe_t apeps, ap, agp, ax;
+
+  mps_polynomial_raise_data (ctx, poly, wp);
+
+  mpc_init2 (fh, wp);
+  mpc_init2 (gh, wp);
+
+  mps_rational_equation_mscaled (MPS_RATIONAL_EQUATION (poly), root->mvalue, fh, gh, apeps);
+  mpc_div (corr, fh, gh);
+
+  mpc_rmod (ap, fh);
+  mpc_rmod (agp, gh);
+
+  mpc_rmod (ax, root->mvalue);
+  rdpe_mul_eq (ax, agp);
+  rdpe_div_eq_2exp (ax, (unsigned long int) wp);
+  rdpe_add_eq (apeps, ax);
+
+  root->again = rdpe_gt (ap, apeps);
+
+  rdpe_add (root->drad, ap, apeps);
+  rdpe_mul_eq_d (root->drad, (double) poly->degree);
+  rdpe_div_eq (root->drad, agp);
+  if (rdpe_eq (root->drad, rdpe_zero))
+    {
+      mpc_rmod (ax, root->mvalue);
+      rdpe_set_2dl (apeps, 4.0 * poly->degree, -wp);
+      rdpe_mul (root->drad, ax, apeps);
+    }
+
+  mpc_clear (fh);
+  mpc_clear (gh);
+}
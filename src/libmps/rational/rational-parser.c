@@ -0,0 +1,194 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+
+/**
+ * @brief Read a number, with its imaginary part if the structure is
+ * complex, and store it in the rational values real_part and imag_part.
+ *
+ * Floating point values are read with the given precision, and converted
+ * exactly.
+ *
+ * @return false if the parsing failed, in which case an error has been
+ * raised on ctx.
+ */
+static mps_boolean
+mps_rational_equation_read_number (mps_context * ctx, mps_input_buffer * buffer,
+                                   mps_structure structure, long int precision,
+                                   mpq_t real_part, mpq_t imag_part, const char * what, int i)
+{
+  mpq_ptr parts[2];
+  int p, n_parts = MPS_STRUCTURE_IS_COMPLEX (structure) ? 2 : 1;
+  char * token;
+  mpf_t ftmp;
+
+  parts[0] = real_part;
+  parts[1] = imag_part;
+
+  mpq_set_ui (imag_part, 0U, 1U);
+  mpf_init2 (ftmp, precision > 0 ? precision : ctx->mpwp);
+
+  for (p = 0; p < n_parts; p++)
+    {
+      mps_boolean failed;
+
+      token = mps_input_buffer_next_token (buffer);
+
+      if (MPS_STRUCTURE_IS_FP (structure))
+        {
+          failed = !token || mpf_set_str (ftmp, token, 10) != 0;
+          if (!failed)
+            mpq_set_f (parts[p], ftmp);
+        }
+      else
+        {
+          failed = !token || mpq_set_str (parts[p], token, 10) != 0;
+          if (!failed)
+            mpq_canonicalize (parts[p]);
+        }
+
+      if (failed)
+        {
+          mps_raise_parsing_error (ctx, buffer, token, "Error while reading the %s part of %s %d",
+                                   p == 0 ? "real" : "imaginary", what, i);
+          free (token);
+          mpf_clear (ftmp);
+          return false;
+        }
+
+      free (token);
+    }
+
+  mpf_clear (ftmp);
+
+  return true;
+}
+
+/**
+ * @brief Read an integer that is at least minimum.
+ */
+static mps_boolean
+mps_rational_equation_read_int (mps_context * ctx, mps_input_buffer * buffer, int * value,
+                                int minimum, const char * message)
+{
+  char * token = mps_input_buffer_next_token (buffer);
+
+  if (!token || sscanf (token, "%d", value) != 1 || *value < minimum)
+    {
+      mps_raise_parsing_error (ctx, buffer, token, message);
+      free (token);
+      return false;
+    }
+
+  free (token);
+  return true;
+}
+
+/**
+ * @brief Parse the stream that has been loaded into buffer and that
+ * describes a mps_rational_equation.
+ *
+ * The terms are given one per line as \f$c_i\f$, \f$d_i\f$ and \f$k_i\f$,
+ * where the complex numbers are written as their real and imaginary parts
+ * if the structure is complex. They are followed by the degree \f$q\f$ of
+ * the right hand side, that can be -1 if it is zero, and by the
+ * coefficients \f$f_0, \dots, f_q\f$. For example
+ * <pre>
+ * RationalFunction;
+ * Real;
+ * Integer;
+ * Degree=2;
+ *
+ * 1 0 2
+ * 1 1 1
+ *
+ * 1
+ * 0 1
+ * </pre>
+ * describes the equation \f$x^{-2} + (x - 1)^{-1} = x\f$.
+ *
+ * @param ctx The current mps_context
+ * @param buffer The buffer that needs to be parsed
+ * @param structure The structure of the coefficients
+ * @param precision The input precision of the coefficients, if specified,
+ * 0 otherwise
+ *
+ * @return A newly allocated mps_rational_equation, or NULL if the parsing
+ * fails.
+ */
+mps_rational_equation *
+mps_rational_equation_read_from_stream (mps_context * ctx, mps_input_buffer * buffer,
+                                        mps_structure structure, long int precision)
+{
+  int i, q, m = ctx->n;
+  int * orders = mps_newv (int, m);
+  mpq_t * values = mps_newv (mpq_t, 4 * m);
+  mps_rational_equation * re = NULL;
+
+  mpq_vinit (values, 4 * m);
+
+  for (i = 0; i < m; i++)
+    {
+      if (!mps_rational_equation_read_number (ctx, buffer, structure, precision,
+                                              values[4 * i], values[4 * i + 1], "coefficient", i) ||
+          !mps_rational_equation_read_number (ctx, buffer, structure, precision,
+                                              values[4 * i + 2], values[4 * i + 3], "pole", i) ||
+          !mps_rational_equation_read_int (ctx, buffer, orders + i, 1,
+                                           "The order of the poles must be a positive integer"))
+        goto cleanup;
+    }
+
+  if (!mps_rational_equation_read_int (ctx, buffer, &q, -1,
+                                       "Cannot parse the degree of the right hand side"))
+    goto cleanup;
+
+  re = mps_rational_equation_new (ctx, m, MAX (q, 0));
+
+  for (i = 0; i < m; i++)
+    {
+      re->orders[i] = orders[i];
+      mpq_set (re->rational_real_coeffs[MPS_RATIONAL_EQUATION_C (re, i)], values[4 * i]);
+      mpq_set (re->rational_imag_coeffs[MPS_RATIONAL_EQUATION_C (re, i)], values[4 * i + 1]);
+      mpq_set (re->rational_real_coeffs[MPS_RATIONAL_EQUATION_D (re, i)], values[4 * i + 2]);
+      mpq_set (re->rational_imag_coeffs[MPS_RATIONAL_EQUATION_D (re, i)], values[4 * i + 3]);
+    }
+
+  for (i = 0; i <= q; i++)
+    {
+      int k = MPS_RATIONAL_EQUATION_F (re, i);
+
+      if (!mps_rational_equation_read_number (ctx, buffer, structure, precision,
+                                              re->rational_real_coeffs[k],
+                                              re->rational_imag_coeffs[k],
+                                              "right hand side coefficient", i))
+        {
+          mps_polynomial_free (ctx, MPS_POLYNOMIAL (re));
+          re = NULL;
+          goto cleanup;
+        }
+    }
+
+  mps_rational_equation_update_coefficients (ctx, re);
+
+  if (MPS_POLYNOMIAL (re)->degree <= 0)
+    {
+      mps_error (ctx, "The rational equation does not have any solution");
+      mps_polynomial_free (ctx, MPS_POLYNOMIAL (re));
+      re = NULL;
+    }
+
+cleanup:
+  mpq_vclear (values, 4 * m);
+  free (values);
+  free (orders);
+
+  return re;
+}
@@ -0,0 +1,162 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <float.h>
+#include <math.h>
+#include <mps/mps.h>
+
+#define pi2 6.283184
+
+/**
+ * @brief Radius of the circle around the pole of the i-th term where its
+ * starting points are placed.
+ *
+ * Close to \f$d_i\f$ the equation behaves like
+ * \f$c_i (x - d_i)^{-k_i} = M_i\f$, where \f$M_i\f$ estimates the other
+ * terms and the right hand side in \f$d_i\f$, so \f$k_i\f$ roots are
+ * expected at distance \f$(|c_i| / M_i)^{1/k_i}\f$. The radius is kept
+ * smaller than half the distance from the other poles, so that no starting
+ * point coincides with a pole.
+ */
+static double
+mps_rational_equation_pole_radius (mps_rational_equation * re, int i)
+{
+  cplx_t d, diff, fv;
+  double m = 0.0, sep = DBL_MAX, r = 1.0, dist;
+  int j, l;
+
+  cplx_set (d, re->fpc[MPS_RATIONAL_EQUATION_D (re, i)]);
+
+  cplx_set (fv, cplx_zero);
+  for (j = re->f_degree; j >= 0; j--)
+    {
+      cplx_mul_eq (fv, d);
+      cplx_add_eq (fv, re->fpc[MPS_RATIONAL_EQUATION_F (re, j)]);
+    }
+  m = cplx_mod (fv);
+
+  for (l = 0; l < re->n_active; l++)
+    {
+      j = re->active_terms[l];
+
+      if (j == i)
+        continue;
+
+      cplx_sub (diff, d, re->fpc[MPS_RATIONAL_EQUATION_D (re, j)]);
+      dist = cplx_mod (diff);
+      sep = MIN (sep, dist);
+
+      if (dist > 0.0)
+        m += re->fap[MPS_RATIONAL_EQUATION_C (re, j)] / pow (dist, re->orders[j]);
+    }
+
+  if (m > 0.0)
+    r = pow (re->fap[MPS_RATIONAL_EQUATION_C (re, i)] / m, 1.0 / re->orders[i]);
+
+  r = MIN (r, 0.5 * sep);
+  if (!(r > 0.0))
+    r = DBL_EPSILON * (1.0 + cplx_mod (d));
+
+  return r;
+}
+
+/**
+ * @brief Select the starting points for a rational equation.
+ *
+ * Each pole \f$d_i\f$ of order \f$k_i\f$ gets \f$k_i\f$ starting points on
+ * a small circle around it, until all the degree is used, and the remaining
+ * points, that approximate the roots of \f$f\f$ far from the poles, are
+ * placed on a circle enclosing all the others.
+ */
+void
+mps_rational_equation_fstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations)
+{
+  mps_rational_equation * re = MPS_RATIONAL_EQUATION (poly);
+  int n = poly->degree;
+  int i, j, l, t, m, k = 0;
+  double sigma, radius = 0.0, bound = 0.0;
+
+  if (re->n_active == 0)
+    {
+      mps_general_fstart (ctx, poly, approximations);
+      return;
+    }
+
+  sigma = (ctx->random_seed) ? drand () : 0.66 * PI / n;
+
+  for (l = 0; l < re->n_active && k < n; l++)
+    {
+      double r, a;
+      cplx_t d;
+
+      i = re->active_terms[l];
+      r = mps_rational_equation_pole_radius (re, i);
+      m = MIN (re->orders[i], n - k);
+
+      cplx_set (d, re->fpc[MPS_RATIONAL_EQUATION_D (re, i)]);
+      radius = MAX (radius, cplx_mod (d) + r);
+
+      /* Rotate the circles of different poles, so that their points are
+       * not aligned. */
+      a = sigma * (l + 1);
+      for (t = 0; t < m; t++, k++)
+        {
+          cplx_set_d (approximations[k]->fvalue,
+                      cplx_Re (d) + r * cos (pi2 * t / re->orders[i] + a),
+                      cplx_Im (d) + r * sin (pi2 * t / re->orders[i] + a));
+        }
+    }
+
+  if (k == n)
+    return;
+
+  /* The roots far from the poles are close to the ones of f, which are
+   * bounded as in the Fujiwara bound. */
+  for (j = 0; j < re->f_degree; j++)
+    bound = MAX (bound, pow (re->fap[MPS_RATIONAL_EQUATION_F (re, j)] /
+                             re->fap[MPS_RATIONAL_EQUATION_F (re, re->f_degree)],
+                             1.0 / (re->f_degree - j)));
+
+  radius = MAX (2.0 * bound, 2.0 * radius);
+  if (radius == 0.0)
+    radius = 1.0;
+
+  for (t = 0, m = n - k; k < n; t++, k++)
+    {
+      cplx_set_d (approximations[k]->fvalue,
+                  radius * cos (pi2 * t / m + sigma),
+                  radius * sin (pi2 * t / m + sigma));
+    }
+}
+
+/**
+ * @brief DPE version of mps_rational_equation_fstart(). The starting points
+ * are computed in floating point and then converted.
+ */
+void
+mps_rational_equation_dstart (mps_context * ctx, mps_polynomial * poly, mps_approximation ** approximations)
+{
+  int i;
+
+  mps_rational_equation_fstart (ctx, poly, approximations);
+
+  for (i = 0; i < poly->degree; i++)
+    {
+      if (!isfinite (cplx_Re (approximations[i]->fvalue)) ||
+          !isfinite (cplx_Im (approximations[i]->fvalue)))
+        {
+          mps_general_dstart (ctx, poly, approximations);
+          return;
+        }
+    }
+
+  for (i = 0; i < poly->degree; i++)
+    cdpe_set_x (approximations[i]->dvalue, approximations[i]->fvalue);
+}
@@ -199,6 +199,23 @@ mps_secular_ga_mpsolve (mps_context * s)
   s->count[1] = 0;
   s->count[2] = 0;
 
+  /* If a checkpoint has been given continue the computation from the
+   * state saved there, skipping the initial phases. */
+  if (s->resume_file)
+    {
+      if (!MPS_IS_SECULAR_EQUATION (s->active_poly))
+        {
+          char which_case;
+          mps_check_data (s, &which_case);
+          EXIT_ON_ERRORS (s);
+        }
+
+      if (!mps_checkpoint_load (s, s->resume_file, &packet, &just_regenerated))
+        goto cleanup;
+
+      goto iterate;
+    }
+
   /* If the input was polynomial we need to determine the secular
    * coefficients */
   if (!MPS_IS_SECULAR_EQUATION (s->active_poly))
@@ -211,29 +228,29 @@ mps_secular_ga_mpsolve (mps_context * s)
           cdpe_set (sec->bdpc[i], cdpe_zero);
         }
 
-      /* Check data first */
-      if (s->input_config->starting_phase == no_phase)
-        {
-          char which_case;
-          mps_check_data (s, &which_case);
+      /* Check data first. This is needed even if the starting phase has
+       * been selected, since it also deflates vanishing leading coefficients. */
+      {
+        char which_case;
+        mps_check_data (s, &which_case);
 
-          if (mps_context_has_errors (s))
-            {
+        if (mps_context_has_errors (s))
+          {
 #ifndef DISABLE_DEBUG
-              mps_stop_timer (total_clock);
+            mps_stop_timer (total_clock);
 #endif
-              return;
-            }
+            return;
+          }
 
-          MPS_DEBUG_WITH_INFO (s, "Check data suggests starting phase should be %s", (which_case == 'f') ? "floating point" : "DPE phase");
+        MPS_DEBUG_WITH_INFO (s, "Check data suggests starting phase should be %s", (which_case == 'f') ? "floating point" : "DPE phase");
 
-          if (which_case == 'f')
-            s->lastphase = float_phase;
-          else
-            s->lastphase = dpe_phase;
-        }
-      else
-        s->lastphase = s->input_config->starting_phase;
+        if (s->input_config->starting_phase != no_phase)
+          s->lastphase = s->input_config->starting_phase;
+        else if (which_case == 'f')
+          s->lastphase = float_phase;
+        else
+          s->lastphase = dpe_phase;
+      }
 
     preliminary_aberth_packet:
 
@@ -291,6 +308,7 @@ mps_secular_ga_mpsolve (mps_context * s)
 	goto cleanup;
 
       mps_cluster_analysis (s, p);
+      mps_events_packet (s);
 
       if (mps_secular_ga_check_stop (s))
         goto cleanup;
@@ -413,6 +431,7 @@ mps_secular_ga_mpsolve (mps_context * s)
     }
 
   /* Cycle until approximated */
+iterate:
   do
     {
       skip_check_stop = false;
@@ -424,7 +443,7 @@ mps_secular_ga_mpsolve (mps_context * s)
         case float_phase:
           MPS_DEBUG_WITH_INFO (s, "Starting floating point iterations");
 
-          if (s->jacobi_iterations)
+          if (s->jacobi_iterations || s->block_iterations)
             roots_computed = mps_faberth_packet (s, MPS_POLYNOMIAL (sec), just_regenerated);
           else
             roots_computed = mps_secular_ga_fiterate (s, s->max_it, just_regenerated);
@@ -437,7 +456,7 @@ mps_secular_ga_mpsolve (mps_context * s)
         case dpe_phase:
           MPS_DEBUG_WITH_INFO (s, "Starting DPE iterations");
 
-          if (s->jacobi_iterations)
+          if (s->jacobi_iterations || s->block_iterations)
             roots_computed = mps_daberth_packet (s, MPS_POLYNOMIAL (sec), just_regenerated);
           else
             roots_computed = mps_secular_ga_diterate (s, s->max_it, just_regenerated);
@@ -447,7 +466,7 @@ mps_secular_ga_mpsolve (mps_context * s)
         case mp_phase:
           MPS_DEBUG_WITH_INFO (s, "Starting MP iterations");
 
-          if (s->jacobi_iterations)
+          if (s->jacobi_iterations || s->block_iterations)
             roots_computed = mps_maberth_packet (s, MPS_POLYNOMIAL (sec), just_regenerated);
           else
             roots_computed = mps_secular_ga_miterate (s, s->max_it, just_regenerated);
@@ -461,6 +480,9 @@ mps_secular_ga_mpsolve (mps_context * s)
       /* Increase the packet counter */
       packet++;
 
+      /* Report the roots isolated or approximated during the packet. */
+      mps_events_packet (s);
+
       /* Check if we need to exit */
       if (s->exit_required)
         {
@@ -598,6 +620,11 @@ mps_secular_ga_mpsolve (mps_context * s)
             return;
           }
       }
+
+      /* Save the state reached at the end of the packet, so that the
+       * computation can be resumed from here if interrupted. */
+      if (s->checkpoint_file)
+        mps_checkpoint_save (s, s->checkpoint_file, packet, just_regenerated);
     } while (skip_check_stop || !mps_secular_ga_check_stop (s));
 
 cleanup:
@@ -42,7 +42,7 @@ __mps_secular_ga_fiterate_worker (void* data_ptr)
           goto cleanup;
         }
 
-      if (s->root[i]->again && !s->root[i]->approximated)
+      if (s->root[i]->again && !s->root[i]->approximated && MPS_DISTRIBUTED_OWNS (s, i))
         {
           /* Increment the number of performed iterations */
 #if defined(__GCC__)
@@ -64,7 +64,7 @@ __mps_secular_ga_fiterate_worker (void* data_ptr)
             }
 
           /* Apply Aberth correction */
-          mps_faberth_wl (s, i, abcorr, data->aberth_mutex);
+          mps_faberth_frozen_wl (s, data->frozen, i, abcorr, data->aberth_mutex);
 
           if (isnan (cplx_Re (abcorr)) || isnan (cplx_Im (abcorr)))
             {
@@ -146,21 +146,10 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
 
   s->operation = MPS_OPERATION_ABERTH_FP_ITERATIONS;
 
-  mps_thread_worker_data *data;
-  pthread_mutex_t *aberth_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-  pthread_mutex_t *roots_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-
-  pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-  for (i = 0; i < s->n; i++)
-    {
-      pthread_mutex_init (roots_mutex + i, NULL);
-      pthread_mutex_init (aberth_mutex + i, NULL);
-    }
-
-  data = mps_newv (mps_thread_worker_data, s->n_threads);
+  /* Mutexes, worker data and job queue are taken from the workspace
+   * of the context, so no allocation is needed for the packet. */
+  mps_thread_workspace *w = mps_thread_workspace_get (s);
+  mps_thread_worker_data *data = w->data;
 
   MPS_DEBUG_THIS_CALL (s);
 
@@ -192,7 +181,18 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
 
   it_threshold = s->n - computed_roots;
 
-  mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
+  /* The roots owned by other processes are iterated there */
+  computed_roots += mps_distributed_count_foreign_roots (s);
+
+  /* The approximations that have stopped do not move during the packet,
+   * so only the active ones are scheduled and the contribution of the
+   * others to the Aberth corrections is cached. */
+  mps_frozen_roots_update (s, w->frozen);
+  if (w->frozen->n_active > 0)
+    {
+      w->queue.schedule = w->frozen->schedule;
+      w->queue.n_scheduled = w->frozen->n_active;
+    }
 
   for (i = 0; i < s->n_threads; i++)
     {
@@ -201,10 +201,11 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
       data[i].s = s;
       data[i].thread = i;
       data[i].n_threads = s->n_threads;
-      data[i].aberth_mutex = aberth_mutex;
-      data[i].roots_mutex = roots_mutex;
-      data[i].queue = queue;
-      data[i].gs_mutex = &gs_mutex;
+      data[i].aberth_mutex = w->aberth_mutex;
+      data[i].roots_mutex = w->roots_mutex;
+      data[i].queue = &w->queue;
+      data[i].frozen = w->frozen;
+      data[i].gs_mutex = &w->gs_mutex;
       data[i].excep = &excep;
 
       mps_thread_pool_assign (s, s->pool,
@@ -213,6 +214,9 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
 
   mps_thread_pool_wait (s, s->pool);
 
+  /* Collect the approximations iterated by the other processes */
+  mps_distributed_gather_packet (s, &nit, &excep, &computed_roots);
+
   /* Check if the roots are improvable in floating point */
   MPS_DEBUG_WITH_INFO (s, "Performed %d iterations with floating point arithmetic",
                        nit);
@@ -277,11 +281,6 @@ mps_secular_ga_fiterate (mps_context * s, int maxit, mps_boolean just_regenerate
   s->fp_iteration_time += mps_stop_timer (my_clock);
 #endif
 
-  mps_thread_job_queue_free (queue);
-  free (data);
-  free (roots_mutex);
-  free (aberth_mutex);
-
   /* Return the number of approximated roots */
   return computed_roots;
 }
@@ -292,58 +291,90 @@ __mps_secular_ga_diterate_worker (void* data_ptr)
 {
   mps_thread_worker_data *data = (mps_thread_worker_data*)data_ptr;
   mps_context *s = data->s;
-  int i;
+  mps_secular_equation *sec = s->secular_equation;
+  int i, k, m;
   cdpe_t corr, abcorr, droot;
   rdpe_t modcorr;
   mps_thread_job job;
+  mps_boolean excep = false;
 
-  while (true && !s->exit_required)
-    {
-      job = mps_thread_job_queue_next (s, data->queue);
-      i = job.i;
+  int batch[MPS_SECULAR_BATCH_TARGETS];
+  cdpe_t x[MPS_SECULAR_BATCH_TARGETS];
+  mps_secular_dsum sums[MPS_SECULAR_BATCH_TARGETS];
 
-      if (job.iter == MPS_THREAD_JOB_EXCEP)
+  while (!excep && !s->exit_required)
+    {
+      /* Collect a batch of roots. Their Newton corrections only depend on
+       * their own value, so the sums needed to compute them can be evaluated
+       * together before applying the Aberth corrections one at a time. */
+      for (m = 0; m < MPS_SECULAR_BATCH_TARGETS; )
         {
-          return NULL;
+          job = mps_thread_job_queue_next (s, data->queue);
+          i = job.i;
+
+          if (job.iter == MPS_THREAD_JOB_EXCEP)
+            {
+              excep = true;
+              break;
+            }
+
+          pthread_mutex_lock (&data->roots_mutex[i]);
+          if (s->root[i]->again && !s->root[i]->approximated && MPS_DISTRIBUTED_OWNS (s, i))
+            {
+              cdpe_set (x[m], s->root[i]->dvalue);
+              batch[m++] = i;
+            }
+          pthread_mutex_unlock (&data->roots_mutex[i]);
         }
 
-      pthread_mutex_lock (&data->roots_mutex[i]);
+      mps_secular_dbatch_sum (s, sec, m, x, sums);
 
-      if (s->root[i]->again && !s->root[i]->approximated)
+      for (k = 0; k < m; k++)
         {
-          /* Lock this roots to make sure that we are the only one working on it */
-          cdpe_set (droot, s->root[i]->dvalue);
+          i = batch[k];
 
-          (*data->it)++;
+          pthread_mutex_lock (&data->roots_mutex[i]);
 
-          mps_secular_dnewton (s, MPS_POLYNOMIAL (s->secular_equation), s->root[i], corr);
+          if (s->root[i]->again && !s->root[i]->approximated)
+            {
+              cdpe_set (droot, s->root[i]->dvalue);
 
-          /* Apply Aberth correction */
-          mps_daberth_wl (s, i, abcorr, data->aberth_mutex);
-          cdpe_mul_eq (abcorr, corr);
-          cdpe_sub (abcorr, cdpe_one, abcorr);
-          cdpe_div (abcorr, corr, abcorr);
+              /* Another thread may have iterated on the root in the
+               * meantime, in which case the sums must be computed again. */
+              if (!cdpe_eq (droot, x[k]))
+                mps_secular_dbatch_sum (s, sec, 1, &droot, sums + k);
 
-          cdpe_sub_eq (droot, abcorr);
+              (*data->it)++;
 
-          /* Correct the radius */
-          if (s->root[i]->again)
-            {
-              cdpe_mod (modcorr, abcorr);
-              rdpe_add_eq (s->root[i]->drad, modcorr);
-            }
+              mps_secular_dnewton_from_sum (s, MPS_POLYNOMIAL (sec), s->root[i], sums + k, corr);
 
-          if (!s->root[i]->again || s->root[i]->approximated)
-            {
-              if (s->debug_level & MPS_DEBUG_APPROXIMATIONS)
-                MPS_DEBUG (s, "Root %d again was set to false on iteration %d by thread %d", i, *data->it, data->thread);
-              (*data->nzeros)++;
+              /* Apply Aberth correction */
+              mps_daberth_frozen_wl (s, data->frozen, i, abcorr, data->aberth_mutex);
+              cdpe_mul_eq (abcorr, corr);
+              cdpe_sub (abcorr, cdpe_one, abcorr);
+              cdpe_div (abcorr, corr, abcorr);
+
+              cdpe_sub_eq (droot, abcorr);
+
+              /* Correct the radius */
+              if (s->root[i]->again)
+                {
+                  cdpe_mod (modcorr, abcorr);
+                  rdpe_add_eq (s->root[i]->drad, modcorr);
+                }
+
+              if (!s->root[i]->again || s->root[i]->approximated)
+                {
+                  if (s->debug_level & MPS_DEBUG_APPROXIMATIONS)
+                    MPS_DEBUG (s, "Root %d again was set to false on iteration %d by thread %d", i, *data->it, data->thread);
+                  (*data->nzeros)++;
+                }
+              else
+                cdpe_set (s->root[i]->dvalue, droot);
             }
-          else
-            cdpe_set (s->root[i]->dvalue, droot);
-        }
 
-      pthread_mutex_unlock (&data->roots_mutex[i]);
+          pthread_mutex_unlock (&data->roots_mutex[i]);
+        }
     }
 
   return NULL;
@@ -378,19 +409,8 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
   clock_t *my_clock = mps_start_timer ();
 #endif
 
-  mps_thread_worker_data *data;
-  pthread_mutex_t *aberth_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-  pthread_mutex_t *roots_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-
-  for (i = 0; i < s->n; i++)
-    {
-      pthread_mutex_init (roots_mutex + i, NULL);
-      pthread_mutex_init (aberth_mutex + i, NULL);
-    }
-
-  data = mps_newv (mps_thread_worker_data, s->n_threads);
+  mps_thread_workspace *w = mps_thread_workspace_get (s);
+  mps_thread_worker_data *data = w->data;
 
   MPS_DEBUG_THIS_CALL (s);
 
@@ -418,11 +438,22 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
 
   it_threshold = (s->n - computed_roots);
 
+  /* The roots owned by other processes are iterated there */
+  computed_roots += mps_distributed_count_foreign_roots (s);
+
   MPS_DEBUG_WITH_INFO (s, "%d roots %s already approximated at the start of the packet", 
 		       computed_roots,
 		       (computed_roots == 1) ? "is" : "are");
 
-  mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
+  /* The approximations that have stopped do not move during the packet,
+   * so only the active ones are scheduled and the contribution of the
+   * others to the Aberth corrections is cached. */
+  mps_frozen_roots_update (s, w->frozen);
+  if (w->frozen->n_active > 0)
+    {
+      w->queue.schedule = w->frozen->schedule;
+      w->queue.n_scheduled = w->frozen->n_active;
+    }
 
   for (i = 0; i < s->n_threads; i++)
     {
@@ -431,15 +462,19 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
       data[i].s = s;
       data[i].thread = i;
       data[i].n_threads = s->n_threads;
-      data[i].aberth_mutex = aberth_mutex;
-      data[i].roots_mutex = roots_mutex;
-      data[i].queue = queue;
+      data[i].aberth_mutex = w->aberth_mutex;
+      data[i].roots_mutex = w->roots_mutex;
+      data[i].queue = &w->queue;
+      data[i].frozen = w->frozen;
 
       mps_thread_pool_assign (s, s->pool, __mps_secular_ga_diterate_worker, data + i);
     }
 
   mps_thread_pool_wait (s, s->pool);
 
+  /* Collect the approximations iterated by the other processes */
+  mps_distributed_gather_packet (s, &nit, NULL, &computed_roots);
+
   /* Check if the roots are improvable in floating point */
   MPS_DEBUG_WITH_INFO (s, "Performed %d iterations with CDPE arithmetic",
                        nit);
@@ -471,12 +506,6 @@ mps_secular_ga_diterate (mps_context * s, int maxit, mps_boolean just_regenerate
   s->dpe_iteration_time += mps_stop_timer (my_clock);
 #endif
 
-  mps_thread_job_queue_free (queue);
-  free (aberth_mutex);
-  free (roots_mutex);
-
-  free (data);
-
   /* Return the number of approximated roots */
   return computed_roots;
 }
@@ -487,106 +516,148 @@ __mps_secular_ga_miterate_worker (void* data_ptr)
 {
   mps_thread_worker_data *data = (mps_thread_worker_data*)data_ptr;
   mps_context *s = data->s;
-  /* mps_secular_equation *sec = s->secular_equation; */
-  int i;
+  mps_secular_equation *sec = s->secular_equation;
+  int i, k, m;
+  long int wp;
   mpc_t corr, abcorr;
   mpc_t mroot;
   rdpe_t modcorr;
   mps_thread_job job;
+  mps_boolean excep = false;
 
-  mps_cluster * cluster = NULL;
+  int batch[MPS_SECULAR_BATCH_TARGETS];
+  mps_cluster * clusters[MPS_SECULAR_BATCH_TARGETS];
+  mpc_t x[MPS_SECULAR_BATCH_TARGETS];
+  mps_secular_msum sums[MPS_SECULAR_BATCH_TARGETS];
 
   mpc_init2 (corr, s->mpwp);
   mpc_init2 (abcorr, s->mpwp);
   mpc_init2 (mroot, s->mpwp);
 
-  /* Get a copy of the MP coefficients that is local to this thread */
-  while (true && !s->exit_required)
+  mpc_vinit2 (x, MPS_SECULAR_BATCH_TARGETS, s->mpwp);
+  for (k = 0; k < MPS_SECULAR_BATCH_TARGETS; k++)
+    mps_secular_msum_init (sums + k, s->mpwp);
+
+  while (!excep && !s->exit_required)
     {
-      job = mps_thread_job_queue_next (s, data->queue);
-      i = job.i;
+      /* Collect a batch of roots whose Newton sums are evaluated together,
+       * as in the DPE iterations. */
+      for (m = 0; m < MPS_SECULAR_BATCH_TARGETS; )
+        {
+          job = mps_thread_job_queue_next (s, data->queue);
+          i = job.i;
 
-      if (job.iter == MPS_THREAD_JOB_EXCEP || *data->nzeros >= s->n)
-        goto cleanup;
+          if (job.iter == MPS_THREAD_JOB_EXCEP || *data->nzeros >= s->n)
+            {
+              excep = true;
+              break;
+            }
 
-      pthread_mutex_lock (&data->roots_mutex[i]);
+          pthread_mutex_lock (&data->roots_mutex[i]);
+          if (s->root[i]->again && !s->root[i]->approximated && MPS_DISTRIBUTED_OWNS (s, i))
+            {
+              wp = mpc_get_prec (s->root[i]->mvalue);
+              if (mpc_get_prec (x[m]) != (unsigned long int) wp)
+                mpc_set_prec (x[m], wp);
+              mps_secular_msum_set_prec (sums + m, wp);
 
-      if (job.iter == MPS_THREAD_JOB_EXCEP || *data->nzeros >= s->n)
-        {
+              pthread_mutex_lock (&data->aberth_mutex[i]);
+              mpc_set (x[m], s->root[i]->mvalue);
+              pthread_mutex_unlock (&data->aberth_mutex[i]);
+
+              clusters[m] = job.cluster_item->cluster;
+              batch[m++] = i;
+            }
           pthread_mutex_unlock (&data->roots_mutex[i]);
-          goto cleanup;
         }
 
-      /* printf ("Thread %d iterating on root %d\n", data->thread, i); */
-
-      cluster = job.cluster_item->cluster;
+      mps_secular_mbatch_sum (s, sec, m, x, sums);
 
-      if (s->root[i]->again && !s->root[i]->approximated)
+      for (k = 0; k < m; k++)
         {
-          /* Lock this roots to make sure that we are the only one working on it */
-          pthread_mutex_lock (&data->aberth_mutex[i]);
-          mpc_set (mroot, s->root[i]->mvalue);
-          pthread_mutex_unlock (&data->aberth_mutex[i]);
-
-          /* Check if, while we were waiting, excep condition has been reached,
-           * or all the zeros has been approximated.                         */
-          if ((*data->nzeros) >= s->n)
+          i = batch[k];
+
+          pthread_mutex_lock (&data->roots_mutex[i]);
+
+          /* Check if, while we were waiting, all the zeros have been
+           * approximated. */
+          if (*data->nzeros >= s->n)
             {
               pthread_mutex_unlock (&data->roots_mutex[i]);
               goto cleanup;
             }
 
-          /* pthread_mutex_lock (data->gs_mutex); */
-          (*data->it)++;
-          /* pthread_mutex_unlock (data->gs_mutex); */
-
-          mps_secular_mnewton (s, MPS_POLYNOMIAL (s->secular_equation), s->root[i],
-                               corr, mpc_get_prec (s->root[i]->mvalue));
-
-          /* Apply Aberth correction */
-          mps_maberth_s_wl (s, i, cluster, abcorr, data->aberth_mutex);
-          mpc_mul_eq (abcorr, corr);
-          mpc_ui_sub (abcorr, 1U, 0U, abcorr);
-
-          if (!mpc_eq_zero (abcorr))
+          if (s->root[i]->again && !s->root[i]->approximated)
             {
-              mpc_div (abcorr, corr, abcorr);
+              wp = mpc_get_prec (s->root[i]->mvalue);
 
               pthread_mutex_lock (&data->aberth_mutex[i]);
-              mpc_sub_eq (mroot, abcorr);
+              mpc_set (mroot, s->root[i]->mvalue);
               pthread_mutex_unlock (&data->aberth_mutex[i]);
-            }
-          else
-            s->root[i]->again = true;
-
-
-          if (!s->root[i]->again || s->root[i]->approximated)
-            {
-              if (s->debug_level & MPS_DEBUG_APPROXIMATIONS)
-                MPS_DEBUG (s, "Root %d again was set to false on iteration %d by thread %d", i, *data->it, data->thread);
 
-              (*data->nzeros)++;
+              /* Another thread may have iterated on the root in the
+               * meantime, in which case the sums must be computed again. */
+              if (mpf_cmp (mpc_Re (mroot), mpc_Re (x[k])) != 0 ||
+                  mpf_cmp (mpc_Im (mroot), mpc_Im (x[k])) != 0)
+                {
+                  mpc_set (x[k], mroot);
+                  mps_secular_mbatch_sum (s, sec, 1, x + k, sums + k);
+                }
+
+              (*data->it)++;
+
+              mps_secular_mnewton_from_sum (s, MPS_POLYNOMIAL (sec), s->root[i],
+                                            sums + k, corr, wp);
+
+              /* Apply Aberth correction */
+              mps_maberth_s_wl (s, i, clusters[k], abcorr, data->aberth_mutex);
+              mpc_mul_eq (abcorr, corr);
+              mpc_ui_sub (abcorr, 1U, 0U, abcorr);
+
+              if (!mpc_eq_zero (abcorr))
+                {
+                  mpc_div (abcorr, corr, abcorr);
+
+                  pthread_mutex_lock (&data->aberth_mutex[i]);
+                  mpc_sub_eq (mroot, abcorr);
+                  pthread_mutex_unlock (&data->aberth_mutex[i]);
+                }
+              else
+                s->root[i]->again = true;
+
+
+              if (!s->root[i]->again || s->root[i]->approximated)
+                {
+                  if (s->debug_level & MPS_DEBUG_APPROXIMATIONS)
+                    MPS_DEBUG (s, "Root %d again was set to false on iteration %d by thread %d", i, *data->it, data->thread);
+
+                  (*data->nzeros)++;
+                }
+              else
+                {
+                  pthread_mutex_lock (&data->aberth_mutex[i]);
+                  mpc_set (s->root[i]->mvalue, mroot);
+                  pthread_mutex_unlock (&data->aberth_mutex[i]);
+
+                  /* Correct the radius */
+                  mpc_rmod (modcorr, abcorr);
+                  rdpe_add_eq (s->root[i]->drad, modcorr);
+
+                  mpc_rmod (modcorr, mroot);
+                  rdpe_mul_eq (modcorr, s->mp_epsilon);
+                  rdpe_add_eq (s->root[i]->drad, modcorr);
+                }
             }
-          else
-            {
-              pthread_mutex_lock (&data->aberth_mutex[i]);
-              mpc_set (s->root[i]->mvalue, mroot);
-              pthread_mutex_unlock (&data->aberth_mutex[i]);
-
-              /* Correct the radius */
-              mpc_rmod (modcorr, abcorr);
-              rdpe_add_eq (s->root[i]->drad, modcorr);
 
-              mpc_rmod (modcorr, mroot);
-              rdpe_mul_eq (modcorr, s->mp_epsilon);
-              rdpe_add_eq (s->root[i]->drad, modcorr);
-            }
+          pthread_mutex_unlock (&data->roots_mutex[i]);
         }
-
-      pthread_mutex_unlock (&data->roots_mutex[i]);
     }
 
 cleanup:
+  for (k = 0; k < MPS_SECULAR_BATCH_TARGETS; k++)
+    mps_secular_msum_clear (sums + k);
+  mpc_vclear (x, MPS_SECULAR_BATCH_TARGETS);
+
   mpc_clear (mroot);
   mpc_clear (abcorr);
   mpc_clear (corr);
@@ -623,21 +694,8 @@ mps_secular_ga_miterate (mps_context * s, int maxit, mps_boolean just_regenerate
   clock_t *my_clock = mps_start_timer ();
 #endif
 
-  mps_thread_worker_data *data;
-  pthread_mutex_t *aberth_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-  pthread_mutex_t *roots_mutex =
-    (pthread_mutex_t*)mps_malloc (sizeof(pthread_mutex_t) * s->n);
-
-  pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-  for (i = 0; i < s->n; i++)
-    {
-      pthread_mutex_init (roots_mutex + i, NULL);
-      pthread_mutex_init (aberth_mutex + i, NULL);
-    }
-
-  data = mps_newv (mps_thread_worker_data, s->n_threads);
+  mps_thread_workspace *w = mps_thread_workspace_get (s);
+  mps_thread_worker_data *data = w->data;
 
   MPS_DEBUG_THIS_CALL (s);
 
@@ -665,7 +723,8 @@ mps_secular_ga_miterate (mps_context * s, int maxit, mps_boolean just_regenerate
         computed_roots++;
     }
 
-  mps_thread_job_queue *queue = mps_thread_job_queue_new (s);
+  /* The roots owned by other processes are iterated there */
+  computed_roots += mps_distributed_count_foreign_roots (s);
 
   for (i = 0; i < s->n_threads; i++)
     {
@@ -674,16 +733,19 @@ mps_secular_ga_miterate (mps_context * s, int maxit, mps_boolean just_regenerate
       data[i].s = s;
       data[i].thread = i;
       data[i].n_threads = s->n_threads;
-      data[i].aberth_mutex = aberth_mutex;
-      data[i].roots_mutex = roots_mutex;
-      data[i].queue = queue;
-      data[i].gs_mutex = &gs_mutex;
+      data[i].aberth_mutex = w->aberth_mutex;
+      data[i].roots_mutex = w->roots_mutex;
+      data[i].queue = &w->queue;
+      data[i].gs_mutex = &w->gs_mutex;
 
       mps_thread_pool_assign (s, s->pool, __mps_secular_ga_miterate_worker, data + i);
     }
 
   mps_thread_pool_wait (s, s->pool);
 
+  /* Collect the approximations iterated by the other processes */
+  mps_distributed_gather_packet (s, &nit, NULL, &computed_roots);
+
   /* Check if the roots are improvable in floating point */
   MPS_DEBUG_WITH_INFO (s, "Performed %d iterations with MP arithmetic",
                        nit);
@@ -727,12 +789,6 @@ mps_secular_ga_miterate (mps_context * s, int maxit, mps_boolean just_regenerate
   s->mp_iteration_time += mps_stop_timer (my_clock);
 #endif
 
-  mps_thread_job_queue_free (queue);
-  free (aberth_mutex);
-  free (roots_mutex);
-
-  free (data);
-
   /* Return the number of approximated roots */
   return computed_roots;
 }
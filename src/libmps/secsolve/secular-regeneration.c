@@ -85,7 +85,10 @@ mps_secular_ga_find_changed_roots (mps_context * s, cdpe_t * old_b, mpc_t * old_
 
   for (i = 0; i < s->n; i++)
     {
-      if (s->just_raised_precision)
+      /* After a raise of the precision all the coefficients must be
+       * recomputed, but the ones of the frozen approximations, that
+       * have been kept by mps_secular_raise_precision (). */
+      if (s->just_raised_precision && !(old_mb && s->root[i]->frozen))
         {
           root_changed[i] = true;
           continue;
@@ -399,6 +402,11 @@ mps_secular_ga_regenerate_coefficients_monomial (mps_context * s, cdpe_t * old_b
 
   for (i = s->n - 1; i >= 0; i--)
     {
+      /* The coefficients relative to the nodes owned by other processes
+       * are regenerated there */
+      if (!MPS_DISTRIBUTED_OWNS (s, i))
+        continue;
+
       data[i].i = i;
       data[i].old_b = old_b;
       data[i].old_mb = old_mb;
@@ -412,6 +420,10 @@ mps_secular_ga_regenerate_coefficients_monomial (mps_context * s, cdpe_t * old_b
 
   mps_thread_pool_wait (s, s->pool);
 
+  /* Collect the coefficients regenerated by the other processes */
+  success = mps_distributed_all (s, success);
+  mps_distributed_gather_coefficients (s);
+
   free (data);
 
   return success;
@@ -462,22 +474,299 @@ mps_secular_ga_regenerate_coefficients_mp (mps_context * s, cdpe_t * old_b, mpc_
   return success;
 }
 
-static int
-__mps_compare_approximations (const void * approximation1, const void * approximation2)
+/*! @cond PRIVATE */
+struct __mps_secular_ga_regenerate_coefficients_native_data {
+  mps_context * s;
+  cdpe_t * hi;
+  cdpe_t * lo;
+  rdpe_t * ap;
+  cdpe_t * a;
+  cdpe_t * b;
+  cdpe_t * old_a;
+  cdpe_t * old_b;
+  cdpe_t * lc;
+  mps_boolean * root_changed;
+  mps_boolean * success;
+  int i;
+};
+/*! @endcond */
+
+static void *
+__mps_secular_ga_regenerate_coefficients_native_worker (void * data_ptr)
+{
+  struct __mps_secular_ga_regenerate_coefficients_native_data * data = data_ptr;
+
+  mps_context * s = data->s;
+  cdpe_t * a = data->a;
+  cdpe_t * b = data->b;
+  cdpe_t * old_b = data->old_b;
+  mps_boolean * root_changed = data->root_changed;
+  int i = data->i, j;
+
+  cdpe_t cprod_b, cdiff;
+  rdpe_t error, rtmp, root_epsilon;
+
+  if (s->exit_required || !*data->success)
+    return NULL;
+
+  /* Approximations are known to DBL_EPSILON precision in the floating point
+   * and in the DPE phase. */
+  rdpe_set_d (root_epsilon, DBL_EPSILON);
+
+  if (root_changed[i])
+    {
+      /* Compute p(b_i) with a certified error bound, and check that it is
+       * accurate at least as the one that would be computed in
+       * mps_secular_ga_regenerate_coefficients_mp(). */
+      mps_dhorner_compensated (s, s->active_poly->degree, data->hi, data->lo, data->ap,
+                               b[i], a[i], error);
+
+      cdpe_mod (rtmp, a[i]);
+      if (rdpe_eq_zero (rtmp))
+        {
+          if (!rdpe_eq_zero (error))
+            {
+              *data->success = false;
+              return NULL;
+            }
+        }
+      else
+        {
+          rdpe_div_eq (error, rtmp);
+          if (rdpe_gt (error, root_epsilon))
+            {
+              if (s->debug_level & MPS_DEBUG_REGENERATION)
+                MPS_DEBUG_RDPE (s, error, "Relative error on p(b_%d) is too large for the native regeneration", i);
+              *data->success = false;
+              return NULL;
+            }
+        }
+
+      cdpe_mul_eq (a[i], *data->lc);
+
+      /* Compute the product of the differences of the b_i */
+      cdpe_set (cprod_b, cdpe_one);
+      for (j = 0; j < s->n; j++)
+        {
+          if (i == j)
+            continue;
+
+          cdpe_sub (cdiff, b[i], b[j]);
+
+          if (cdpe_eq_zero (cdiff))
+            {
+              MPS_DEBUG (s, "Native regeneration of the coefficients failed because b_%d == b_%d", i, j);
+              *data->success = false;
+              return NULL;
+            }
+
+          cdpe_mul_eq (cprod_b, cdiff);
+        }
+
+      cdpe_div_eq (a[i], cprod_b);
+    }
+  else
+    {
+      cdpe_set (a[i], data->old_a[i]);
+
+      for (j = 0; j < s->n; j++)
+        {
+          if (root_changed[j] && i != j)
+            {
+              cdpe_sub (cdiff, b[i], old_b[j]);
+              cdpe_mul_eq (a[i], cdiff);
+
+              cdpe_sub (cdiff, b[i], b[j]);
+              cdpe_div_eq (a[i], cdiff);
+            }
+        }
+    }
+
+  return NULL;
+}
+
+/**
+ * @brief Regenerate the coefficients \f$a_i\f$ of the secular equation, using the
+ * new \f$b_i\f$ stored in <code>sec->bmpc</code>, without resorting to multiprecision.
+ *
+ * This function is meant to be used in the floating point and in the DPE phase,
+ * where the MP version of the regeneration runs with a precision that is only
+ * slightly higher than the one of a double. The values \f$p(b_i)\f$ are computed
+ * with mps_dhorner_compensated(), that works in (scaled) standard floating point
+ * and gives a certified bound to the error of the result. If any of the
+ * evaluations cannot be certified to have a relative error smaller than the
+ * machine precision the function returns false and leaves the secular
+ * equation untouched, so that the caller can fall back to
+ * mps_secular_ga_regenerate_coefficients_mp().
+ *
+ * This is only available for polynomials represented in the monomial basis, for
+ * other polynomials the function always returns false.
+ *
+ * @param s The mps_context of the computation.
+ * @param old_b Old \f$b_i\f$ coefficients from which we are regenerating from. These are used
+ * to adjust the a_i for already approximated roots.
+ * @return true if the regeneration has been performed, false otherwise.
+ */
+MPS_PRIVATE mps_boolean
+mps_secular_ga_regenerate_coefficients_native (mps_context * s, cdpe_t * old_b)
+{
+  MPS_DEBUG_THIS_CALL (s);
+
+  mps_polynomial * p = s->active_poly;
+  mps_secular_equation * sec = s->secular_equation;
+  mps_monomial_poly * mp;
+  mps_boolean success = true;
+  struct __mps_secular_ga_regenerate_coefficients_native_data * data;
+  cdpe_t * hi, * lo, * a, * b, * old_a;
+  mps_boolean * root_changed;
+  cdpe_t lc;
+  mpc_t mtmp;
+  int i, n = p->degree;
+
+  if (s->lastphase == mp_phase || !MPS_IS_MONOMIAL_POLY (p))
+    return false;
+
+  mp = MPS_MONOMIAL_POLY (p);
+
+  /* Make sure that the coefficients are known with (at least) twice the
+   * standard floating point precision, so that we can split them in a
+   * leading and in a trailing part. */
+  mps_polynomial_raise_data (s, p, MPS_SECULAR_STARTING_MP_PRECISION);
+
+  hi = cdpe_valloc (n + 1);
+  lo = cdpe_valloc (n + 1);
+  a = cdpe_valloc (s->n);
+  b = cdpe_valloc (s->n);
+  old_a = cdpe_valloc (s->n);
+  root_changed = mps_boolean_valloc (s->n);
+  data = mps_newv (struct __mps_secular_ga_regenerate_coefficients_native_data, s->n);
+
+  mpc_init2 (mtmp, mpc_get_prec (mp->mfpc[0]));
+  for (i = 0; i <= n; i++)
+    {
+      mpc_get_cdpe (hi[i], mp->mfpc[i]);
+      mpc_set_cdpe (mtmp, hi[i]);
+      mpc_sub (mtmp, mp->mfpc[i], mtmp);
+      mpc_get_cdpe (lo[i], mtmp);
+    }
+
+  /* Compute -1 / lc */
+  mpc_set_prec (mtmp, DBL_MANT_DIG);
+  mps_polynomial_get_leading_coefficient (s, p, mtmp);
+  mpc_get_cdpe (lc, mtmp);
+  cdpe_inv_eq (lc);
+  cdpe_neg_eq (lc);
+  mpc_clear (mtmp);
+
+  for (i = 0; i < s->n; i++)
+    {
+      mpc_get_cdpe (b[i], sec->bmpc[i]);
+
+      if (s->lastphase == float_phase)
+        cdpe_set_x (old_a[i], sec->afpc[i]);
+      else
+        cdpe_set (old_a[i], sec->adpc[i]);
+
+      root_changed[i] = s->just_raised_precision || cdpe_ne (b[i], old_b[i]);
+    }
+
+  for (i = s->n - 1; i >= 0; i--)
+    {
+      if (!MPS_DISTRIBUTED_OWNS (s, i))
+        continue;
+
+      data[i].s = s;
+      data[i].hi = hi;
+      data[i].lo = lo;
+      data[i].ap = mp->dap;
+      data[i].a = a;
+      data[i].b = b;
+      data[i].old_a = old_a;
+      data[i].old_b = old_b;
+      data[i].lc = &lc;
+      data[i].root_changed = root_changed;
+      data[i].success = &success;
+      data[i].i = i;
+      mps_thread_pool_assign (s, s->pool, __mps_secular_ga_regenerate_coefficients_native_worker,
+                              data + i);
+    }
+
+  mps_thread_pool_wait (s, s->pool);
+
+  /* Collect the coefficients regenerated by the other processes */
+  success = mps_distributed_all (s, success);
+  if (success)
+    mps_distributed_gather_cdpe (s, a);
+
+  if (success && !s->exit_required)
+    {
+      MPS_DEBUG (s, "Coefficients regenerated without multiprecision");
+
+      for (i = 0; i < s->n; i++)
+        {
+          /* Keep the working precision of the roots in sync with what the MP
+           * regeneration would have selected. */
+          if (root_changed[i])
+            mps_secular_ga_update_root_wp (s, i, MAX (s->mpwp + log2 (s->n), s->root[i]->wp), sec->bmpc);
+
+          mpc_set_cdpe (sec->ampc[i], a[i]);
+          mpc_set_cdpe (sec->bmpc[i], b[i]);
+        }
+    }
+  else
+    {
+      MPS_DEBUG (s, "Falling back to the multiprecision regeneration of the coefficients");
+      success = false;
+    }
+
+  free (data);
+  mps_boolean_vfree (root_changed);
+  cdpe_vfree (old_a);
+  cdpe_vfree (b);
+  cdpe_vfree (a);
+  cdpe_vfree (lo);
+  cdpe_vfree (hi);
+
+  return success;
+}
+
+/**
+ * @brief Check if two approximations are equal up to the working
+ * precision of the first one.
+ *
+ * The DPE copies in the sort keys decide most of the pairs, and the
+ * difference is computed in multiprecision, in the preallocated cmp,
+ * only for the others.
+ */
+static mps_boolean
+__mps_approximations_numerically_equal (mps_sort_key * k1, mps_sort_key * k2, mpc_t cmp)
 {
-  mps_approximation * a1 = *((mps_approximation**)approximation1);
-  mps_approximation * a2 = *((mps_approximation**)approximation2);
+  mps_approximation * a1 = k1->root;
+  mps_approximation * a2 = k2->root;
 
   long int wp = mpc_get_prec (a1->mvalue);
   rdpe_t epsilon, rtmp;
+  cdpe_t ccmp;
 
-  rdpe_set_2dl (epsilon, 1.0, -wp);
+  /* The copies have a relative error smaller than 2^-52, while the
+   * tolerance is smaller than 2^-53 times the sum of the moduli. */
+  cdpe_sub (ccmp, k1->value, k2->value);
+  cdpe_mod (epsilon, k1->value);
+  cdpe_mod (rtmp, k2->value);
+  rdpe_add_eq (epsilon, rtmp);
+  rdpe_div_eq_2exp (epsilon, 50);
 
-  int return_value = 0;
-  mpc_t cmp;
-  cdpe_t ccmp;
+  rdpe_abs (rtmp, cdpe_Re (ccmp));
+  if (rdpe_gt (rtmp, epsilon))
+    return false;
+  rdpe_abs (rtmp, cdpe_Im (ccmp));
+  if (rdpe_gt (rtmp, epsilon))
+    return false;
 
-  mpc_init2 (cmp, wp);
+  if (mpc_get_prec (cmp) != (unsigned long int) wp)
+    mpc_set_prec (cmp, wp);
+
+  rdpe_set_2dl (epsilon, 1.0, -wp);
 
   mpc_sub (cmp, a1->mvalue, a2->mvalue);
   mpc_get_cdpe (ccmp, cmp);
@@ -487,22 +776,11 @@ __mps_compare_approximations (const void * approximation1, const void * approxim
   rdpe_mul_eq (epsilon, rtmp);
 
   rdpe_abs (rtmp, cdpe_Re (ccmp));
-  if (rdpe_lt (rtmp, epsilon))
-    {
-      rdpe_abs (rtmp, cdpe_Im (ccmp));
-      if (rdpe_lt (rtmp, epsilon))
-        return_value = 0;
-      else
-        return_value = rdpe_lt (cdpe_Im (ccmp), rdpe_zero) ? -1 : 1;
-    }
-  else
-    {
-      return_value = rdpe_lt (cdpe_Re (ccmp), rdpe_zero) ? -2 : 2;
-    }
-
-  mpc_clear (cmp);
+  if (!rdpe_lt (rtmp, epsilon))
+    return false;
 
-  return return_value;
+  rdpe_abs (rtmp, cdpe_Im (ccmp));
+  return rdpe_lt (rtmp, epsilon);
 }
 
 /**
@@ -521,8 +799,11 @@ mps_secular_ga_separate_approximations (mps_context * ctx)
    * allow us to recognize the ones that are identical to the
    * current working precision. */
   mps_approximation ** current_approximations = mps_newv (mps_approximation *, ctx->n);
+  mps_sort_key * keys = mps_newv (mps_sort_key, ctx->n);
+  mpc_t cmp;
 
   mpc_init2 (perturbation, ctx->mpwp);
+  mpc_init2 (cmp, ctx->mpwp);
 
   if (ctx->lastphase == mp_phase)
     rdpe_set (epsilon, ctx->mp_epsilon);
@@ -532,11 +813,29 @@ mps_secular_ga_separate_approximations (mps_context * ctx)
   for (i = 0; i < ctx->n; i++)
     {
       current_approximations[i] = ctx->root[i];
-      mpc_set_prec (current_approximations[i]->mvalue, ctx->mpwp);
+
+      /* The frozen approximations are isolated, so they cannot be
+       * numerically equal to any other one. If one of them is not
+       * isolated anymore it is brought to the working precision. */
+      if (ctx->root[i]->status != MPS_ROOT_STATUS_ISOLATED &&
+          ctx->root[i]->status != MPS_ROOT_STATUS_APPROXIMATED)
+        ctx->root[i]->frozen = false;
+
+      if (!ctx->root[i]->frozen)
+        mpc_set_prec (current_approximations[i]->mvalue, ctx->mpwp);
     }
 
-  qsort (current_approximations, ctx->n, sizeof(mps_approximation*),
-         __mps_compare_approximations);
+  for (i = 0; i < ctx->n; i++)
+    {
+      mpc_get_cdpe (keys[i].value, ctx->root[i]->mvalue);
+      keys[i].root = ctx->root[i];
+      keys[i].index = i;
+    }
+
+  mps_sort_keys (ctx, keys, ctx->n);
+
+  for (i = 0; i < ctx->n; i++)
+    current_approximations[i] = keys[i].root;
 
   /* Check if we find a cluster of k equal approximations */
   for (i = 0; i < ctx->n - 1; i++)
@@ -546,7 +845,7 @@ mps_secular_ga_separate_approximations (mps_context * ctx)
           /* If the next approximation is different start tracking the cluster.
            * Stop event if it is equal but it's the last one. In that case increase
            * the value of i. */
-          if ((__mps_compare_approximations (&current_approximations[i], &current_approximations[i + 1]) != 0)
+          if (!__mps_approximations_numerically_equal (&keys[i], &keys[i + 1], cmp)
               || (i == ctx->n - 2))
             {
               /* This is a workaround to handle the special case where the cluster ends
@@ -613,7 +912,7 @@ mps_secular_ga_separate_approximations (mps_context * ctx)
         }
       else
         {
-          if (__mps_compare_approximations (&current_approximations[i], &current_approximations[i + 1]) == 0)
+          if (__mps_approximations_numerically_equal (&keys[i], &keys[i + 1], cmp))
             {
               cluster_base = i;
             }
@@ -621,7 +920,9 @@ mps_secular_ga_separate_approximations (mps_context * ctx)
     }
 
   free (current_approximations);
+  free (keys);
   mpc_clear (perturbation);
+  mpc_clear (cmp);
 }
 
 /**
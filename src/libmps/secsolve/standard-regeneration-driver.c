@@ -45,8 +45,10 @@ mps_standard_regeneration_driver_update_fsecular_equation (mps_context * s,
       mpc_set (sec->bmpc[i], approximations[i]->mvalue);
     }
 
-  /* Regeneration */
-  if (!(successful_regeneration = mps_secular_ga_regenerate_coefficients_mp (s, old_db, old_mb)))
+  /* Regeneration: try to avoid multiprecision, if the result can be certified
+   * in floating point. */
+  if (!(successful_regeneration = mps_secular_ga_regenerate_coefficients_native (s, old_db) ||
+        mps_secular_ga_regenerate_coefficients_mp (s, old_db, old_mb)))
     {
       for (i = 0; i < s->n; i++)
 	{
@@ -132,8 +134,10 @@ mps_standard_regeneration_driver_update_dsecular_equation (mps_context * s,
       mpc_set (sec->bmpc[i], approximations[i]->mvalue);
     }
 
-  /* Regeneration */
-  if (!(successful_regeneration = mps_secular_ga_regenerate_coefficients_mp (s, old_db, old_mb)))
+  /* Regeneration: try to avoid multiprecision, if the result can be certified
+   * in DPE. */
+  if (!(successful_regeneration = mps_secular_ga_regenerate_coefficients_native (s, old_db) ||
+        mps_secular_ga_regenerate_coefficients_mp (s, old_db, old_mb)))
     {
       MPS_DEBUG (s, "Regeneration failed");
       for (i = 0; i < s->n; i++)
@@ -0,0 +1,345 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+
+/*! @cond PRIVATE */
+
+/* Differences x - b_i whose scaled modulus is smaller than this value
+ * are computed with DPE arithmetic, so that their inverses and squares
+ * never overflow in the floating point accumulators. */
+#define MPS_SECULAR_BATCH_MIN_DIFF 0x1p-300
+
+/* Exponent used for values whose components are both zero. */
+#define MPS_SECULAR_BATCH_NO_EXPONENT LONG_MIN
+
+/* A tile of DPE coefficients stored as doubles with a shared exponent:
+ * a_i = (ar[i] + I ai[i]) 2^ea and b_i = (br[i] + I bi[i]) 2^eb. */
+typedef struct {
+  double ar[MPS_SECULAR_BATCH_TILE], ai[MPS_SECULAR_BATCH_TILE];
+  double br[MPS_SECULAR_BATCH_TILE], bi[MPS_SECULAR_BATCH_TILE];
+  long int ea, eb;
+} mps_secular_dtile;
+
+/*! @endcond */
+
+static long int
+mps_secular_batch_exponent (const cdpe_t c, long int e)
+{
+  if (rdpe_Mnt (cdpe_Re (c)) != 0.0)
+    e = MAX (e, rdpe_Esp (cdpe_Re (c)));
+  if (rdpe_Mnt (cdpe_Im (c)) != 0.0)
+    e = MAX (e, rdpe_Esp (cdpe_Im (c)));
+  return e;
+}
+
+/* Return x 2^-e as a double, assuming that x is not larger than 2^e.
+ * Values that underflow are flushed to zero. */
+static double
+mps_secular_batch_scale (const rdpe_t x, long int e)
+{
+  long int d = rdpe_Esp (x) - e;
+
+  if (rdpe_Mnt (x) == 0.0 || d < DBL_MIN_EXP - DBL_MANT_DIG)
+    return 0.0;
+
+  return ldexp (rdpe_Mnt (x), (int) d);
+}
+
+static void
+mps_secular_batch_add_scaled (rdpe_t acc, double x, long int e)
+{
+  rdpe_t t;
+
+  if (x == 0.0)
+    return;
+
+  rdpe_set_2dl (t, x, e);
+  rdpe_add_eq (acc, t);
+}
+
+static void
+mps_secular_dtile_load (mps_secular_dtile * tile, cdpe_t * a, cdpe_t * b, int n)
+{
+  int i;
+
+  tile->ea = tile->eb = MPS_SECULAR_BATCH_NO_EXPONENT;
+  for (i = 0; i < n; i++)
+    {
+      tile->ea = mps_secular_batch_exponent (a[i], tile->ea);
+      tile->eb = mps_secular_batch_exponent (b[i], tile->eb);
+    }
+
+  if (tile->ea == MPS_SECULAR_BATCH_NO_EXPONENT)
+    tile->ea = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      tile->ar[i] = mps_secular_batch_scale (cdpe_Re (a[i]), tile->ea);
+      tile->ai[i] = mps_secular_batch_scale (cdpe_Im (a[i]), tile->ea);
+      tile->br[i] = mps_secular_batch_scale (cdpe_Re (b[i]), tile->eb);
+      tile->bi[i] = mps_secular_batch_scale (cdpe_Im (b[i]), tile->eb);
+    }
+}
+
+/* Add the term of index i to the sums using DPE arithmetic. Return
+ * false if x is equal to b_i. */
+static mps_boolean
+mps_secular_dbatch_term (cdpe_t x, cdpe_t a, cdpe_t b, mps_secular_dsum * sum)
+{
+  cdpe_t ctmp, ctmp2;
+  rdpe_t rtmp;
+
+  cdpe_sub (ctmp, x, b);
+  if (cdpe_eq_zero (ctmp))
+    return false;
+
+  cdpe_inv_eq (ctmp);
+  cdpe_add_eq (sum->sumb, ctmp);
+
+  cdpe_mul (ctmp2, a, ctmp);
+  rdpe_abs (rtmp, cdpe_Re (ctmp2));
+  rdpe_add_eq (sum->asum, rtmp);
+  rdpe_abs (rtmp, cdpe_Im (ctmp2));
+  rdpe_add_eq (sum->asum, rtmp);
+
+  cdpe_add_eq (sum->pol, ctmp2);
+  cdpe_mul_eq (ctmp2, ctmp);
+  cdpe_sub_eq (sum->fp, ctmp2);
+
+  return true;
+}
+
+/**
+ * @brief Evaluate the sums needed by the DPE Newton correction of the
+ * secular equation on <code>m</code> points.
+ *
+ * Each tile of coefficients is converted to doubles sharing a common
+ * exponent for the \f$a_i\f$ and one for the \f$b_i\f$, and the point and
+ * the \f$b_i\f$ are scaled to the larger of their exponents. The terms are then computed in
+ * floating point and only the partial sums of the tile are converted back
+ * to DPE. The terms where \f$x - b_i\f$ is too small compared to the scale
+ * of the tile are computed in DPE, so the result has the same accuracy of
+ * a computation carried out entirely in DPE arithmetic.
+ *
+ * @param s The current mps_context.
+ * @param sec The secular equation.
+ * @param m The number of points.
+ * @param x The points where the sums should be evaluated.
+ * @param sums Array of <code>m</code> structs where the sums are stored.
+ */
+void
+mps_secular_dbatch_sum (mps_context * s, mps_secular_equation * sec, int m,
+                        cdpe_t * x, mps_secular_dsum * sums)
+{
+  int n = MPS_POLYNOMIAL (sec)->degree;
+  mps_secular_dtile tile;
+  int i, j, k, len;
+
+  for (k = 0; k < m; k++)
+    {
+      cdpe_set (sums[k].pol, cdpe_zero);
+      cdpe_set (sums[k].fp, cdpe_zero);
+      cdpe_set (sums[k].sumb, cdpe_zero);
+      rdpe_set (sums[k].asum, rdpe_zero);
+      sums[k].index = -1;
+    }
+
+  for (j = 0; j < n; j += MPS_SECULAR_BATCH_TILE)
+    {
+      len = MIN (MPS_SECULAR_BATCH_TILE, n - j);
+      mps_secular_dtile_load (&tile, sec->adpc + j, sec->bdpc + j, len);
+
+      for (k = 0; k < m; k++)
+        {
+          double zr, zi, f, dr, di, d, ir, ii, tr, ti;
+          double pr = 0.0, pi = 0.0, fr = 0.0, fi = 0.0, sr = 0.0, si = 0.0, as = 0.0;
+          long int e;
+
+          if (sums[k].index >= 0)
+            continue;
+
+          e = MAX (tile.eb, mps_secular_batch_exponent (x[k], MPS_SECULAR_BATCH_NO_EXPONENT));
+          if (e == MPS_SECULAR_BATCH_NO_EXPONENT)
+            e = 0;
+
+          zr = mps_secular_batch_scale (cdpe_Re (x[k]), e);
+          zi = mps_secular_batch_scale (cdpe_Im (x[k]), e);
+          f = (tile.eb == MPS_SECULAR_BATCH_NO_EXPONENT) ? 0.0 :
+              ldexp (1.0, (int) MAX (tile.eb - e, DBL_MIN_EXP - DBL_MANT_DIG - 1));
+
+          for (i = 0; i < len; i++)
+            {
+              dr = zr - f * tile.br[i];
+              di = zi - f * tile.bi[i];
+
+              if (fabs (dr) + fabs (di) < MPS_SECULAR_BATCH_MIN_DIFF)
+                {
+                  if (!mps_secular_dbatch_term (x[k], sec->adpc[j + i], sec->bdpc[j + i], sums + k))
+                    {
+                      sums[k].index = j + i;
+                      break;
+                    }
+                  continue;
+                }
+
+              /* Compute (x - b_i)^{-1} and a_i / (x - b_i) */
+              d = dr * dr + di * di;
+              ir = dr / d;
+              ii = -di / d;
+
+              tr = tile.ar[i] * ir - tile.ai[i] * ii;
+              ti = tile.ar[i] * ii + tile.ai[i] * ir;
+
+              sr += ir;
+              si += ii;
+              pr += tr;
+              pi += ti;
+              as += fabs (tr) + fabs (ti);
+
+              /* Compute a_i / (x - b_i)^2 */
+              fr += tr * ir - ti * ii;
+              fi += tr * ii + ti * ir;
+            }
+
+          if (sums[k].index >= 0)
+            continue;
+
+          mps_secular_batch_add_scaled (cdpe_Re (sums[k].sumb), sr, -e);
+          mps_secular_batch_add_scaled (cdpe_Im (sums[k].sumb), si, -e);
+          mps_secular_batch_add_scaled (cdpe_Re (sums[k].pol), pr, tile.ea - e);
+          mps_secular_batch_add_scaled (cdpe_Im (sums[k].pol), pi, tile.ea - e);
+          mps_secular_batch_add_scaled (cdpe_Re (sums[k].fp), -fr, tile.ea - 2 * e);
+          mps_secular_batch_add_scaled (cdpe_Im (sums[k].fp), -fi, tile.ea - 2 * e);
+          mps_secular_batch_add_scaled (sums[k].asum, as, tile.ea - e);
+        }
+    }
+}
+
+/**
+ * @brief Initialize a mps_secular_msum with precision <code>wp</code>.
+ */
+void
+mps_secular_msum_init (mps_secular_msum * sum, long int wp)
+{
+  mpc_init2 (sum->pol, wp);
+  mpc_init2 (sum->fp, wp);
+  mpc_init2 (sum->sumb, wp);
+  mpc_init2 (sum->t1, wp);
+  mpc_init2 (sum->t2, wp);
+}
+
+/**
+ * @brief Change the precision of a mps_secular_msum, if it is
+ * different from <code>wp</code>.
+ */
+void
+mps_secular_msum_set_prec (mps_secular_msum * sum, long int wp)
+{
+  if (mpc_get_prec (sum->pol) == (unsigned long int) wp)
+    return;
+
+  mpc_set_prec (sum->pol, wp);
+  mpc_set_prec (sum->fp, wp);
+  mpc_set_prec (sum->sumb, wp);
+  mpc_set_prec (sum->t1, wp);
+  mpc_set_prec (sum->t2, wp);
+}
+
+/**
+ * @brief Free the memory used by a mps_secular_msum.
+ */
+void
+mps_secular_msum_clear (mps_secular_msum * sum)
+{
+  mpc_clear (sum->pol);
+  mpc_clear (sum->fp);
+  mpc_clear (sum->sumb);
+  mpc_clear (sum->t1);
+  mpc_clear (sum->t2);
+}
+
+/**
+ * @brief Evaluate the sums needed by the multiprecision Newton correction
+ * of the secular equation on <code>m</code> points.
+ *
+ * The sums of each point are computed at the precision of the
+ * corresponding element of <code>sums</code>, with the temporaries that
+ * it contains, so no memory is allocated during the evaluation. The terms
+ * are accumulated in the order of the coefficients, so the result does
+ * not depend on the number of points in the batch.
+ *
+ * @param s The current mps_context.
+ * @param sec The secular equation.
+ * @param m The number of points.
+ * @param x The points where the sums should be evaluated.
+ * @param sums Array of <code>m</code> initialized structs where the sums are
+ * stored.
+ */
+void
+mps_secular_mbatch_sum (mps_context * s, mps_secular_equation * sec, int m,
+                        mpc_t * x, mps_secular_msum * sums)
+{
+  int n = MPS_POLYNOMIAL (sec)->degree;
+  mpc_t *ampc = sec->ampc, *bmpc = sec->bmpc;
+  rdpe_t rtmp;
+  int i, j, k, len;
+
+  for (k = 0; k < m; k++)
+    {
+      mpc_set_ui (sums[k].pol, 0U, 0U);
+      mpc_set_ui (sums[k].fp, 0U, 0U);
+      mpc_set_ui (sums[k].sumb, 0U, 0U);
+      rdpe_set (sums[k].asum, rdpe_zero);
+      sums[k].index = -1;
+    }
+
+  for (j = 0; j < n; j += MPS_SECULAR_BATCH_TILE)
+    {
+      len = MIN (MPS_SECULAR_BATCH_TILE, n - j);
+
+      for (k = 0; k < m; k++)
+        {
+          mps_secular_msum * sum = sums + k;
+
+          if (sum->index >= 0)
+            continue;
+
+          for (i = j; i < j + len; i++)
+            {
+              /* Compute z - b_i */
+              mpc_sub (sum->t1, x[k], bmpc[i]);
+
+              if (mpc_eq_zero (sum->t1))
+                {
+                  sum->index = i;
+                  break;
+                }
+
+              /* Compute (z-b_i)^{-1} and add it to sumb */
+              mpc_inv_eq (sum->t1);
+              mpc_add_eq (sum->sumb, sum->t1);
+
+              /* Compute a_i / (z - b_i) */
+              mpc_mul (sum->t2, ampc[i], sum->t1);
+              mpc_rmod (rtmp, sum->t2);
+              rdpe_add_eq (sum->asum, rtmp);
+              mpc_add_eq (sum->pol, sum->t2);
+
+              /* Compute a_i / (z - b_i)^2 */
+              mpc_mul_eq (sum->t2, sum->t1);
+              mpc_sub_eq (sum->fp, sum->t2);
+            }
+        }
+    }
+}
@@ -561,6 +561,11 @@ mps_secular_raise_coefficient_precision (mps_context * s, mps_polynomial * p, lo
 
   mpc_t * raising_ampc;
   mpc_t * raising_bmpc;
+  mps_boolean frozen = false;
+
+  if (p->degree == s->n)
+    for (i = 0; i < s->n; i++)
+      frozen = frozen || s->root[i]->frozen;
 
   pthread_mutex_lock (&sec->precision_mutex);
 
@@ -583,6 +588,22 @@ mps_secular_raise_coefficient_precision (mps_context * s, mps_polynomial * p, lo
 
   for (i = 0; i < p->degree; i++)
     {
+      /* The coefficients of the frozen approximations are kept as they
+       * are, and so are all the b_i, so that the regeneration can update
+       * the a_i of the frozen approximations instead of recomputing them. */
+      if (frozen)
+        {
+          mpc_set_prec (raising_bmpc[i], MAX (wp, mpc_get_prec (sec->bmpc[i])));
+          mpc_set (raising_bmpc[i], sec->bmpc[i]);
+
+          if (s->root[i]->frozen)
+            {
+              mpc_set_prec (raising_ampc[i], mpc_get_prec (sec->ampc[i]));
+              mpc_set (raising_ampc[i], sec->ampc[i]);
+              continue;
+            }
+        }
+
       mpc_set_prec (raising_ampc[i], wp);
       if (!MPS_STRUCTURE_IS_FP (p->structure))
         {
@@ -592,6 +613,9 @@ mps_secular_raise_coefficient_precision (mps_context * s, mps_polynomial * p, lo
       else
         mpc_set (raising_ampc[i], sec->ampc[i]);
 
+      if (frozen)
+        continue;
+
       mpc_set_prec (raising_bmpc[i], wp);
       if (!MPS_STRUCTURE_IS_FP (p->structure))
         {
@@ -619,6 +643,8 @@ mps_secular_raise_coefficient_precision (mps_context * s, mps_polynomial * p, lo
  * @brief Raise precision of the roots (not the coefficients nor the
  * system) to <code>wp</code> bits.
  *
+ * The approximations marked as frozen keep their precision.
+ *
  * @param s The mps_context of the computation.
  * @param wp The bits of precision to which the roots will be set.
  *
@@ -633,8 +659,46 @@ mps_secular_raise_root_precision (mps_context * s, int wp)
 
   for (i = 0; i < s->n; i++)
     {
-      mpc_set_prec (s->root[i]->mvalue, wp);
+      if (!s->root[i]->frozen)
+        mpc_set_prec (s->root[i]->mvalue, wp);
+    }
+}
+
+/**
+ * @brief Decide which approximations do not need the precision that
+ * is about to be set, and mark them as frozen.
+ *
+ * An approximation is frozen if its inclusion is isolated from the
+ * others. Its secular iterations are over: either its radius already
+ * certifies the digits requested in output, or these are obtained by
+ * the Newton refinement of mps_improve () starting from the isolated
+ * inclusion. Thus it keeps its current precision, and the regeneration
+ * updates its coefficient instead of evaluating the polynomial in it
+ * again.
+ *
+ * @param s The mps_context of the computation.
+ * @return The number of frozen approximations.
+ */
+static int
+mps_secular_freeze_approximations (mps_context * s)
+{
+  int i, frozen = 0;
+
+  for (i = 0; i < s->n; i++)
+    {
+      mps_approximation * root = s->root[i];
+
+      /* The coefficients are copied from the floating point ones when
+       * entering the multiprecision phase, so there is nothing to keep. */
+      root->frozen = (s->lastphase == mp_phase) &&
+                     (root->status == MPS_ROOT_STATUS_ISOLATED ||
+                      root->status == MPS_ROOT_STATUS_APPROXIMATED);
+
+      if (root->frozen)
+        frozen++;
     }
+
+  return frozen;
 }
 
 /**
@@ -653,7 +717,10 @@ mps_secular_raise_precision (mps_context * s, int wp)
 {
   MPS_DEBUG_THIS_CALL (s);
 
-  int i;
+  int i, frozen = mps_secular_freeze_approximations (s);
+
+  if (frozen > 0)
+    MPS_DEBUG_WITH_INFO (s, "%d approximations are kept at their precision", frozen);
 
   mps_secular_raise_coefficient_precision (s, MPS_POLYNOMIAL (s->secular_equation), wp);
   mps_secular_raise_root_precision (s, wp);
@@ -666,8 +733,8 @@ mps_secular_raise_precision (mps_context * s, int wp)
 
   for (i = 0; i < s->n; i++)
     {
-      s->root[i]->approximated = false;
-      s->root[i]->again = true;
+      s->root[i]->approximated = s->root[i]->frozen;
+      s->root[i]->again = !s->root[i]->frozen;
     }
 }
 
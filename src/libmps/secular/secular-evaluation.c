@@ -278,8 +278,7 @@ mps_secular_meval_with_error (mps_context * s, mps_polynomial * p, mpc_t x, mpc_
 {
   mps_secular_equation * sec = MPS_SECULAR_EQUATION (p);
   mpc_t ctmp;
-  rdpe_t rtmp, ax;
-  cdpe_t cdtmp;
+  rdpe_t rtmp;
   unsigned int wp = mpc_get_prec (x);
   int i;
 
@@ -297,9 +296,6 @@ mps_secular_meval_with_error (mps_context * s, mps_polynomial * p, mpc_t x, mpc_
   mpc_set_ui (value, 0U, 0U);
   mpc_set_prec (value, wp);
 
-  /* Get |x| */
-  mpc_rmod (ax, x);
-
   rdpe_set (error, rdpe_zero);
 
   for (i = 0; i < s->n; i++)
@@ -315,14 +311,12 @@ mps_secular_meval_with_error (mps_context * s, mps_polynomial * p, mpc_t x, mpc_
       mpc_div (ctmp, sec->ampc[i], ctmp);
       mpc_add_eq (value, ctmp);
 
-      mpc_get_cdpe (cdtmp, ctmp);
-      cdpe_mod (rtmp, cdtmp);
-      rdpe_mul_eq_d (rtmp, i + 2);
-      rdpe_add_eq (error, rtmp);
+      mps_mag_set_mpc (rtmp, ctmp);
+      mps_mag_fma_d (error, rtmp, i + 2, error);
     }
 
   mpc_sub_eq_ui (value, 1U, 0U);
-  rdpe_add_eq (error, rdpe_one);
+  mps_mag_add (error, error, rdpe_one);
 
   if (p->prec < wp)
     rdpe_set_2dl (rtmp, 4.0, 1 - p->prec);
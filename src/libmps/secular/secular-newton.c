@@ -25,8 +25,7 @@
 #define MPS_SQRT2 1.4142135623
 
 /* We need some special codes to identify the meaning of the exit
- * status of mps_secular_fparallel_sum() and its DPE and MP
- * versions. */
+ * status of mps_secular_fparallel_sum(). */
 #define MPS_PARALLEL_SUM_SUCCESS -1
 #define MPS_PARALLEL_SUM_FAILED  -2
 
@@ -237,115 +236,50 @@ mps_secular_fnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
     }
 }
 
-/**
- * @brief Perform the evaluation of the DPE Newton correction with the formula
- * obtained implicitly by the secular equation using the parallel
- * algorithm.
- *
- * @param s The mps_context associated to the current computation
- * @param root The approximation that shall be used as evaluation point
- * @param n The length of the terms that should be summed by the function
- * @param adpc A pointer to the first DPE a_i coefficient
- * @param bdpc A pointer to the first DPE b_i coefficient
- * @param pol The CDPE value where the result of the evaluation of S(x) will
- *   be stored
- * @param fp The CDPE value where the result of the evaluation of S'(x) will be
- *   stored
- * @param sumb The CDPE value where the result of the evaluation of the sum of
- *   the terms \f$\frac{1}{(x - b_i)}\f$ will be stored
- * @param asum The RDPE value where the sum of the module of the complex terms
- *   \f$\frac{a_i}{(x - b_i)}\f$ will be saved
- * @return If the returned value is a positive integer it is the index of the \f$b_i\f$ term
- *   that is equal to \f$x\f$, suggesting that the alternate evaluation algorithm must be used.
- *   If it is MPS_PARALLEL_SUM_FAILED then a floting point was encountered in the computation,
- *   while MPS_PARALLEL_SUM_SUCCESS indicates that the evaluation was successful.
- */
-int
-mps_secular_dparallel_sum (mps_context * s, mps_approximation * root, int n, cdpe_t * adpc, cdpe_t * bdpc,
-                           cdpe_t pol, cdpe_t fp, cdpe_t sumb, rdpe_t asum)
+void
+mps_secular_dnewton (mps_context * s, mps_polynomial * p, mps_approximation * root, cdpe_t corr)
 {
-  if (n <= 2)
-    {
-      int i;
-      cdpe_t ctmp, ctmp2;
-      rdpe_t rtmp;
-      for (i = 0; i < n; i++)
-        {
-          /* Compute z - b_i */
-          cdpe_sub (ctmp, root->dvalue, bdpc[i]);
-
-          /* Check if we are in the case where z == b_i and return,
-           * without doing any further iteration */
-          if (cdpe_eq_zero (ctmp))
-            {
-              return i;
-            }
-
-          /* Compute (z-b_i)^{-1} */
-          cdpe_inv_eq (ctmp);
-
-          /* Compute sum of (z-b_i)^{-1} */
-          cdpe_add_eq (sumb, ctmp);
-
-          /* Compute a_i / (z - b_i) */
-          cdpe_mul (ctmp2, adpc[i], ctmp);
-
-          /* Compute the sum of module of (a_i/(z-b_i)) * (i + 2) */
-          rdpe_abs (rtmp, cdpe_Re (ctmp2));
-          rdpe_add_eq (asum, rtmp);
-          rdpe_abs (rtmp, cdpe_Im (ctmp2));
-          rdpe_add_eq (asum, rtmp);
-
-          /* Add a_i / (z - b_i) to pol */
-          cdpe_add_eq (pol, ctmp2);
-
-          /* Compute a_i / (z - b_i)^2a */
-          cdpe_mul_eq (ctmp2, ctmp);
-
-          /* Add it to fp */
-          cdpe_sub_eq (fp, ctmp2);
-        }
+  mps_secular_dsum sum;
+  cdpe_t x;
 
-      return MPS_PARALLEL_SUM_SUCCESS;
-    }
-  else
-    {
-      int i = n / 2, k;
-      if ((k = mps_secular_dparallel_sum (s, root, i, adpc, bdpc, pol, fp, sumb, asum)) >= 0)
-        {
-          return k;
-        }
-      if ((k = mps_secular_dparallel_sum (s, root, n - i, adpc + i, bdpc + i, pol, fp, sumb, asum)) >= 0)
-        {
-          return i + k;
-        }
-
-      return MPS_PARALLEL_SUM_SUCCESS;
-    }
+  cdpe_set (x, root->dvalue);
+  mps_secular_dbatch_sum (s, MPS_SECULAR_EQUATION (p), 1, &x, &sum);
+  mps_secular_dnewton_from_sum (s, p, root, &sum, corr);
 }
 
+/**
+ * @brief Compute the DPE Newton correction of the secular equation in
+ * <code>root</code>, starting from the sums computed in its value by
+ * mps_secular_dbatch_sum ().
+ *
+ * @param s The current mps_context.
+ * @param p The secular equation.
+ * @param root The approximation whose correction should be computed.
+ * @param sum The sums evaluated in the value of <code>root</code>.
+ * @param corr The output Newton correction.
+ */
 void
-mps_secular_dnewton (mps_context * s, mps_polynomial * p, mps_approximation * root, cdpe_t corr)
+mps_secular_dnewton_from_sum (mps_context * s, mps_polynomial * p, mps_approximation * root,
+                              mps_secular_dsum * sum, cdpe_t corr)
 {
-  int i;
+  int i = sum->index;
   cdpe_t ctmp, ctmp2, pol, fp, sumb, x;
   rdpe_t apol, asum, asum_on_apol, ax, rtmp, rtmp2, acorr;
   mps_secular_equation *sec = MPS_SECULAR_EQUATION (p);
 
   cdpe_set (x, root->dvalue);
-  rdpe_set (asum, rdpe_zero);
   cdpe_mod (ax, x);
 
   /* First set again to true */
   root->again = true;
 
-  cdpe_set (pol, cdpe_zero);
-  cdpe_set (fp, cdpe_zero);
-  cdpe_set (sumb, cdpe_zero);
+  cdpe_set (pol, sum->pol);
+  cdpe_set (fp, sum->fp);
+  cdpe_set (sumb, sum->sumb);
+  rdpe_set (asum, sum->asum);
   cdpe_set (corr, cdpe_zero);
 
-  if ((i = mps_secular_dparallel_sum (s, root, MPS_POLYNOMIAL (sec)->degree, sec->adpc, sec->bdpc,
-                                      pol, fp, sumb, asum)) != MPS_PARALLEL_SUM_SUCCESS)
+  if (i >= 0)
     {
       int k;
 
@@ -434,121 +368,42 @@ mps_secular_dnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
     }
 }
 
-/**
- * @brief Perform the evaluation of the Newton correction with the formula
- * obtained implicitly by the secular equation using the parallel
- * algorithm.
- *
- * @param s The mps_context associated to the current computation
- * @param root The approximation that shall be used as evaluation point
- * @param n The length of the terms that should be summed by the function
- * @param afpc A pointer to the first floating point a_i coefficient
- * @param bfpc A pointer to the first floating point b_i coefficient
- * @param pol The complex value where the result of the evaluation of S(x) will
- *   be stored
- * @param fp The complex value where the result of the evaluation of S'(x) will be
- *   stored
- * @param sumb The complex value where the result of the evaluation of the sum of
- *   the terms \f$\frac{1}{(x - b_i)}\f$ will be stored
- * @param asum A pointer to a double where the sum of the module of the complex terms
- *   \f$\frac{a_i}{(x - b_i)}\f$ will be saved
- * @return If the returned value is a positive integer it is the index of the \f$b_i\f$ term
- *   that is equal to \f$x\f$, suggesting that the alternate evaluation algorithm must be used.
- *   If it is MPS_PARALLEL_SUM_FAILED then a floting point was encountered in the computation,
- *   while MPS_PARALLEL_SUM_SUCCESS indicates that the evaluation was successful.
- */
-int
-mps_secular_mparallel_sum (mps_context * s, mps_approximation * root, int n, mpc_t * ampc, mpc_t * bmpc,
-                           mpc_t pol, mpc_t fp, mpc_t sumb, rdpe_t asum)
+void
+mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * root, mpc_t corr, long int wp)
 {
-  long int wp = mpc_get_prec (pol);
-
-  if (n <= 2)
-    {
-      int i;
-      mpc_t ctmp, ctmp2;
-
-      mpc_init2 (ctmp, wp);
-      mpc_init2 (ctmp2, wp);
-
-      for (i = 0; i < n; i++)
-        {
-          rdpe_t rtmp;
-
-          /* Compute z - b_i */
-          mpc_sub (ctmp, root->mvalue, bmpc[i]);
-
-          /* Check if we are in the case where z == b_i and return,
-           * without doing any further iteration */
-          if (mpc_eq_zero (ctmp))
-            {
-              return i;
-            }
+  mps_secular_msum sum;
 
-          /* Compute (z-b_i)^{-1} */
-          mpc_inv_eq (ctmp);
-
-          /* Compute sum of (z-b_i)^{-1} */
-          mpc_add_eq (sumb, ctmp);
-
-          /* Compute a_i / (z - b_i) */
-          mpc_mul (ctmp2, ampc[i], ctmp);
-
-          /* Compute the sum of module of (a_i/(z-b_i)) */
-          mpc_rmod (rtmp, ctmp2);
-          rdpe_add_eq (asum, rtmp);
-
-          /* Add a_i / (z - b_i) to pol */
-          mpc_add_eq (pol, ctmp2);
-
-          /* Compute a_i / (z - b_i)^2a */
-          mpc_mul_eq (ctmp2, ctmp);
-
-          /* Add it to fp */
-          mpc_sub_eq (fp, ctmp2);
-        }
-
-      mpc_clear (ctmp);
-      mpc_clear (ctmp2);
-
-      return MPS_PARALLEL_SUM_SUCCESS;
-    }
-  else
-    {
-      int i = n / 2, k;
-      if ((k = mps_secular_mparallel_sum (s, root, i, ampc, bmpc, pol, fp, sumb, asum)) >= 0)
-        {
-          return k;
-        }
-      if ((k = mps_secular_mparallel_sum (s, root, n - i, ampc + i, bmpc + i, pol, fp, sumb, asum)) >= 0)
-        {
-          return i + k;
-        }
-
-      return MPS_PARALLEL_SUM_SUCCESS;
-    }
+  mps_secular_msum_init (&sum, wp);
+  mps_secular_mbatch_sum (s, MPS_SECULAR_EQUATION (p), 1, &root->mvalue, &sum);
+  mps_secular_mnewton_from_sum (s, p, root, &sum, corr, wp);
+  mps_secular_msum_clear (&sum);
 }
 
+/**
+ * @brief Compute the multiprecision Newton correction of the secular
+ * equation in <code>root</code>, starting from the sums computed in its
+ * value by mps_secular_mbatch_sum ().
+ *
+ * The sums and the temporaries in <code>sum</code> are overwritten.
+ *
+ * @param s The current mps_context.
+ * @param p The secular equation.
+ * @param root The approximation whose correction should be computed.
+ * @param sum The sums evaluated in the value of <code>root</code>, with
+ * precision <code>wp</code>.
+ * @param corr The output Newton correction.
+ * @param wp The working precision.
+ */
 void
-mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * root, mpc_t corr, long int wp)
+mps_secular_mnewton_from_sum (mps_context * s, mps_polynomial * p, mps_approximation * root,
+                              mps_secular_msum * sum, mpc_t corr, long int wp)
 {
-  int i;
-  mpc_t ctmp, ctmp2, pol, fp, sumb, x;
+  int i = sum->index;
   rdpe_t apol, acorr, rtmp, epsilon;
   rdpe_t asum, asum_on_apol, ax, axeps;
   mps_secular_equation *sec = MPS_SECULAR_EQUATION (p);
 
-  /* Init MP variables */
-  mpc_init2 (x, wp);
-  mpc_init2 (ctmp, wp);
-  mpc_init2 (ctmp2, wp);
-  mpc_init2 (pol, wp);
-  mpc_init2 (fp, wp);
-  mpc_init2 (sumb, wp);
-
-  mpc_set (x, root->mvalue);
-
-  rdpe_set (asum, rdpe_zero);
+  rdpe_set (asum, sum->asum);
   mpc_rmod (ax, root->mvalue);
 
   /* Setup a reasonable epsilon to use for the checks such as |corr| < |x| * eps */
@@ -564,25 +419,12 @@ mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
   /* First set again to true */
   root->again = true;
 
-  mpc_set_ui (pol, 0U, 0U);
-  mpc_set_ui (fp, 0U, 0U);
-  mpc_set_ui (sumb, 0U, 0U);
   mpc_set_ui (corr, 0U, 0U);
 
-  if ((i = mps_secular_mparallel_sum (s, root, MPS_POLYNOMIAL (sec)->degree, sec->ampc,
-                                      sec->bmpc, pol,
-                                      fp, sumb, asum)) >= 0)
+  if (i >= 0)
     {
       int k;
 
-      /* Note: If we are using a limited precision polynomial mparallel sum will have computed
-       * a biased error because it will assume that the machine epsilon is 2^{- mpc_get_prec (x)}.
-       * In that case we have to correct the estimate. */
-      if (p->prec > 0 && p->prec < mpc_get_prec (pol))
-        {
-          rdpe_mul_eq_d (asum, 1 << (mpc_get_prec (pol) - wp));
-        }
-
       rdpe_set (asum, rdpe_zero);
       mpc_set_ui (corr, 0U, 0U);
 
@@ -590,15 +432,13 @@ mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
         {
           if (i != k)
             {
-              rdpe_t rtmp;
-
-              mpc_sub (ctmp, bmpc[i], bmpc[k]);
-              mpc_add (ctmp2, ampc[i], ampc[k]);
-              mpc_inv_eq (ctmp);
-              mpc_mul_eq (ctmp2, ctmp);
-              mpc_add_eq (corr, ctmp2);
+              mpc_sub (sum->t1, bmpc[i], bmpc[k]);
+              mpc_add (sum->t2, ampc[i], ampc[k]);
+              mpc_inv_eq (sum->t1);
+              mpc_mul_eq (sum->t2, sum->t1);
+              mpc_add_eq (corr, sum->t2);
 
-              mpc_rmod (rtmp, ctmp2);
+              mpc_rmod (rtmp, sum->t2);
               rdpe_add_eq (asum, rtmp);
             }
         }
@@ -618,27 +458,27 @@ mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
       else
         root->again = false;
 
-      goto mnewton_cleanup;
+      return;
     }
 
   /* Compute secular function */
-  mpc_sub_eq_ui (pol, 1U, 0U);
+  mpc_sub_eq_ui (sum->pol, 1U, 0U);
   rdpe_add_eq (asum, rdpe_one);
 
   /* Compute the module of pol */
-  mpc_rmod (apol, pol);
+  mpc_rmod (apol, sum->pol);
 
   /* Compute newton correction */
-  mpc_mul (corr, pol, sumb);
-  mpc_add_eq (corr, fp);
+  mpc_mul (corr, sum->pol, sum->sumb);
+  mpc_add_eq (corr, sum->fp);
   if (mpc_eq_zero (corr))
     {
-      mpc_set (corr, pol);
+      mpc_set (corr, sum->pol);
       root->again = false;
-      goto mnewton_cleanup;
+      return;
     }
   else
-    mpc_div (corr, pol, corr);
+    mpc_div (corr, sum->pol, corr);
 
   rdpe_div (asum_on_apol, asum, apol);
   mpc_rmod (acorr, corr);
@@ -677,13 +517,4 @@ mps_secular_mnewton (mps_context * s, mps_polynomial * p, mps_approximation * ro
       if (rdpe_lt (new_rad, root->drad))
         rdpe_set (root->drad, new_rad);
     }
-
-mnewton_cleanup:
-
-  mpc_clear (ctmp);
-  mpc_clear (ctmp2);
-  mpc_clear (pol);
-  mpc_clear (fp);
-  mpc_clear (sumb);
-  mpc_clear (x);
 }
@@ -84,6 +84,9 @@ mps_allocate_data (mps_context * s)
   for (i = 0; i < s->n; i++)
     s->root[i]->wp = DBL_DIG * LOG2_10;
 
+  /* Memory used by the iteration packets */
+  s->workspace = mps_thread_workspace_new (s);
+
   /* Init the mutex that need it */
   pthread_mutex_init (&s->precision_mutex, NULL);
 
@@ -279,4 +282,7 @@ mps_free_data (mps_context * s)
   rdpe_vfree (s->dap1);
   cdpe_vfree (s->dpc1);
   cdpe_vfree (s->dpc2);
+
+  mps_thread_workspace_free (s, s->workspace);
+  s->workspace = NULL;
 }
@@ -0,0 +1,449 @@
+/*
+ * This file is part of MPSolve 3.1.8
+ *
+ * Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+ * License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+ *
+ * Authors:
+ *   Leonardo Robol <leonardo.robol@sns.it>
+ */
+
+#include <mps/mps.h>
+#include <string.h>
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifdef HAVE_MPI
+#include <mpi.h>
+
+/*! @cond PRIVATE */
+struct mps_distributed_buffer {
+  char * data;
+  size_t size;
+  size_t alloc;
+};
+/*! @endcond */
+
+static void
+mps_distributed_write (struct mps_distributed_buffer * b, const void * ptr, size_t size)
+{
+  if (b->size + size > b->alloc)
+    {
+      b->alloc = MAX (2 * b->alloc, b->size + size);
+      b->data = mps_realloc (b->data, b->alloc);
+    }
+
+  memcpy (b->data + b->size, ptr, size);
+  b->size += size;
+}
+
+static const char *
+mps_distributed_read (const char * p, void * ptr, size_t size)
+{
+  memcpy (ptr, p, size);
+  return p + size;
+}
+
+/**
+ * @brief Write the raw representation of a floating point number, in the
+ * same way as in the checkpoints. All the processes run on the same
+ * architecture, so no conversion is needed.
+ */
+static void
+mps_distributed_write_mpc (struct mps_distributed_buffer * b, mpc_t x)
+{
+  int k;
+
+  for (k = 0; k < 2; k++)
+    {
+      mpf_ptr f = (k == 0) ? mpc_Re (x) : mpc_Im (x);
+      long int prec = mpf_get_prec (f);
+      int size = f->_mp_size;
+      long int exp = f->_mp_exp;
+
+      mps_distributed_write (b, &prec, sizeof(long int));
+      mps_distributed_write (b, &size, sizeof(int));
+      mps_distributed_write (b, &exp, sizeof(long int));
+      mps_distributed_write (b, f->_mp_d, sizeof(mp_limb_t) * ((size < 0) ? -size : size));
+    }
+}
+
+static const char *
+mps_distributed_read_mpc (const char * p, mpc_t x)
+{
+  int k;
+
+  for (k = 0; k < 2; k++)
+    {
+      mpf_ptr f = (k == 0) ? mpc_Re (x) : mpc_Im (x);
+      long int prec, exp;
+      int size;
+
+      p = mps_distributed_read (p, &prec, sizeof(long int));
+      p = mps_distributed_read (p, &size, sizeof(int));
+      p = mps_distributed_read (p, &exp, sizeof(long int));
+
+      if (mpf_get_prec (f) != prec)
+        mpf_set_prec (f, prec);
+
+      p = mps_distributed_read (p, f->_mp_d, sizeof(mp_limb_t) * ((size < 0) ? -size : size));
+      f->_mp_size = size;
+      f->_mp_exp = exp;
+    }
+
+  return p;
+}
+
+/**
+ * @brief Share the content of the buffers of all the processes.
+ *
+ * @return A newly allocated vector with the concatenation of the buffers,
+ * ordered by rank. The offset and the length of the buffer of each process
+ * are stored in <code>displs</code> and <code>counts</code>, that must be
+ * vectors of <code>s->distributed_size</code> integers.
+ */
+static char *
+mps_distributed_allgather (mps_context * s, struct mps_distributed_buffer * b,
+                           int * counts, int * displs)
+{
+  int count = b->size;
+  int total = 0;
+  int r;
+  char * data;
+
+  MPI_Allgather (&count, 1, MPI_INT, counts, 1, MPI_INT, MPI_COMM_WORLD);
+
+  for (r = 0; r < s->distributed_size; r++)
+    {
+      displs[r] = total;
+      total += counts[r];
+    }
+
+  data = mps_newv (char, MAX (total, 1));
+  MPI_Allgatherv (b->data, count, MPI_BYTE, data, counts, displs, MPI_BYTE, MPI_COMM_WORLD);
+
+  return data;
+}
+
+/**
+ * @brief Indices of the first approximation owned by the process of rank
+ * <code>r</code> and of the first one following its slice.
+ */
+static void
+mps_distributed_slice (mps_context * s, int r, int * first, int * last)
+{
+  long int n = s->n, size = s->distributed_size;
+
+  *first = (r * n + size - 1) / size;
+  *last = ((r + 1) * n + size - 1) / size;
+}
+#endif /* HAVE_MPI */
+
+/**
+ * @brief Read the rank of this process and the number of processes in the
+ * MPI job, that must be already initialized.
+ *
+ * @return true if the context can be distributed, false otherwise. In the
+ * latter case an error is set in the context.
+ */
+mps_boolean
+mps_distributed_setup (mps_context * s)
+{
+#ifdef HAVE_MPI
+  int initialized = 0;
+
+  MPI_Initialized (&initialized);
+  if (!initialized)
+    {
+      mps_error (s, "MPI must be initialized before distributing the computation");
+      return false;
+    }
+
+  MPI_Comm_rank (MPI_COMM_WORLD, &s->distributed_rank);
+  MPI_Comm_size (MPI_COMM_WORLD, &s->distributed_size);
+
+  MPS_DEBUG_WITH_INFO (s, "Process %d of %d in the distributed computation",
+                       s->distributed_rank, s->distributed_size);
+
+  return true;
+#else
+  mps_error (s, "This version of MPSolve has been built without MPI support");
+  return false;
+#endif
+}
+
+/**
+ * @brief Number of approximations that still need to be iterated, but are
+ * owned by the other processes.
+ *
+ * The iteration packets count them as already computed, so that they
+ * terminate as soon as the approximations owned by this process are done.
+ */
+int
+mps_distributed_count_foreign_roots (mps_context * s)
+{
+  int i, count = 0;
+
+  if (!s->distributed)
+    return 0;
+
+  for (i = 0; i < s->n; i++)
+    if (!MPS_DISTRIBUTED_OWNS (s, i) && s->root[i]->again && !s->root[i]->approximated)
+      count++;
+
+  return count;
+}
+
+/**
+ * @brief Send the approximations owned by this process to all the others,
+ * and receive theirs.
+ *
+ * The multiprecision values are exchanged only if <code>s->lastphase</code>
+ * is <code>mp_phase</code>, since they are not used in the other phases.
+ */
+void
+mps_distributed_gather_roots (mps_context * s)
+{
+#ifdef HAVE_MPI
+  struct mps_distributed_buffer b = { NULL, 0, 0 };
+  mps_boolean mp = (s->lastphase == mp_phase);
+  int * counts, * displs;
+  const char * p, * end;
+  char * data;
+  int i, r;
+
+  if (!s->distributed)
+    return;
+
+  for (i = 0; i < s->n; i++)
+    {
+      mps_approximation * appr = s->root[i];
+
+      if (!MPS_DISTRIBUTED_OWNS (s, i))
+        continue;
+
+      mps_distributed_write (&b, &i, sizeof(int));
+      mps_distributed_write (&b, appr->fvalue, sizeof(cplx_t));
+      mps_distributed_write (&b, &appr->frad, sizeof(double));
+      mps_distributed_write (&b, appr->dvalue, sizeof(cdpe_t));
+      mps_distributed_write (&b, appr->drad, sizeof(rdpe_t));
+      mps_distributed_write (&b, &appr->approximated, sizeof(mps_boolean));
+      mps_distributed_write (&b, &appr->again, sizeof(mps_boolean));
+      mps_distributed_write (&b, &appr->wp, sizeof(long int));
+      mps_distributed_write (&b, &appr->status, sizeof(mps_root_status));
+      mps_distributed_write (&b, &appr->attrs, sizeof(mps_root_attrs));
+      mps_distributed_write (&b, &appr->inclusion, sizeof(mps_root_inclusion));
+
+      if (mp)
+        mps_distributed_write_mpc (&b, appr->mvalue);
+    }
+
+  counts = mps_newv (int, s->distributed_size);
+  displs = mps_newv (int, s->distributed_size);
+  data = mps_distributed_allgather (s, &b, counts, displs);
+
+  for (r = 0; r < s->distributed_size; r++)
+    {
+      if (r == s->distributed_rank)
+        continue;
+
+      for (p = data + displs[r], end = p + counts[r]; p < end; )
+        {
+          mps_approximation * appr;
+
+          p = mps_distributed_read (p, &i, sizeof(int));
+          appr = s->root[i];
+
+          p = mps_distributed_read (p, appr->fvalue, sizeof(cplx_t));
+          p = mps_distributed_read (p, &appr->frad, sizeof(double));
+          p = mps_distributed_read (p, appr->dvalue, sizeof(cdpe_t));
+          p = mps_distributed_read (p, appr->drad, sizeof(rdpe_t));
+          p = mps_distributed_read (p, &appr->approximated, sizeof(mps_boolean));
+          p = mps_distributed_read (p, &appr->again, sizeof(mps_boolean));
+          p = mps_distributed_read (p, &appr->wp, sizeof(long int));
+          p = mps_distributed_read (p, &appr->status, sizeof(mps_root_status));
+          p = mps_distributed_read (p, &appr->attrs, sizeof(mps_root_attrs));
+          p = mps_distributed_read (p, &appr->inclusion, sizeof(mps_root_inclusion));
+
+          if (mp)
+            p = mps_distributed_read_mpc (p, appr->mvalue);
+        }
+    }
+
+  free (data);
+  free (displs);
+  free (counts);
+  free (b.data);
+#endif
+}
+
+/**
+ * @brief Bring all the processes to the same state at the end of a packet
+ * of iterations.
+ *
+ * The approximations are exchanged, the number of iterations is summed over
+ * all the processes, and the exception flag is raised if it has been raised
+ * on any of them. The number of computed roots is recomputed on the
+ * gathered approximations.
+ *
+ * @param s The mps_context of the computation.
+ * @param nit The number of iterations performed by this process.
+ * @param excep The exception flag of this process, or NULL.
+ * @param computed_roots The number of roots that reached a stop condition, or NULL.
+ */
+void
+mps_distributed_gather_packet (mps_context * s, int * nit, mps_boolean * excep,
+                               int * computed_roots)
+{
+#ifdef HAVE_MPI
+  int i, local_nit = *nit;
+
+  if (!s->distributed)
+    return;
+
+  mps_distributed_gather_roots (s);
+
+  MPI_Allreduce (&local_nit, nit, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  if (excep)
+    *excep = mps_distributed_any (s, *excep);
+
+  if (computed_roots)
+    {
+      *computed_roots = 0;
+      for (i = 0; i < s->n; i++)
+        if (!s->root[i]->again || s->root[i]->approximated)
+          (*computed_roots)++;
+    }
+#endif
+}
+
+/**
+ * @brief Collect a vector of CDPE values whose components have been
+ * computed by the processes owning them.
+ */
+void
+mps_distributed_gather_cdpe (mps_context * s, cdpe_t * v)
+{
+#ifdef HAVE_MPI
+  int * counts, * displs;
+  int r, first, last;
+
+  if (!s->distributed)
+    return;
+
+  counts = mps_newv (int, s->distributed_size);
+  displs = mps_newv (int, s->distributed_size);
+
+  for (r = 0; r < s->distributed_size; r++)
+    {
+      mps_distributed_slice (s, r, &first, &last);
+      displs[r] = first * sizeof(cdpe_t);
+      counts[r] = (last - first) * sizeof(cdpe_t);
+    }
+
+  MPI_Allgatherv (MPI_IN_PLACE, 0, MPI_BYTE, v, counts, displs, MPI_BYTE, MPI_COMM_WORLD);
+
+  free (displs);
+  free (counts);
+#endif
+}
+
+/**
+ * @brief Collect the coefficients \f$a_i\f$ of the secular equation
+ * regenerated in multiprecision by the processes owning the nodes
+ * \f$b_i\f$, together with the working precision selected for them.
+ */
+void
+mps_distributed_gather_coefficients (mps_context * s)
+{
+#ifdef HAVE_MPI
+  struct mps_distributed_buffer b = { NULL, 0, 0 };
+  mps_secular_equation * sec = s->secular_equation;
+  int * counts, * displs;
+  const char * p, * end;
+  char * data;
+  long int wp;
+  int i, r;
+
+  if (!s->distributed)
+    return;
+
+  for (i = 0; i < s->n; i++)
+    {
+      if (!MPS_DISTRIBUTED_OWNS (s, i))
+        continue;
+
+      mps_distributed_write (&b, &i, sizeof(int));
+      mps_distributed_write (&b, &s->root[i]->wp, sizeof(long int));
+      mps_distributed_write_mpc (&b, sec->ampc[i]);
+    }
+
+  counts = mps_newv (int, s->distributed_size);
+  displs = mps_newv (int, s->distributed_size);
+  data = mps_distributed_allgather (s, &b, counts, displs);
+
+  for (r = 0; r < s->distributed_size; r++)
+    {
+      if (r == s->distributed_rank)
+        continue;
+
+      for (p = data + displs[r], end = p + counts[r]; p < end; )
+        {
+          p = mps_distributed_read (p, &i, sizeof(int));
+          p = mps_distributed_read (p, &wp, sizeof(long int));
+
+          /* Raise the precision of the data as the owner did */
+          if (wp != s->root[i]->wp)
+            mps_secular_ga_update_root_wp (s, i, wp, sec->bmpc);
+
+          p = mps_distributed_read_mpc (p, sec->ampc[i]);
+        }
+    }
+
+  free (data);
+  free (displs);
+  free (counts);
+  free (b.data);
+#endif
+}
+
+/**
+ * @brief True if <code>value</code> is true on any of the processes.
+ */
+mps_boolean
+mps_distributed_any (mps_context * s, mps_boolean value)
+{
+#ifdef HAVE_MPI
+  int local = value, global;
+
+  if (s->distributed)
+    {
+      MPI_Allreduce (&local, &global, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+      return global;
+    }
+#endif
+
+  return value;
+}
+
+/**
+ * @brief True if <code>value</code> is true on all the processes.
+ */
+mps_boolean
+mps_distributed_all (mps_context * s, mps_boolean value)
+{
+#ifdef HAVE_MPI
+  int local = value, global;
+
+  if (s->distributed)
+    {
+      MPI_Allreduce (&local, &global, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+      return global;
+    }
+#endif
+
+  return value;
+}
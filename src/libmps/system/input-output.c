@@ -622,21 +622,28 @@ int snprintf (char *str, size_t size, const char *format, ...);
 void
 mps_error (mps_context * s, const char * format, ...)
 {
-  va_list ap;
+  va_list ap, aq;
   int buffer_size = 32;
   int missing_characters = 0;
 
   va_start (ap, format);
 
   s->error_state = true;
-  if (s->last_error == NULL)
-    s->last_error = mps_newv (char, buffer_size);
+  s->last_error = mps_realloc (s->last_error, buffer_size);
 
   /* Measure space needed for the string, if our initial guess for the space neede
-   * is not enough */
-  while ((missing_characters = vsnprintf (s->last_error, buffer_size, format, ap)) > buffer_size)
+   * is not enough. The argument list needs to be copied since it cannot be
+   * traversed twice. */
+  while (true)
     {
-      buffer_size += missing_characters + 1;
+      va_copy (aq, ap);
+      missing_characters = vsnprintf (s->last_error, buffer_size, format, aq);
+      va_end (aq);
+
+      if (missing_characters < buffer_size)
+        break;
+
+      buffer_size = missing_characters + 1;
       s->last_error = mps_realloc (s->last_error, buffer_size);
     }
 
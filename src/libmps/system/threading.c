@@ -10,11 +10,14 @@
  *   Leonardo Robol <leonardo.robol@sns.it>
  */
 
+#define _GNU_SOURCE
 
 #include <float.h>
 #include <mps/mps.h>
 #include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #ifdef HAVE_CONFIG_H
 #include <config.h>
@@ -24,6 +27,10 @@
 #include <unistd.h>
 #endif
 
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+#include <sched.h>
+#endif
+
 #ifdef __WINDOWS
 #include <windows.h>
 #endif
@@ -92,6 +99,175 @@ mps_thread_get_core_number (mps_context * s)
   return cores;
 }
 
+/**
+ * @brief Position of a logical CPU in the topology of the machine.
+ */
+struct mps_thread_cpu_info {
+  int cpu;
+  int package;
+  int core;
+  int sibling;
+};
+
+/**
+ * @brief Read an integer value describing a logical CPU from sysfs,
+ * or return <code>fallback</code> if it is not available.
+ */
+static int
+mps_thread_read_cpu_value (int cpu, const char * name, int fallback)
+{
+  char path[128];
+  FILE * f;
+  int value;
+
+  snprintf (path, sizeof(path), "/sys/devices/system/cpu/cpu%d/%s", cpu, name);
+
+  if ((f = fopen (path, "r")) == NULL)
+    return fallback;
+
+  if (fscanf (f, "%d", &value) != 1)
+    value = fallback;
+
+  fclose (f);
+  return value;
+}
+
+/**
+ * @brief Order used by MPS_THREAD_AFFINITY_COMPACT: fill the hyperthreads
+ * of a core, then the cores of a socket, then move to the next socket.
+ */
+static int
+mps_thread_cpu_compact_cmp (const void * a, const void * b)
+{
+  const struct mps_thread_cpu_info * x = a, * y = b;
+
+  if (x->package != y->package)
+    return x->package - y->package;
+  if (x->core != y->core)
+    return x->core - y->core;
+  if (x->sibling != y->sibling)
+    return x->sibling - y->sibling;
+
+  return x->cpu - y->cpu;
+}
+
+/**
+ * @brief Order used by MPS_THREAD_AFFINITY_SCATTER: use a single hyperthread
+ * per physical core, alternating the sockets, and only then the
+ * siblings.
+ */
+static int
+mps_thread_cpu_scatter_cmp (const void * a, const void * b)
+{
+  const struct mps_thread_cpu_info * x = a, * y = b;
+
+  if (x->sibling != y->sibling)
+    return x->sibling - y->sibling;
+  if (x->core != y->core)
+    return x->core - y->core;
+  if (x->package != y->package)
+    return x->package - y->package;
+
+  return x->cpu - y->cpu;
+}
+
+/**
+ * @brief Compute the order in which the threads are pinned on the online
+ * cores of the machine for the given affinity policy.
+ *
+ * The topology is read from sysfs; if it is not available every logical
+ * CPU is considered a distinct core of the same socket.
+ *
+ * @return The number of cores written in the newly allocated vector
+ * <code>*cores</code>.
+ */
+static int
+mps_thread_affinity_core_order (mps_context * s, mps_thread_affinity affinity,
+                                int n_cpus, int ** cores)
+{
+  struct mps_thread_cpu_info * info = mps_newv (struct mps_thread_cpu_info, n_cpus);
+  int i, j, n = 0;
+
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+  /* Only consider the cores where the process is allowed to run */
+  cpu_set_t allowed;
+  mps_boolean has_allowed = (sched_getaffinity (0, sizeof(cpu_set_t), &allowed) == 0);
+#endif
+
+  for (i = 0; i < n_cpus; i++)
+    {
+      if (!mps_thread_read_cpu_value (i, "online", 1))
+        continue;
+
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+      if (has_allowed && (i >= CPU_SETSIZE || !CPU_ISSET (i, &allowed)))
+        continue;
+#endif
+
+      info[n].cpu = i;
+      info[n].package = mps_thread_read_cpu_value (i, "topology/physical_package_id", 0);
+      info[n].core = mps_thread_read_cpu_value (i, "topology/core_id", i);
+      info[n].sibling = 0;
+
+      for (j = 0; j < n; j++)
+        if (info[j].package == info[n].package && info[j].core == info[n].core)
+          info[n].sibling++;
+
+      n++;
+    }
+
+  qsort (info, n, sizeof(struct mps_thread_cpu_info),
+         (affinity == MPS_THREAD_AFFINITY_SCATTER) ?
+         mps_thread_cpu_scatter_cmp : mps_thread_cpu_compact_cmp);
+
+  *cores = mps_newv (int, MAX (n, 1));
+  for (i = 0; i < n; i++)
+    (*cores)[i] = info[i].cpu;
+
+  free (info);
+  return n;
+}
+
+/**
+ * @brief Pin a thread on the core selected for it by the affinity
+ * policy of its pool, or let it run on any core if the pool has no
+ * affinity set.
+ */
+static void
+mps_thread_pin (mps_context * s, mps_thread_pool * pool, mps_thread * thread)
+{
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+  cpu_set_t set;
+  int core = -1;
+  int i;
+
+  if (pool->n_cores > 0)
+    core = pool->cores[thread->id % pool->n_cores];
+
+  if (core == thread->core)
+    return;
+
+  CPU_ZERO (&set);
+  if (core < 0)
+    {
+      for (i = 0; i < CPU_SETSIZE; i++)
+        CPU_SET (i, &set);
+    }
+  else if (core < CPU_SETSIZE)
+    CPU_SET (core, &set);
+
+  if (core >= CPU_SETSIZE ||
+      pthread_setaffinity_np (*thread->thread, sizeof(cpu_set_t), &set) != 0)
+    {
+      mps_warn (s, "Cannot pin thread %d on core %d", thread->id, core);
+      return;
+    }
+
+  thread->core = core;
+  MPS_DEBUG_WITH_INFO (s, "Thread %d pinned on core %d", thread->id, core);
+#endif
+}
+
 
 /**
  * @brief Create a new mps_thread_job_queue that can
@@ -108,12 +284,25 @@ mps_thread_job_queue_new (mps_context * s)
   pthread_mutex_init (&q->mutex, NULL);
 
   /* Set initial data */
+  mps_thread_job_queue_reset (s, q);
+  return q;
+}
+
+/**
+ * @brief Bring a mps_thread_job_queue back to its initial state,
+ * so that it can be used for a new packet of iterations.
+ */
+void
+mps_thread_job_queue_reset (mps_context * s, mps_thread_job_queue * q)
+{
   q->iter = 0;
   q->n_roots = s->n;
   q->max_iter = s->max_it;
   q->cluster_item = s->clusterization->first;
   q->root = q->cluster_item->cluster->first;
-  return q;
+  q->schedule = NULL;
+  q->n_scheduled = 0;
+  q->position = 0;
 }
 
 /*
@@ -127,6 +316,118 @@ mps_thread_job_queue_free (mps_thread_job_queue * q)
   free (q);
 }
 
+/**
+ * @brief Allocate a new mps_thread_workspace sized on the current
+ * number of roots and threads of the context.
+ */
+mps_thread_workspace *
+mps_thread_workspace_new (mps_context * s)
+{
+  mps_thread_workspace * w = mps_new (mps_thread_workspace);
+  int i;
+
+  w->n = s->n;
+  w->n_threads = MAX (s->n_threads, 1);
+
+  w->aberth_mutex = mps_newv (pthread_mutex_t, w->n);
+  w->roots_mutex = mps_newv (pthread_mutex_t, w->n);
+  for (i = 0; i < w->n; i++)
+    {
+      pthread_mutex_init (&w->aberth_mutex[i], NULL);
+      pthread_mutex_init (&w->roots_mutex[i], NULL);
+    }
+
+  pthread_mutex_init (&w->gs_mutex, NULL);
+  pthread_mutex_init (&w->global_aberth_mutex, NULL);
+  pthread_mutex_init (&w->queue.mutex, NULL);
+
+  w->data = mps_newv (mps_thread_worker_data, w->n_threads);
+
+  w->jacobi_data = mps_newv (mps_jacobi_aberth_step_data, w->n);
+  w->fcorrections = cplx_valloc (w->n);
+  w->dcorrections = cdpe_valloc (w->n);
+  w->mcorrections = mpc_valloc (w->n);
+  w->mcorrections_prec = 0;
+  mpc_vinit2 (w->mcorrections, w->n, 0);
+
+  w->fsnapshot = cplx_valloc (w->n);
+  w->dsnapshot = cdpe_valloc (w->n);
+  w->msnapshot = mpc_valloc (w->n);
+  w->msnapshot_prec = 0;
+  mpc_vinit2 (w->msnapshot, w->n, 0);
+
+  w->frozen = mps_frozen_roots_new (w->n);
+
+  return w;
+}
+
+/**
+ * @brief Free a mps_thread_workspace allocated with
+ * mps_thread_workspace_new ().
+ */
+void
+mps_thread_workspace_free (mps_context * s, mps_thread_workspace * w)
+{
+  int i;
+
+  if (!w)
+    return;
+
+  for (i = 0; i < w->n; i++)
+    {
+      pthread_mutex_destroy (&w->aberth_mutex[i]);
+      pthread_mutex_destroy (&w->roots_mutex[i]);
+    }
+
+  pthread_mutex_destroy (&w->gs_mutex);
+  pthread_mutex_destroy (&w->global_aberth_mutex);
+  pthread_mutex_destroy (&w->queue.mutex);
+
+  free (w->aberth_mutex);
+  free (w->roots_mutex);
+  free (w->data);
+  free (w->jacobi_data);
+
+  cplx_vfree (w->fcorrections);
+  cdpe_vfree (w->dcorrections);
+  mpc_vclear (w->mcorrections, w->n);
+  mpc_vfree (w->mcorrections);
+
+  cplx_vfree (w->fsnapshot);
+  cdpe_vfree (w->dsnapshot);
+  mpc_vclear (w->msnapshot, w->n);
+  mpc_vfree (w->msnapshot);
+
+  mps_frozen_roots_free (w->frozen);
+
+  free (w);
+}
+
+/**
+ * @brief Get the workspace of the context, ready to be used for a new
+ * packet of iterations.
+ *
+ * The workspace is reallocated only if the number of roots or threads
+ * has grown since its allocation, so that in the common case starting
+ * a packet does not require any memory allocation. The job queue
+ * embedded in the workspace is reset.
+ */
+mps_thread_workspace *
+mps_thread_workspace_get (mps_context * s)
+{
+  mps_thread_workspace * w = s->workspace;
+
+  if (w == NULL || w->n < s->n || w->n_threads < s->n_threads)
+    {
+      mps_thread_workspace_free (s, w);
+      w = s->workspace = mps_thread_workspace_new (s);
+    }
+
+  mps_thread_job_queue_reset (s, &w->queue);
+
+  return w;
+}
+
 /**
  * @brief Obtain iter and i for the next available job.
  */
@@ -144,6 +445,25 @@ mps_thread_job_queue_next (mps_context * s, mps_thread_job_queue * q)
     {
       j.iter = MPS_THREAD_JOB_EXCEP;
     }
+  else if (q->schedule)
+    {
+      /* Only the scheduled roots are handed out: a sweep is complete
+       * when all of them have been assigned once. */
+      j.i = q->schedule[q->position++];
+      j.iter = q->iter;
+
+      if (q->position == q->n_scheduled)
+        {
+          q->position = 0;
+          q->iter++;
+
+          if (j.iter == q->max_iter)
+            {
+              j.iter = MPS_THREAD_JOB_EXCEP;
+              q->iter = MPS_THREAD_JOB_EXCEP;
+            }
+        }
+    }
   else
     {
       /* Assigning the root */
@@ -374,6 +694,8 @@ mps_thread_new (mps_context * s, mps_thread_pool * pool)
   thread->alive = true;
   thread->pool = pool;
   thread->busy = false;
+  thread->id = pool->n;
+  thread->core = -1;
 
   /* Start the thread mainloop */
   mps_thread_start_mainloop (s, thread);
@@ -417,6 +739,9 @@ mps_thread_pool_insert_new_thread (mps_context * s, mps_thread_pool * pool)
   thread->next = pool->first;
   pool->first = thread;
   pool->n++;
+
+  if (pool->affinity != MPS_THREAD_AFFINITY_NONE)
+    mps_thread_pin (s, pool, thread);
 }
 
 /**
@@ -450,6 +775,68 @@ mps_thread_pool_set_strict_async (mps_thread_pool * pool, mps_boolean strict_asy
   pool->strict_async = strict_async;
 }
 
+/**
+ * @brief Select how the threads of the pool are pinned to the cores of
+ * the machine.
+ *
+ * With MPS_THREAD_AFFINITY_COMPACT and MPS_THREAD_AFFINITY_SCATTER the
+ * order of the cores is determined from the topology of the machine,
+ * while MPS_THREAD_AFFINITY_LIST uses the <code>n_cores</code> cores in
+ * <code>cores</code>, which are ignored by the other policies. In every
+ * case the i-th thread of the pool is pinned on the core in position
+ * <code>i % n_cores</code>, and the threads spawned later inherit the
+ * same policy. MPS_THREAD_AFFINITY_NONE removes any previous pinning.
+ *
+ * Pinning is silently not performed on systems where it is not supported.
+ */
+void
+mps_thread_pool_set_affinity (mps_context * s, mps_thread_pool * pool,
+                              mps_thread_affinity affinity, const int * cores, int n_cores)
+{
+  mps_thread * thread;
+  int n_cpus = pool ? pool->n : s->pool->n;
+
+  if (!pool)
+    pool = s->pool;
+
+  free (pool->cores);
+  pool->cores = NULL;
+  pool->n_cores = 0;
+  pool->affinity = MPS_THREAD_AFFINITY_NONE;
+
+#ifdef HAVE_SYSCONF
+  n_cpus = MAX (n_cpus, sysconf (_SC_NPROCESSORS_CONF));
+#endif
+
+  switch (affinity)
+    {
+    case MPS_THREAD_AFFINITY_LIST:
+      if (cores == NULL || n_cores <= 0)
+        {
+          mps_error (s, "An explicit list of cores is required to pin the threads");
+          return;
+        }
+
+      pool->cores = mps_newv (int, n_cores);
+      memcpy (pool->cores, cores, sizeof(int) * n_cores);
+      pool->n_cores = n_cores;
+      break;
+
+    case MPS_THREAD_AFFINITY_COMPACT:
+    case MPS_THREAD_AFFINITY_SCATTER:
+      pool->n_cores = mps_thread_affinity_core_order (s, affinity, n_cpus, &pool->cores);
+      break;
+
+    default:
+      break;
+    }
+
+  pool->affinity = affinity;
+
+  for (thread = pool->first; thread != NULL; thread = thread->next)
+    mps_thread_pin (s, pool, thread);
+}
+
 /**
  * @brief Allocate a new thread pool and return a pointer to it,
  * with a number of threads suitable for this system.
@@ -479,6 +866,10 @@ mps_thread_pool_new (mps_context * s, int n_threads)
   pool->busy_counter = 0;
   pool->strict_async = false;
 
+  pool->affinity = MPS_THREAD_AFFINITY_NONE;
+  pool->cores = NULL;
+  pool->n_cores = 0;
+
   for (i = 0; i < threads; i++)
     mps_thread_pool_insert_new_thread (s, pool);
 
@@ -512,6 +903,7 @@ mps_thread_pool_free (mps_context * s, mps_thread_pool * pool)
     }
 
   free (pool->queue);
+  free (pool->cores);
   free (pool);
 }
 
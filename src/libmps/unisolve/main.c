@@ -106,6 +106,7 @@ mps_standard_mpsolve (mps_context * s)
         fprintf (s->logstr, "Float phase ...\n");
       mps_fsolve (s, &d_after_f);
       s->lastphase = float_phase;
+      mps_events_packet (s);
 
       if (s->DOLOG)
         mps_dump (s);
@@ -131,6 +132,7 @@ mps_standard_mpsolve (mps_context * s)
           }
       s->lastphase = dpe_phase;
       mps_dsolve (s, d_after_f);
+      mps_events_packet (s);
 
       if (s->DOLOG)
         mps_dump (s);
@@ -205,6 +207,7 @@ mps_standard_mpsolve (mps_context * s)
         fprintf (s->logstr, "MAIN: now call msolve nclust=%ld\n", s->clusterization->n);
       mps_msolve (s);
       s->lastphase = mp_phase;
+      mps_events_packet (s);
 
       /* if (s->DOLOG) dump(logstr); */
 
@@ -17,9 +17,13 @@
 #endif
 
 #if HAVE_GRAPHICAL_DEBUGGER
-#define MPSOLVE_GETOPT_STRING "a:G:D:d::xt:o:O:j:S:O:i:vl:bp:rs:c"
+#define MPSOLVE_GETOPT_STRING "a:G:D:d::xt:o:O:j:S:O:i:vl:bp:rs:ck:K:meBA:fy"
 #else
-#define MPSOLVE_GETOPT_STRING "a:G:D:d::t:o:O:j:S:O:i:vl:bp:rs:c"
+#define MPSOLVE_GETOPT_STRING "a:G:D:d::t:o:O:j:S:O:i:vl:bp:rs:ck:K:meBA:fy"
+#endif
+
+#ifdef HAVE_MPI
+#include <mpi.h>
 #endif
 
 #if HAVE_GRAPHICAL_DEBUGGER
@@ -113,8 +117,8 @@ void
 usage (mps_context * s, const char *program)
 {
   fprintf (stdout,
-           "%s [-a alg] [-b] -c [-G goal] [-o digits] [-i digits] [-j n] [-t type] [-S set] \n"
-"  [-D detect] [-O format] [-l] [-r] [filename | -p poly] "
+           "%s [-a alg] [-b] [-B] -c [-f] [-G goal] [-o digits] [-i digits] [-j n[:aff]] [-t type] [-S set] \n"
+"  [-D detect] [-O format] [-l] [-r] [-e] [-k file] [-K file] [-m] [-A file] [filename | -p poly] "
 #if HAVE_GRAPHICAL_DEBUGGER
           "[-x] "           
 #endif
@@ -125,15 +129,28 @@ usage (mps_context * s, const char *program)
            "              u: Classic unisolve algorithm (Aberth iterations and dynamic precision)\n"
            "              s: Secular algorithm, using regeneration of increasingly better-conditioned\n"
            "                 secular equations with the same roots of the polynomial\n"
+           "              a: Choose the algorithm and its tuning from the features of the input\n"
+           "                 (this is the default)\n"
+           " -A file     Read the thresholds used by -aa from a calibration file\n"
            " -b          Perform Aberth iterations in Jacobi-style instead of Gauss-Seidel\n"
+           " -B          Perform Aberth iterations in block Gauss-Seidel style, with results\n"
+           "             that do not depend on the number of threads\n"
 	   " -c          Enable crude approximation mode. Fast but not always effective\n"
+           " -f          Split polynomials with exact real coefficients in square-free\n"
+           "             factors, and solve them separately\n"
+           " -y          Solve polynomials with exact coefficients in x^k, or palindromic,\n"
+           "             through a polynomial of lower degree\n"
            " -G goal     Select the goal to reach. Possible values are:\n"
            "              a: Approximate the roots\n"
            "              i: Isolate the roots\n"
            "              c: Count the roots in the search set\n"
            " -o digits   Number of guaranteed digits of the roots\n"
            " -i digits   Digits of precision of the input coefficients\n"
-           " -j n        Number of threads to spawn as workers\n"
+           " -j n[:aff]  Number of threads to spawn as workers, optionally followed by\n"
+           "             the policy used to pin them to the cores:\n"
+           "               compact: fill the cores of a socket before the next one\n"
+           "               scatter: spread the threads across sockets and cores\n"
+           "               c1,c2,...: pin the threads on the listed cores\n"
            " -t type     Type can be 'f' for floating point or 'd' for DPE\n"
            " -S set      Restrict the search set for the roots \n"
            "             set can be one of:\n"
@@ -181,12 +198,20 @@ usage (mps_context * s, const char *program)
 	   " -p poly     Solve the polynomial specified on the command line. \n"
            "               Example: %s -p \"x^4-6x^9+6/7x + 5\" \n"
 	   " -r          Use a recursive strategy to dispose the initial approximations.\n"
+	   " -e          Use the eigenvalues of the companion matrix as initial approximations.\n"
 	   "             This option is available only for monomial polynomials. \n"
 	   "             Note: this option is considered experimental.\n"
 	   " -s file     Read the starting approximations from the given file, instead\n"
 	   "             of relying on the internal algorithm of MPSolve.\n"
 	   "             The format for this file is the same of the *.res files foun in\n"
 	   "             src/unisolve/*.res in the source distribution of MPSolve.\n"
+	   " -k file     Save the state of the secular algorithm in the given file at the\n"
+	   "             end of every packet of iterations.\n"
+	   " -K file     Resume the secular algorithm from a file saved with -k. The same\n"
+	   "             polynomial must be given as input.\n"
+	   " -m          Distribute the computation among the processes of an MPI job,\n"
+	   "             started for example with mpirun -np 4 mpsolve -m file.pol.\n"
+	   "             The roots are printed by the process of rank 0.\n"
            " -v          Print the version and exit\n"
            "\n",
            program, program, program);
@@ -194,6 +219,18 @@ usage (mps_context * s, const char *program)
   exit (EXIT_FAILURE);
 }
 
+#ifdef HAVE_MPI
+static void
+finalize_mpi (void)
+{
+  int finalized = 0;
+
+  MPI_Finalized (&finalized);
+  if (!finalized)
+    MPI_Finalize ();
+}
+#endif
+
 void*
 cleanup_context (mps_context * ctx, void * user_data)
 {
@@ -204,8 +241,9 @@ cleanup_context (mps_context * ctx, void * user_data)
       return NULL;
     }
 
-  /* Output the roots */
-  mps_output (ctx);
+  /* Output the roots, only once if the computation is distributed */
+  if (ctx->distributed_rank == 0)
+    mps_output (ctx);
 
 #ifdef HAVE_GRAPHICAL_DEBUGGER
   if (logger_closed)
@@ -276,6 +314,10 @@ main (int argc, char **argv)
      otherwise we will be using our own heuristic. */
   mps_boolean explicit_algorithm_selection = false;
 
+  /* Thread pinning policy selected with -j, if any. */
+  char * affinity = NULL;
+  int i;
+
   opt = NULL;
   while ((mps_getopts (&opt, &argc, &argv, MPSOLVE_GETOPT_STRING)))
     {
@@ -305,6 +347,10 @@ main (int argc, char **argv)
 	  mps_context_select_starting_strategy (s, MPS_STARTING_STRATEGY_RECURSIVE);
 	  break;
 
+	case 'e':
+	  mps_context_select_starting_strategy (s, MPS_STARTING_STRATEGY_COMPANION);
+	  break;
+
         case 'O':
           /* Select the desired output format */
           if (!opt->optvalue)
@@ -469,6 +515,9 @@ main (int argc, char **argv)
             case 's':
               mps_context_select_algorithm (s, MPS_ALGORITHM_SECULAR_GA);
               break;
+            case 'a':
+              mps_context_select_algorithm (s, MPS_ALGORITHM_AUTO);
+              break;
             default:
               mps_error (s, "The selected algorithm is not supported");
               break;
@@ -477,9 +526,18 @@ main (int argc, char **argv)
         case 'b':
           mps_context_set_jacobi_iterations (s, true);
           break;
+        case 'B':
+          mps_context_set_block_iterations (s, true);
+          break;
 	case 'c':
 	  mps_context_set_crude_approximation_mode (s, true);
 	  break;
+        case 'f':
+          mps_context_set_square_free (s, true);
+          break;
+        case 'y':
+          mps_context_set_exploit_symmetry (s, true);
+          break;
         case 'o':
           mps_context_set_output_prec (s, (atoi (opt->optvalue)) * LOG2_10 + 1);
           break;
@@ -587,6 +645,18 @@ main (int argc, char **argv)
 	    }
 	  break;
 
+	case 'k':
+	  mps_context_set_checkpoint_file (s, opt->optvalue);
+	  break;
+
+	case 'K':
+	  mps_context_set_resume_file (s, opt->optvalue);
+	  break;
+
+        case 'A':
+          mps_context_set_auto_calibration_file (s, opt->optvalue);
+          break;
+
         case 't':
           switch (opt->optvalue[0])
             {
@@ -601,9 +671,58 @@ main (int argc, char **argv)
             }
           break;
 
+        case 'm':
+#ifdef HAVE_MPI
+          {
+            int provided;
+            MPI_Init_thread (NULL, NULL, MPI_THREAD_FUNNELED, &provided);
+            atexit (finalize_mpi);
+          }
+#endif
+          mps_context_set_distributed (s, true);
+          if (mps_context_has_errors (s))
+            {
+              mps_print_errors (s);
+              return EXIT_FAILURE;
+            }
+          break;
+
         case 'j':
           mps_thread_pool_set_concurrency_limit (s, NULL, atoi (opt->optvalue));
           s->n_threads = atoi (opt->optvalue);
+
+          if ((affinity = strchr (opt->optvalue, ':')) != NULL)
+            {
+              affinity++;
+
+              if (strcmp (affinity, "compact") == 0)
+                mps_context_set_thread_affinity (s, MPS_THREAD_AFFINITY_COMPACT, NULL, 0);
+              else if (strcmp (affinity, "scatter") == 0)
+                mps_context_set_thread_affinity (s, MPS_THREAD_AFFINITY_SCATTER, NULL, 0);
+              else
+                {
+                  int n_cores = 1;
+                  int * cores;
+                  char * p;
+
+                  for (p = affinity; *p != '\0'; p++)
+                    if (*p == ',')
+                      n_cores++;
+
+                  cores = mps_newv (int, n_cores);
+                  for (i = 0, p = affinity; i < n_cores; i++, p++)
+                    {
+                      char * end;
+                      cores[i] = strtol (p, &end, 10);
+                      if (end == p || cores[i] < 0 || (*end != ',' && *end != '\0'))
+                        usage (s, argv[0]);
+                      p = end;
+                    }
+
+                  mps_context_set_thread_affinity (s, MPS_THREAD_AFFINITY_LIST, cores, n_cores);
+                  free (cores);
+                }
+            }
           break;
         default:
           usage (s, argv[0]);
@@ -684,14 +803,10 @@ main (int argc, char **argv)
   if (input_precision >= 0)
     mps_polynomial_set_input_prec (s, poly, input_precision);
 
-  /* Perform some heuristic for the algorithm selection, but only if the user
-   * hasn't explicitely selected one. */
+  /* Let the features of the input drive the choice of the algorithm, but
+   * only if the user hasn't explicitely selected one. */
   if (! explicit_algorithm_selection)
-    {
-      mps_context_select_algorithm (s, (MPS_IS_MONOMIAL_POLY (poly) && 
-					MPS_DENSITY_IS_SPARSE (poly->density)) ? 
-				    MPS_ALGORITHM_STANDARD_MPSOLVE : MPS_ALGORITHM_SECULAR_GA );
-    }
+    mps_context_select_algorithm (s, MPS_ALGORITHM_AUTO);
 
   /* Close the file if it's not stdin */
   if (argc == 2 && ! inline_poly)
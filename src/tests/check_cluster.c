@@ -95,6 +95,67 @@ START_TEST (cluster_isolation)
 }
 END_TEST
 
+/* Verify that the floating point copies of the discs used to speed up
+ * the cluster analysis in the DPE and multiprecision phases give the same
+ * answers as the exact checks. The discs are centered on a grid with unit
+ * spacing, with radii close to 1/2 so that some pairs are very close to
+ * touching, and some of them are scaled out of the range of doubles. */
+START_TEST (cluster_shadow)
+{
+  const int n = 48;
+  mps_context *s = mps_context_new ();
+  mps_monomial_poly *p = mps_monomial_poly_new (s, n);
+  mps_disc_shadow * shadow = mps_newv (mps_disc_shadow, n);
+  rdpe_t * drad = rdpe_valloc (n);
+  int i, j, nf;
+
+  mps_monomial_poly_set_coefficient_int (s, p, n, 1, 0);
+  mps_monomial_poly_set_coefficient_int (s, p, 0, -1, 0);
+
+  mps_context_set_input_poly (s, MPS_POLYNOMIAL (p));
+  mps_allocate_data (s);
+  mps_mp_set_prec (s, 128);
+
+  for (i = 0; i < n; i++)
+    {
+      cdpe_set_d (s->root[i]->dvalue, i % 8, i / 8);
+      rdpe_set_d (drad[i], 0.5 + ((i % 5) - 2) * DBL_EPSILON);
+
+      /* Move some of the discs far away, or shrink them */
+      if (i % 7 == 3)
+        {
+          rdpe_Esp (cdpe_Re (s->root[i]->dvalue)) += 5000;
+          rdpe_Esp (cdpe_Im (s->root[i]->dvalue)) += 5000;
+        }
+      if (i % 11 == 5)
+        rdpe_Esp (drad[i]) -= 5000;
+
+      mpc_set_cdpe (s->root[i]->mvalue, s->root[i]->dvalue);
+    }
+
+  for (nf = 1; nf <= 2; nf++)
+    {
+      mps_dshadow_discs (s, drad, nf, shadow);
+      for (i = 0; i < n; i++)
+        for (j = 0; j < n; j++)
+          fail_unless (mps_dtouchnwt_shadow (s, shadow, drad, nf, i, j) ==
+                       mps_dtouchnwt (s, drad, nf, i, j),
+                       "Wrong DPE check on the discs %d and %d", i, j);
+
+      mps_mshadow_discs (s, drad, nf, shadow);
+      for (i = 0; i < n; i++)
+        for (j = 0; j < n; j++)
+          fail_unless (mps_mtouchnwt_shadow (s, shadow, drad, nf, i, j) ==
+                       mps_mtouchnwt (s, drad, nf, i, j),
+                       "Wrong multiprecision check on the discs %d and %d", i, j);
+    }
+
+  free (shadow);
+  rdpe_vfree (drad);
+  mps_polynomial_free (s, MPS_POLYNOMIAL (p));
+  mps_context_free (s);
+}
+END_TEST
 
 int
 main (void)
@@ -109,6 +170,7 @@ main (void)
   // Add tests of the Cluster management test case
   tcase_add_test (tc_management, cluster_create);
   tcase_add_test (tc_management, cluster_isolation);
+  tcase_add_test (tc_management, cluster_shadow);
 
   suite_add_tcase (s, tc_management);
 
@@ -0,0 +1,233 @@
+#include <check.h>
+#include <mps/mps.h>
+#include <math.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <check_implementation.h>
+
+/**
+ * @brief Create the Mandelbrot polynomial of degree \f$2^k - 1\f$, defined
+ * by \f$p_0 = 1\f$ and \f$p_{l} = 1 + x p_{l-1}^2\f$.
+ */
+static mps_composed_poly *
+mandelbrot_poly_new (mps_context * ctx, int k)
+{
+  mps_composed_poly * cp = mps_composed_poly_new (ctx, 0, 1, 2, k);
+
+  mps_composed_poly_set_base_coefficient_i (ctx, cp, 0, 1, 0);
+  mps_composed_poly_set_coefficient_i (ctx, cp, 0, 0, 1, 0);
+  mps_composed_poly_set_coefficient_i (ctx, cp, 1, 2, 1, 0);
+
+  return cp;
+}
+
+/**
+ * @brief Check that every root stored in the results file is in the
+ * inclusion disc of the computed approximation closest to it.
+ */
+static void
+check_roots_with_results (mps_context * ctx, const char * pol_name)
+{
+  char * res_file = get_res_file (pol_name, "unisolve");
+  FILE * result_stream = fopen (res_file, "r");
+  int n = mps_context_get_degree (ctx);
+  mpc_t * mroots = NULL;
+  rdpe_t * radii = NULL;
+  mpc_t root, ctmp;
+  cdpe_t cdtmp;
+  rdpe_t dist, min_dist;
+  int i, j, found_root;
+  char ch;
+
+  fail_unless (result_stream != NULL, "Cannot open the results file %s", res_file);
+
+  mps_context_get_roots_m (ctx, &mroots, &radii);
+
+  mpc_init2 (root, mps_context_get_data_prec_max (ctx));
+  mpc_init2 (ctmp, mps_context_get_data_prec_max (ctx));
+
+  for (i = 0; i < n; i++)
+    {
+      while (isspace (ch = getc (result_stream)))
+        ;
+      ungetc (ch, result_stream);
+      mpc_inp_str (root, result_stream, 10);
+
+      found_root = 0;
+      for (j = 0; j < n; j++)
+        {
+          mpc_sub (ctmp, root, mroots[j]);
+          mpc_get_cdpe (cdtmp, ctmp);
+          cdpe_mod (dist, cdtmp);
+
+          if (j == 0 || rdpe_lt (dist, min_dist))
+            {
+              rdpe_set (min_dist, dist);
+              found_root = j;
+            }
+        }
+
+      rdpe_div_eq_d (min_dist, 1 + 4.0 * DBL_EPSILON);
+      fail_unless (rdpe_le (min_dist, radii[found_root]),
+                   "Root %d of %s is not in the inclusion disc of approximation %d",
+                   i, pol_name, found_root);
+    }
+
+  mpc_clear (root);
+  mpc_clear (ctmp);
+  mpc_vclear (mroots, n);
+  free (mroots);
+  free (radii);
+
+  fclose (result_stream);
+  free (res_file);
+}
+
+START_TEST (test_composed_poly_mandelbrot_degree)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_composed_poly * cp = mandelbrot_poly_new (ctx, 10);
+  cplx_t x, value;
+  mpc_t lc;
+  double error, expected;
+
+  fail_unless (MPS_POLYNOMIAL (cp)->degree == 1023,
+               "The degree of the Mandelbrot polynomial of level 10 is %d", MPS_POLYNOMIAL (cp)->degree);
+  fail_unless (MPS_STRUCTURE_IS_INTEGER (MPS_POLYNOMIAL (cp)->structure));
+
+  mpc_init2 (lc, 64);
+  mps_polynomial_get_leading_coefficient (ctx, MPS_POLYNOMIAL (cp), lc);
+  fail_unless (mpc_eq_one (lc), "The leading coefficient should be 1");
+  mpc_clear (lc);
+
+  /* p_l(-2) = 1 - 2 p_{l-1}(-2)^2 is -1 for every l > 0 */
+  cplx_set_d (x, -2.0, 0.0);
+  mps_polynomial_feval (ctx, MPS_POLYNOMIAL (cp), x, value, &error);
+  expected = -1.0;
+  fail_unless (fabs (cplx_Re (value) - expected) <= error && cplx_Im (value) == 0.0,
+               "Wrong value of the Mandelbrot polynomial in -2");
+
+  mps_polynomial_free (ctx, MPS_POLYNOMIAL (cp));
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (test_composed_poly_mandelbrot)
+{
+  mps_algorithm algorithms[] = { MPS_ALGORITHM_SECULAR_GA, MPS_ALGORITHM_STANDARD_MPSOLVE };
+  int i;
+
+  for (i = 0; i < 2; i++)
+    {
+      mps_context * ctx = mps_context_new ();
+      mps_composed_poly * cp = mandelbrot_poly_new (ctx, 7);
+
+      mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (cp));
+      mps_context_select_algorithm (ctx, algorithms[i]);
+      mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+      mps_context_set_output_prec (ctx, 128);
+      mps_mpsolve (ctx);
+
+      fail_if (mps_context_has_errors (ctx), "Error while solving the Mandelbrot polynomial");
+      check_roots_with_results (ctx, "mand127");
+
+      mps_polynomial_free (ctx, MPS_POLYNOMIAL (cp));
+      mps_context_free (ctx);
+    }
+}
+END_TEST
+
+START_TEST (test_composed_poly_composition)
+{
+  mps_context * ctx = mps_context_new ();
+
+  /* The composition of 6 copies of y^2 - 2, whose roots are
+   * 2 cos ((2j + 1) pi / 128). */
+  mps_composed_poly * cp = mps_composed_poly_new (ctx, 1, 0, 2, 6);
+  mpc_t *mroots = NULL;
+  rdpe_t *radii = NULL;
+  int i, j, n;
+
+  mps_composed_poly_set_base_coefficient_i (ctx, cp, 1, 1, 0);
+  mps_composed_poly_set_coefficient_i (ctx, cp, 0, 0, -2, 0);
+  mps_composed_poly_set_coefficient_i (ctx, cp, 0, 2, 1, 0);
+
+  n = MPS_POLYNOMIAL (cp)->degree;
+  fail_unless (n == 64, "The degree of the composition is %d", n);
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (cp));
+  mps_context_select_algorithm (ctx, MPS_ALGORITHM_SECULAR_GA);
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_context_set_output_prec (ctx, 53);
+  mps_mpsolve (ctx);
+
+  mps_context_get_roots_m (ctx, &mroots, &radii);
+  for (i = 0; i < n; i++)
+    {
+      double expected_root = 2.0 * cos ((2.0 * i + 1) / 128 * PI);
+      double epsilon = DBL_MAX;
+      int found_root = -1;
+
+      for (j = 0; j < n; j++)
+        {
+          cdpe_t ctmp;
+          double residue;
+
+          mpc_get_cdpe (ctmp, mroots[j]);
+          residue = hypot (rdpe_get_d (cdpe_Re (ctmp)) - expected_root,
+                           rdpe_get_d (cdpe_Im (ctmp)));
+          if (residue < epsilon)
+            {
+              epsilon = residue;
+              found_root = j;
+            }
+        }
+
+      fail_unless (epsilon < 4.0 * DBL_EPSILON + rdpe_get_d (radii[found_root]),
+                   "Root %d of the composition is not approximated", i);
+    }
+
+  mpc_vclear (mroots, n);
+  free (mroots);
+  free (radii);
+
+  mps_polynomial_free (ctx, MPS_POLYNOMIAL (cp));
+  mps_context_free (ctx);
+}
+END_TEST
+
+Suite *
+composed_poly_suite (void)
+{
+  Suite *s = suite_create ("composed_poly");
+
+  TCase *tcase_t = tcase_create ("Solution of composed polynomials");
+
+  tcase_add_test (tcase_t, test_composed_poly_mandelbrot_degree);
+  tcase_add_test (tcase_t, test_composed_poly_mandelbrot);
+  tcase_add_test (tcase_t, test_composed_poly_composition);
+
+  tcase_set_timeout (tcase_t, 60);
+
+  suite_add_tcase (s, tcase_t);
+  return s;
+}
+
+int
+main (void)
+{
+  Suite *cs = composed_poly_suite ();
+  SRunner *sr = srunner_create (cs);
+  int number_failed;
+
+  if (getenv ("MPS_SIMPLE_TESTS_ONLY") != NULL)
+    return EXIT_SUCCESS;
+
+  srunner_run_all (sr, CK_NORMAL);
+
+  /* Get number of failed test and report */
+  number_failed = srunner_ntests_failed (sr);
+  srunner_free (sr);
+
+  return(number_failed != 0);
+}
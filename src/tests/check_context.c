@@ -1,6 +1,9 @@
 #include <mps/mps.h>
 #include <check.h>
 #include "check_implementation.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
 
 START_TEST (basics_allocate_context)
 {
@@ -84,6 +87,326 @@ START_TEST (basics_context_reuse_shrink)
 }
 END_TEST
 
+START_TEST (auto_configuration_features)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_polynomial_features features;
+  cplx_t * roots = NULL;
+  int i;
+
+  /* The roots of x^4 - 16 lie on the circle of radius 2. */
+  mps_monomial_poly *poly = mps_monomial_poly_new (ctx, 4);
+
+  mps_monomial_poly_set_coefficient_d (ctx, poly, 0, -16, 0.0);
+  mps_monomial_poly_set_coefficient_d (ctx, poly, 4, 1, 0.0);
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_polynomial_features_compute (ctx, MPS_POLYNOMIAL (poly), &features);
+
+  fail_unless (features.degree == 4 && features.monomial && !features.secular,
+               "Wrong type of polynomial in the features");
+  fail_unless (fabs (features.sparsity - 0.6) < 1e-12, "Wrong sparsity");
+  fail_unless (fabs (features.dynamic_range - 4.0) < 1e-12, "Wrong dynamic range");
+  fail_unless (features.hull_vertices == 2, "Wrong number of vertices of the Newton polygon");
+  fail_unless (features.modulus_spread == 0.0, "Wrong spread of the moduli");
+
+  mps_context_select_algorithm (ctx, MPS_ALGORITHM_AUTO);
+  mps_mpsolve (ctx);
+
+  fail_unless (!mps_context_has_errors (ctx), "Error while solving with MPS_ALGORITHM_AUTO");
+  fail_unless (ctx->algorithm != MPS_ALGORITHM_AUTO, "No algorithm has been selected");
+
+  mps_context_get_roots_d (ctx, &roots, NULL);
+  for (i = 0; i < 4; i++)
+    fail_unless (fabs (cplx_mod (roots[i]) - 2.0) < 1e-12, "Wrong root computed");
+
+  cplx_vfree (roots);
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (auto_configuration_calibration_file)
+{
+  const char * filename = "check_context.calibration";
+  mps_context * ctx = mps_context_new ();
+  FILE * f;
+
+  f = fopen (filename, "w");
+  fail_unless (f != NULL, "Cannot create the calibration file");
+  fprintf (f, "# Test calibration\nsparse_ratio = 0.25\n\nroots_per_thread = 8 # comment\n");
+  fclose (f);
+
+  mps_context_set_auto_calibration_file (ctx, filename);
+  fail_unless (!mps_context_has_errors (ctx), "Error while loading the calibration file");
+  fail_unless (ctx->auto_calibration->sparse_ratio == 0.25 &&
+               ctx->auto_calibration->roots_per_thread == 8,
+               "Calibration file not loaded");
+
+  f = fopen (filename, "w");
+  fail_unless (f != NULL, "Cannot create the calibration file");
+  fprintf (f, "unknown_key = 1\n");
+  fclose (f);
+
+  mps_context_set_auto_calibration_file (ctx, filename);
+  fail_unless (mps_context_has_errors (ctx), "Unknown key accepted in the calibration file");
+
+  remove (filename);
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (root_view_export)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly *poly = mps_monomial_poly_new (ctx, 1502);
+  mps_root_view view;
+  cplx_t * roots = NULL;
+  double * radii = NULL;
+  mpc_t * mroots = NULL;
+  rdpe_t * mradii = NULL;
+  double *re, *im, *rad;
+  long double *lre, *lim, *lrad;
+  mpc_t * exported;
+  rdpe_t * exported_radii;
+  int i, n;
+
+  /* x^2 (x^1500 - 1), so that two roots are deflated */
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 2, -1, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 1502, 1, 0);
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_set_output_prec (ctx, 128);
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_mpsolve (ctx);
+
+  n = mps_context_get_degree (ctx);
+
+  fail_unless (mps_context_get_root_view (ctx, &view) == 0);
+  fail_unless (view.n == n && view.zero_roots == 2);
+
+  mps_context_get_roots_d (ctx, &roots, &radii);
+  mps_context_get_roots_m (ctx, &mroots, &mradii);
+
+  re = malloc (sizeof (double) * n);
+  im = malloc (sizeof (double) * n);
+  rad = malloc (sizeof (double) * n);
+  lre = malloc (sizeof (long double) * n);
+  lim = malloc (sizeof (long double) * n);
+  lrad = malloc (sizeof (long double) * n);
+  exported = mpc_valloc (n);
+  exported_radii = rdpe_valloc (n);
+  mpc_vinit2 (exported, n, 64);
+
+  fail_unless (mps_context_export_roots_d (ctx, re, im, rad, true) == 0);
+  fail_unless (mps_context_export_roots_ld (ctx, lre, lim, lrad, false) == 0);
+  fail_unless (mps_context_export_roots_m (ctx, exported, exported_radii, true) == 0);
+
+  for (i = 0; i < n; i++)
+    {
+      cdpe_t ctmp;
+      rdpe_t rtmp;
+
+      fail_unless (re[i] == cplx_Re (roots[i]) && im[i] == cplx_Im (roots[i]) && rad[i] == radii[i],
+                   "The double export of root %d differs from mps_context_get_roots_d ()", i);
+
+      fail_unless (fabsl (lre[i] - re[i]) <= 4 * DBL_EPSILON * fabs (re[i]) &&
+                   fabsl (lim[i] - im[i]) <= 4 * DBL_EPSILON * fabs (im[i]),
+                   "The long double export of root %d is not accurate", i);
+
+      /* The exported roots are rounded to the precision of the output */
+      mpc_sub (exported[i], exported[i], mroots[i]);
+      mpc_get_cdpe (ctmp, exported[i]);
+      cdpe_mod (rtmp, ctmp);
+      fail_unless (rdpe_get_d (rtmp) <= 2.0 / (1UL << 63),
+                   "The multiprecision export of root %d is not accurate", i);
+      fail_unless (rdpe_eq (exported_radii[i], mradii[i]));
+
+      fail_unless (mps_approximation_get_status (ctx, view.root[i]) ==
+                   mps_context_get_root_status (ctx, i));
+      fail_unless (mps_approximation_get_wp (ctx, view.root[i]) > 0);
+    }
+
+  free (re);
+  free (im);
+  free (rad);
+  free (lre);
+  free (lim);
+  free (lrad);
+  mpc_vclear (exported, n);
+  mpc_vfree (exported);
+  rdpe_vfree (exported_radii);
+  mpc_vclear (mroots, n);
+  mpc_vfree (mroots);
+  rdpe_vfree (mradii);
+  cplx_vfree (roots);
+  free (radii);
+
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+}
+END_TEST
+
+/* Sort keys with many ties, some of them broken by the multiprecision
+ * values, and check that the parallel merge sort gives a sorted
+ * permutation that does not depend on the number of threads. */
+START_TEST (sort_keys_parallel)
+{
+  mps_context * ctx = mps_context_new ();
+  const int n = 20000;
+  mps_sort_key * keys = mps_newv (mps_sort_key, n);
+  mps_sort_key * sequential = mps_newv (mps_sort_key, n);
+  mps_approximation ** roots = mps_newv (mps_approximation *, n);
+  int * seen = mps_newv (int, n);
+  int i, threads = ctx->n_threads;
+  mpf_t tiny;
+
+  mpf_init2 (tiny, 64);
+
+  for (i = 0; i < n; i++)
+    {
+      roots[i] = mps_approximation_new (ctx);
+      mpc_set_prec (roots[i]->mvalue, 256);
+      mpc_set_d (roots[i]->mvalue, (i * 7919 % 97) / 7.0, (i % 3) - 1.0);
+
+      /* Differences that are lost in the DPE copies */
+      mpf_set_ui (tiny, i % 7 + 1);
+      mpf_div_2exp (tiny, tiny, 200);
+      mpf_add (mpc_Re (roots[i]->mvalue), mpc_Re (roots[i]->mvalue), tiny);
+
+      mpc_get_cdpe (keys[i].value, roots[i]->mvalue);
+      keys[i].root = roots[i];
+      keys[i].index = i;
+      sequential[i] = keys[i];
+    }
+
+  ctx->n_threads = 5;
+  mps_sort_keys (ctx, keys, n);
+  ctx->n_threads = 1;
+  mps_sort_keys (ctx, sequential, n);
+  ctx->n_threads = threads;
+
+  memset (seen, 0, sizeof (int) * n);
+  for (i = 0; i < n; i++)
+    {
+      fail_unless (keys[i].index == sequential[i].index,
+                   "The order depends on the number of threads at position %d", i);
+      seen[keys[i].index]++;
+
+      if (i > 0)
+        {
+          int cmp = rdpe_cmp (cdpe_Re (keys[i - 1].value), cdpe_Re (keys[i].value));
+
+          if (cmp == 0)
+            cmp = rdpe_cmp (cdpe_Im (keys[i - 1].value), cdpe_Im (keys[i].value));
+          if (cmp == 0)
+            cmp = mpf_cmp (mpc_Re (keys[i - 1].root->mvalue), mpc_Re (keys[i].root->mvalue));
+          if (cmp == 0)
+            cmp = keys[i - 1].index - keys[i].index;
+
+          fail_unless (cmp < 0, "The keys are not sorted at position %d", i);
+        }
+    }
+
+  for (i = 0; i < n; i++)
+    fail_unless (seen[i] == 1, "The key %d is missing or repeated", i);
+
+  for (i = 0; i < n; i++)
+    mps_approximation_free (ctx, roots[i]);
+
+  mpf_clear (tiny);
+  free (roots);
+  free (seen);
+  free (keys);
+  free (sequential);
+  mps_context_free (ctx);
+}
+END_TEST
+
+static void *
+events_on_solved (mps_context * ctx, void * user_data)
+{
+  __sync_add_and_fetch ((int *) user_data, 1);
+  return NULL;
+}
+
+START_TEST (events_async_streaming)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly *poly = mps_monomial_poly_new (ctx, 300);
+  mps_event_queue * queue = mps_event_queue_new (1024);
+  mps_event event;
+  int * reported;
+  int i, n, packets = 0, done = 0, solved = 0, last_packet = 0;
+  cplx_t * roots = NULL;
+
+  /* x^300 - 3x + 1, whose roots are approximated at different times. */
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 0, 1, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 1, -3, 0);
+  mps_monomial_poly_set_coefficient_int (ctx, poly, 300, 1, 0);
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_select_algorithm (ctx, MPS_ALGORITHM_SECULAR_GA);
+  mps_context_set_output_prec (ctx, 128);
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_context_set_event_queue (ctx, queue);
+
+  n = mps_context_get_degree (ctx);
+  reported = calloc (n, sizeof (int));
+
+  mps_mpsolve_async (ctx, events_on_solved, &solved);
+
+  /* Consume the events while the computation is running. */
+  while (!mps_event_queue_is_finished (queue))
+    {
+      if (!mps_event_queue_pop (queue, &event))
+        continue;
+
+      fail_unless (event.ctx == ctx);
+      fail_unless (event.packet >= last_packet, "The events are not in order");
+      fail_if (done, "Event received after the end of the computation");
+      last_packet = event.packet;
+
+      switch (event.type)
+        {
+        case MPS_EVENT_PACKET:
+          packets++;
+          break;
+        case MPS_EVENT_ROOT_ISOLATED:
+        case MPS_EVENT_ROOT_APPROXIMATED:
+          fail_unless (event.root >= 0 && event.root < n);
+          fail_unless (reported[event.root] < (int) event.type,
+                       "Root %d has been reported twice", event.root);
+          reported[event.root] = event.type;
+          break;
+        case MPS_EVENT_DONE:
+          fail_unless (event.approximated == n);
+          done = 1;
+          break;
+        }
+    }
+
+  fail_unless (done && packets > 0);
+  fail_unless (mps_event_queue_get_dropped (queue) == 0);
+
+  while (!__sync_fetch_and_add (&solved, 0))
+    ;
+
+  /* Every root has been reported as approximated. */
+  mps_context_get_roots_d (ctx, &roots, NULL);
+  for (i = 0; i < n; i++)
+    fail_unless (reported[i] == MPS_EVENT_ROOT_APPROXIMATED,
+                 "Root %d has not been reported", i);
+
+  cplx_vfree (roots);
+  free (reported);
+
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+  mps_event_queue_free (queue);
+}
+END_TEST
+
 int
 main (void)
 {
@@ -99,6 +422,11 @@ main (void)
   tcase_add_test (tc_basics, basics_context_reuse_without_free);
   tcase_add_test (tc_basics, basics_context_reuse_expand);
   tcase_add_test (tc_basics, basics_context_reuse_shrink);
+  tcase_add_test (tc_basics, auto_configuration_features);
+  tcase_add_test (tc_basics, auto_configuration_calibration_file);
+  tcase_add_test (tc_basics, root_view_export);
+  tcase_add_test (tc_basics, events_async_streaming);
+  tcase_add_test (tc_basics, sort_keys_parallel);
 
   suite_add_tcase (s, tc_basics);
 
@@ -2,6 +2,8 @@
 #include <check_implementation.h>
 #include <mps/mps.h>
 #include <limits.h>
+#include <float.h>
+#include <math.h>
 
 /**
  * @brief Testing RDPE for safe comparison
@@ -64,6 +66,24 @@ START_TEST (test_rdpe_mul_overflow)
 }
 END_TEST
 
+START_TEST (test_cdpe_div_eq)
+{
+  cdpe_t a, b, c;
+  double re, im;
+
+  cdpe_set_d (a, 3.0, 4.0);
+  cdpe_set_d (b, 1.0, 2.0);
+  cdpe_div (c, a, b);
+  cdpe_div_eq (a, b);
+
+  /* (3 + 4i) / (1 + 2i) = 2.2 - 0.4i */
+  cdpe_get_d (&re, &im, a);
+  fail_if (fabs (re - 2.2) > 4 * DBL_EPSILON || fabs (im + 0.4) > 4 * DBL_EPSILON,
+           "cdpe_div_eq: (3 + 4i) / (1 + 2i) = %e + %ei", re, im);
+  fail_if (!cdpe_eq (a, c), "cdpe_div_eq and cdpe_div give different results");
+}
+END_TEST
+
 /**
  * @brief Create the test suite used to test DPE values.
  */
@@ -76,6 +96,7 @@ dpe_suite (void)
   tcase_add_test (tc_rdpe, test_rdpe_comparison);
   tcase_add_test (tc_rdpe, test_rdpe_sum_overflow);
   tcase_add_test (tc_rdpe, test_rdpe_mul_overflow);
+  tcase_add_test (tc_rdpe, test_cdpe_div_eq);
 
   suite_add_tcase (s, tc_rdpe);
   return s;
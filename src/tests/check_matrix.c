@@ -194,6 +194,95 @@ START_TEST (determinant_shifted_mhessenberg_example1)
 }
 END_TEST
 
+START_TEST (determinant_shifted_hessenberg_batch)
+{
+  /* Hessenberg matrices of size 8, as in the examples above, and 150, whose
+   * determinants need to be rescaled, evaluated on 20 shifts together. */
+  size_t sizes[] = { 8, 150 };
+  int n_shifts = 20, k, i, j;
+  cplx_t shifts[20], det[20], ddet[20], t, d;
+  cplx_t results[2];
+  long int exponents[20];
+
+  cplx_set_d (shifts[0], 0.403815598068559, 0.754480932782281);
+  cplx_set_d (shifts[1], 0.0590780603923638, 0.9236523504901163);
+  cplx_set_d (results[0], -0.2755152414594506, 0.0732925950505913);
+  cplx_set_d (results[1], 0.5885575152394473, -0.0800261442305445);
+  for (i = 2; i < n_shifts; i++)
+    cplx_set_d (shifts[i], cos (1.0 * i), sin (2.0 * i));
+
+  mps_context *ctx = mps_context_new ();
+
+  /* Use more jobs than blocks of shifts, and start with a workspace that
+   * is too small for the matrices. */
+  ctx->n_threads = 4;
+  mps_hessenberg_workspace * w = mps_hessenberg_workspace_new (ctx, 4);
+
+  for (k = 0; k < 2; k++)
+    {
+      size_t n = sizes[k];
+      cplx_t *hessenberg_matrix = mps_newv (cplx_t, n * n);
+
+      for (i = 0; i < n; i++)
+        for (j = 0; j < n; j++)
+          {
+            if (j >= i - 1)
+              cplx_set_d (hessenberg_matrix[i * n + j], sin (1.0 * (i + 1)) * cos (1.0 * (j + 1)) + 1e-3 * (i + 1) * (j + 1), 0.0);
+            else
+              cplx_set (hessenberg_matrix[i * n + j], cplx_zero);
+          }
+
+      mps_fhessenberg_shifted_determinants (ctx, hessenberg_matrix, n, shifts, n_shifts,
+                                            det, ddet, exponents, w);
+
+      if (n == 8)
+        for (i = 0; i < 2; i++)
+          {
+            cplx_mul_d (t, det[i], ldexp (1.0, exponents[i]));
+            cplx_sub_eq (t, results[i]);
+
+            fail_unless (cplx_mod (t) < cplx_mod (results[i]) * 10.0 * 8 * DBL_EPSILON,
+                         "The error on batched Hessenberg determinant %d is bigger than n * DBL_EPSILON", i);
+          }
+
+      for (i = 0; i < n_shifts; i++)
+        {
+          long int exp, exp2;
+          cplx_t h;
+
+          /* The determinant must match the one computed alone */
+          mps_fhessenberg_shifted_determinant (ctx, hessenberg_matrix, shifts[i], n, t, &exp);
+          cplx_mul_eq_d (t, ldexp (1.0, exp - exponents[i]));
+          cplx_sub (d, t, det[i]);
+
+          fail_unless (cplx_mod (d) <= cplx_mod (t) * 8 * DBL_EPSILON,
+                       "Batched determinant %d of size %d does not match the single shift one", i, n);
+
+          /* Check the derivative against a central difference */
+          cplx_set_d (h, 1e-6, 0.0);
+          cplx_add (d, shifts[i], h);
+          mps_fhessenberg_shifted_determinant (ctx, hessenberg_matrix, d, n, t, &exp);
+          cplx_sub (d, shifts[i], h);
+          mps_fhessenberg_shifted_determinant (ctx, hessenberg_matrix, d, n, d, &exp2);
+
+          cplx_mul_eq_d (t, ldexp (1.0, exp - exponents[i]));
+          cplx_mul_eq_d (d, ldexp (1.0, exp2 - exponents[i]));
+          cplx_sub_eq (t, d);
+          cplx_div_eq_d (t, 2e-6);
+          cplx_sub (d, t, ddet[i]);
+
+          fail_unless (cplx_mod (d) <= cplx_mod (ddet[i]) * 1e-6,
+                       "Derivative of the batched determinant %d of size %d is not accurate", i, n);
+        }
+
+      free (hessenberg_matrix);
+    }
+
+  mps_hessenberg_workspace_free (ctx, w);
+  mps_context_free (ctx);
+}
+END_TEST
+
 START_TEST (rational_matrix_creation)
 {
   int degree = 6;
@@ -260,6 +349,7 @@ main (void)
   // Add tests of the deteminant
   tcase_add_test (tc_determinant, determinant_hessenberg_example1);
   tcase_add_test (tc_determinant, determinant_shifted_hessenberg_example1);
+  tcase_add_test (tc_determinant, determinant_shifted_hessenberg_batch);
   tcase_add_test (tc_determinant, determinant_mhessenberg_example1);
   tcase_add_test (tc_determinant, determinant_shifted_mhessenberg_example1);
 
@@ -76,6 +76,246 @@ START_TEST (set_coefficient_s2)
 END_TEST
 
 
+START_TEST (compensated_horner1)
+{
+  /* p(x) = 2^1500 (x - 1)^8, evaluated near its multiple root, where the
+   * standard Horner scheme has only a few correct digits and the coefficients
+   * are not representable as standard floating point numbers. */
+  double binomial[] = { 1, -8, 28, -56, 70, -56, 28, -8, 1 };
+  int n = 8, i;
+  mps_context * ctx = mps_context_new ();
+  cdpe_t coefficients[9], x, value, exact;
+  rdpe_t moduli[9], error, rtmp;
+
+  for (i = 0; i <= n; i++)
+    {
+      cdpe_set_2dl (coefficients[i], binomial[i], 1500, 0.0, 0);
+      cdpe_mod (moduli[i], coefficients[i]);
+    }
+
+  cdpe_set_d (x, 1.0 + 1.0 / 16, 0.0);
+  mps_dhorner_compensated (ctx, n, coefficients, NULL, moduli, x, value, error);
+
+  /* The exact value is 2^1500 * 2^(-32) */
+  cdpe_set_2dl (exact, 1.0, 1468, 0.0, 0);
+
+  cdpe_sub_eq (exact, value);
+  cdpe_mod (rtmp, exact);
+
+  fail_unless (rdpe_le (rtmp, error),
+               "The error bound of the compensated Horner scheme is not satisfied");
+
+  cdpe_mod (rtmp, value);
+  rdpe_div_eq (error, rtmp);
+  fail_unless (rdpe_get_d (error) < 4 * DBL_EPSILON,
+               "The compensated Horner scheme is not accurate enough");
+
+  mps_context_free (ctx);
+}
+END_TEST
+
+/**
+ * @brief Create the polynomial with the given roots, that must be dyadic
+ * numbers with few digits, so that its coefficients are exact.
+ */
+static mps_monomial_poly *
+count_poly_new (mps_context * ctx, int n, const double roots[][2])
+{
+  mps_monomial_poly * poly = mps_monomial_poly_new (ctx, n);
+  cplx_t * c = cplx_valloc (n + 1);
+  cplx_t r, tmp;
+  int i, j;
+
+  cplx_set (c[0], cplx_one);
+  for (i = 1; i <= n; i++)
+    cplx_set (c[i], cplx_zero);
+
+  /* Multiply by x - r, one root at a time. */
+  for (i = 0; i < n; i++)
+    {
+      cplx_set_d (r, roots[i][0], roots[i][1]);
+      for (j = i + 1; j >= 0; j--)
+        {
+          cplx_mul (tmp, c[j], r);
+          cplx_neg_eq (tmp);
+          if (j > 0)
+            cplx_add_eq (tmp, c[j - 1]);
+          cplx_set (c[j], tmp);
+        }
+    }
+
+  for (i = 0; i <= n; i++)
+    mps_monomial_poly_set_coefficient_d (ctx, poly, i, cplx_Re (c[i]), cplx_Im (c[i]));
+
+  cplx_vfree (c);
+  return poly;
+}
+
+START_TEST (count_roots1)
+{
+  const double roots[][2] = {
+    {  0.5,   0.25 }, { -0.25,  0.5  }, {  2.0,  -0.5  },
+    { -3.0,  -1.0  }, {  0.5,   3.0  }, { -0.5,  -0.5  },
+    { -1.5,   1.5  }, {  0.25, -0.75 }, {  1.5,   0.5  }
+  };
+  mps_search_set search_sets[] = {
+    MPS_SEARCH_SET_COMPLEX_PLANE, MPS_SEARCH_SET_UNITARY_DISC,
+    MPS_SEARCH_SET_UNITARY_DISC_COMPL, MPS_SEARCH_SET_POSITIVE_REAL_PART,
+    MPS_SEARCH_SET_NEGATIVE_REAL_PART, MPS_SEARCH_SET_POSITIVE_IMAG_PART,
+    MPS_SEARCH_SET_NEGATIVE_IMAG_PART
+  };
+  int expected[] = { 9, 4, 5, 5, 4, 5, 4 };
+  int n = 9, i, k;
+
+  for (k = 0; k < 7; k++)
+    {
+      mps_context * ctx = mps_context_new ();
+      mps_monomial_poly * poly = count_poly_new (ctx, n, roots);
+
+      mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+      mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_COUNT);
+      ctx->output_config->search_set = search_sets[k];
+
+      mps_mpsolve (ctx);
+      mps_countroots (ctx);
+
+      fail_unless (ctx->count[0] == expected[k] && ctx->count[1] == n - expected[k] &&
+                   ctx->count[2] == 0,
+                   "Wrong count of the roots in the search set %d: %d inside, %d outside, %d uncertain",
+                   k, ctx->count[0], ctx->count[1], ctx->count[2]);
+
+      /* The roots have not been approximated. */
+      for (i = 0; i < n; i++)
+        fail_unless (rdpe_eq (ctx->root[i]->drad, RDPE_MAX),
+                     "The roots have been counted by approximating them");
+
+      mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+      mps_context_free (ctx);
+    }
+}
+END_TEST
+
+START_TEST (count_roots2)
+{
+  /* x^2 + 1 has its roots on the boundary of the right half-plane, so
+   * they cannot be counted without approximating them. */
+  const double roots[][2] = { { 0.0, 1.0 }, { 0.0, -1.0 } };
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = count_poly_new (ctx, 2, roots);
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_COUNT);
+  ctx->output_config->search_set = MPS_SEARCH_SET_POSITIVE_REAL_PART;
+
+  fail_unless (!mps_count_mpsolve (ctx),
+               "The roots on the boundary of the search set have been counted");
+
+  /* They are in the upper and lower half-planes. */
+  ctx->output_config->search_set = MPS_SEARCH_SET_POSITIVE_IMAG_PART;
+  fail_unless (mps_count_mpsolve (ctx),
+               "The roots in the upper half-plane have not been counted");
+
+  mps_countroots (ctx);
+  fail_unless (ctx->count[0] == 1 && ctx->count[1] == 1,
+               "Wrong count of the roots in the upper half-plane");
+
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (small_degree1)
+{
+  const double roots[][2] = {
+    {  0.5,   0.25 }, { -0.25,  0.5  }, {  2.0,  -0.5  },
+    { -3.0,  -1.0  }, {  0.5,   3.0  }, { -0.5,  -0.5  },
+    { -1.5,   1.5  }, {  0.25, -0.75 }, {  1.5,   0.5  }
+  };
+  mps_output_goal goals[] = { MPS_OUTPUT_GOAL_ISOLATE, MPS_OUTPUT_GOAL_APPROXIMATE };
+  int n = 9, i, j, k, inside;
+  cplx_t r, d;
+
+  for (k = 0; k < 2; k++)
+    {
+      mps_context * ctx = mps_context_new ();
+      mps_monomial_poly * poly = count_poly_new (ctx, n, roots);
+
+      mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+      mps_context_set_output_goal (ctx, goals[k]);
+
+      fail_unless (mps_small_degree_mpsolve (ctx),
+                   "The roots have not been isolated by the small degree solver");
+
+      /* Every inclusion disc contains exactly one of the roots. */
+      for (i = 0; i < n; i++)
+        {
+          inside = 0;
+          for (j = 0; j < n; j++)
+            {
+              cplx_set_d (r, roots[j][0], roots[j][1]);
+              cplx_sub (d, r, ctx->root[i]->fvalue);
+              if (cplx_mod (d) <= ctx->root[i]->frad)
+                inside++;
+            }
+
+          fail_unless (inside == 1,
+                       "The inclusion disc of the approximation %d contains %d roots", i, inside);
+          fail_unless (goals[k] != MPS_OUTPUT_GOAL_APPROXIMATE ||
+                       ctx->root[i]->status == MPS_ROOT_STATUS_APPROXIMATED,
+                       "The approximation %d is not accurate to the output precision", i);
+        }
+
+      mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+      mps_context_free (ctx);
+    }
+}
+END_TEST
+
+START_TEST (small_degree2)
+{
+  /* The double root cannot be isolated, so the polynomial is handed to
+   * the standard algorithm. */
+  const double roots[][2] = {
+    { 1.0, 0.0 }, { 1.0, 0.0 }, { -1.0, 0.0 }, { 0.0, 0.5 }
+  };
+  mps_context * ctx = mps_context_new ();
+  mps_monomial_poly * poly = count_poly_new (ctx, 4, roots);
+  cplx_t * results = cplx_valloc (4);
+  double * radii = double_valloc (4);
+  cplx_t r, d;
+  int i, j;
+
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_ISOLATE);
+
+  fail_unless (!mps_small_degree_mpsolve (ctx),
+               "The double root has been isolated by the small degree solver");
+
+  mps_mpsolve (ctx);
+  mps_context_get_roots_d (ctx, &results, &radii);
+
+  for (j = 0; j < 4; j++)
+    {
+      mps_boolean found = false;
+
+      cplx_set_d (r, roots[j][0], roots[j][1]);
+      for (i = 0; i < 4; i++)
+        {
+          cplx_sub (d, r, results[i]);
+          if (cplx_mod (d) <= radii[i])
+            found = true;
+        }
+
+      fail_unless (found, "The root %d is not contained in any inclusion disc", j);
+    }
+
+  cplx_vfree (results);
+  free (radii);
+  mps_monomial_poly_free (ctx, MPS_POLYNOMIAL (poly));
+  mps_context_free (ctx);
+}
+END_TEST
+
 int
 main (void)
 {
@@ -90,7 +330,24 @@ main (void)
   tcase_add_test (tc_coefficients, set_coefficient_s1);
   tcase_add_test (tc_coefficients, set_coefficient_s2);
 
+  TCase *tc_evaluation = tcase_create ("Evaluation");
+
+  tcase_add_test (tc_evaluation, compensated_horner1);
+
+  TCase *tc_count = tcase_create ("Root counting");
+
+  tcase_add_test (tc_count, count_roots1);
+  tcase_add_test (tc_count, count_roots2);
+
+  TCase *tc_small_degree = tcase_create ("Small degree");
+
+  tcase_add_test (tc_small_degree, small_degree1);
+  tcase_add_test (tc_small_degree, small_degree2);
+
   suite_add_tcase (s, tc_coefficients);
+  suite_add_tcase (s, tc_evaluation);
+  suite_add_tcase (s, tc_count);
+  suite_add_tcase (s, tc_small_degree);
 
   SRunner *sr = srunner_create (s);
 
@@ -81,6 +81,75 @@ START_TEST (basics_multiplication)
 }
 END_TEST
 
+START_TEST (ball_horner)
+{
+  mpc_t x, c, exact;
+  rdpe_t ax, ac, r, rexact;
+  mps_mball b;
+  long int precisions[] = { 64, 128, 1024 };
+  int i, j, n = 200;
+
+  for (i = 0; i < 3; i++)
+    {
+      mpc_init2 (x, precisions[i]);
+      mpc_init2 (c, precisions[i]);
+      mpc_init2 (exact, 8 * n * precisions[i]);
+      mps_mball_init2 (&b, precisions[i]);
+
+      /* Evaluate the polynomial with coefficients (j + 1/3) (1 - i / j) in
+       * x = 0.999 + 0.01i, both at the given precision and with a precision
+       * where the computation is exact. */
+      mpc_set_d (x, 0.999, 0.01);
+      mps_mag_set_mpc (ax, x);
+
+      mpc_set_ui (exact, 0U, 0U);
+      for (j = n; j >= 0; j--)
+        {
+          mpc_set_ui (c, 1U, 0U);
+          mpc_div_ui (c, c, 3U);
+          mpc_add_ui (c, c, j, 0U);
+          if (j > 0)
+            mpf_div_ui (mpc_Im (c), mpc_Re (c), j);
+          mpf_neg (mpc_Im (c), mpc_Im (c));
+
+          mpc_rmod (ac, c);
+          mps_mag_set_mpc (r, c);
+
+          /* The magnitude must be an upper bound, and a tight one. */
+          fail_unless (rdpe_ge (r, ac), "The magnitude of c is not an upper bound");
+          rdpe_mul_eq_d (ac, 1.0 + 64 * DBL_EPSILON);
+          fail_unless (rdpe_le (r, ac), "The magnitude of c is not accurate");
+
+          if (j == n)
+            mps_mball_set_mpc (&b, c, r);
+          else
+            mps_mball_fma (&b, x, ax, c, r);
+
+          mpc_mul_eq (exact, x);
+          mpc_add_eq (exact, c);
+        }
+
+      /* The coefficients are exact here, so the radius must contain the
+       * error of the evaluation, and be within a few bits of it. */
+      mpc_sub_eq (exact, b.mid);
+      mpc_rmod (rexact, exact);
+      fail_unless (rdpe_le (rexact, b.rad),
+                   "The radius of the ball does not bound the error at precision %ld",
+                   precisions[i]);
+
+      mpc_rmod (r, b.mid);
+      rdpe_mul_eq_d (r, n * n);
+      rdpe_mul_eq (r, b.eps);
+      fail_unless (rdpe_le (b.rad, r), "The radius of the ball is too large");
+
+      mps_mball_clear (&b);
+      mpc_clear (x);
+      mpc_clear (c);
+      mpc_clear (exact);
+    }
+}
+END_TEST
+
 int
 main (void)
 {
@@ -97,6 +166,11 @@ main (void)
 
   suite_add_tcase (s, tc_basics);
 
+  // Ball arithmetic
+  TCase *tc_ball = tcase_create ("Ball arithmetic");
+  tcase_add_test (tc_ball, ball_horner);
+  suite_add_tcase (s, tc_ball);
+
   SRunner *sr = srunner_create (s);
   srunner_run_all (sr, CK_NORMAL);
   number_failed = srunner_ntests_failed (sr);
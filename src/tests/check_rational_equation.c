@@ -0,0 +1,282 @@
+#include <check.h>
+#include <mps/mps.h>
+#include <math.h>
+#include <stdio.h>
+#include <check_implementation.h>
+
+/**
+ * @brief Check that the computed roots are close to the expected ones,
+ * that are given by their real and imaginary parts.
+ */
+static void
+check_expected_roots (mps_context * ctx, int n, const double * expected)
+{
+  cplx_t * roots = cplx_valloc (n);
+  double * radii = mps_newv (double, n);
+  int i, j;
+
+  fail_unless (mps_context_get_degree (ctx) == n,
+               "The equation has degree %d instead of %d", mps_context_get_degree (ctx), n);
+
+  mps_context_get_roots_d (ctx, &roots, &radii);
+
+  for (i = 0; i < n; i++)
+    {
+      double min_dist = DBL_MAX;
+      int found_root = -1;
+
+      for (j = 0; j < n; j++)
+        {
+          double dist = hypot (cplx_Re (roots[j]) - expected[2 * i],
+                               cplx_Im (roots[j]) - expected[2 * i + 1]);
+          if (dist < min_dist)
+            {
+              min_dist = dist;
+              found_root = j;
+            }
+        }
+
+      fail_unless (min_dist < 4.0 * DBL_EPSILON + radii[found_root] && radii[found_root] < 1e-12,
+                   "Root %d is not approximated", i);
+    }
+
+  cplx_vfree (roots);
+  free (radii);
+}
+
+static void
+solve (mps_context * ctx, mps_rational_equation * re, mps_algorithm algorithm, long int prec)
+{
+  mps_context_set_input_poly (ctx, MPS_POLYNOMIAL (re));
+  mps_context_select_algorithm (ctx, algorithm);
+  mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_context_set_output_prec (ctx, prec);
+  mps_mpsolve (ctx);
+
+  fail_if (mps_context_has_errors (ctx), "Error while solving the rational equation");
+}
+
+START_TEST (test_rational_equation_degree)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_rational_equation * re = mps_rational_equation_new (ctx, 3, 2);
+  mpc_t lc;
+
+  /* 1 / (x - 1) + 1 / (x + 1) + 3 / x^2 = 0 */
+  mps_rational_equation_set_term_i (ctx, re, 0, 1, 0, 1, 0, 1);
+  mps_rational_equation_set_term_i (ctx, re, 1, 1, 0, -1, 0, 1);
+  mps_rational_equation_set_term_i (ctx, re, 2, 3, 0, 0, 0, 2);
+
+  fail_unless (MPS_POLYNOMIAL (re)->degree == 3,
+               "The degree of the rational equation is %d", MPS_POLYNOMIAL (re)->degree);
+
+  mpc_init2 (lc, 64);
+  mps_polynomial_get_leading_coefficient (ctx, MPS_POLYNOMIAL (re), lc);
+  fail_unless (mpf_cmp_ui (mpc_Re (lc), 2U) == 0 && mpf_sgn (mpc_Im (lc)) == 0,
+               "The leading coefficient should be the sum of the c_i of the simple poles");
+
+  /* With the right hand side 5 x^2 the degree is 4 + 2. */
+  mps_rational_equation_set_rhs_coefficient_i (ctx, re, 2, 5, 0);
+  fail_unless (MPS_POLYNOMIAL (re)->degree == 6,
+               "The degree of the rational equation is %d", MPS_POLYNOMIAL (re)->degree);
+
+  mps_polynomial_get_leading_coefficient (ctx, MPS_POLYNOMIAL (re), lc);
+  fail_unless (mpf_cmp_si (mpc_Re (lc), -5) == 0, "The leading coefficient should be -5");
+  mpc_clear (lc);
+
+  mps_polynomial_free (ctx, MPS_POLYNOMIAL (re));
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (test_rational_equation_roots)
+{
+  mps_algorithm algorithms[] = { MPS_ALGORITHM_SECULAR_GA, MPS_ALGORITHM_STANDARD_MPSOLVE };
+  int i;
+
+  for (i = 0; i < 2; i++)
+    {
+      mps_context * ctx = mps_context_new ();
+      mps_rational_equation * re = mps_rational_equation_new (ctx, 2, 0);
+
+      /* 3 / (x - 1) - 3 / (x + 1) = 2 has the roots +-2. */
+      double expected[] = { 2.0, 0.0, -2.0, 0.0 };
+
+      mps_rational_equation_set_term_i (ctx, re, 0, 3, 0, 1, 0, 1);
+      mps_rational_equation_set_term_i (ctx, re, 1, -3, 0, -1, 0, 1);
+      mps_rational_equation_set_rhs_coefficient_i (ctx, re, 0, 2, 0);
+
+      solve (ctx, re, algorithms[i], 53);
+      check_expected_roots (ctx, 2, expected);
+
+      mps_polynomial_free (ctx, MPS_POLYNOMIAL (re));
+      mps_context_free (ctx);
+    }
+}
+END_TEST
+
+START_TEST (test_rational_equation_multiple_pole)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_rational_equation * re = mps_rational_equation_new (ctx, 1, 0);
+
+  /* 1 / (x - i)^3 = 8, whose roots are i + exp(2 pi i j / 3) / 2. */
+  double expected[] = { 0.5, 1.0,
+                        -0.25, 1.0 + sqrt (3.0) / 4,
+                        -0.25, 1.0 - sqrt (3.0) / 4 };
+
+  mps_rational_equation_set_term_i (ctx, re, 0, 1, 0, 0, 1, 3);
+  mps_rational_equation_set_rhs_coefficient_i (ctx, re, 0, 8, 0);
+
+  solve (ctx, re, MPS_ALGORITHM_SECULAR_GA, 53);
+  check_expected_roots (ctx, 3, expected);
+
+  mps_polynomial_free (ctx, MPS_POLYNOMIAL (re));
+  mps_context_free (ctx);
+}
+END_TEST
+
+START_TEST (test_rational_equation_many_poles)
+{
+  mps_algorithm algorithms[] = { MPS_ALGORITHM_SECULAR_GA, MPS_ALGORITHM_STANDARD_MPSOLVE };
+  int m = 60, i, j, a;
+
+  for (a = 0; a < 2; a++)
+    {
+      mps_context * ctx = mps_context_new ();
+      mps_rational_equation * re = mps_rational_equation_new (ctx, m, 1);
+      mpc_t * mroots = NULL;
+      rdpe_t * radii = NULL;
+      int n;
+
+      /* sum_j 1 / (x - j)^(1 + j mod 2) = x */
+      for (j = 0; j < m; j++)
+        mps_rational_equation_set_term_i (ctx, re, j, 1, 0, j + 1, 0, 1 + (j + 1) % 2);
+      mps_rational_equation_set_rhs_coefficient_i (ctx, re, 1, 1, 0);
+
+      n = MPS_POLYNOMIAL (re)->degree;
+      fail_unless (n == m + m / 2 + 1, "The degree of the rational equation is %d", n);
+
+      solve (ctx, re, algorithms[a], 128);
+      mps_context_get_roots_m (ctx, &mroots, &radii);
+
+      /* The residual of the equation in every approximation must be
+       * compatible with its inclusion radius. */
+      for (i = 0; i < n; i++)
+        {
+          mpc_t x, t, u, value, deriv;
+          rdpe_t av, ad, bound;
+
+          mpc_init2 (x, 256);
+          mpc_init2 (t, 256);
+          mpc_init2 (u, 256);
+          mpc_init2 (value, 256);
+          mpc_init2 (deriv, 256);
+
+          mpc_set (x, mroots[i]);
+          mpc_neg (value, x);
+          mpc_set_si (deriv, -1, 0);
+
+          for (j = 0; j < m; j++)
+            {
+              int k = 1 + (j + 1) % 2;
+
+              mpc_set_si (t, j + 1, 0);
+              mpc_sub (t, x, t);
+              mpc_inv_eq (t);
+              mpc_pow_si (u, t, k);
+              mpc_add_eq (value, u);
+              mpc_mul_eq (u, t);
+              mpc_mul_eq_ui (u, k);
+              mpc_sub_eq (deriv, u);
+            }
+
+          mpc_rmod (av, value);
+          mpc_rmod (ad, deriv);
+          rdpe_mul (bound, ad, radii[i]);
+          rdpe_mul_eq_d (bound, 4.0);
+          rdpe_add_eq_d (bound, 1e-60);
+
+          fail_unless (rdpe_le (av, bound), "The residual in the approximation %d is too large", i);
+
+          mpc_clear (x);
+          mpc_clear (t);
+          mpc_clear (u);
+          mpc_clear (value);
+          mpc_clear (deriv);
+        }
+
+      mpc_vclear (mroots, n);
+      free (mroots);
+      free (radii);
+
+      mps_polynomial_free (ctx, MPS_POLYNOMIAL (re));
+      mps_context_free (ctx);
+    }
+}
+END_TEST
+
+START_TEST (test_rational_equation_parser)
+{
+  mps_context * ctx = mps_context_new ();
+  mps_polynomial * poly = mps_parse_string (ctx,
+                                            "RationalFunction;\n"
+                                            "Real;\n"
+                                            "Integer;\n"
+                                            "Degree=2;\n"
+                                            "\n"
+                                            "1 0 2\n"
+                                            "1 1 1\n"
+                                            "\n"
+                                            "1\n"
+                                            "0 1\n");
+
+  fail_unless (poly != NULL && !mps_context_has_errors (ctx), "Cannot parse the rational equation");
+  fail_unless (MPS_IS_RATIONAL_EQUATION (poly), "The parsed polynomial is not a rational equation");
+  fail_unless (poly->degree == 4, "The degree of the parsed equation is %d", poly->degree);
+  fail_unless (MPS_RATIONAL_EQUATION (poly)->orders[0] == 2 &&
+               MPS_RATIONAL_EQUATION (poly)->orders[1] == 1,
+               "Wrong orders of the poles in the parsed equation");
+
+  mps_polynomial_free (ctx, poly);
+  mps_context_free (ctx);
+}
+END_TEST
+
+Suite *
+rational_equation_suite (void)
+{
+  Suite *s = suite_create ("rational_equation");
+
+  TCase *tcase_t = tcase_create ("Solution of rational equations");
+
+  tcase_add_test (tcase_t, test_rational_equation_degree);
+  tcase_add_test (tcase_t, test_rational_equation_roots);
+  tcase_add_test (tcase_t, test_rational_equation_multiple_pole);
+  tcase_add_test (tcase_t, test_rational_equation_many_poles);
+  tcase_add_test (tcase_t, test_rational_equation_parser);
+
+  tcase_set_timeout (tcase_t, 60);
+
+  suite_add_tcase (s, tcase_t);
+  return s;
+}
+
+int
+main (void)
+{
+  Suite *cs = rational_equation_suite ();
+  SRunner *sr = srunner_create (cs);
+  int number_failed;
+
+  if (getenv ("MPS_SIMPLE_TESTS_ONLY") != NULL)
+    return EXIT_SUCCESS;
+
+  srunner_run_all (sr, CK_NORMAL);
+
+  /* Get number of failed test and report */
+  number_failed = srunner_ntests_failed (sr);
+  srunner_free (sr);
+
+  return(number_failed != 0);
+}
@@ -5,6 +5,7 @@
 #include <check.h>
 #include <mps/mps.h>
 #include <gmp.h>
+#include <math.h>
 #include <stdio.h>
 #include <ctype.h>
 #include <string.h>
@@ -16,6 +17,21 @@
  */
 test_pol **test_polynomials;
 
+/**
+ * @brief Starting strategy used by test_secsolve_on_pol_impl ().
+ */
+mps_starting_strategy test_starting_strategy = MPS_STARTING_STRATEGY_DEFAULT;
+
+/**
+ * @brief Square-free switch used by test_secsolve_on_pol_impl ().
+ */
+mps_boolean test_square_free = false;
+
+/**
+ * @brief Symmetry switch used by test_secsolve_on_pol_impl ().
+ */
+mps_boolean test_exploit_symmetry = false;
+
 int test_secsolve_on_pol_impl (test_pol*, mps_output_goal, mps_boolean jacobi_iterations);
 
 int
@@ -71,6 +87,9 @@ test_secsolve_on_pol_impl (test_pol * pol, mps_output_goal goal, mps_boolean jac
   mps_context_set_output_prec (s, pol->out_digits);
   mps_context_set_output_goal (s, goal);
   mps_context_set_jacobi_iterations (s, jacobi_iterations);
+  mps_context_select_starting_strategy (s, test_starting_strategy);
+  mps_context_set_square_free (s, test_square_free);
+  mps_context_set_exploit_symmetry (s, test_exploit_symmetry);
 
   /* Solve it */
   mps_context_select_algorithm (s, (pol->ga) ? MPS_ALGORITHM_SECULAR_GA : MPS_ALGORITHM_STANDARD_MPSOLVE);
@@ -551,6 +570,690 @@ START_TEST (test_secsolve_mig1_500_1)
 }
 END_TEST
 
+/**
+ * @brief Solve the polynomial in <code>pol</code> with the secular algorithm,
+ * saving and/or resuming the computation from the given checkpoint files.
+ */
+static mps_context *
+solve_with_checkpoint (test_pol * pol, const char * checkpoint_file, const char * resume_file)
+{
+  mps_context * s = mps_context_new ();
+  FILE * input_stream = fopen (pol->pol_file, "r");
+  mps_polynomial * poly;
+
+  fail_unless (input_stream != NULL, "Cannot open the polynomial file");
+
+  poly = mps_parse_stream (s, input_stream);
+  fclose (input_stream);
+
+  mps_context_set_input_poly (s, poly);
+  mps_context_set_output_prec (s, pol->out_digits);
+  mps_context_set_output_goal (s, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_context_select_algorithm (s, MPS_ALGORITHM_SECULAR_GA);
+
+  mps_context_set_checkpoint_file (s, checkpoint_file);
+  mps_context_set_resume_file (s, resume_file);
+
+  mps_mpsolve (s);
+
+  return s;
+}
+
+/**
+ * @brief Check that a computation resumed from a checkpoint reaches
+ * the same roots of the computation that saved it.
+ */
+START_TEST (test_secsolve_checkpoint)
+{
+  const char * checkpoint = "check_secsolve.checkpoint";
+  test_pol * pol = test_pol_new ("kir1_10", "unisolve", 50 * LOG2_10, float_phase, true);
+  mps_context * s1, * s2;
+  mpc_t * roots1 = NULL, * roots2 = NULL;
+  rdpe_t * rad1 = NULL, * rad2 = NULL;
+  mpc_t diff;
+  cdpe_t cdiff;
+  rdpe_t dist, rtmp;
+  int i, j, n;
+  mps_boolean found;
+
+  remove (checkpoint);
+
+  starting_test_message (pol->pol_file);
+
+  s1 = solve_with_checkpoint (pol, checkpoint, NULL);
+  fail_unless (!mps_context_has_errors (s1), "Error while saving the checkpoint");
+
+  s2 = solve_with_checkpoint (pol, NULL, checkpoint);
+  fail_unless (!mps_context_has_errors (s2), "Error while resuming from the checkpoint");
+
+  n = mps_context_get_degree (s1);
+  fail_unless (n == mps_context_get_degree (s2), "Degree of the resumed computation is different");
+
+  mps_context_get_roots_m (s1, &roots1, &rad1);
+  mps_context_get_roots_m (s2, &roots2, &rad2);
+
+  mpc_init2 (diff, mps_context_get_data_prec_max (s1));
+
+  /* Every root of the resumed computation must be in the inclusion of
+   * a root of the original one. */
+  for (i = 0; i < n; i++)
+    {
+      found = false;
+      for (j = 0; j < n && !found; j++)
+        {
+          mpc_sub (diff, roots2[i], roots1[j]);
+          mpc_get_cdpe (cdiff, diff);
+          cdpe_mod (dist, cdiff);
+          rdpe_add (rtmp, rad1[j], rad2[i]);
+          found = rdpe_le (dist, rtmp);
+        }
+
+      fail_unless (found, "Root %d of the resumed computation has not been found", i);
+    }
+
+  mpc_clear (diff);
+  mpc_vclear (roots1, n);
+  mpc_vclear (roots2, n);
+  free (roots1);
+  free (roots2);
+  free (rad1);
+  free (rad2);
+
+  mps_polynomial_free (s1, mps_context_get_active_poly (s1));
+  mps_polynomial_free (s2, mps_context_get_active_poly (s2));
+  mps_context_free (s1);
+  mps_context_free (s2);
+
+  success_test_message (pol->pol_file);
+
+  /* A checkpoint of a different equation must be refused */
+  test_pol_free (pol);
+  pol = test_pol_new ("kir1_20", "unisolve", 53, float_phase, true);
+
+  s1 = solve_with_checkpoint (pol, NULL, checkpoint);
+  fail_unless (mps_context_has_errors (s1), "Checkpoint of a different equation has been accepted");
+
+  mps_polynomial_free (s1, mps_context_get_active_poly (s1));
+  mps_context_free (s1);
+
+  test_pol_free (pol);
+  remove (checkpoint);
+}
+END_TEST
+
+/**
+ * @brief Check that the solver works with the threads pinned to the
+ * cores, and that invalid pinning requests are reported.
+ */
+START_TEST (test_secsolve_thread_affinity)
+{
+  test_pol * pol = test_pol_new ("kir1_20", "unisolve", 53, float_phase, true);
+  mps_thread_affinity policies[] = { MPS_THREAD_AFFINITY_COMPACT,
+                                     MPS_THREAD_AFFINITY_SCATTER,
+                                     MPS_THREAD_AFFINITY_NONE };
+  mps_context * s;
+  FILE * input_stream;
+  mps_polynomial * poly;
+  int i;
+
+  starting_test_message (pol->pol_file);
+
+  for (i = 0; i < 3; i++)
+    {
+      s = mps_context_new ();
+      input_stream = fopen (pol->pol_file, "r");
+      fail_unless (input_stream != NULL, "Cannot open the polynomial file");
+
+      poly = mps_parse_stream (s, input_stream);
+      fclose (input_stream);
+
+      mps_context_set_thread_affinity (s, policies[i], NULL, 0);
+      mps_context_set_input_poly (s, poly);
+      mps_context_set_output_prec (s, pol->out_digits);
+      mps_context_set_output_goal (s, MPS_OUTPUT_GOAL_ISOLATE);
+      mps_context_select_algorithm (s, MPS_ALGORITHM_SECULAR_GA);
+
+      mps_mpsolve (s);
+
+      fail_unless (!mps_context_has_errors (s), "Error while solving with pinned threads");
+      fail_unless (mps_context_get_degree (s) == 84, "Wrong number of roots computed");
+
+      mps_polynomial_free (s, poly);
+      mps_context_free (s);
+    }
+
+  s = mps_context_new ();
+  mps_context_set_thread_affinity (s, MPS_THREAD_AFFINITY_LIST, NULL, 0);
+  fail_unless (mps_context_has_errors (s), "Empty list of cores has been accepted");
+  mps_context_free (s);
+
+  success_test_message (pol->pol_file);
+  test_pol_free (pol);
+}
+END_TEST
+
+START_TEST (test_secsolve_companion_starting)
+{
+  const char * names[] = { "nroots50", "kam1_1", "mig1_100", "wilk40" };
+  test_pol * pol;
+  int i;
+
+  test_starting_strategy = MPS_STARTING_STRATEGY_COMPANION;
+
+  for (i = 0; i < 4; i++)
+    {
+      pol = test_pol_new (names[i], "unisolve", 53, float_phase, true);
+      test_secsolve_on_pol (pol);
+      test_pol_free (pol);
+    }
+
+  test_starting_strategy = MPS_STARTING_STRATEGY_DEFAULT;
+}
+END_TEST
+
+/**
+ * @brief Check that the block Gauss-Seidel iterations give the same
+ * approximations independently of the number of threads.
+ */
+START_TEST (test_secsolve_block_iterations)
+{
+  test_pol * pol = test_pol_new ("wilk40", "unisolve", 53, float_phase, true);
+  int threads[] = { 1, 4 };
+  cplx_t * roots[2] = { NULL, NULL };
+  double * radii[2] = { NULL, NULL };
+  mps_context * s;
+  FILE * input_stream;
+  mps_polynomial * poly;
+  int i, j, n = 0;
+
+  starting_test_message (pol->pol_file);
+
+  for (i = 0; i < 2; i++)
+    {
+      s = mps_context_new ();
+      input_stream = fopen (pol->pol_file, "r");
+      fail_unless (input_stream != NULL, "Cannot open the polynomial file");
+
+      poly = mps_parse_stream (s, input_stream);
+      fclose (input_stream);
+
+      mps_thread_pool_set_concurrency_limit (s, NULL, threads[i]);
+      s->n_threads = threads[i];
+
+      mps_context_set_input_poly (s, poly);
+      mps_context_set_block_iterations (s, true);
+      mps_context_set_output_prec (s, pol->out_digits);
+      mps_context_set_output_goal (s, MPS_OUTPUT_GOAL_APPROXIMATE);
+      mps_context_select_algorithm (s, MPS_ALGORITHM_SECULAR_GA);
+
+      mps_mpsolve (s);
+
+      fail_unless (!mps_context_has_errors (s), "Error while solving with block iterations");
+
+      n = mps_context_get_degree (s);
+      mps_context_get_roots_d (s, &roots[i], &radii[i]);
+
+      mps_polynomial_free (s, poly);
+      mps_context_free (s);
+    }
+
+  for (j = 0; j < n; j++)
+    fail_unless (cplx_eq (roots[0][j], roots[1][j]) && radii[0][j] == radii[1][j],
+                 "Block iterations depend on the number of threads");
+
+  for (i = 0; i < 2; i++)
+    {
+      cplx_vfree (roots[i]);
+      free (radii[i]);
+    }
+
+  success_test_message (pol->pol_file);
+  test_pol_free (pol);
+}
+END_TEST
+
+/**
+ * @brief Check that the Aberth corrections computed with the cached
+ * contribution of the frozen approximations agree with the ones
+ * computed directly.
+ */
+START_TEST (test_secsolve_frozen_roots)
+{
+  test_pol * pol = test_pol_new ("wilk20", "unisolve", 53, float_phase, true);
+  mps_context * s = mps_context_new ();
+  mps_frozen_roots * fr;
+  pthread_mutex_t * mutexes;
+  FILE * input_stream;
+  mps_polynomial * poly;
+  cplx_t * roots = NULL, exact, cached, z;
+  double * radii = NULL, scale;
+  int i, j, k, n;
+
+  starting_test_message (pol->pol_file);
+
+  input_stream = fopen (pol->pol_file, "r");
+  fail_unless (input_stream != NULL, "Cannot open the polynomial file");
+
+  poly = mps_parse_stream (s, input_stream);
+  fclose (input_stream);
+
+  mps_context_set_input_poly (s, poly);
+  mps_context_set_output_prec (s, pol->out_digits);
+  mps_context_set_output_goal (s, MPS_OUTPUT_GOAL_APPROXIMATE);
+  mps_context_select_algorithm (s, MPS_ALGORITHM_SECULAR_GA);
+  mps_mpsolve (s);
+
+  fail_unless (!mps_context_has_errors (s), "Error while solving the polynomial");
+
+  n = mps_context_get_degree (s);
+  mps_context_get_roots_d (s, &roots, &radii);
+
+  mutexes = mps_newv (pthread_mutex_t, n);
+  for (i = 0; i < n; i++)
+    pthread_mutex_init (&mutexes[i], NULL);
+
+  /* Freeze the approximations of even index. */
+  for (i = 0; i < n; i++)
+    {
+      cplx_set (s->root[i]->fvalue, roots[i]);
+      s->root[i]->again = (i % 2 == 1);
+      s->root[i]->approximated = (i % 2 == 0);
+    }
+
+  fr = mps_frozen_roots_new (n);
+  mps_frozen_roots_update (s, fr);
+
+  fail_unless (fr->n_active == n / 2 && fr->n_frozen == n - n / 2,
+               "Wrong partition of the approximations");
+
+  /* The first sweep computes the expansions, the following ones move the
+   * active approximations slightly and use them. */
+  for (k = 0; k < 3; k++)
+    {
+      for (j = 1; j < n; j += 2)
+        {
+          mps_faberth_frozen_wl (s, fr, j, cached, mutexes);
+          mps_faberth_wl (s, j, exact, mutexes);
+
+          scale = 0.0;
+          for (i = 0; i < n; i++)
+            if (i != j)
+              {
+                cplx_sub (z, s->root[j]->fvalue, s->root[i]->fvalue);
+                scale += 1.0 / cplx_mod (z);
+              }
+
+          cplx_sub_eq (cached, exact);
+          fail_unless (cplx_mod (cached) <= 1e-6 * scale,
+                       "Cached Aberth correction of root %d differs from the exact one", j);
+        }
+
+      for (j = 1; j < n; j += 2)
+        {
+          cplx_set_d (z, 1e-9 * (k + 1), -1e-9 * (k + 1));
+          cplx_add_eq (s->root[j]->fvalue, z);
+        }
+    }
+
+  for (i = 0; i < n; i++)
+    pthread_mutex_destroy (&mutexes[i]);
+  free (mutexes);
+
+  mps_frozen_roots_free (fr);
+  cplx_vfree (roots);
+  free (radii);
+
+  mps_polynomial_free (s, poly);
+  mps_context_free (s);
+
+  success_test_message (pol->pol_file);
+  test_pol_free (pol);
+}
+END_TEST
+
+/**
+ * @brief Check that the isolated approximations are not brought to
+ * the precision needed to separate the clustered roots, and that the
+ * roots are still correct.
+ */
+START_TEST (test_secsolve_frozen_precision)
+{
+  test_pol * pol = test_pol_new ("mig1_200", "unisolve", 100 * LOG2_10, float_phase, true);
+  mps_context * s = mps_context_new ();
+  FILE * input_stream;
+  mps_polynomial * poly;
+  int i, frozen = 0;
+
+  starting_test_message (pol->pol_file);
+
+  input_stream = fopen (pol->pol_file, "r");
+  fail_unless (input_stream != NULL, "Cannot open the polynomial file");
+
+  poly = mps_parse_stream (s, input_stream);
+  fclose (input_stream);
+
+  mps_context_set_input_poly (s, poly);
+  mps_context_set_output_prec (s, pol->out_digits);
+  mps_context_set_output_goal (s, MPS_OUTPUT_GOAL_ISOLATE);
+  mps_context_select_algorithm (s, MPS_ALGORITHM_SECULAR_GA);
+  mps_mpsolve (s);
+
+  fail_unless (!mps_context_has_errors (s), "Error while solving the polynomial");
+
+  for (i = 0; i < s->n; i++)
+    if (s->root[i]->frozen)
+      {
+        frozen++;
+        fail_unless (mpc_get_prec (s->root[i]->mvalue) < s->mpwp,
+                     "The precision of the frozen root %d has been raised", i);
+      }
+
+  fail_unless (frozen > 0 && frozen < s->n,
+               "The isolated roots have not been frozen (%d of %d)", frozen, s->n);
+
+  mps_polynomial_free (s, poly);
+  mps_context_free (s);
+
+  test_secsolve_on_pol (pol);
+  test_pol_free (pol);
+}
+END_TEST
+
+/**
+ * @brief Check the square-free factorization of mult1, that is
+ * \f$(x+1)^5(x^{10}+x+1)\f$, and the roots obtained solving the
+ * factors separately.
+ */
+START_TEST (test_secsolve_square_free)
+{
+  const char * names[] = { "mult1", "kam1_1" };
+  mps_square_free_factor * factors;
+  mps_context * s = mps_context_new ();
+  test_pol * pol = test_pol_new ("mult1", "unisolve", 15, float_phase, true);
+  FILE * input_stream;
+  mps_polynomial * poly;
+  int i, n_factors, multiple = 0;
+
+  starting_test_message (pol->pol_file);
+
+  input_stream = fopen (pol->pol_file, "r");
+  fail_unless (input_stream != NULL, "Cannot open the polynomial file");
+
+  poly = mps_parse_stream (s, input_stream);
+  fclose (input_stream);
+
+  mps_context_set_input_poly (s, poly);
+
+  n_factors = mps_square_free_factorize (s, MPS_MONOMIAL_POLY (poly), &factors);
+  fail_unless (n_factors == 2, "Found %d square-free factors instead of 2", n_factors);
+  fail_unless (MPS_POLYNOMIAL (factors[0].poly)->degree == 10 && factors[0].multiplicity == 1,
+               "Wrong first square-free factor");
+  fail_unless (MPS_POLYNOMIAL (factors[1].poly)->degree == 1 && factors[1].multiplicity == 5,
+               "Wrong second square-free factor");
+  mps_square_free_factors_free (s, factors, n_factors);
+
+  mps_context_set_output_prec (s, pol->out_digits);
+  mps_context_set_square_free (s, true);
+  mps_mpsolve (s);
+
+  fail_unless (!mps_context_has_errors (s), "Error while solving the polynomial");
+
+  for (i = 0; i < s->n; i++)
+    if (mps_context_get_root_status (s, i) == MPS_ROOT_STATUS_MULTIPLE)
+      multiple++;
+
+  fail_unless (multiple == 5, "Found %d multiple roots instead of 5", multiple);
+
+  mps_polynomial_free (s, poly);
+  mps_context_free (s);
+  test_pol_free (pol);
+
+  /* Check the roots, also on kam1_1 that is square-free and is solved
+   * as usual. */
+  test_square_free = true;
+
+  for (i = 0; i < 2; i++)
+    {
+      pol = test_pol_new (names[i], "unisolve", 100, float_phase, i == 0);
+      test_secsolve_on_pol (pol);
+      test_pol_free (pol);
+    }
+
+  test_square_free = false;
+}
+END_TEST
+
+/**
+ * @brief Check the detection of polynomials in \f$x^k\f$ and of
+ * palindromic ones, and the roots obtained solving the reduced
+ * polynomials.
+ */
+START_TEST (test_secsolve_symmetry)
+{
+  /* x^6 - 2, a palindromic polynomial of degree 7, an anti-palindromic
+   * one of degree 6 and x^5 + 2x + 1. */
+  const char * strings[] = {
+    "Monomial;\nReal;\nInteger;\nDegree=6;\n-2\n0\n0\n0\n0\n0\n1\n",
+    "Monomial;\nReal;\nInteger;\nDegree=7;\n1\n3\n-2\n5\n5\n-2\n3\n1\n",
+    "Monomial;\nReal;\nInteger;\nDegree=6;\n-1\n-3\n-2\n0\n2\n3\n1\n",
+    "Monomial;\nReal;\nInteger;\nDegree=5;\n1\n2\n0\n0\n0\n1\n"
+  };
+  const mps_symmetry symmetries[] = {
+    MPS_SYMMETRY_NONE, MPS_SYMMETRY_PALINDROMIC,
+    MPS_SYMMETRY_ANTI_PALINDROMIC, MPS_SYMMETRY_NONE
+  };
+  const int powers[] = { 6, 1, 1, 1 };
+  const char * names[] = { "kir1_10", "nroots50" };
+  mps_context * s, * ctx;
+  mps_polynomial * poly;
+  test_pol * pol;
+  mpc_t ctmp;
+  rdpe_t dist, rad;
+  int i, j, l, power;
+
+  for (i = 0; i < 4; i++)
+    {
+      s = mps_context_new ();
+      poly = mps_parse_string (s, strings[i]);
+      mps_context_set_input_poly (s, poly);
+
+      fail_unless (mps_context_get_symmetry (s, &power) == symmetries[i] && power == powers[i],
+                   "Wrong structure detected for the polynomial %d", i);
+
+      /* Solve the polynomial with and without the reduction, and check
+       * that every inclusion disc intersects one of the other set. */
+      if (i < 3)
+        {
+          ctx = mps_context_new ();
+          mps_context_set_input_poly (ctx, poly);
+          mps_context_set_output_prec (ctx, 128);
+          mps_context_set_output_goal (ctx, MPS_OUTPUT_GOAL_APPROXIMATE);
+          mps_mpsolve (ctx);
+
+          mps_context_set_output_prec (s, 128);
+          mps_context_set_output_goal (s, MPS_OUTPUT_GOAL_APPROXIMATE);
+          mps_context_set_exploit_symmetry (s, true);
+          mps_mpsolve (s);
+
+          fail_unless (!mps_context_has_errors (s), "Error while solving the polynomial %d", i);
+
+          mpc_init2 (ctmp, mps_context_get_data_prec_max (s));
+          for (j = 0; j < s->n; j++)
+            {
+              mps_boolean found = false;
+
+              for (l = 0; l < ctx->n && !found; l++)
+                {
+                  mpc_sub (ctmp, s->root[j]->mvalue, ctx->root[l]->mvalue);
+                  mpc_rmod (dist, ctmp);
+                  rdpe_add (rad, s->root[j]->drad, ctx->root[l]->drad);
+                  found = rdpe_le (dist, rad);
+                }
+
+              fail_unless (found, "Root %d of the polynomial %d is not correct", j, i);
+            }
+          mpc_clear (ctmp);
+
+          mps_context_free (ctx);
+        }
+
+      mps_polynomial_free (s, poly);
+      mps_context_free (s);
+    }
+
+  test_exploit_symmetry = true;
+
+  for (i = 0; i < 2; i++)
+    {
+      pol = test_pol_new (names[i], "unisolve", 100, float_phase, false);
+      test_secsolve_on_pol (pol);
+      test_pol_free (pol);
+    }
+
+  test_exploit_symmetry = false;
+}
+END_TEST
+
+/**
+ * @brief Check the batch evaluation of the secular sums against a
+ * direct evaluation in DPE, on coefficients with a wide range of
+ * exponents.
+ */
+START_TEST (test_secsolve_batch_sum)
+{
+  mps_context * s = mps_context_new ();
+  const int n = 150, m = 5;
+  cplx_t * a = cplx_valloc (n), * b = cplx_valloc (n);
+  cdpe_t x[5], scale, ctmp, ctmp2, pol, fp, sumb;
+  rdpe_t asum, err, rtmp, fpsum;
+  mps_secular_dsum sums[5], single;
+  mps_secular_msum msums[5], msingle;
+  mpc_t mx[5];
+  mps_secular_equation * sec;
+  int i, k;
+
+  for (i = 0; i < n; i++)
+    {
+      cplx_set_d (a[i], cos (i), sin (2.0 * i));
+      cplx_set_d (b[i], 1.0 + 0.3 * cos (3.0 * i), sin (5.0 * i));
+    }
+
+  sec = mps_secular_equation_new (s, a, b, n);
+
+  /* Spread the exponents of the coefficients well beyond the range of
+   * the floating point numbers. */
+  for (i = 0; i < n; i++)
+    {
+      cdpe_set_2dl (scale, 1.0, (i % 7) * 900 - 2700, 0.0, 0);
+      cdpe_mul_eq (sec->bdpc[i], scale);
+      cdpe_set_2dl (scale, 1.0, (i % 5) * 1500 - 3000, 0.0, 0);
+      cdpe_mul_eq (sec->adpc[i], scale);
+    }
+
+  cdpe_set_d (x[0], 0.5, 0.25);
+  cdpe_set_2dl (x[1], 1.0, 1800, -0.5, 1790);
+  cdpe_set_2dl (x[2], 0.75, -2650, 0.1, -2700);
+  cdpe_set (x[3], sec->bdpc[42]);
+  cdpe_set (x[4], sec->bdpc[13]);
+  rdpe_mul_eq_d (cdpe_Re (x[4]), 1.0 + 1e-12);
+
+  mps_secular_dbatch_sum (s, sec, m, x, sums);
+
+  for (k = 0; k < m; k++)
+    {
+      /* The result of a point must not depend on the other ones. */
+      mps_secular_dbatch_sum (s, sec, 1, x + k, &single);
+      fail_unless (single.index == sums[k].index &&
+                   cdpe_eq (single.pol, sums[k].pol) && cdpe_eq (single.fp, sums[k].fp) &&
+                   cdpe_eq (single.sumb, sums[k].sumb),
+                   "The batch evaluation of point %d depends on the batch", k);
+
+      if (k == 3)
+        {
+          fail_unless (sums[k].index == 42, "The coincidence of x with b_42 has not been detected");
+          continue;
+        }
+
+      fail_unless (sums[k].index == -1, "Wrong coincidence detected for point %d", k);
+
+      cdpe_set (pol, cdpe_zero);
+      cdpe_set (fp, cdpe_zero);
+      cdpe_set (sumb, cdpe_zero);
+      rdpe_set (asum, rdpe_zero);
+      rdpe_set (fpsum, rdpe_zero);
+
+      for (i = 0; i < n; i++)
+        {
+          cdpe_sub (ctmp, x[k], sec->bdpc[i]);
+          cdpe_inv_eq (ctmp);
+          cdpe_add_eq (sumb, ctmp);
+          cdpe_mul (ctmp2, sec->adpc[i], ctmp);
+          cdpe_mod (rtmp, ctmp2);
+          rdpe_add_eq (asum, rtmp);
+          cdpe_add_eq (pol, ctmp2);
+          cdpe_mul_eq (ctmp2, ctmp);
+          cdpe_sub_eq (fp, ctmp2);
+          cdpe_mod (rtmp, ctmp2);
+          rdpe_add_eq (fpsum, rtmp);
+        }
+
+      cdpe_sub (ctmp, pol, sums[k].pol);
+      cdpe_mod (err, ctmp);
+      rdpe_mul_eq_d (asum, 1e-13);
+      fail_unless (rdpe_le (err, asum), "Inaccurate sum of a_i / (x - b_i) on point %d", k);
+
+      cdpe_sub (ctmp, fp, sums[k].fp);
+      cdpe_mod (err, ctmp);
+      rdpe_mul_eq_d (fpsum, 1e-13);
+      fail_unless (rdpe_le (err, fpsum), "Inaccurate sum of a_i / (x - b_i)^2 on point %d", k);
+    }
+
+  /* The multiprecision version must give the same results on any batch. */
+  mpc_vinit2 (mx, m, 128);
+  for (k = 0; k < m; k++)
+    {
+      mpc_set_cplx (mx[k], sec->bfpc[k]);
+      mpc_add_eq_ui (mx[k], 1U, 1U);
+      mps_secular_msum_init (msums + k, 128);
+    }
+  mps_secular_msum_init (&msingle, 128);
+
+  mps_secular_mbatch_sum (s, sec, m, mx, msums);
+  for (k = 0; k < m; k++)
+    {
+      mps_secular_mbatch_sum (s, sec, 1, mx + k, &msingle);
+      fail_unless (mpf_cmp (mpc_Re (msingle.pol), mpc_Re (msums[k].pol)) == 0 &&
+                   mpf_cmp (mpc_Im (msingle.fp), mpc_Im (msums[k].fp)) == 0 &&
+                   mpf_cmp (mpc_Re (msingle.sumb), mpc_Re (msums[k].sumb)) == 0,
+                   "The MP batch evaluation of point %d depends on the batch", k);
+      mps_secular_msum_clear (msums + k);
+    }
+
+  mps_secular_msum_clear (&msingle);
+  mpc_vclear (mx, m);
+
+  mps_secular_equation_free (s, MPS_POLYNOMIAL (sec));
+  cplx_vfree (a);
+  cplx_vfree (b);
+  mps_context_free (s);
+}
+END_TEST
+
+START_TEST (test_secsolve_distributed_setup)
+{
+  mps_context * s = mps_context_new ();
+
+  /* MPI is never initialized by the test suite, so the request must be
+   * refused and the context must keep working on a single process. */
+  mps_context_set_distributed (s, true);
+  fail_unless (mps_context_has_errors (s), "Distributed mode enabled without MPI");
+  fail_unless (!s->distributed && s->distributed_size == 1,
+               "Context left in distributed mode after a failed setup");
+
+  mps_context_free (s);
+}
+END_TEST
+
 /**
  * @brief Create the secsolve test suite
  */
@@ -630,6 +1333,18 @@ Suite * secsolve_suite (int standard)
   tcase_add_test (tc_monomial, test_secsolve_mig1_200_high_precision);
   tcase_add_test (tc_monomial, test_secsolve_mig1_500_1);
 
+  /* Checkpoint and resume */
+  tcase_add_test (tc_monomial, test_secsolve_checkpoint);
+  tcase_add_test (tc_monomial, test_secsolve_thread_affinity);
+  tcase_add_test (tc_monomial, test_secsolve_block_iterations);
+  tcase_add_test (tc_monomial, test_secsolve_frozen_roots);
+  tcase_add_test (tc_monomial, test_secsolve_frozen_precision);
+  tcase_add_test (tc_monomial, test_secsolve_batch_sum);
+  tcase_add_test (tc_monomial, test_secsolve_distributed_setup);
+  tcase_add_test (tc_monomial, test_secsolve_companion_starting);
+  tcase_add_test (tc_monomial, test_secsolve_square_free);
+  tcase_add_test (tc_monomial, test_secsolve_symmetry);
+
   /* Add test case to the suite */
   suite_add_tcase (s, tc_secular);
   suite_add_tcase (s, tc_monomial);
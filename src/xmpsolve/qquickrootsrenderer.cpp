@@ -5,6 +5,8 @@ using namespace xmpsolve;
 QQuickRootsRenderer::QQuickRootsRenderer(QQuickItem *parent) :
     QQuickPaintedItem(parent)
 {
+    // Repaint when the density tiles missing from the view are ready.
+    connect(m_tileWorker, SIGNAL(tileReady()), this, SLOT(update()));
 }
 
 void
@@ -8,6 +8,9 @@ QRootsRenderer::QRootsRenderer(QWidget *parent) :
     QWidget(parent)
 {
     mDragging = false;
+
+    // Repaint when the density tiles missing from the view are ready.
+    connect(m_tileWorker, SIGNAL(tileReady()), this, SLOT(update()));
 }
 
 void
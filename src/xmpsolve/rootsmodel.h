@@ -37,6 +37,12 @@ public:
      */
     Q_INVOKABLE void markRoot(int i = -1);
 
+    /**
+     * @brief markedRoot is the index of the highlighted approximation,
+     * or -1 if there is none.
+     */
+    int markedRoot() const { return m_marked_root; }
+
     double getPointX(int i) { return m_roots[i]->get_real_part(); }
     double getPointY(int i) { return m_roots[i]->get_imag_part(); }
 
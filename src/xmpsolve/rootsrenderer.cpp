@@ -6,20 +6,64 @@
 
 namespace xmpsolve {
 
+/**
+ * @brief Maximum number of approximations that are drawn one by one. When
+ * more of them are visible their density is displayed instead.
+ */
+static const int MAX_DRAWN_ROOTS = 50000;
+
+/**
+ * @brief Minimum area, in pixels, available to each approximation for it to
+ * be drawn separately from the others.
+ */
+static const int MIN_PIXELS_PER_ROOT = 64;
+
+/**
+ * @brief Maximum number of density tiles kept in memory.
+ */
+static const int MAX_CACHED_TILES = 256;
+
+/**
+ * @brief Maximum number of moved approximations for which the cached tiles
+ * are invalidated one by one, instead of being discarded altogether.
+ */
+static const int MAX_INCREMENTAL_CHANGES = 4096;
+
+/**
+ * @brief floorDiv computes the integer part of a / b, rounding towards
+ * minus infinity, for b > 0.
+ */
+static inline qint64
+floorDiv(qint64 a, qint64 b)
+{
+    return (a >= 0) ? a / b : - ((- a + b - 1) / b);
+}
+
 RootsRenderer::RootsRenderer()
 {
     m_maxImagModule = m_maxRealModule = 0.0;
     m_model = NULL;
     mCenter = QPointF(0.0, 0.0);
+    m_generation = 0;
+    m_tiles.setMaxCost(MAX_CACHED_TILES);
+    m_tileWorker = new RootsTileWorker();
+}
+
+RootsRenderer::~RootsRenderer()
+{
+    delete m_tileWorker;
 }
 
 void
 RootsRenderer::reloadRoots()
 {
-    m_roots.clear();
+    int n = m_model->rowCount();
+    QVector<QPointF> points(n);
+    QVector<double> radii(n);
+
     m_maxRealModule = m_maxImagModule = DBL_MIN;
 
-    for (int i = 0; i < m_model->rowCount(); i++)
+    for (int i = 0; i < n; i++)
     {
         Root * root = (Root*) (m_model->data(m_model->index(i), RootsModel::ROOT).value<void*>());
 
@@ -28,7 +72,81 @@ RootsRenderer::reloadRoots()
         m_maxRealModule = qMax (fabs(root->get_real_part()), m_maxRealModule);
         m_maxImagModule = qMax (fabs(root->get_imag_part()), m_maxImagModule);
 
-        m_roots.append(QPointF(root->get_real_part(), root->get_imag_part()));
+        points[i] = QPointF(root->get_real_part(), root->get_imag_part());
+        radii[i] = root->get_radius();
+    }
+
+    // Find out which approximations moved, to keep the tiles that are still
+    // valid. Changing the marked root or the radii does not move anything.
+    bool moved = true;
+
+    if (! m_index.isNull() && m_index->size() == n)
+    {
+        QVector<QPointF> changes;
+
+        for (int i = 0; i < n && changes.size() <= 2 * MAX_INCREMENTAL_CHANGES; i++)
+        {
+            if (points[i] != m_index->point(i))
+            {
+                changes.append(m_index->point(i));
+                changes.append(points[i]);
+            }
+        }
+
+        moved = ! changes.isEmpty();
+
+        if (changes.size() <= 2 * MAX_INCREMENTAL_CHANGES)
+            invalidateTiles(changes);
+        else
+            m_tiles.clear();
+    }
+    else
+        m_tiles.clear();
+
+    if (moved)
+        m_generation++;
+
+    m_index = QSharedPointer<const RootsSpatialIndex>(new RootsSpatialIndex(points, radii));
+    m_tileWorker->setIndex(m_index, m_generation);
+}
+
+void
+RootsRenderer::invalidateTiles(const QVector<QPointF>& points)
+{
+    if (points.isEmpty())
+        return;
+
+    QList<RootsTileKey> keys = m_tiles.keys();
+
+    for (int i = 0; i < keys.length(); i++)
+    {
+        QRectF rect = keys[i].rect();
+
+        for (int j = 0; j < points.size(); j++)
+        {
+            const QPointF& p = points[j];
+
+            if (p.x() >= rect.left() && p.x() <= rect.right() &&
+                    p.y() >= rect.top() && p.y() <= rect.bottom())
+            {
+                m_tiles.remove(keys[i]);
+                break;
+            }
+        }
+    }
+}
+
+void
+RootsRenderer::collectTiles()
+{
+    QList<QPair<RootsTileKey, QPair<int, QImage> > > tiles;
+    m_tileWorker->takeTiles(tiles);
+
+    for (int i = 0; i < tiles.length(); i++)
+    {
+        // Tiles rendered before the last movement of the roots may be stale.
+        if (tiles[i].second.first == m_generation)
+            m_tiles.insert(tiles[i].first, new QImage(tiles[i].second.second));
     }
 }
 
@@ -89,12 +207,27 @@ RootsRenderer::scaleVector(QPointF point, int width, int height)
     return QPointF(x, y);
 }
 
+QRectF
+RootsRenderer::visibleRect(int width, int height)
+{
+    double margin = 24;
+    double maxModule = qMax (m_maxRealModule, m_maxImagModule);
+
+    // Invert scalePoint() on the corners of the widget.
+    double left   = mCenter.x() + 2 * maxModule * (-margin / (width - 2 * margin) - .5);
+    double right  = mCenter.x() + 2 * maxModule * ((width - margin) / (width - 2 * margin) - .5);
+    double top    = mCenter.y() - 2 * maxModule * ((height - margin) / (height - 2 * margin) - .5);
+    double bottom = mCenter.y() - 2 * maxModule * (-margin / (height - 2 * margin) - .5);
+
+    return QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
 void
 RootsRenderer::drawTicks(QPainter& painter, double w, double h)
 {
     double maxModule = qMax(m_maxImagModule, m_maxRealModule);
 
-    if (maxModule == 0.0 || m_roots.length() == 0)
+    if (maxModule == 0.0 || m_index.isNull() || m_index->size() == 0)
         return;
 
     int tick_distance_eps = log10 (maxModule * 2);
@@ -172,36 +305,129 @@ RootsRenderer::handlePaintEvent(QPainter& painter, int w, int h, QPaintEvent *)
 
     drawTicks(painter, w, h);
 
-    // The default color for the point is red.
-    painter.setBrush(QBrush("red"));
-    painter.setPen(QColor(Qt::red));
+    if (m_index.isNull() || m_index->size() == 0)
+        return;
 
-    // ...and we need this to keep track of the MARKED point,
-    // if it exists.
-    int markedPoint = -1;
+    collectTiles();
 
-    for (int i = 0; i < m_roots.length(); i++)
-    {
-        QPointF p = scalePoint(m_roots[i], w, h);
+    // Draw the roots one by one only if there is enough room to tell
+    // them apart; otherwise display their density.
+    QRectF view = visibleRect(w, h);
+    int limit = qMin(MAX_DRAWN_ROOTS, w * h / MIN_PIXELS_PER_ROOT);
 
-        // We draw only not MARKED points. The MARKED one will be drawn in
-        // green outside of this for loop.
-        if (! m_model->data(m_model->index(i), RootsModel::MARKED).toBool())
-            painter.drawEllipse(p, 2, 2);
-        else
-            markedPoint = i;
-    }
+    if (m_index->count(view, limit) <= limit)
+        drawRoots(painter, view, w, h);
+    else
+        drawTiles(painter, view, w, h);
 
-    // If we have left out the MARKED point (and this happend only if this
-    // point exists) then draw it with green, and bigger than the others.
-    if (markedPoint != -1)
+    // Draw the MARKED point, if it exists, with green and bigger than the
+    // others.
+    int markedPoint = m_model ? m_model->markedRoot() : -1;
+    if (markedPoint >= 0 && markedPoint < m_index->size())
     {
-        QPointF p = scalePoint(m_roots[markedPoint], w, h);
-        painter.setBrush(QBrush("green"));
+        QPointF p = scalePoint(m_index->point(markedPoint), w, h);
         painter.setBrush(QColor(Qt::green));
         painter.setPen(QColor(Qt::green));
         painter.drawEllipse(p, 3, 3);
     }
 }
 
+void
+RootsRenderer::drawRoots(QPainter& painter, const QRectF& view, int w, int h)
+{
+    QVector<int> visible;
+    m_index->query(view, visible);
+
+    // Inclusion discs are drawn only if they are larger than the points,
+    // and lightly, so they do not hide the approximations.
+    QPointF unit = scaleVector(QPointF(1.0, 1.0), w, h);
+    double sx = fabs(unit.x()), sy = fabs(unit.y());
+
+    painter.setBrush(Qt::NoBrush);
+    painter.setPen(QColor(255, 0, 0, 64));
+
+    for (int i = 0; i < visible.size(); i++)
+    {
+        double r = m_index->radius(visible[i]);
+
+        if (std::isfinite(r) && r * sx >= 3 && r * sx <= 4 * (w + h))
+            painter.drawEllipse(scalePoint(m_index->point(visible[i]), w, h),
+                                r * sx, r * sy);
+    }
+
+    // The default color for the point is red.
+    painter.setBrush(QBrush("red"));
+    painter.setPen(QColor(Qt::red));
+
+    for (int i = 0; i < visible.size(); i++)
+        painter.drawEllipse(scalePoint(m_index->point(visible[i]), w, h), 2, 2);
+}
+
+void
+RootsRenderer::drawTiles(QPainter& painter, const QRectF& view, int w, int h)
+{
+    // Choose the tiles so that each pixel of their images covers at most
+    // one pixel of the screen.
+    QPointF unit = scaleVector(QPointF(1.0, 1.0), w, h);
+    double scale = qMax(fabs(unit.x()), fabs(unit.y()));
+
+    if (! std::isfinite(scale) || scale <= 0)
+        return;
+
+    int exponent = (int) ceil(log2(RootsTileWorker::TILE_SIZE / scale));
+    double side = ldexp(1.0, exponent);
+
+    QRectF bounds = view.intersected(m_index->bounds().adjusted(-side, -side, side, side));
+    qint64 x0 = (qint64) floor(bounds.left() / side);
+    qint64 x1 = (qint64) floor(bounds.right() / side);
+    qint64 y0 = (qint64) floor(bounds.top() / side);
+    qint64 y1 = (qint64) floor(bounds.bottom() / side);
+
+    QList<RootsTileKey> missing;
+
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+
+    for (qint64 y = y0; y <= y1; y++)
+    {
+        for (qint64 x = x0; x <= x1; x++)
+        {
+            RootsTileKey key(exponent, x, y);
+            QRectF rect = key.rect();
+            QRectF target(scalePoint(rect.bottomLeft(), w, h),
+                          scalePoint(rect.topRight(), w, h));
+            QImage * image = m_tiles.object(key);
+
+            if (image)
+            {
+                painter.drawImage(target, *image);
+                continue;
+            }
+
+            missing.append(key);
+
+            // While the tile is rendered, stretch the part of a coarser one
+            // that is already available, if any.
+            for (int k = 1; k <= 4; k++)
+            {
+                qint64 ratio = (qint64) 1 << k;
+                RootsTileKey parent(exponent + k, floorDiv(x, ratio), floorDiv(y, ratio));
+                QImage * parentImage = m_tiles.object(parent);
+
+                if (! parentImage)
+                    continue;
+
+                double size = RootsTileWorker::TILE_SIZE / (double) ratio;
+                QRectF source((x - parent.x * ratio) * size,
+                              (parent.y * ratio + ratio - 1 - y) * size,
+                              size, size);
+                painter.drawImage(target, *parentImage, source);
+                break;
+            }
+        }
+    }
+
+    if (! missing.isEmpty())
+        m_tileWorker->requestTiles(missing);
+}
+
 } // namespace xmpsolve
@@ -3,16 +3,31 @@
 
 #include "root.h"
 #include "rootsmodel.h"
+#include "rootsspatialindex.h"
+#include "rootstileworker.h"
 #include <QPainter>
 #include <QPaintEvent>
+#include <QCache>
+#include <QSharedPointer>
 
 namespace xmpsolve {
 
+/**
+ * @brief The RootsRenderer class draws the approximations on the complex plane.
+ *
+ * The approximations are kept in a RootsSpatialIndex, so that only the ones
+ * in the current view are considered. When they are too many to be told
+ * apart on the screen they are aggregated into density tiles, that are
+ * rendered by a RootsTileWorker in the background and cached; otherwise
+ * every approximation is drawn, together with its inclusion disc when
+ * this is large enough to be visible.
+ */
 class RootsRenderer
 {
 
 public:
     explicit RootsRenderer();
+    virtual ~RootsRenderer();
 
     void handlePaintEvent(QPainter& painter, int w, int h, QPaintEvent *);
 
@@ -61,15 +76,63 @@ protected:
     QPointF scaleVector(QPointF point, int width, int height);
     QPointF scaleVectorInverse(QPointF point, int width, int height);
 
+    /**
+     * @brief visibleRect returns the part of the complex plane that is
+     * displayed on a widget of the given size.
+     */
+    QRectF visibleRect(int width, int height);
+
     /**
      * @brief drawTicks is used internally to draw ticks on the axis.
      */
     void drawTicks(QPainter& painter, double w, double h);
 
     /**
-     * @brief Points that should be displayed.
+     * @brief drawRoots draws every approximation contained in view, and the
+     * inclusion discs that are large enough to be seen.
+     */
+    void drawRoots(QPainter& painter, const QRectF& view, int w, int h);
+
+    /**
+     * @brief drawTiles draws the density of the approximations contained in
+     * view using the cached tiles, and requests the missing ones to the
+     * worker thread.
+     */
+    void drawTiles(QPainter& painter, const QRectF& view, int w, int h);
+
+    /**
+     * @brief collectTiles moves the tiles completed by the worker thread
+     * into the cache.
+     */
+    void collectTiles();
+
+    /**
+     * @brief invalidateTiles removes from the cache the tiles containing
+     * one of the given points.
+     */
+    void invalidateTiles(const QVector<QPointF>& points);
+
+    /**
+     * @brief m_index is the spatial index of the approximations that
+     * should be displayed.
+     */
+    QSharedPointer<const RootsSpatialIndex> m_index;
+
+    /**
+     * @brief m_generation is incremented each time the approximations move,
+     * so that the tiles rendered before can be recognized.
+     */
+    int m_generation;
+
+    /**
+     * @brief m_tiles contains the density tiles already rendered.
+     */
+    QCache<RootsTileKey, QImage> m_tiles;
+
+    /**
+     * @brief m_tileWorker renders the density tiles in background.
      */
-    QList<QPointF> m_roots;
+    RootsTileWorker * m_tileWorker;
 
     /**
      * @brief m_maxRealModule is the maximum module of the real parts of the roots.
@@ -0,0 +1,201 @@
+#include "rootsspatialindex.h"
+#include <cmath>
+
+namespace xmpsolve {
+
+/**
+ * @brief Average number of approximations in each cell of the grid.
+ */
+static const int ROOTS_PER_CELL = 8;
+
+/**
+ * @brief Maximum number of cells along each side of the grid.
+ */
+static const int MAX_GRID_SIZE = 2048;
+
+static inline bool
+isFinitePoint(const QPointF& p)
+{
+    return std::isfinite(p.x()) && std::isfinite(p.y());
+}
+
+static inline bool
+rectContains(const QRectF& rect, const QPointF& p)
+{
+    return p.x() >= rect.left() && p.x() <= rect.right() &&
+           p.y() >= rect.top() && p.y() <= rect.bottom();
+}
+
+RootsSpatialIndex::RootsSpatialIndex(const QVector<QPointF>& points,
+                                     const QVector<double>& radii) :
+    m_points(points), m_radii(radii)
+{
+    int n = m_points.size();
+    double left = 0.0, right = 0.0, top = 0.0, bottom = 0.0;
+    int finite = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        const QPointF& p = m_points[i];
+
+        if (! isFinitePoint(p))
+            continue;
+
+        if (finite++ == 0)
+        {
+            left = right = p.x();
+            top = bottom = p.y();
+        }
+        else
+        {
+            left = qMin(left, p.x());
+            right = qMax(right, p.x());
+            top = qMin(top, p.y());
+            bottom = qMax(bottom, p.y());
+        }
+    }
+
+    m_bounds = QRectF(QPointF(left, top), QPointF(right, bottom));
+    m_gridSize = qBound(1, (int) sqrt((double) finite / ROOTS_PER_CELL), MAX_GRID_SIZE);
+
+    // Sort the approximations by cell with a counting sort, so that the
+    // ones in each cell are contiguous in m_order.
+    QVector<int> cells(n, -1);
+    m_cellStart.fill(0, m_gridSize * m_gridSize + 1);
+
+    double sx = m_bounds.width() > 0 ? m_gridSize / m_bounds.width() : 0.0;
+    double sy = m_bounds.height() > 0 ? m_gridSize / m_bounds.height() : 0.0;
+
+    for (int i = 0; i < n; i++)
+    {
+        const QPointF& p = m_points[i];
+
+        if (! isFinitePoint(p))
+            continue;
+
+        int cx = qMin((int) ((p.x() - left) * sx), m_gridSize - 1);
+        int cy = qMin((int) ((p.y() - top) * sy), m_gridSize - 1);
+
+        cells[i] = cy * m_gridSize + cx;
+        m_cellStart[cells[i] + 1]++;
+    }
+
+    for (int c = 0; c < m_gridSize * m_gridSize; c++)
+        m_cellStart[c + 1] += m_cellStart[c];
+
+    QVector<int> next(m_cellStart);
+    m_order.resize(finite);
+
+    for (int i = 0; i < n; i++)
+        if (cells[i] != -1)
+            m_order[next[cells[i]]++] = i;
+}
+
+bool
+RootsSpatialIndex::cellRange(const QRectF& rect, int& x0, int& y0, int& x1, int& y1) const
+{
+    if (m_order.isEmpty() ||
+            rect.right() < m_bounds.left() || rect.left() > m_bounds.right() ||
+            rect.bottom() < m_bounds.top() || rect.top() > m_bounds.bottom())
+        return false;
+
+    double sx = m_bounds.width() > 0 ? m_gridSize / m_bounds.width() : 0.0;
+    double sy = m_bounds.height() > 0 ? m_gridSize / m_bounds.height() : 0.0;
+
+    x0 = qBound(0.0, floor((rect.left() - m_bounds.left()) * sx), m_gridSize - 1.0);
+    x1 = qBound(0.0, floor((rect.right() - m_bounds.left()) * sx), m_gridSize - 1.0);
+    y0 = qBound(0.0, floor((rect.top() - m_bounds.top()) * sy), m_gridSize - 1.0);
+    y1 = qBound(0.0, floor((rect.bottom() - m_bounds.top()) * sy), m_gridSize - 1.0);
+
+    return true;
+}
+
+void
+RootsSpatialIndex::query(const QRectF& rect, QVector<int>& result) const
+{
+    int x0, y0, x1, y1;
+
+    if (! cellRange(rect, x0, y0, x1, y1))
+        return;
+
+    for (int cy = y0; cy <= y1; cy++)
+    {
+        for (int c = cy * m_gridSize + x0; c <= cy * m_gridSize + x1; c++)
+        {
+            for (int k = m_cellStart[c]; k < m_cellStart[c + 1]; k++)
+            {
+                if (rectContains(rect, m_points[m_order[k]]))
+                    result.append(m_order[k]);
+            }
+        }
+    }
+}
+
+int
+RootsSpatialIndex::count(const QRectF& rect, int limit) const
+{
+    int x0, y0, x1, y1, total = 0;
+
+    if (! cellRange(rect, x0, y0, x1, y1))
+        return 0;
+
+    for (int cy = y0; cy <= y1 && total <= limit; cy++)
+    {
+        // Cells in the interior of the range are entirely contained in rect,
+        // and can be counted without looking at their content.
+        bool inner_row = cy > y0 && cy < y1;
+
+        for (int cx = x0; cx <= x1; cx++)
+        {
+            int c = cy * m_gridSize + cx;
+
+            if (inner_row && cx > x0 && cx < x1)
+            {
+                total += m_cellStart[c + 1] - m_cellStart[c];
+                continue;
+            }
+
+            for (int k = m_cellStart[c]; k < m_cellStart[c + 1]; k++)
+            {
+                if (rectContains(rect, m_points[m_order[k]]))
+                    total++;
+            }
+        }
+    }
+
+    return total;
+}
+
+void
+RootsSpatialIndex::histogram(const QRectF& rect, int width, int height,
+                             QVector<unsigned int>& bins) const
+{
+    int x0, y0, x1, y1;
+
+    if (! cellRange(rect, x0, y0, x1, y1))
+        return;
+
+    double sx = width / rect.width();
+    double sy = height / rect.height();
+
+    for (int cy = y0; cy <= y1; cy++)
+    {
+        for (int c = cy * m_gridSize + x0; c <= cy * m_gridSize + x1; c++)
+        {
+            for (int k = m_cellStart[c]; k < m_cellStart[c + 1]; k++)
+            {
+                const QPointF& p = m_points[m_order[k]];
+
+                if (! rectContains(rect, p))
+                    continue;
+
+                int px = qMin((int) ((p.x() - rect.left()) * sx), width - 1);
+                int py = qMin((int) ((rect.bottom() - p.y()) * sy), height - 1);
+
+                bins[py * width + px]++;
+            }
+        }
+    }
+}
+
+} // namespace xmpsolve
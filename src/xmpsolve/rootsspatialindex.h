@@ -0,0 +1,105 @@
+#ifndef XMPSOLVE_ROOTSSPATIALINDEX_H
+#define XMPSOLVE_ROOTSSPATIALINDEX_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+namespace xmpsolve {
+
+/**
+ * @brief The RootsSpatialIndex class stores the approximations in a uniform
+ * grid over their bounding box, so that the ones falling in a rectangle
+ * of the complex plane can be found without looking at all of them.
+ *
+ * The index is never modified after being built, and can therefore be read
+ * from the background thread that renders the density tiles while the
+ * user interface keeps working with it.
+ */
+class RootsSpatialIndex
+{
+
+public:
+    /**
+     * @brief Build the index of the given points.
+     *
+     * @param points The approximations, as (real part, imaginary part).
+     * @param radii The inclusion radii of the approximations.
+     */
+    explicit RootsSpatialIndex(const QVector<QPointF>& points,
+                               const QVector<double>& radii);
+
+    /**
+     * @brief size is the number of approximations in the index.
+     */
+    int size() const { return m_points.size(); }
+
+    /**
+     * @brief point returns the i-th approximation.
+     */
+    const QPointF& point(int i) const { return m_points[i]; }
+
+    /**
+     * @brief radius returns the inclusion radius of the i-th approximation.
+     */
+    double radius(int i) const { return m_radii[i]; }
+
+    /**
+     * @brief bounds is the smallest rectangle containing all the finite
+     * approximations.
+     */
+    QRectF bounds() const { return m_bounds; }
+
+    /**
+     * @brief query appends to result the indices of the approximations
+     * contained in rect.
+     */
+    void query(const QRectF& rect, QVector<int>& result) const;
+
+    /**
+     * @brief count returns the number of approximations contained in rect,
+     * stopping as soon as more than limit of them have been found.
+     */
+    int count(const QRectF& rect, int limit) const;
+
+    /**
+     * @brief histogram adds to the width x height matrix bins the number of
+     * approximations falling in each of the pixels that rect is divided into.
+     * The first row of bins corresponds to the top of rect, i.e., to the
+     * largest imaginary parts.
+     */
+    void histogram(const QRectF& rect, int width, int height,
+                   QVector<unsigned int>& bins) const;
+
+private:
+    /**
+     * @brief cellRange computes the cells of the grid intersecting rect.
+     * @return false if rect does not intersect the grid at all.
+     */
+    bool cellRange(const QRectF& rect, int& x0, int& y0, int& x1, int& y1) const;
+
+    QVector<QPointF> m_points;
+    QVector<double> m_radii;
+    QRectF m_bounds;
+
+    /**
+     * @brief m_gridSize is the number of cells along each side of the grid.
+     */
+    int m_gridSize;
+
+    /**
+     * @brief m_cellStart[c] is the position in m_order of the first
+     * approximation of the cell c, which ends at m_cellStart[c + 1].
+     */
+    QVector<int> m_cellStart;
+
+    /**
+     * @brief m_order contains the indices of the finite approximations
+     * sorted by cell.
+     */
+    QVector<int> m_order;
+};
+
+} // namespace xmpsolve
+
+#endif // XMPSOLVE_ROOTSSPATIALINDEX_H
@@ -0,0 +1,131 @@
+#include "rootstileworker.h"
+#include <QMutexLocker>
+#include <cmath>
+
+namespace xmpsolve {
+
+QRectF
+RootsTileKey::rect() const
+{
+    double side = ldexp(1.0, exponent);
+    return QRectF(x * side, y * side, side, side);
+}
+
+RootsTileWorker::RootsTileWorker(QObject *parent) :
+    QThread(parent)
+{
+    m_stop = false;
+    m_generation = 0;
+}
+
+RootsTileWorker::~RootsTileWorker()
+{
+    m_mutex.lock();
+    m_stop = true;
+    m_condition.wakeAll();
+    m_mutex.unlock();
+
+    wait();
+}
+
+void
+RootsTileWorker::setIndex(QSharedPointer<const RootsSpatialIndex> index, int generation)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_index = index;
+    m_generation = generation;
+    m_requests.clear();
+}
+
+void
+RootsTileWorker::requestTiles(const QList<RootsTileKey>& keys)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_requests = keys;
+
+    if (! isRunning())
+        start(QThread::LowPriority);
+    else
+        m_condition.wakeAll();
+}
+
+void
+RootsTileWorker::takeTiles(QList<QPair<RootsTileKey, QPair<int, QImage> > >& tiles)
+{
+    QMutexLocker locker(&m_mutex);
+
+    tiles.append(m_results);
+    m_results.clear();
+}
+
+QImage
+RootsTileWorker::renderTile(const RootsSpatialIndex& index, const RootsTileKey& key)
+{
+    QVector<unsigned int> bins(TILE_SIZE * TILE_SIZE, 0);
+    QImage image(TILE_SIZE, TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+
+    index.histogram(key.rect(), TILE_SIZE, TILE_SIZE, bins);
+
+    // The opacity grows with the logarithm of the number of approximations
+    // in each pixel, on a scale that does not depend on the tile so that
+    // adjacent tiles blend together.
+    for (int y = 0; y < TILE_SIZE; y++)
+    {
+        QRgb * line = (QRgb*) image.scanLine(y);
+
+        for (int x = 0; x < TILE_SIZE; x++)
+        {
+            unsigned int c = bins[y * TILE_SIZE + x];
+
+            if (c == 0)
+            {
+                line[x] = qRgba(0, 0, 0, 0);
+                continue;
+            }
+
+            int alpha = qMin(255, (int) (96 + 20 * log2((double) c)));
+            line[x] = qRgba(alpha, 0, 0, alpha);
+        }
+    }
+
+    return image;
+}
+
+void
+RootsTileWorker::run()
+{
+    forever
+    {
+        m_mutex.lock();
+
+        while (! m_stop && m_requests.isEmpty())
+            m_condition.wait(&m_mutex);
+
+        if (m_stop)
+        {
+            m_mutex.unlock();
+            return;
+        }
+
+        RootsTileKey key = m_requests.takeFirst();
+        QSharedPointer<const RootsSpatialIndex> index = m_index;
+        int generation = m_generation;
+
+        m_mutex.unlock();
+
+        if (index.isNull())
+            continue;
+
+        QImage image = renderTile(*index, key);
+
+        m_mutex.lock();
+        m_results.append(qMakePair(key, qMakePair(generation, image)));
+        m_mutex.unlock();
+
+        emit tileReady();
+    }
+}
+
+} // namespace xmpsolve
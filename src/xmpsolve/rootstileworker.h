@@ -0,0 +1,121 @@
+#ifndef XMPSOLVE_ROOTSTILEWORKER_H
+#define XMPSOLVE_ROOTSTILEWORKER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSharedPointer>
+#include <QImage>
+#include <QList>
+#include <QPair>
+#include <QHash>
+#include "rootsspatialindex.h"
+
+namespace xmpsolve {
+
+/**
+ * @brief The RootsTileKey struct identifies a square tile of the complex
+ * plane of side \f$2^{exponent}\f$, whose bottom left corner is
+ * \f$2^{exponent} (x + iy)\f$.
+ *
+ * Tiles are aligned to a fixed grid of the plane, and not to the current
+ * view, so the ones already rendered can be reused while panning.
+ */
+struct RootsTileKey
+{
+    int exponent;
+    qint64 x;
+    qint64 y;
+
+    RootsTileKey(int e = 0, qint64 tx = 0, qint64 ty = 0) :
+        exponent(e), x(tx), y(ty) {}
+
+    /**
+     * @brief rect returns the part of the complex plane covered by the tile.
+     */
+    QRectF rect() const;
+
+    bool operator==(const RootsTileKey& other) const
+    {
+        return exponent == other.exponent && x == other.x && y == other.y;
+    }
+};
+
+inline uint qHash(const RootsTileKey& key)
+{
+    return qHash(key.x * 1000003 + key.y) ^ qHash(key.exponent);
+}
+
+/**
+ * @brief The RootsTileWorker class renders the density tiles of the
+ * approximations in a background thread.
+ *
+ * The renderers ask for the tiles that they are missing with requestTiles(),
+ * and collect the completed ones with takeTiles() when the tileReady()
+ * signal asks them to repaint.
+ */
+class RootsTileWorker : public QThread
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Side, in pixels, of the images of the tiles.
+     */
+    static const int TILE_SIZE = 256;
+
+    explicit RootsTileWorker(QObject *parent = 0);
+    ~RootsTileWorker();
+
+    /**
+     * @brief setIndex selects the approximations used to render the tiles
+     * requested from now on.
+     *
+     * @param index The spatial index of the approximations.
+     * @param generation A number identifying index, that is attached to the
+     * tiles rendered with it.
+     */
+    void setIndex(QSharedPointer<const RootsSpatialIndex> index, int generation);
+
+    /**
+     * @brief requestTiles replaces the tiles waiting to be rendered with keys.
+     * Tiles requested before and not yet rendered are dropped, since they
+     * usually belong to a view that is not visible anymore.
+     */
+    void requestTiles(const QList<RootsTileKey>& keys);
+
+    /**
+     * @brief takeTiles moves the tiles rendered since its last call to tiles,
+     * together with the generation of the index used for each of them.
+     */
+    void takeTiles(QList<QPair<RootsTileKey, QPair<int, QImage> > >& tiles);
+
+    /**
+     * @brief renderTile draws the density of the approximations in the part
+     * of the plane covered by key.
+     */
+    static QImage renderTile(const RootsSpatialIndex& index, const RootsTileKey& key);
+
+    void run();
+
+signals:
+    /**
+     * @brief tileReady is emitted, from the worker thread, each time a new
+     * tile can be collected with takeTiles().
+     */
+    void tileReady();
+
+private:
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    bool m_stop;
+
+    QSharedPointer<const RootsSpatialIndex> m_index;
+    int m_generation;
+
+    QList<RootsTileKey> m_requests;
+    QList<QPair<RootsTileKey, QPair<int, QImage> > > m_results;
+};
+
+} // namespace xmpsolve
+
+#endif // XMPSOLVE_ROOTSTILEWORKER_H
@@ -63,6 +63,8 @@ HEADERS += ./mpsolveworker.h \
            ./polynomialsolver.h \
            ./root.h \
            ./rootsrenderer.h \
+           ./rootsspatialindex.h \
+           ./rootstileworker.h \
            ./monomial.h \
            ./rootsmodel.h \
            ./polsyntaxhighlighter.h
@@ -72,6 +74,8 @@ SOURCES += ./main.cpp \
            ./polynomialsolver.cpp \
            ./root.cpp \
            ./rootsrenderer.cpp \
+           ./rootsspatialindex.cpp \
+           ./rootstileworker.cpp \
            ./rootsmodel.cpp \
            ./polsyntaxhighlighter.cpp
 
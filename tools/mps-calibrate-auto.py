@@ -0,0 +1,141 @@
+#!/usr/bin/python3
+#
+# This file is part of MPSolve 3.1.8
+#
+# Copyright (C) 2001-2019, Dipartimento di Matematica "L. Tonelli", Pisa.
+# License: http://www.gnu.org/licenses/gpl.html GPL version 3 or higher
+#
+# Calibrate the thresholds used by the automatic configuration of MPSolve
+# (mpsolve -aa) on a set of benchmark polynomials.
+#
+# Every polynomial is solved once with -aa, to read its features from the
+# debug output, and then with each of the alternatives that the automatic
+# configuration can choose. The thresholds are then selected, one at a
+# time, to minimize the total time spent on the benchmarks, and written
+# in a file that can be loaded with mpsolve -A file.
+#
+# Usage: mps-calibrate-auto.py [-m mpsolve] [-t timeout] [-j threads]
+#                              [-o output] file.pol [file.pol ...]
+#
+
+import argparse
+import re
+import subprocess
+import sys
+import time
+
+FEATURES_RE = re.compile(r"Auto-configuration features: degree = (\d+), "
+                         r"sparsity = ([-0-9.e]+), dynamic range = ([-0-9.e]+) bits, "
+                         r"Newton polygon vertices = (\d+), modulus spread = ([-0-9.e]+) bits")
+
+# Alternatives that the automatic configuration chooses among, and the
+# options that force them.
+VARIANTS = {
+    'standard':  ['-au'],
+    'secular':   ['-as'],
+    'dpe':       ['-as', '-td'],
+    'companion': ['-as', '-e'],
+    'block':     ['-as', '-B'],
+    'serial':    ['-as', '-j1'],
+}
+
+
+def run(mpsolve, options, pol, timeout):
+    start = time.time()
+    try:
+        result = subprocess.run([mpsolve] + options + [pol], stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT, timeout=timeout,
+                                universal_newlines=True)
+    except subprocess.TimeoutExpired:
+        return None, 2 * timeout
+    return result.stdout, time.time() - start
+
+
+def best_threshold(candidates, cost):
+    return min(sorted(set(candidates)), key=cost)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Calibrate the automatic configuration of MPSolve')
+    parser.add_argument('-m', '--mpsolve', default='mpsolve', help='path of the mpsolve executable')
+    parser.add_argument('-t', '--timeout', type=float, default=60.0,
+                        help='time limit for a single run, in seconds')
+    parser.add_argument('-j', '--threads', type=int, default=0,
+                        help='number of threads used for the parallel runs')
+    parser.add_argument('-o', '--output', default='-', help='calibration file to write')
+    parser.add_argument('polynomials', nargs='+', help='benchmark polynomials')
+    args = parser.parse_args()
+
+    data = []
+    for pol in args.polynomials:
+        output, _ = run(args.mpsolve, ['-aa', '-d'], pol, args.timeout)
+        match = FEATURES_RE.search(output or '')
+        if not match:
+            print('%s: cannot read the features, skipping' % pol, file=sys.stderr)
+            continue
+
+        features = {
+            'degree': int(match.group(1)),
+            'density': 1.0 - float(match.group(2)),
+            'range': float(match.group(3)),
+            'spread': float(match.group(5)),
+        }
+
+        times = {}
+        for name, options in VARIANTS.items():
+            if args.threads and name != 'serial':
+                options = options + ['-j%d' % args.threads]
+            times[name] = run(args.mpsolve, options, pol, args.timeout)[1]
+
+        print('%s: %s' % (pol, ', '.join('%s %.2fs' % t for t in sorted(times.items()))),
+              file=sys.stderr)
+        data.append((features, times))
+
+    if not data:
+        sys.exit('No benchmark could be run')
+
+    # Each threshold is chosen assuming the default for the others, since
+    # every alternative is only compared with the plain secular algorithm.
+    calibration = {}
+
+    calibration['sparse_ratio'] = best_threshold(
+        [0.0] + [f['density'] for f, _ in data],
+        lambda r: sum(t['standard'] if f['density'] <= r else t['secular'] for f, t in data))
+
+    calibration['dpe_dynamic_range'] = best_threshold(
+        [1024.0] + [f['range'] for f, _ in data],
+        lambda r: sum(t['dpe'] if f['range'] > r else t['secular'] for f, t in data))
+
+    calibration['companion_max_degree'] = best_threshold(
+        [0] + [f['degree'] for f, _ in data],
+        lambda d: sum(t['companion'] if f['degree'] <= d else t['secular'] for f, t in data))
+
+    calibration['companion_min_spread'] = best_threshold(
+        [0.0] + [f['spread'] for f, _ in data],
+        lambda r: sum(t['companion'] if (f['degree'] <= calibration['companion_max_degree'] and
+                                         f['spread'] > r) else t['secular'] for f, t in data))
+
+    calibration['roots_per_thread'] = best_threshold(
+        [1, 2, 4, 8, 16, 32, 64, 128, 256],
+        lambda r: sum(t['serial'] if f['degree'] < 2 * r else t['secular'] for f, t in data))
+
+    calibration['block_min_degree'] = best_threshold(
+        [0] + [f['degree'] for f, _ in data],
+        lambda d: sum(t['block'] if d > 0 and f['degree'] >= d else t['secular'] for f, t in data))
+
+    calibration['block_max_spread'] = best_threshold(
+        [0.0] + [f['spread'] for f, _ in data],
+        lambda r: sum(t['block'] if (calibration['block_min_degree'] > 0 and
+                                     f['degree'] >= calibration['block_min_degree'] and
+                                     f['spread'] <= r) else t['secular'] for f, t in data))
+
+    out = sys.stdout if args.output == '-' else open(args.output, 'w')
+    out.write('# Calibration of mpsolve -aa on %d benchmarks\n' % len(data))
+    for key, value in calibration.items():
+        out.write('%s = %s\n' % (key, value))
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == '__main__':
+    main()